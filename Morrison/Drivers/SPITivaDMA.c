@@ -52,6 +52,8 @@
 #include <driverlib/udma.h>
 #include <driverlib/sysctl.h>
 
+#include "ErrorLog.h"
+
 /*
  * Macro to access "Mode of Operation" bits in the SSIPP register
  * If it returns 0; we're using a SSI controller
@@ -66,6 +68,8 @@ void         SPITivaDMA_init(SPI_Handle handle);
 SPI_Handle   SPITivaDMA_open(SPI_Handle handle, SPI_Params *params);
 void         SPITivaDMA_serviceISR(SPI_Handle handle);
 bool         SPITivaDMA_transfer(SPI_Handle handle, SPI_Transaction *transaction);
+bool         SPITivaDMA_transferSG(SPI_Handle handle,
+                                   SPITivaDMA_SGTransaction *sgTransaction);
 void         SPITivaDMA_transferCancel(SPI_Handle handle);
 static void  SPITivaDMA_transferCallback(SPI_Handle handle,
                                          SPI_Transaction *transaction);
@@ -124,6 +128,25 @@ static const uint32_t dmaNullConfig[] = {
     UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_NONE | UDMA_ARB_4  // 16bit
 };
 
+/*
+ * These lookup tables are used to build the scatter/gather tasks for the
+ * appropriate (8bit or 16bit) transfer sizes.
+ */
+static const uint32_t dmaItemSize[] = {
+    UDMA_SIZE_8,            /* 8bit */
+    UDMA_SIZE_16            /* 16bit */
+};
+
+static const uint32_t dmaSrcIncrement[] = {
+    UDMA_SRC_INC_8,         /* 8bit */
+    UDMA_SRC_INC_16         /* 16bit */
+};
+
+static const uint32_t dmaDstIncrement[] = {
+    UDMA_DST_INC_8,         /* 8bit */
+    UDMA_DST_INC_16         /* 16bit */
+};
+
 /* This lookup table is used to find the appropiate SysCtlPeripheralReset args */
 static const uint32_t peripheralResets [] = {
     SYSCTL_PERIPH_SSI0,
@@ -305,6 +328,130 @@ static void SPITivaDMA_configDMA(SPI_Handle handle, SPI_Transaction *transaction
     hwAttrs->channelMappingFxn(hwAttrs->txChannelMappingFxnArg);
     hwAttrs->channelMappingFxn(hwAttrs->rxChannelMappingFxnArg);
 
+    /* A scatter/gather transfer may have left the alternate structure selected */
+    uDMAChannelAttributeDisable(hwAttrs->txChannelIndex, UDMA_ATTR_ALTSELECT);
+    uDMAChannelAttributeDisable(hwAttrs->rxChannelIndex, UDMA_ATTR_ALTSELECT);
+
+    /* Enable DMA Channels */
+    uDMAChannelEnable(hwAttrs->txChannelIndex);
+    uDMAChannelEnable(hwAttrs->rxChannelIndex);
+
+    Hwi_restore(key);
+}
+
+/*
+ *  ======== SPITivaDMA_setTask ========
+ *  This functions fills a scatter/gather task of a DMA channel
+ */
+static void SPITivaDMA_setTask(tDMAControlTable *task, size_t count,
+                               uint32_t itemSize, uint32_t srcIncrement,
+                               void *srcBuf, uint32_t dstIncrement,
+                               void *dstBuf, uint32_t taskMode)
+{
+    tDMAControlTable entry = uDMATaskStructEntry(count, itemSize,
+                                                 srcIncrement, srcBuf,
+                                                 dstIncrement, dstBuf,
+                                                 UDMA_ARB_4, taskMode);
+
+    *task = entry;
+}
+
+/*
+ *  ======== SPITivaDMA_configDMASG ========
+ *  This functions configures the transmit and receive DMA channels in
+ *  peripheral scatter/gather mode for a given SPI_Handle and
+ *  SPITivaDMA_SGTransaction. The first task of each channel moves the command
+ *  segment and the second one moves the data segment.
+ *
+ *  @pre    Function assumes that the handle and transaction is not NULL
+ */
+static void SPITivaDMA_configDMASG(SPI_Handle handle,
+                                   SPITivaDMA_SGTransaction *sgTransaction)
+{
+    SPIDataType                dummy;
+    unsigned int               key;
+    void                      *buf;
+    uint32_t                   increment;
+    SPI_Transaction           *transaction = &(sgTransaction->transaction);
+    SPITivaDMA_Object         *object = handle->object;
+    SPITivaDMA_HWAttrs const  *hwAttrs = handle->hwAttrs;
+    void                      *dataReg = (void *)(hwAttrs->baseAddr + SSI_O_DR);
+
+    /* Clear out the FIFO */
+    while (SSIDataGetNonBlocking(hwAttrs->baseAddr, &dummy)) {
+    }
+
+    /* Setup the TX tasks, the command first and then the data */
+    SPITivaDMA_setTask(&(object->txTaskList[0]), sgTransaction->cmdCount,
+                       dmaItemSize[object->frameSize],
+                       dmaSrcIncrement[object->frameSize],
+                       sgTransaction->cmdBuf,
+                       UDMA_DST_INC_NONE, dataReg,
+                       UDMA_MODE_PER_SCATTER_GATHER);
+
+    if (transaction->txBuf) {
+        increment = dmaSrcIncrement[object->frameSize];
+        buf = transaction->txBuf;
+    }
+    else {
+        increment = UDMA_SRC_INC_NONE;
+        *hwAttrs->scratchBufPtr = hwAttrs->defaultTxBufValue;
+        buf = hwAttrs->scratchBufPtr;
+    }
+
+    SPITivaDMA_setTask(&(object->txTaskList[1]), transaction->count,
+                       dmaItemSize[object->frameSize], increment, buf,
+                       UDMA_DST_INC_NONE, dataReg, UDMA_MODE_BASIC);
+
+    /* Setup the RX tasks, the frames clocked in by the command are dropped */
+    SPITivaDMA_setTask(&(object->rxTaskList[0]), sgTransaction->cmdCount,
+                       dmaItemSize[object->frameSize],
+                       UDMA_SRC_INC_NONE, dataReg,
+                       UDMA_DST_INC_NONE, hwAttrs->scratchBufPtr,
+                       UDMA_MODE_PER_SCATTER_GATHER);
+
+    if (transaction->rxBuf) {
+        increment = dmaDstIncrement[object->frameSize];
+        buf = transaction->rxBuf;
+    }
+    else {
+        increment = UDMA_DST_INC_NONE;
+        buf = hwAttrs->scratchBufPtr;
+    }
+
+    SPITivaDMA_setTask(&(object->rxTaskList[1]), transaction->count,
+                       dmaItemSize[object->frameSize],
+                       UDMA_SRC_INC_NONE, dataReg, increment, buf,
+                       UDMA_MODE_BASIC);
+
+    /* Point the primary structures at the task lists */
+    uDMAChannelScatterGatherSet(hwAttrs->txChannelIndex, 2,
+                                object->txTaskList, 1);
+    uDMAChannelScatterGatherSet(hwAttrs->rxChannelIndex, 2,
+                                object->rxTaskList, 1);
+
+    Log_print1(Diags_USER1,"SPI:(%p) DMA scatter/gather transfer enabled",
+                            hwAttrs->baseAddr);
+
+    Log_print5(Diags_USER2,"SPI:(%p) DMA transaction: %p, "
+                           "rxBuf: %p; txBuf: %p; Count: %d",
+                            hwAttrs->baseAddr,
+                            (UArg)transaction,
+                            (UArg)transaction->rxBuf,
+                            (UArg)transaction->txBuf,
+                            (UArg)transaction->count);
+
+    /* A lock is needed because we are accessing shared uDMA registers.*/
+    key = Hwi_disable();
+
+    /* Configure channel mapping */
+    hwAttrs->channelMappingFxn(hwAttrs->txChannelMappingFxnArg);
+    hwAttrs->channelMappingFxn(hwAttrs->rxChannelMappingFxnArg);
+
+    /* The task lists are started from the primary structures */
+    uDMAChannelAttributeDisable(hwAttrs->txChannelIndex, UDMA_ATTR_ALTSELECT);
+    uDMAChannelAttributeDisable(hwAttrs->rxChannelIndex, UDMA_ATTR_ALTSELECT);
+
     /* Enable DMA Channels */
     uDMAChannelEnable(hwAttrs->txChannelIndex);
     uDMAChannelEnable(hwAttrs->rxChannelIndex);
@@ -325,6 +472,15 @@ void SPITivaDMA_hwiFxn(UArg arg)
     Log_print1(Diags_USER2, "SPI:(%p) interrupt context start",
                hwAttrs->baseAddr);
 
+    /*
+     * A receive overrun means the DMA lost data, queue it for the error log
+     * as the dataflash cannot be written from here
+     */
+    if (SSIIntStatus(hwAttrs->baseAddr, false) & SSI_RXOR) {
+        SSIIntClear(hwAttrs->baseAddr, SSI_RXOR);
+        ErrorLogWriteFromISR(ERRORCODE_ENUM_SPI_ERROR, ERRORTYPE_ENUM_CRITICAL);
+    }
+
     /* Determine if the TX and RX DMA channels have completed */
 #if defined(MWARE)
     if ((object->transaction) &&
@@ -538,6 +694,72 @@ bool SPITivaDMA_transfer(SPI_Handle handle, SPI_Transaction *transaction)
     return (true);
 }
 
+/*
+ *  ======== SPITivaDMA_transferSG ========
+ *  @pre    Function assumes that handle and sgTransaction is not NULL
+ */
+bool SPITivaDMA_transferSG(SPI_Handle handle,
+                           SPITivaDMA_SGTransaction *sgTransaction)
+{
+    unsigned int               key;
+    SPI_Transaction           *transaction = &(sgTransaction->transaction);
+    SPITivaDMA_Object         *object = handle->object;
+    SPITivaDMA_HWAttrs const  *hwattrs = handle->hwAttrs;
+
+    /* Check the transaction arguments, each segment is one uDMA task */
+    if ((transaction->count == 0) || (transaction->count > 1024) ||
+        (sgTransaction->cmdCount == 0) || (sgTransaction->cmdCount > 1024) ||
+        !sgTransaction->cmdBuf || !hwattrs->scratchBufPtr) {
+        return (false);
+    }
+
+    /* Make sure that the buffers are aligned properly */
+    if (object->frameSize == SPITivaDMA_16bit) {
+        Assert_isTrue(!((uint32_t)sgTransaction->cmdBuf & 0x1), NULL);
+        Assert_isTrue(!((uint32_t)transaction->txBuf & 0x1), NULL);
+        Assert_isTrue(!((uint32_t)transaction->rxBuf & 0x1), NULL);
+    }
+
+    /* Check if a transfer is in progress */
+    key = Hwi_disable();
+    if (object->transaction) {
+        Hwi_restore(key);
+
+        Log_error1("SPI:(%p) transaction still in progress",
+                   hwattrs->baseAddr);
+
+        /* Transfer is in progress */
+        return (false);
+    }
+    else {
+        /* Save the pointer to the transaction */
+        object->transaction = transaction;
+    }
+    Hwi_restore(key);
+
+    SPITivaDMA_configDMASG(handle, sgTransaction);
+
+    if (object->transferMode == SPI_MODE_BLOCKING) {
+        Log_print1(Diags_USER1,
+                   "SPI:(%p) transfer pending on transferComplete semaphore",
+                    hwattrs->baseAddr);
+
+        if (!Semaphore_pend(Semaphore_handle(&(object->transferComplete)),
+                            object->transferTimeout)) {
+
+            /*
+             * Transfer has timed out.
+             * Bring the SPI driver back to a known good state.
+             */
+            SPITivaDMA_transferCancel(handle);
+
+            return(false);
+        }
+    }
+
+    return (true);
+}
+
 /*
  *  ======== SPITivaDMA_transferCancel ========
  *  A function to cancel a transaction (if one is in progress) when the driver
@@ -103,6 +103,16 @@
  *  The Tiva micro DMA contoller only supports data transfers of upto 1024
  *  data frames. A data frame can be 4 to 16 bits in length.
  *
+ *  ## Scatter/gather transfers #
+ *
+ *  SPITivaDMA_transferSG() sends a command segment followed by a data segment
+ *  in a single transfer. The frames received while the command is sent are
+ *  discarded into the scratch buffer and the frames received after it land in
+ *  the payload buffer. Both segments are moved by the uDMA in peripheral
+ *  scatter/gather mode so no frame is copied by the CPU. Each segment is
+ *  limited to 1024 frames and the uDMA control table must hold the alternate
+ *  control structures.
+ *
  *  ## DMA accessible memory #
  *
  *  As this driver uses uDMA to transfer data/from data buffers, it is the
@@ -123,7 +133,9 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <TM4CSPI.h>
+#include <driverlib/udma.h>
 
 #include <ti/sysbios/knl/Semaphore.h>
 #define ti_sysbios_family_arm_m3_Hwi__nolocalnames
@@ -263,11 +275,42 @@ typedef struct SPITivaDMA_Object {
 
     SPI_Transaction      *transaction;         /* void * to the current transaction*/
 
+    tDMAControlTable      txTaskList[2];       /* TX scatter/gather tasks */
+    tDMAControlTable      rxTaskList[2];       /* RX scatter/gather tasks */
+
     SPITivaDMA_FrameSize  frameSize;           /* Data frame size variable */
 
     bool                  isOpen;              /* flag to indicate module is open */
 } SPITivaDMA_Object, *SPITivaDMA_Handle;
 
+/*!
+ *  @brief  SPITivaDMA scatter/gather transaction
+ *
+ *  transaction.count, transaction.txBuf and transaction.rxBuf describe the
+ *  data segment. A NULL txBuf sends defaultTxBufValue and a NULL rxBuf
+ *  discards the received frames. cmdCount frames of cmdBuf are sent before
+ *  the data segment and as many received frames are discarded.
+ */
+typedef struct SPITivaDMA_SGTransaction {
+    SPI_Transaction       transaction;         /* Data segment and status */
+    void                 *cmdBuf;              /* Command segment */
+    size_t                cmdCount;            /* Frames in the command segment */
+} SPITivaDMA_SGTransaction;
+
+/*!
+ *  @brief  Function to perform a scatter/gather SPI transaction
+ *
+ *  The transfer follows the mode of the SPI_Handle like SPI_transfer().
+ *
+ *  @param  handle        A SPI_Handle opened with the SPITivaDMA driver
+ *
+ *  @param  sgTransaction A pointer to a SPITivaDMA_SGTransaction
+ *
+ *  @return true if started successfully; else false
+ */
+extern bool SPITivaDMA_transferSG(SPI_Handle handle,
+                                  SPITivaDMA_SGTransaction *sgTransaction);
+
 /* Do not interfere with the app if they include the family Hwi module */
 #undef ti_sysbios_family_arm_m3_Hwi__nolocalnames
 
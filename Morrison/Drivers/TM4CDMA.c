@@ -73,8 +73,6 @@
 static uint8_t g_pui8TxBuf[UART_TXBUF_SIZE];
 static uint8_t g_pui8RxPing[UART_RXBUF_SIZE];
 static uint8_t g_pui8RxPong[UART_RXBUF_SIZE];
-// Error counter
-static uint32_t g_ui32DMAErrCount = 0;
 // Transfer counters
 static uint32_t g_ui32RxPingCount = 0;
 static uint32_t g_ui32RxPongCount = 0;
@@ -106,30 +104,6 @@ void PWMInit1(void);
 // GLOBAL  FUNCTIONS PROTOTYPES
 //==============================================================================
 
-//==============================================================================
-//
-//  void uDMAErrorHandler(void)
-//
-//  Author:     Muhammad Saleem
-//  Date:       2016/21/11
-//
-//! uDMA error handler
-//
-//============================================================================== 
-
-void uDMAErrorHandler(void)
-{
-   uint32_t ui32Status;
-
-   ui32Status = ROM_uDMAErrorStatusGet();
-
-   if(ui32Status)
-   {
-     ROM_uDMAErrorStatusClear();
-     g_ui32DMAErrCount++;
-   }
-}
-
 //==============================================================================
 //
 //  void DMA1IntHandler(void)
@@ -277,7 +251,6 @@ void initDMAmain(void)
    // Enable uDMA
    ROM_SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
    ROM_SysCtlPeripheralSleepEnable(SYSCTL_PERIPH_UDMA);
-   //ROM_IntEnable(INT_UDMAERR); SALEEM
    ROM_uDMAEnable();
    ROM_uDMAControlBaseSet(ucControlTable);
 
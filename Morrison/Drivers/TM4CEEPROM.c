@@ -167,8 +167,8 @@ bool TM4CEEPROMReadData(unsigned int *data, unsigned char blockNumber, unsigned
     {
         //Get the total number of bytes
         numberOfBytes = numberOfWords * 4;
-        //Calculate the address
-        startAddressCalculated = (BLOCK_NUMBER_OF_WORDS * blockNumber) + (startWordNumber * 4);
+        //Calculate the address, a block has 16 words of 4 bytes
+        startAddressCalculated = (BLOCK_NUMBER_OF_WORDS * 4 * blockNumber) + (startWordNumber * 4);
         //Read the data
         EEPROMRead(data, startAddressCalculated, numberOfBytes);
     }
@@ -211,8 +211,8 @@ bool TM4CEEPROMWriteData(unsigned int *data, unsigned char blockNumber, unsigned
     {
         //Get the total number of bytes
         numberOfBytes = numberOfWords * 4;
-        //Calculate the address
-        startAddressCalculated = (BLOCK_NUMBER_OF_WORDS * blockNumber) + (startWordNumber * 4);
+        //Calculate the address, a block has 16 words of 4 bytes
+        startAddressCalculated = (BLOCK_NUMBER_OF_WORDS * 4 * blockNumber) + (startWordNumber * 4);
         //Read the data
         writeStatus = EEPROMProgram(data, startAddressCalculated, numberOfBytes);
     }
@@ -220,7 +220,8 @@ bool TM4CEEPROMWriteData(unsigned int *data, unsigned char blockNumber, unsigned
     {
         //Do nothing
     }
-    if ( writeStatus == 0 )
+    //EEPROMProgram returns 0 if the words are programmed, an error otherwise
+    if ( writeStatus != 0 )
     {
        isDataCorrect = false;
     }
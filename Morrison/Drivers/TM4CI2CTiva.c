@@ -59,6 +59,7 @@
 #include <inc/hw_types.h>
 #include <driverlib/i2c.h>
 #include "TM4CI2CTiva.h"
+#include "ErrorLog.h"
 //
 //==============================================================================
 // CONSTANTAS, DEFINES AND MACROS
@@ -549,6 +550,12 @@ static void I2CTiva_hwiFxn(UArg arg)
         // Some sort of error happened! 
         object->mode = I2CTiva_ERROR;
 
+        // A lost arbitration is a bus fault, queue it for the error log. A
+        // missing acknowledge is an answer of the slave and is not logged
+        if (errStatus & I2C_MASTER_ERR_ARB_LOST) {
+            ErrorLogWriteFromISR(ERRORCODE_ENUM_I2C_LOCKUP_ERROR, ERRORTYPE_ENUM_CRITICAL);
+        }
+
         if (errStatus & (I2C_MASTER_ERR_ARB_LOST | I2C_MASTER_ERR_ADDR_ACK)) {
             I2CTiva_completeTransfer((I2C_Handle) arg);
         }
@@ -44,14 +44,29 @@
 //  INCLUDES 
 //==============================================================================
 
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+#include <ti/sysbios/gates/GateMutex.h>
 #include "ErrorLog.h"
 #include "Dataflash.h"
+#include "DataflashQueue.h"
+#include "WearLevel.h"
 #include "TM4CRTC.h"
 
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
 
+#define ERRLOG_PAGE_LENGTH            (ERRLOG_ENTRIES_PER_PAGE * WORDS_PER_ERRLOG * 2U) //!< Bytes of the entries of an error log page
+#define ERRLOG_RECORD_LENGTH          (WORDS_PER_ERRLOG * 2U)                   //!< Bytes of an error log entry
+#define ERRLOG_COMMIT_MARKER_OFFSET   (ERRLOG_TIME2_OFFSET * 2U)                //!< Byte of the entry holding the commit marker, high byte of the year
+#define ERRLOG_COMMIT_MARKER          0x00U                                     //!< Commit marker of a completely programmed entry
+#define ERRLOG_ERASED_BYTE            0xFFU                                     //!< Value of an erased dataflash byte
+#define ERRLOG_DEFERRED_QUEUE_MASK    (ERRLOG_DEFERRED_QUEUE_LENGTH - 1U)       //!< Mask of the slot of a queued error
+#define ERRLOG_WRITE_SLOTS            4U                                        //!< Entries queued to the dataflash task at once
+#define SECONDS_PER_MINUTE            60U                                       //!< Seconds in a minute
+#define SECONDS_PER_HOUR              3600U                                     //!< Seconds in an hour
 
 //==============================================================================
 //  LOCAL DATA STRUCTURE DEFINITION
@@ -62,7 +77,38 @@ typedef struct
    ERRORCODE_ENUM errorCode;
    unsigned char entryIndex;
    unsigned short errorIdentifier;
+   bool isNextEntryTorn;
 } ERROR_INFORMATION_STRUCT;
+
+//! This data structure defines the rate of the errors of one code, the legacy
+//! codes share an error log but each of them has its own bucket
+typedef struct
+{
+   ERRORCODE_ENUM errorCode;                                                    //!< Code of the errors, ERRORCODE_ENUM_NO_ERROR if the entry is free
+   unsigned char errorIndex;                                                    //!< Index of the error log of the code in errorInformation
+   unsigned char tokens;                                                        //!< Errors of the code that can be written at once
+   unsigned int tokenTicks;                                                     //!< Clock ticks when the last token was added
+   unsigned int usedTicks;                                                      //!< Clock ticks when an error of the code was last written or counted
+   unsigned char repeatCount;                                                   //!< Errors not written, 0 if none
+   DATE_TIME_STRUCT repeatDateTime;                                             //!< Time of the first error not written
+   DATE_TIME_STRUCT repeatLastDateTime;                                         //!< Time of the last error not written
+} ERROR_RATE_STRUCT;
+
+//! This data structure defines an error queued by an interrupt
+typedef struct
+{
+   ERRORCODE_ENUM errorCode;
+   unsigned int queuedTicks;
+} DEFERRED_ERROR_STRUCT;
+
+//! This data structure defines an entry queued to the dataflash task, the
+//! entry is programmed first and its commit marker after it
+typedef struct
+{
+   unsigned char record[ERRLOG_RECORD_LENGTH];                                  //!< Entry to be programmed
+   DATAFLASH_REQUEST_STRUCT recordRequest;                                      //!< Program of the entry
+   DATAFLASH_REQUEST_STRUCT markerRequest;                                      //!< Program of the commit marker
+} ERROR_WRITE_SLOT_STRUCT;
    
 //==============================================================================
 //  GLOBAL DATA DECLARATIONS
@@ -80,41 +126,66 @@ static ERRORCODE_ENUM currentErrorCode = ERRORCODE_ENUM_NO_ERROR;
 static bool isErrorLogDueForWDTReset = false;                                   //!< Error code for watchdog reset
 static ERROR_INFORMATION_STRUCT errorInformation[TOTAL_NUMBER_OF_ERRORS] = 
 {
-  { 0 , ERRORCODE_ENUM_WHISPER_DEVICE_ERROR, 0, 0},
-  { 1 , ERRORCODE_ENUM_ETHERNET_COMMUNICATION_ERROR, 0, 0},
-  { 2 , ERRORCODE_ENUM_WIFI_COMMUNICATION_ERROR, 0, 0},
-  { 3 , ERRORCODE_ENUM_CELLULAR_COMMUNICATION_ERROR, 0, 0},
-  { 4 , ERRORCODE_ENUM_DATAFLASH_READ_WRITE_ERROR, 0, 0},
-  { 5 , ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR, 0, 0},
-  { 6 , ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR, 0, 0},
-  { 7 , ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR, 0, 0},
-  { 8 , ERRORCODE_ENUM_UNDEFINED_MODBUS_REGISTER, 0, 0}, //Using this error, All except above 8 are the legacy error
+  { .errorNumber = 0, .errorCode = ERRORCODE_ENUM_WHISPER_DEVICE_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 1, .errorCode = ERRORCODE_ENUM_ETHERNET_COMMUNICATION_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 2, .errorCode = ERRORCODE_ENUM_WIFI_COMMUNICATION_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 3, .errorCode = ERRORCODE_ENUM_CELLULAR_COMMUNICATION_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 4, .errorCode = ERRORCODE_ENUM_DATAFLASH_READ_WRITE_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 5, .errorCode = ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 6, .errorCode = ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 7, .errorCode = ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false },
+  { .errorNumber = 8, .errorCode = ERRORCODE_ENUM_UNDEFINED_MODBUS_REGISTER, .entryIndex = 0, .errorIdentifier = 0, .isNextEntryTorn = false }, //Using this error, All except above 8 are the legacy error
 };
 // This variable contains the location in memory where the error is logged 
 unsigned char errorLogIndex = 0U;
+static unsigned char errorLogPageArray[ERRLOG_PAGE_LENGTH];                     //!< Entries of an error log page read at once
+static unsigned char errorRecordArray[ERRLOG_RECORD_LENGTH];                    //!< Entry assembled before it is programmed
+static volatile DEFERRED_ERROR_STRUCT deferredErrorArray[ERRLOG_DEFERRED_QUEUE_LENGTH]; //!< Errors queued by the interrupts
+static volatile unsigned char deferredErrorHead = 0U;                           //!< Count of the errors queued, changed by the interrupts only
+static volatile unsigned char deferredErrorTail = 0U;                           //!< Count of the errors written, changed by the error log task only
+static volatile unsigned int deferredErrorLostCount = 0U;                       //!< Errors lost with the queue full
+static GateMutex_Handle errorLogGateHandle = NULL;                              //!< Serializes the tasks writing, reading and clearing the error log
+static ERROR_WRITE_SLOT_STRUCT errorWriteSlots[ERRLOG_WRITE_SLOTS];             //!< Entries queued to the dataflash task
+static unsigned char errorWriteSlot = 0U;                                       //!< Next slot of an entry
+static unsigned char errorCommitMarker = ERRLOG_COMMIT_MARKER;                  //!< Commit marker programmed by the marker requests
+static volatile unsigned int pendingErrorWrites = 0U;                           //!< Entries queued and not programmed yet
+static DATAFLASH_REQUEST_STRUCT errorClearRequest;                              //!< Flush of the cleared identifiers
+static ERROR_RATE_STRUCT errorRateArray[ERRLOG_RATE_CODES];                     //!< Rate of the codes written lately
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
 
-static void FindEntryOfIdentifier(unsigned short seekIdentifier, unsigned char *entryIndexNumber, ERRORCODE_ENUM errorCode);
+static void ScanErrorLog(ERRORCODE_ENUM errorCode, unsigned short *highestIdentifier, unsigned char *entryIndexNumber);
+static bool IsNextEntryTorn(unsigned char entryIndex, ERRORCODE_ENUM errorCode);
+static void WriteErrorEntry(unsigned char errorIndex, ERRORCODE_ENUM errorCode, const DATE_TIME_STRUCT *dateTime, unsigned char repeatCount);
+static void AddErrorTokens(ERROR_RATE_STRUCT *errorRate);
+static bool TakeErrorToken(ERROR_RATE_STRUCT *errorRate);
+static void WriteRepeatedError(ERROR_RATE_STRUCT *errorRate);
+static ERROR_RATE_STRUCT *GetErrorRate(ERRORCODE_ENUM errorCode, unsigned char errorIndex);
+static void WriteError(ERRORCODE_ENUM errorCode, const DATE_TIME_STRUCT *dateTime);
+static void SubtractSecondsOfDay(DATE_TIME_STRUCT *dateTime, unsigned int seconds);
 static void IsDataFlashError(ERRORCODE_ENUM errorCode, bool *isFlashError);
+static unsigned short ErrorIndexToLogicalPage(unsigned char entryIndex, ERRORCODE_ENUM errorCode );
 static unsigned short ErrorIndexToPage(unsigned char entryIndex, ERRORCODE_ENUM errorCode );
 static unsigned short ErrorNumberToAddress(unsigned char entryIndex);
+static IArg EnterErrorLog(void);
+static void CompleteErrorWrite(DATAFLASH_REQUEST_STRUCT *request);
+static void WaitErrorWrites(void);
 
 //==============================================================================
 //  LOCAL FUNCTIONS IMPLEMENTATION
 //==============================================================================
 //------------------------------------------------------------------------------
-//   ErrorIndexToPage(unsigned char entryIndex, ERRORCODE_ENUM errorCode )
+//   ErrorIndexToLogicalPage(unsigned char entryIndex, ERRORCODE_ENUM errorCode )
 //
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/09
 //
-//!  This function finds the page number correponding to the entry index
+//!  This function finds the logical page number correponding to the entry index
 //
 //------------------------------------------------------------------------------
 
-unsigned short ErrorIndexToPage(
+unsigned short ErrorIndexToLogicalPage(
                                   unsigned char entryIndex,                     //!< Error Entry Index
                                   ERRORCODE_ENUM errorCode                      //!< Error Code Correponsing to entry index
                                )
@@ -160,6 +231,25 @@ unsigned short ErrorIndexToPage(
    return pageNumber;
 }
 //------------------------------------------------------------------------------
+//   ErrorIndexToPage(unsigned char entryIndex, ERRORCODE_ENUM errorCode )
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function finds the dataflash subsector holding the page correponding
+//!  to the entry index, the pages are moved around by the wear level allocator
+//
+//------------------------------------------------------------------------------
+
+unsigned short ErrorIndexToPage(
+                                  unsigned char entryIndex,                     //!< Error Entry Index
+                                  ERRORCODE_ENUM errorCode                      //!< Error Code Correponsing to entry index
+                               )
+{
+   //Return the subsector holding the logical page
+   return WearLevelGetSubsector(ErrorIndexToLogicalPage(entryIndex, errorCode));
+}
+//------------------------------------------------------------------------------
 //   ErrorNumberToAddress(unsigned char entryIndex)
 //
 //   Author:   Ali Zulqarnain Anjum
@@ -181,264 +271,422 @@ unsigned short ErrorNumberToAddress(
    
 }
 //------------------------------------------------------------------------------
-//   FindEntryOfIdentifier(unsigned short seekIdentifier, unsigned char *entryIndexNumber,ERRORCODE_ENUM errorCode)
+//   ScanErrorLog(ERRORCODE_ENUM errorCode, unsigned short *highestIdentifier, unsigned char *entryIndexNumber)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/01
+//   Date:     2026/10/17
 //
-//!  This function finds the entry number in memory location for the error
+//!  This function finds the highest error identifier of an error and the entry
+//!  holding it. Each page of the error is read with one dataflash transfer.
+//!  The entry number is INVALID_ENTRY_NUMBER if no entry is above the given
+//!  identifier
 //
 //------------------------------------------------------------------------------
 
-static void FindEntryOfIdentifier(
-                                   unsigned short seekIdentifier,         //!< This variable contains the identifier to be searched in error log
-                                   unsigned char *entryIndexNumber,        //!< This variable contains the location of error in memory
-                                   ERRORCODE_ENUM errorCode                      //!< Error Code Correponsing to entry index
-                                 )
+static void ScanErrorLog(
+                           ERRORCODE_ENUM errorCode,                    //!< Error Code Correponsing to entry index
+                           unsigned short *highestIdentifier,           //!< Highest identifier found, searched above its value
+                           unsigned char *entryIndexNumber              //!< Entry holding the highest identifier
+                        )
 {
-    // Identifier is the error number 
-    unsigned short errorLogNumber = 0U; 
-    unsigned int dataFlashPage;
-    unsigned short errorPagePosition;
-    // This variable contains the status is error number found or not
-    bool isIdentifierFound = false ;
-    // For calculating the address
-    unsigned short address = 0u;
-    *entryIndexNumber = 0U;
-    isIdentifierFound = false ;
-   //Get the correct page Number
-   switch(errorCode)
-   {
-     case ERRORCODE_ENUM_WHISPER_DEVICE_ERROR:
-        dataFlashPage = WHISPER_DEVICE_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_ETHERNET_COMMUNICATION_ERROR:
-        dataFlashPage = ETHERNET_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_WIFI_COMMUNICATION_ERROR:
-        dataFlashPage = WIFI_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_CELLULAR_COMMUNICATION_ERROR:
-        dataFlashPage = CELLULAR_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_DATAFLASH_READ_WRITE_ERROR:
-        dataFlashPage = DATAFLASH_READ_WRITE_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR:
-        dataFlashPage = NETWORK_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR:
-        dataFlashPage = NFC_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-     case ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR:
-        dataFlashPage = BTLE_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-     default:
-        dataFlashPage = LEGACY_ERRORS_SUBSECTOR;
-        break;
-   }
-    while ( (isIdentifierFound != true) && ((*entryIndexNumber) < TOTAL_ERROR_ENTRIES) )
-    {  
-        errorPagePosition = (unsigned short)(*entryIndexNumber) % ERRLOG_ENTRIES_PER_PAGE ;
-        // If it is the start of a new page, erase the page
-        if ( errorPagePosition == 0U )
+    // It represents the location in memory where error is logged
+    unsigned char errorLogEntryNumber = 0U;
+    // Identifier is the error number
+    unsigned short errorLogNumber = 0U;
+    // Address of the identifier in the page array
+    unsigned short byteAddress = 0U;
+    *entryIndexNumber = INVALID_ENTRY_NUMBER;
+    // Scan the error log, look for the highest error identifier
+    for ( errorLogEntryNumber = 0U; errorLogEntryNumber < TOTAL_ERROR_ENTRIES; errorLogEntryNumber++ )
+    {
+        // Read all the entries of the page at its first entry
+        if ( (errorLogEntryNumber % ERRLOG_ENTRIES_PER_PAGE) == 0U )
+        {
+            DataFlashReadBytes( ErrorIndexToPage(errorLogEntryNumber, errorCode), 0U, errorLogPageArray, (unsigned short)ERRLOG_PAGE_LENGTH );
+        }
+        else
         {
-            dataFlashPage = ErrorIndexToPage(*entryIndexNumber,errorCode);
+            //Do nothing
         }
-        // Get the address
-        address = ErrorNumberToAddress(*entryIndexNumber);
-        // Read the error identifier from entry number   
-        DataFlashReadGeneralWord( (unsigned short)dataFlashPage, 
-            (address + ERRLOG_IDENTIFIER_OFFSET), &errorLogNumber );
-        if ( (errorLogNumber <= MAX_VALID_ERROR_IDENTIFIER) && (errorLogNumber == seekIdentifier) )
+        // Words are saved high byte first
+        byteAddress = (unsigned short)((ErrorNumberToAddress(errorLogEntryNumber) + ERRLOG_IDENTIFIER_OFFSET) << 1);
+        errorLogNumber = ((unsigned short)errorLogPageArray[byteAddress] << 8) + errorLogPageArray[byteAddress + 1U];
+        // An entry cut by a power loss does not have the commit marker
+        if ( (errorLogNumber > (*highestIdentifier)) &&
+            (errorLogNumber <= MAX_VALID_ERROR_IDENTIFIER) &&
+            (errorLogPageArray[byteAddress + ERRLOG_COMMIT_MARKER_OFFSET] == ERRLOG_COMMIT_MARKER) )
         {
-            isIdentifierFound = true ;
+            *highestIdentifier = errorLogNumber;
+            *entryIndexNumber = errorLogEntryNumber;
         }
         else
         {
-            (*entryIndexNumber)++ ;
+            //Do nothing
         }
     }
-    
-    if ( isIdentifierFound != true )
-    {
-        *entryIndexNumber = INVALID_ENTRY_NUMBER ;
-    }
 }
 
 //------------------------------------------------------------------------------
-//   IsDataFlashError(ERRORCODE_ENUM errorCode, BOOLEAN *isFlashError)
+//   IsNextEntryTorn(unsigned char entryIndex, ERRORCODE_ENUM errorCode)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/01
+//   Date:     2026/10/17
 //
-//!  This function checks the dataflash error
+//!  This function checks if the entry following the latest one has been cut
+//!  by a power loss. Such an entry is not erased and cannot be programmed
+//!  again, the entry at the start of a page is erased before it is written
 //
 //------------------------------------------------------------------------------
 
-static void IsDataFlashError(
-                             ERRORCODE_ENUM errorCode,      //!< This variable constant error codes of a structure errorCodeENUM 
-                             bool *isFlashError          //!< This variable constant dataflash error status True or False
-                             )
+static bool IsNextEntryTorn(
+                              unsigned char entryIndex,                   //!< Entry holding the latest error
+                              ERRORCODE_ENUM errorCode                    //!< Error Code Correponsing to entry index
+                           )
 {
-    // Error code is of dataflash error
-    if ( ((unsigned int)errorCode > FIRST_DATAFLASH_ERROR) && (((unsigned int) errorCode) <= LAST_DATAFLASH_ERROR) )
+    // This variable contains the status of the entry
+    bool isTorn = false;
+    // For indexing the loop
+    unsigned char byteIndex = 0U;
+    if ( entryIndex != INVALID_ENTRY_NUMBER )
     {
-        *isFlashError = true;
+        entryIndex = entryIndex + 1U;
+        if ( entryIndex >= TOTAL_ERROR_ENTRIES )
+        {
+            entryIndex = 0U;
+        }
+        else
+        {
+            //Do nothing
+        }
+        if ( (entryIndex % ERRLOG_ENTRIES_PER_PAGE) != 0U )
+        {
+            DataFlashReadBytes( ErrorIndexToPage(entryIndex, errorCode), (unsigned short)(ErrorNumberToAddress(entryIndex) << 1),
+                errorRecordArray, (unsigned short)ERRLOG_RECORD_LENGTH );
+            while ( byteIndex < ERRLOG_RECORD_LENGTH )
+            {
+                if ( errorRecordArray[byteIndex] != ERRLOG_ERASED_BYTE )
+                {
+                    isTorn = true;
+                }
+                else
+                {
+                    //Do nothing
+                }
+                byteIndex++;
+            }
+        }
+        else
+        {
+            //Do nothing
+        }
     }
     else
     {
-        *isFlashError = false;
+        //Do nothing
     }
+    return isTorn;
 }
 
+//------------------------------------------------------------------------------
+//   WriteErrorEntry(unsigned char errorIndex, ERRORCODE_ENUM errorCode, const DATE_TIME_STRUCT *dateTime, unsigned char repeatCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes an error to the entry following the latest one of
+//!  its error log. The repeat count is zero for an error, it is the number of
+//!  errors for a record of ERRORCODE_ENUM_REPEATED_ERROR
+//
+//------------------------------------------------------------------------------
 
-//==============================================================================
-//  GLOBAL FUNCTIONS IMPLEMENTATION
-//==============================================================================
+static void WriteErrorEntry(
+                              unsigned char errorIndex,                   //!< Index of the error in errorInformation
+                              ERRORCODE_ENUM errorCode,                   //!< Error code of the entry
+                              const DATE_TIME_STRUCT *dateTime,           //!< Time of the error
+                              unsigned char repeatCount                   //!< Errors of a repeated error record, 0 for an error
+                           )
+{
+    // Identifier for the next error
+    unsigned short nextErrorIdentifier = 1U;
+    //This variable is used to check if the sector change is required or not
+    unsigned short errorPagePosition = 0u;
+    //For the current Position
+    unsigned short currentPosition = 0u;
+    //For the slot of the entry
+    ERROR_WRITE_SLOT_STRUCT *writeSlot = NULL;
+    // For the interrupt state
+    unsigned int key;
+    if ( (errorInformation[errorIndex].errorIdentifier == 0U) || (errorInformation[errorIndex].errorIdentifier > MAX_VALID_ERROR_IDENTIFIER) )
+    { 
+      // Make error entry number zero      
+      errorInformation[errorIndex].entryIndex = 0U ;
+      errorInformation[errorIndex].errorIdentifier = 1U;
+      errorInformation[errorIndex].isNextEntryTorn = false;
+      nextErrorIdentifier = 1U ;
+      // Start with a freshly erased page, the first entry may have been cut
+      // by a power loss. The queued entries are programmed before the erase
+      WaitErrorWrites();
+      errorLogDataFlashPage = WearLevelEraseSubsector( ErrorIndexToLogicalPage(errorInformation[errorIndex].entryIndex, errorInformation[errorIndex].errorCode) ) ;
+    }
+    else
+    {
+      nextErrorIdentifier = errorInformation[errorIndex].errorIdentifier + 1;
+      //Increment in error identifier
+      errorInformation[errorIndex].errorIdentifier = errorInformation[errorIndex].errorIdentifier + 1;
+      if ( nextErrorIdentifier > MAX_VALID_ERROR_IDENTIFIER )
+      {
+        nextErrorIdentifier = 1U ;
+      }
+      // Overwrite the entry following the latest, or the one after it if
+      // it has been cut by a power loss
+      errorInformation[errorIndex].entryIndex = errorInformation[errorIndex].entryIndex + 1 ;
+      if ( errorInformation[errorIndex].isNextEntryTorn == true )
+      {
+        errorInformation[errorIndex].entryIndex = errorInformation[errorIndex].entryIndex + 1 ;
+        errorInformation[errorIndex].isNextEntryTorn = false;
+      }
+      if ( errorInformation[errorIndex].entryIndex >= TOTAL_ERROR_ENTRIES )
+      {
+        errorInformation[errorIndex].entryIndex = errorInformation[errorIndex].entryIndex - TOTAL_ERROR_ENTRIES;
+      }             
+      errorPagePosition = (unsigned short)errorInformation[errorIndex].entryIndex % ERRLOG_ENTRIES_PER_PAGE ;
+      // Get the dataflash page number
+      errorLogDataFlashPage = ErrorIndexToPage(errorInformation[errorIndex].entryIndex, errorInformation[errorIndex].errorCode);;
+      // If it is the start of a new page, move the page to a freshly erased subsector
+      if ( errorPagePosition == 0U )
+      {
+         WaitErrorWrites();
+         errorLogDataFlashPage = WearLevelEraseSubsector( ErrorIndexToLogicalPage(errorInformation[errorIndex].entryIndex, errorInformation[errorIndex].errorCode) ) ;
+      }
+    }
+    //Get the current Position
+    currentPosition = ErrorNumberToAddress(errorInformation[errorIndex].entryIndex);
+    // Take the next slot once its entry is programmed
+    writeSlot = &errorWriteSlots[errorWriteSlot];
+    errorWriteSlot = (unsigned char)((errorWriteSlot + 1U) % ERRLOG_WRITE_SLOTS);
+    DataFlashQueueWait(&writeSlot->markerRequest);
+    // Assemble the entry, the words are saved high byte first
+    writeSlot->record[(ERRLOG_IDENTIFIER_OFFSET * 2U)] = HIBYTE_WORD16(nextErrorIdentifier);
+    writeSlot->record[(ERRLOG_IDENTIFIER_OFFSET * 2U) + 1U] = LOBYTE_WORD16(nextErrorIdentifier);
+    // The error code of the error occurred
+    writeSlot->record[(ERRLOG_CODE_OFFSET * 2U)] = HIBYTE_WORD16(errorCode);
+    writeSlot->record[(ERRLOG_CODE_OFFSET * 2U) + 1U] = LOBYTE_WORD16(errorCode);
+    // The month and date of the error occurred
+    writeSlot->record[(ERRLOG_TIME1_OFFSET * 2U)] = dateTime->monthId;
+    writeSlot->record[(ERRLOG_TIME1_OFFSET * 2U) + 1U] = dateTime->dayId;
+    // The year of the error occurred, the commit marker is left erased
+    writeSlot->record[ERRLOG_COMMIT_MARKER_OFFSET] = ERRLOG_ERASED_BYTE;
+    writeSlot->record[(ERRLOG_TIME2_OFFSET * 2U) + 1U] = (unsigned char) dateTime->yearId;
+    // The hour and minutes of the error occurred
+    writeSlot->record[(ERRLOG_TIME3_OFFSET * 2U)] = dateTime->hourId;
+    writeSlot->record[(ERRLOG_TIME3_OFFSET * 2U) + 1U] = dateTime->minId;
+    // The seconds of the error occurred, the high byte holds the number of
+    // errors of a repeated error record only
+    writeSlot->record[(ERRLOG_TIME4_OFFSET * 2U)] = repeatCount;
+    writeSlot->record[(ERRLOG_TIME4_OFFSET * 2U) + 1U] = dateTime->secondId;
+    // Queue the program of the entry and the program of the commit marker
+    // once the entry is complete, the high byte of the year is then zero as
+    // in the entries written before the marker. The dataflash task programs
+    // them in order, the error log task goes on
+    writeSlot->recordRequest.subsectorNumber = errorLogDataFlashPage;
+    writeSlot->recordRequest.byteAddress = (unsigned short)(currentPosition << 1);
+    writeSlot->markerRequest.subsectorNumber = errorLogDataFlashPage;
+    writeSlot->markerRequest.byteAddress = (unsigned short)((currentPosition << 1) + ERRLOG_COMMIT_MARKER_OFFSET);
+    key = Hwi_disable();
+    pendingErrorWrites++;
+    Hwi_restore(key);
+    DataFlashQueueSubmit(&writeSlot->recordRequest);
+    DataFlashQueueSubmit(&writeSlot->markerRequest);
+}
 //------------------------------------------------------------------------------
-//   ErrorLogFindLatestIdentifier(unsigned int *highestIdentifier,ERRORCODE_ENUM errorCode)
+//   AddErrorTokens(ERROR_RATE_STRUCT *errorRate)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/01
+//   Date:     2026/10/17
 //
-//!  This function finds the latest error identifier in the error log
+//!  This function adds the tokens of a code due since the last one, the
+//!  bucket gets a token every ERRLOG_TOKEN_PERIOD_MS up to ERRLOG_BUCKET_TOKENS
 //
 //------------------------------------------------------------------------------
 
-void ErrorLogFindLatestIdentifier(
-                                   unsigned short *highestIdentifier,         //!< This argument identifies the recent error 
-                                   ERRORCODE_ENUM errorCode                      //!< Error Code Correponsing to entry index
-                                  )
+static void AddErrorTokens(
+                             ERROR_RATE_STRUCT *errorRate                 //!< Rate of the code
+                          )
 {
-    // It represents the location in memory where error is logged
-    unsigned char errorLogEntryNumber= 0U;  
-    // Identifier is the error number
-    unsigned short errorLogNumber = 0U; 
-    // Address in memory to start reading from
-    unsigned short wordAddress = 0U;  
-    // Temporary variable contains the address in the page to start reading from
-    unsigned short  tempWordAddress;
-    // This variable is used to update the new secotor ID.
-    unsigned short dataFlashPage;
-    //This variable is used to check if the page boundry has reached or not       
-    unsigned short errorPagePosition;
-        //Get the correct page Number
-        switch(errorCode)
+    // For the clock ticks of a token
+    unsigned int tokenPeriodTicks = (ERRLOG_TOKEN_PERIOD_MS * 1000U) / Clock_tickPeriod;
+    // For the tokens added since the last one
+    unsigned int newTokens = 0U;
+    newTokens = (Clock_getTicks() - errorRate->tokenTicks) / tokenPeriodTicks;
+    if ( newTokens != 0U )
+    {
+        errorRate->tokenTicks = errorRate->tokenTicks + (newTokens * tokenPeriodTicks);
+        if ( newTokens >= (ERRLOG_BUCKET_TOKENS - errorRate->tokens) )
         {
-        case ERRORCODE_ENUM_WHISPER_DEVICE_ERROR:
-        dataFlashPage = WHISPER_DEVICE_ERROR_SUBSECTOR;
-        break;
-        case ERRORCODE_ENUM_ETHERNET_COMMUNICATION_ERROR:
-        dataFlashPage = ETHERNET_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-        case ERRORCODE_ENUM_WIFI_COMMUNICATION_ERROR:
-        dataFlashPage = WIFI_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-        case ERRORCODE_ENUM_CELLULAR_COMMUNICATION_ERROR:
-        dataFlashPage = CELLULAR_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-        case ERRORCODE_ENUM_DATAFLASH_READ_WRITE_ERROR:
-        dataFlashPage = DATAFLASH_READ_WRITE_ERROR_SUBSECTOR;
-        break;
-        case ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR:
-        dataFlashPage = NETWORK_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-        case ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR:
-        dataFlashPage = NFC_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-       case ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR:
-        dataFlashPage = BTLE_COMMUNICATION_ERROR_SUBSECTOR;
-        break;
-        default:
-        dataFlashPage = LEGACY_ERRORS_SUBSECTOR;
-        break;
+            errorRate->tokens = ERRLOG_BUCKET_TOKENS;
         }
-        // Scan the error log, look for the highest error identifier
-        for ( errorLogEntryNumber = 0U; errorLogEntryNumber < TOTAL_ERROR_ENTRIES; errorLogEntryNumber++ )
+        else
         {
-            errorPagePosition = (unsigned short)errorLogEntryNumber % ERRLOG_ENTRIES_PER_PAGE ;
-            // If it is the start of a new page, erase the page
-            if ( errorPagePosition == 0U )
-            {
-                dataFlashPage = ErrorIndexToPage(errorLogEntryNumber,errorCode);
-            }
-            // Address of entry number 
-            wordAddress = ErrorNumberToAddress(errorLogEntryNumber) + ERRLOG_IDENTIFIER_OFFSET;
-            tempWordAddress = wordAddress;
-            // Read the entry number to get the error identifier
-            DataFlashReadGeneralWord( dataFlashPage, tempWordAddress, &errorLogNumber );
-            if ( (errorLogNumber > (*highestIdentifier)) &&
-                (errorLogNumber <= MAX_VALID_ERROR_IDENTIFIER) )
-            {
-                *highestIdentifier = errorLogNumber ;
-            }
-        }        
+            errorRate->tokens = errorRate->tokens + (unsigned char)newTokens;
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
 }
 //------------------------------------------------------------------------------
-//   void ErrorLogInit(void)
+//   TakeErrorToken(ERROR_RATE_STRUCT *errorRate)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/01
+//   Date:     2026/10/17
 //
-//!  This function initializes the Errorlog parameters.
+//!  This function takes a token of the bucket of a code. It returns false if
+//!  the bucket is empty and the error is to be counted as repeated
 //
 //------------------------------------------------------------------------------
 
-void ErrorLogInit(void)
+static bool TakeErrorToken(
+                             ERROR_RATE_STRUCT *errorRate                 //!< Rate of the code
+                          )
+{
+    // This variable contains the status of the token
+    bool isTokenTaken = false;
+    AddErrorTokens( errorRate );
+    if ( errorRate->tokens != 0U )
+    {
+        errorRate->tokens--;
+        isTokenTaken = true;
+    }
+    else
+    {
+        //Do nothing
+    }
+    return isTokenTaken;
+}
+//------------------------------------------------------------------------------
+//   WriteRepeatedError(ERROR_RATE_STRUCT *errorRate)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the errors of a code not written. The first one is
+//!  written as it occurred, a record of the repeated errors follows it if
+//!  there were more
+//
+//------------------------------------------------------------------------------
+
+static void WriteRepeatedError(
+                                 ERROR_RATE_STRUCT *errorRate             //!< Rate of the code
+                              )
+{
+    WriteErrorEntry( errorRate->errorIndex, errorRate->errorCode, &errorRate->repeatDateTime, 0U );
+    if ( errorRate->repeatCount > 1U )
+    {
+        WriteErrorEntry( errorRate->errorIndex, ERRORCODE_ENUM_REPEATED_ERROR, &errorRate->repeatLastDateTime, errorRate->repeatCount );
+    }
+    else
+    {
+        //Do nothing
+    }
+    errorRate->repeatCount = 0U;
+}
+//------------------------------------------------------------------------------
+//   GetErrorRate(ERRORCODE_ENUM errorCode, unsigned char errorIndex)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the rate of a code. A code without one gets a free
+//!  entry with a full bucket, or the entry of the code written least recently;
+//!  the errors of that code not written yet are written first
+//
+//------------------------------------------------------------------------------
+
+static ERROR_RATE_STRUCT *GetErrorRate(
+                                         ERRORCODE_ENUM errorCode,        //!< Code of the error
+                                         unsigned char errorIndex         //!< Index of the error log of the code in errorInformation
+                                      )
 {
     //For indexing the loop
-    unsigned loopIndex = 0u;
-    if(isErrorLogInit == false)
+    unsigned char loopIndex = 0u;
+    //For the entry of the code, or the entry given to it
+    ERROR_RATE_STRUCT *errorRate = NULL;
+    //For the entry written least recently
+    ERROR_RATE_STRUCT *oldestRate = &errorRateArray[0];
+    // For the clock ticks of the error
+    unsigned int currentTicks = Clock_getTicks();
+    while ( (loopIndex < ERRLOG_RATE_CODES) && (errorRate == NULL) )
     {
-        while ( loopIndex < TOTAL_NUMBER_OF_ERRORS )
+        if ( errorRateArray[loopIndex].errorCode == errorCode )
         {
-            // Get the latest error identifier in the error log
-            ErrorLogFindLatestIdentifier( &errorInformation[loopIndex].errorIdentifier, errorInformation[loopIndex].errorCode ) ;
-            // Get the entry number for the error
-            FindEntryOfIdentifier( errorInformation[loopIndex].errorIdentifier, &errorInformation[loopIndex].entryIndex, errorInformation[loopIndex].errorCode ) ;
-            //Increment the loop
+            errorRate = &errorRateArray[loopIndex];
+        }
+        else
+        {
+            if ( (errorRateArray[loopIndex].errorCode == ERRORCODE_ENUM_NO_ERROR) ||
+                 ((oldestRate->errorCode != ERRORCODE_ENUM_NO_ERROR) &&
+                  ((currentTicks - errorRateArray[loopIndex].usedTicks) > (currentTicks - oldestRate->usedTicks))) )
+            {
+                oldestRate = &errorRateArray[loopIndex];
+            }
+            else
+            {
+                //Do nothing
+            }
             loopIndex++;
         }
-        // Set flag to indicate ErrorLog has been initialized
-        isErrorLogInit = true;
     }
+    if ( errorRate == NULL )
+    {
+        // Give the entry to the code, the errors of its last code are not lost
+        errorRate = oldestRate;
+        if ( errorRate->repeatCount != 0U )
+        {
+            WriteRepeatedError( errorRate );
+        }
+        else
+        {
+            //Do nothing
+        }
+        errorRate->errorCode = errorCode;
+        errorRate->errorIndex = errorIndex;
+        errorRate->tokens = ERRLOG_BUCKET_TOKENS;
+        errorRate->tokenTicks = currentTicks;
+    }
+    else
+    {
+        //Do nothing
+    }
+    errorRate->usedTicks = currentTicks;
+    return errorRate;
 }
-
 //------------------------------------------------------------------------------
-//   ErrorLogWrite(ERRORCODE_ENUM errorCode, ERRORTYPE_ENUM errorType)
+//   WriteError(ERRORCODE_ENUM errorCode, const DATE_TIME_STRUCT *dateTime)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/01
+//   Date:     2026/10/17
 //
-//!  This function writes a new error to error log entry
+//!  This function writes an error with the given time to its error log, or
+//!  counts it as repeated if its rate does not allow it
 //
 //------------------------------------------------------------------------------
 
-void ErrorLogWrite(
-                   ERRORCODE_ENUM errorCode,          //!< Predefined constant error codes of a structure errorCodeENUM 
-                   ERRORTYPE_ENUM errorType           //!< Error type associated with error code
-                   )
+static void WriteError(
+                        ERRORCODE_ENUM errorCode,                   //!< Predefined constant error codes of a structure errorCodeENUM
+                        const DATE_TIME_STRUCT *dateTime            //!< Time of the error
+                      )
 {
-    // Identifier for the next error
-  unsigned short nextErrorIdentifier = 1U;           
   // This variable contains the data flash error status True or False
   bool isDataflashError = false;          
-  //This variable is used to check if the sector change is required or not
-  unsigned short errorPagePosition = 0u;   
   //TODO: Add after the battery module implementation
   bool isCriticalBatteryIndicationOn = false;
   //For indexing the loop
   unsigned char loopIndex = 0u;
   //For checking if the correct index is found
   bool isIndexFound = false;
-  //Date/time structure
-  DATE_TIME_STRUCT currentDateTime;
-  //For the current Position
-  unsigned short currentPosition = 0u;
-  //For saving the error Type
-  ERRORCODE_ENUM currentErrorType = ERRORCODE_ENUM_NO_ERROR;
-  currentErrorType = errorCode;
+  //For the rate of the code
+  ERROR_RATE_STRUCT *errorRate = NULL;
   //Find the correct Index
   //Check if the correct error code is found, otherwise it will be dealt as 
   //Legacy error
@@ -472,59 +720,431 @@ void ErrorLogWrite(
     if ( isDataflashError == false )
       // Don't try to write an error to the dataflash with this error, because the dataflash isn't working correctly anyway
     {
-      if ( (errorInformation[loopIndex].errorIdentifier == 0U) || (errorInformation[loopIndex].errorIdentifier > MAX_VALID_ERROR_IDENTIFIER) )
-      { 
-        // Make error entry number zero      
-        errorInformation[loopIndex].entryIndex = 0U ;
-        errorInformation[loopIndex].errorIdentifier = 1U;
-        nextErrorIdentifier = 1U ;
-        // Get the dataflash page number
-        errorLogDataFlashPage = ErrorIndexToPage(errorInformation[loopIndex].entryIndex, errorInformation[loopIndex].errorCode);
+      // Write the repeated errors of all the errors whose rate allows it, they
+      // are older than this error
+      ErrorLogFlushRepeated();
+      errorRate = GetErrorRate( errorCode, loopIndex );
+      if ( TakeErrorToken(errorRate) == true )
+      {
+        WriteErrorEntry( loopIndex, errorCode, dateTime, 0U );
       }
       else
       {
-        nextErrorIdentifier = errorInformation[loopIndex].errorIdentifier + 1;
-        //Increment in error identifier
-        errorInformation[loopIndex].errorIdentifier = errorInformation[loopIndex].errorIdentifier + 1;
-        if ( nextErrorIdentifier > MAX_VALID_ERROR_IDENTIFIER )
+        // Count the error as repeated, keep the time of the first one and the
+        // time of the last one
+        if ( errorRate->repeatCount == 0U )
         {
-          nextErrorIdentifier = 1U ;
+          errorRate->repeatDateTime = *dateTime;
         }
-        // Overwrite the entry following the latest
-        errorInformation[loopIndex].entryIndex = errorInformation[loopIndex].entryIndex + 1 ;
-        if ( errorInformation[loopIndex].entryIndex >= TOTAL_ERROR_ENTRIES )
+        else
         {
-          errorInformation[loopIndex].entryIndex = 0U;
-        }             
-        errorPagePosition = (unsigned short)errorInformation[loopIndex].entryIndex % ERRLOG_ENTRIES_PER_PAGE ;
-        // Get the dataflash page number
-        errorLogDataFlashPage = ErrorIndexToPage(errorInformation[loopIndex].entryIndex, errorInformation[loopIndex].errorCode);;
-        // If it is the start of a new page, erase the page
-        if ( errorPagePosition == 0U )
+          //Do nothing
+        }
+        errorRate->repeatLastDateTime = *dateTime;
+        if ( errorRate->repeatCount < ERRLOG_MAX_REPEAT_COUNT )
         {
-           DataFlashErasePage( errorLogDataFlashPage ) ;
+          errorRate->repeatCount++;
+        }
+        else
+        {
+          //Do nothing
         }
       }
-      // Update real time
-      RTCGetCurrentDateTime(&currentDateTime); 
-      //Get the current Position
-      currentPosition = ErrorNumberToAddress(errorInformation[loopIndex].entryIndex);
-      // Write the error identifier to the empty entry number
-      DataFlashWriteGeneralWord( errorLogDataFlashPage, (currentPosition + ERRLOG_IDENTIFIER_OFFSET), nextErrorIdentifier );
-      // Write the error code of the error occurred to entry number
-      DataFlashWriteGeneralWord( errorLogDataFlashPage, (currentPosition + ERRLOG_CODE_OFFSET), currentErrorType );
-      // Write the month and date of the error occurred to entry number
-      DataFlashWriteGeneralWord( errorLogDataFlashPage, (currentPosition + ERRLOG_TIME1_OFFSET), ((unsigned short)currentDateTime.monthId << 8) + currentDateTime.dayId );
-      // Write the year of the error occurred to entry number
-      DataFlashWriteGeneralWord( errorLogDataFlashPage, (currentPosition + ERRLOG_TIME2_OFFSET), (unsigned short)currentDateTime.yearId );
-      // Write the hour and minutes of the error occurred to entry number
-      DataFlashWriteGeneralWord( errorLogDataFlashPage, (currentPosition + ERRLOG_TIME3_OFFSET), ((unsigned short)currentDateTime.hourId << 8) + currentDateTime.minId );
-      // Write the seconds of the error occurred to entry number
-      DataFlashWriteGeneralWord( errorLogDataFlashPage, (currentPosition + ERRLOG_TIME4_OFFSET), (unsigned short)currentDateTime.secondId );
     } 
   }
 }
 
+//------------------------------------------------------------------------------
+//   SubtractSecondsOfDay(DATE_TIME_STRUCT *dateTime, unsigned int seconds)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function moves a time back by some seconds. The date is kept, a time
+//!  before the start of the day gives the start of the day
+//
+//------------------------------------------------------------------------------
+
+static void SubtractSecondsOfDay(
+                                  DATE_TIME_STRUCT *dateTime,       //!< Time to be moved back
+                                  unsigned int seconds              //!< Seconds to be subtracted
+                                )
+{
+    // For the seconds since the start of the day
+    unsigned int secondsOfDay = 0U;
+    secondsOfDay = ((unsigned int)dateTime->hourId * SECONDS_PER_HOUR) + ((unsigned int)dateTime->minId * SECONDS_PER_MINUTE) + dateTime->secondId;
+    if ( seconds < secondsOfDay )
+    {
+        secondsOfDay = secondsOfDay - seconds;
+    }
+    else
+    {
+        secondsOfDay = 0U;
+    }
+    dateTime->hourId = (unsigned char)(secondsOfDay / SECONDS_PER_HOUR);
+    dateTime->minId = (unsigned char)((secondsOfDay % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
+    dateTime->secondId = (unsigned char)(secondsOfDay % SECONDS_PER_MINUTE);
+}
+//------------------------------------------------------------------------------
+//   IsDataFlashError(ERRORCODE_ENUM errorCode, BOOLEAN *isFlashError)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2016/12/01
+//
+//!  This function checks the dataflash error
+//
+//------------------------------------------------------------------------------
+
+static void IsDataFlashError(
+                             ERRORCODE_ENUM errorCode,      //!< This variable constant error codes of a structure errorCodeENUM 
+                             bool *isFlashError          //!< This variable constant dataflash error status True or False
+                             )
+{
+    // Error code is of dataflash error
+    if ( ((unsigned int)errorCode > FIRST_DATAFLASH_ERROR) && (((unsigned int) errorCode) <= LAST_DATAFLASH_ERROR) )
+    {
+        *isFlashError = true;
+    }
+    else
+    {
+        *isFlashError = false;
+    }
+}
+//------------------------------------------------------------------------------
+//   EnterErrorLog(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function enters the gate of the error log. The gate is kept through
+//!  the dataflash accesses of a write, a read or a clear, it is entered again
+//!  by the global functions called from the owner task
+//
+//------------------------------------------------------------------------------
+
+static IArg EnterErrorLog(void)
+{
+    return GateMutex_enter(errorLogGateHandle);
+}
+
+//------------------------------------------------------------------------------
+//   CompleteErrorWrite(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function is called by the dataflash task once the commit marker of
+//!  a queued entry is programmed, the entry is then in the dataflash
+//
+//------------------------------------------------------------------------------
+
+static void CompleteErrorWrite(
+                                 DATAFLASH_REQUEST_STRUCT *request        //!< Program of the commit marker
+                              )
+{
+    // For the interrupt state
+    unsigned int key;
+    (void) request;
+    key = Hwi_disable();
+    pendingErrorWrites--;
+    Hwi_restore(key);
+}
+
+//------------------------------------------------------------------------------
+//   WaitErrorWrites(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function waits until the queued entries are programmed. It is called
+//!  before the error log is read or a page of it is erased, the gate of the
+//!  error log must be entered
+//
+//------------------------------------------------------------------------------
+
+static void WaitErrorWrites(void)
+{
+    // For indexing the slots
+    unsigned char slotIndex = 0U;
+    if ( pendingErrorWrites != 0U )
+    {
+        for ( slotIndex = 0U; slotIndex < ERRLOG_WRITE_SLOTS; slotIndex++ )
+        {
+            DataFlashQueueWait(&errorWriteSlots[slotIndex].markerRequest);
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   ErrorLogCreateGate(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates the gate of the error log. It is called before the
+//!  tasks are started, so no two tasks create it
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogCreateGate(void)
+{
+    // For indexing the slots
+    unsigned char slotIndex = 0U;
+    if ( errorLogGateHandle == NULL )
+    {
+        errorLogGateHandle = GateMutex_create(NULL, NULL);
+        // The slots hold no entry, their requests are completed
+        for ( slotIndex = 0U; slotIndex < ERRLOG_WRITE_SLOTS; slotIndex++ )
+        {
+            errorWriteSlots[slotIndex].recordRequest.operation = DATAFLASH_REQUEST_PROGRAM;
+            errorWriteSlots[slotIndex].recordRequest.data = errorWriteSlots[slotIndex].record;
+            errorWriteSlots[slotIndex].recordRequest.nBytes = (unsigned short)ERRLOG_RECORD_LENGTH;
+            errorWriteSlots[slotIndex].recordRequest.isCompleted = true;
+            errorWriteSlots[slotIndex].markerRequest.operation = DATAFLASH_REQUEST_PROGRAM;
+            errorWriteSlots[slotIndex].markerRequest.data = &errorCommitMarker;
+            errorWriteSlots[slotIndex].markerRequest.nBytes = 1U;
+            errorWriteSlots[slotIndex].markerRequest.callback = CompleteErrorWrite;
+            errorWriteSlots[slotIndex].markerRequest.isCompleted = true;
+        }
+        errorClearRequest.operation = DATAFLASH_REQUEST_FLUSH;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   ErrorLogFindLatestIdentifier(unsigned int *highestIdentifier,ERRORCODE_ENUM errorCode)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2016/12/01
+//
+//!  This function finds the latest error identifier in the error log
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogFindLatestIdentifier(
+                                   unsigned short *highestIdentifier,         //!< This argument identifies the recent error 
+                                   ERRORCODE_ENUM errorCode                      //!< Error Code Correponsing to entry index
+                                  )
+{
+    // Entry holding the identifier, not needed here
+    unsigned char entryIndexNumber = 0U;
+    // For entering the gate of the error log
+    IArg gateKey;
+    gateKey = EnterErrorLog();
+    WaitErrorWrites();
+    ScanErrorLog( errorCode, highestIdentifier, &entryIndexNumber );
+    GateMutex_leave(errorLogGateHandle, gateKey);
+}
+//------------------------------------------------------------------------------
+//   void ErrorLogInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2016/12/01
+//
+//!  This function initializes the Errorlog parameters.
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogInit(void)
+{
+    //For indexing the loop
+    unsigned loopIndex = 0u;
+    // For entering the gate of the error log
+    IArg gateKey;
+    gateKey = EnterErrorLog();
+    if(isErrorLogInit == false)
+    {
+        WaitErrorWrites();
+        while ( loopIndex < TOTAL_NUMBER_OF_ERRORS )
+        {
+            // Get the latest error identifier in the error log and its entry
+            // number in one pass over the pages of the error
+            ScanErrorLog( errorInformation[loopIndex].errorCode, &errorInformation[loopIndex].errorIdentifier, &errorInformation[loopIndex].entryIndex ) ;
+            // The next error skips an entry cut by a power loss
+            errorInformation[loopIndex].isNextEntryTorn = IsNextEntryTorn( errorInformation[loopIndex].entryIndex, errorInformation[loopIndex].errorCode ) ;
+            //Increment the loop
+            loopIndex++;
+        }
+        // No code has a rate yet, a code starts with a full bucket
+        for ( loopIndex = 0u; loopIndex < ERRLOG_RATE_CODES; loopIndex++ )
+        {
+            errorRateArray[loopIndex].errorCode = ERRORCODE_ENUM_NO_ERROR;
+            errorRateArray[loopIndex].repeatCount = 0U;
+        }
+        // Set flag to indicate ErrorLog has been initialized
+        isErrorLogInit = true;
+    }
+    GateMutex_leave(errorLogGateHandle, gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   ErrorLogWrite(ERRORCODE_ENUM errorCode, ERRORTYPE_ENUM errorType)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2016/12/01
+//
+//!  This function writes a new error to error log entry
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogWrite(
+                   ERRORCODE_ENUM errorCode,          //!< Predefined constant error codes of a structure errorCodeENUM 
+                   ERRORTYPE_ENUM errorType           //!< Error type associated with error code
+                   )
+{
+  //Date/time structure
+  DATE_TIME_STRUCT currentDateTime;
+  // For entering the gate of the error log
+  IArg gateKey;
+  // The error type is not logged
+  (void)errorType;
+  // Update real time
+  RTCGetCurrentDateTime(&currentDateTime); 
+  gateKey = EnterErrorLog();
+  WriteError( errorCode, &currentDateTime );
+  GateMutex_leave(errorLogGateHandle, gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   ErrorLogWriteFromISR(ERRORCODE_ENUM errorCode, ERRORTYPE_ENUM errorType)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function queues an error of an interrupt. The interrupts of the
+//!  drivers can nest, so the slot is taken with the interrupts disabled; the
+//!  error log task takes the errors out without a lock
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogWriteFromISR(
+                           ERRORCODE_ENUM errorCode,          //!< Predefined constant error codes of a structure errorCodeENUM
+                           ERRORTYPE_ENUM errorType           //!< Error type associated with error code
+                         )
+{
+    // For the interrupt state
+    unsigned int key;
+    // For the count of the errors queued
+    unsigned char head = 0U;
+    // The error type is not logged
+    (void)errorType;
+    key = Hwi_disable();
+    head = deferredErrorHead;
+    if ( (unsigned char)(head - deferredErrorTail) < ERRLOG_DEFERRED_QUEUE_LENGTH )
+    {
+        deferredErrorArray[head & ERRLOG_DEFERRED_QUEUE_MASK].errorCode = errorCode;
+        deferredErrorArray[head & ERRLOG_DEFERRED_QUEUE_MASK].queuedTicks = Clock_getTicks();
+        // Publish the error once it is complete
+        deferredErrorHead = head + 1U;
+    }
+    else
+    {
+        deferredErrorLostCount++;
+    }
+    Hwi_restore(key);
+}
+
+//------------------------------------------------------------------------------
+//   ErrorLogProcessDeferred(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes all the errors queued by the interrupts. The real
+//!  time is read once for all of them, each error is moved back by the time
+//!  it has been queued
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogProcessDeferred(void)
+{
+    // For the count of the errors written
+    unsigned char tail = 0U;
+    // For the clock ticks when the real time is read
+    unsigned int currentTicks = 0U;
+    // For the clock ticks of a second
+    unsigned int ticksPerSecond = 1000000U / Clock_tickPeriod;
+    //Date/time structure
+    DATE_TIME_STRUCT currentDateTime;
+    // For the time of the error
+    DATE_TIME_STRUCT errorDateTime;
+    // For entering the gate of the error log
+    IArg gateKey;
+    gateKey = EnterErrorLog();
+    tail = deferredErrorTail;
+    if ( tail != deferredErrorHead )
+    {
+        RTCGetCurrentDateTime(&currentDateTime);
+        currentTicks = Clock_getTicks();
+        while ( tail != deferredErrorHead )
+        {
+            errorDateTime = currentDateTime;
+            SubtractSecondsOfDay( &errorDateTime, (currentTicks - deferredErrorArray[tail & ERRLOG_DEFERRED_QUEUE_MASK].queuedTicks) / ticksPerSecond );
+            WriteError( deferredErrorArray[tail & ERRLOG_DEFERRED_QUEUE_MASK].errorCode, &errorDateTime );
+            // Give the slot back once the error is written
+            tail++;
+            deferredErrorTail = tail;
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    // Write the repeated errors whose rate allows it again
+    ErrorLogFlushRepeated();
+    GateMutex_leave(errorLogGateHandle, gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   ErrorLogFlushRepeated(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the errors not written whose rate allows it again.
+//!  The first one is written as it occurred, a record of the repeated errors
+//!  follows it if there were more
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogFlushRepeated(void)
+{
+    //For indexing the loop
+    unsigned char loopIndex = 0u;
+    // For entering the gate of the error log
+    IArg gateKey;
+    gateKey = EnterErrorLog();
+    if ( isErrorLogInit == true )
+    {
+        for ( loopIndex = 0; loopIndex < ERRLOG_RATE_CODES; loopIndex++ )
+        {
+            if ( (errorRateArray[loopIndex].repeatCount != 0U) && (TakeErrorToken(&errorRateArray[loopIndex]) == true) )
+            {
+                WriteRepeatedError( &errorRateArray[loopIndex] );
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    GateMutex_leave(errorLogGateHandle, gateKey);
+}
+
 //------------------------------------------------------------------------------
 //   ErrorLogRead(unsigned int *data, ERRORCODE_ENUM errorCode )
 //
@@ -551,8 +1171,13 @@ void ErrorLogRead(
     char trackDownload = 0u;
     //For the entry index
     unsigned char entryIndex = 0u;
+    // For entering the gate of the error log
+    IArg gateKey;
+    gateKey = EnterErrorLog();
     //Initialize the errorLog Just in case it has not been initialized earlier
     ErrorLogInit();
+    //Read the entries still queued from the dataflash
+    WaitErrorWrites();
     //Get the correct index
     //Find the correct Index
    //Check if the correct error code is found, otherwise it will be dealt as 
@@ -638,6 +1263,7 @@ void ErrorLogRead(
            entryIndex = entryIndex - 1;
        }
     }
+    GateMutex_leave(errorLogGateHandle, gateKey);
 }
 //------------------------------------------------------------------------------
 //   ErrorLogClear(void)
@@ -661,6 +1287,11 @@ void ErrorLogClear(void)
     unsigned int errorPagePosition = 0u;
     // This variable is used for indexing the loop
     unsigned char loopIndex = 0;
+    // For entering the gate of the error log
+    IArg gateKey;
+    gateKey = EnterErrorLog();
+    // The queued entries are programmed before their pages are erased
+    WaitErrorWrites();
     // Go through all the errors
     for ( loopIndex = 0; loopIndex < TOTAL_NUMBER_OF_ERRORS; loopIndex++ )
     {
@@ -671,8 +1302,7 @@ void ErrorLogClear(void)
            if ( errorPagePosition == 0U )
            {
                // Get the dataflash page number
-               errorLogDataFlashPage = ErrorIndexToPage(errorLogIndex,errorInformation[loopIndex].errorCode);
-               DataFlashErasePage( errorLogDataFlashPage ) ;
+               errorLogDataFlashPage = WearLevelEraseSubsector( ErrorIndexToLogicalPage(errorLogIndex,errorInformation[loopIndex].errorCode) ) ;
            }
            // Address of entry number 
            wordAddress = ErrorNumberToAddress(errorLogIndex) + ERRLOG_IDENTIFIER_OFFSET;
@@ -683,7 +1313,15 @@ void ErrorLogClear(void)
        errorInformation[loopIndex].errorIdentifier=0U;
        errorInformation[loopIndex].entryIndex=INVALID_ENTRY_NUMBER;
     }
-    
+    // The errors not written are cleared with the log
+    for ( loopIndex = 0; loopIndex < ERRLOG_RATE_CODES; loopIndex++ )
+    {
+       errorRateArray[loopIndex].repeatCount=0U;
+    }
+    // Program the cleared identifiers still in the page cache
+    DataFlashQueueSubmit(&errorClearRequest);
+    DataFlashQueueWait(&errorClearRequest);
+    GateMutex_leave(errorLogGateHandle, gateKey);
 }
 //
 ////------------------------------------------------------------------------------
@@ -69,6 +69,11 @@
 #define TOTAL_ERROR_ENTRIES           ((PAGES_PER_ERROR_LOG) * ERRLOG_ENTRIES_PER_PAGE ) //!< Total number of event log entries in all Event Log pages
 #define ERRORLOG_CLEAR_REQUEST        4u                                                 //!< Identifier for Error log clear request 
 #define TOTAL_NUMBER_OF_ERRORS        9u                                        //!< Total Number of Errors for logging
+#define ERRLOG_BUCKET_TOKENS          4U                                        //!< Errors of a code written at once before they are counted as repeated
+#define ERRLOG_TOKEN_PERIOD_MS        1000U                                     //!< Milliseconds for an error of a code to be written again
+#define ERRLOG_MAX_REPEAT_COUNT       255U                                      //!< Most errors counted by a repeated error record, high byte of its seconds word
+#define ERRLOG_RATE_CODES             16U                                       //!< Error codes whose rate is kept at once, the least recently written is given up first
+#define ERRLOG_DEFERRED_QUEUE_LENGTH  16U                                       //!< Errors of the interrupts waiting to be written, a power of 2
 #define WHISPER_DEVICE_ERROR_SUBSECTOR      1u                                  //!< Subsector for whisper device error
 #define ETHERNET_COMMUNICATION_ERROR_SUBSECTOR      2u                          //!< Subsector for ethernet device error
 #define WIFI_COMMUNICATION_ERROR_SUBSECTOR     3u                               //!< Subsector for wifi device error
@@ -102,6 +107,7 @@ typedef enum
     ERRORCODE_ENUM_INSTRUMENT_PARAM_CHECKSUM_ERROR          = 404U,          //!< Error code for instrument parameters checksum invalid
     ERRORCODE_ENUM_I2C_LOCKUP_ERROR                         = 420U,          //!< Error code for I2C lock up error
     ERRORCODE_ENUM_SPI_ERROR                                = 451U,          //!< Error code if SPI error
+    ERRORCODE_ENUM_UDMA_ERROR                               = 452U,          //!< Error code if uDMA bus error
     ERRORCODE_ENUM_ILLEGAL_BATTERY_TYPE                     = 470U,          //!< Error code if Alkaline battery is detected in VentisPro    
     ERRORCODE_ENUM_DEVICE_RESET_BY_EXT_WDT                  = 471u,          //!< Error code if device is reset by external WDT    
     // Dataflash errors: 5xx
@@ -124,6 +130,7 @@ typedef enum
     ERRORCODE_ENUM_SPI_PORT_NOT_DEFINED                     = 811u,
     ERRORCODE_ENUM_INSTRUMENT_PARAM_BACKUP_ERROR            = 850u,          //!< Error code for instrument parameters checksum invalid
     ERRORCODE_ENUM_MICRO_VDD_ERROR                          = 851u,          //!< Error code for detection of Micro VDD voltage abnormalities
+    ERRORCODE_ENUM_EEPROM_WRITE_ERROR                       = 852u,          //!< Error code if a write of the internal EEPROM fails
     // todo - These codes are added temporary - and needs to be confirmed later on
     ERRORCODE_ENUM_WL_INCOMING_MB_CHECKSUM_ERROR            = 901u,
     ERRORCODE_ENUM_WL_INCOMING_MB_PARSING_ERROR             = 902u,
@@ -147,6 +154,7 @@ typedef enum
     ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR              = 976U,               //!< Error code for device communication error
     ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR                  = 977U,               //!< Error code for NFC communication error
     ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR                 = 978U,               //!< Error code for BLE communication error
+    ERRORCODE_ENUM_REPEATED_ERROR                           = 979U,               //!< Record of the errors not written, follows the record of the first of them
 } ERRORCODE_ENUM;
 
 //==============================================================================
@@ -159,6 +167,19 @@ typedef enum
 //  EXTERNAL OR GLOBAL FUNCTIONS
 //==============================================================================
 
+//------------------------------------------------------------------------------
+//   ErrorLogCreateGate(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates the gate of the error log. It is called before the
+//!  tasks are started, so no two tasks create it
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogCreateGate(void);
+
 //------------------------------------------------------------------------------
 //   ErrorLogWrite(ERRORCODE_ENUM errorCode, ERRORTYPE_ENUM errorType)
 //
@@ -180,7 +201,10 @@ void ErrorLogWrite(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/01
 //
-//!  This function reads the error code and time byte of the selected error form the log
+//!  This function reads the error code and time byte of the selected error form the log.
+//!  Every entry gives five words: the code, month and day, year, hours and
+//!  minutes, seconds. The high byte of the seconds word is zero except in the
+//!  entry of ERRORCODE_ENUM_REPEATED_ERROR, see ErrorLogFlushRepeated
 //
 //------------------------------------------------------------------------------
 
@@ -230,6 +254,52 @@ void ErrorLogSelectIdentifierForReadback(
 
 void ErrorLogClear(void);
 
+//------------------------------------------------------------------------------
+//   ErrorLogFlushRepeated(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the errors not written whose rate allows it again.
+//!  The first of them is written as a usual entry with its code and time. If
+//!  there were more, an entry of ERRORCODE_ENUM_REPEATED_ERROR follows it with
+//!  the time of the last one; the high byte of its seconds word is the number
+//!  of errors, the first one included, up to ERRLOG_MAX_REPEAT_COUNT
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogFlushRepeated(void);
+
+//------------------------------------------------------------------------------
+//   ErrorLogWriteFromISR(ERRORCODE_ENUM errorCode, ERRORTYPE_ENUM errorType)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function queues an error of an interrupt, it does not wait for the
+//!  dataflash. The error is written with the time it was queued by
+//!  ErrorLogProcessDeferred, it is lost if the queue is full
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogWriteFromISR(
+                           ERRORCODE_ENUM errorCode,                            //!< Predefined constant error codes of a structure errorCodeENUM
+                           ERRORTYPE_ENUM errorType                             //!< Error type associated with error code
+                         );
+
+//------------------------------------------------------------------------------
+//   ErrorLogProcessDeferred(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes all the errors queued by the interrupts and the
+//!  repeated records due. It is called in a loop by the error log task
+//
+//------------------------------------------------------------------------------
+
+void ErrorLogProcessDeferred(void);
+
 //------------------------------------------------------------------------------
 //   void ErrorLogInit(void)
 //
@@ -42,157 +42,2044 @@
 //  INCLUDES 
 //==============================================================================
 
+#include <string.h>
+#include <xdc/std.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/gates/GateMutex.h>
+#if defined(__ICCARM__)
+#include <intrinsics.h>
+#else
+#include <stdatomic.h>
+#endif
 #include "EventLog.h"
+#include "EventLogIndex.h"
 #include "Dataflash.h"
+#include "DataflashQueue.h"
+#include "CRC16.h"
 #include "ErrorLog.h"
 #include "TM4CRTC.h"
 #include "TM4CEEPROM.h"
-#include "TM4CRTC.h"
+#include "EventLogJournal.h"
 
 //==============================================================================
 //  CONSTANTS, TYPEDEFS AND MACROS 
 //==============================================================================
 
-#define SUBSECTOR_BLOCK_INTERNAL_EEPROM 0                                       //!< Subsector block number in the internal EEPROM
+#define SUBSECTOR_BLOCK_INTERNAL_EEPROM 0                                       //!< Subsector block number in the internal EEPROM, read before the journal is written
 #define SUBSECTOR_WORD_INTERNAL_EEPROM 0                                        //!< Subsector word numbr in the internal EEPROM
 #define EVENT_COUNT_BLOCK_INTERNAL_EEPROM 0                                     //!< event counter block number in the internal EEPROM
 #define EVENT_COUNT_WORD_INTERNAL_EEPROM 1                                      //!< event counter word numbr in the internal EEPROM
-#define FIRST_EVENTLOG_SUBSECTOR ((TOTAL_NUMBER_OF_ERRORS*2)+1)                 //!< First event log subsector
-#define LAST_EVENTLOG_SUBSECTOR 4089                                            //!< Last event log subsector  
+#define LAYOUT_BLOCK_INTERNAL_EEPROM 0                                          //!< Layout version block number in the internal EEPROM
+#define LAYOUT_WORD_INTERNAL_EEPROM 2                                           //!< Layout version word number in the internal EEPROM
+#define ERASED_EEPROM_WORD 0xFFFFFFFFu                                          //!< Value of an EEPROM word never written
+#define ERASED_DATAFLASH_WORD 0xFFFFu                                           //!< Value of an erased dataflash word
+#define ERASE_CHECK_FIRST_WORD 0u                                               //!< First word of a subsector checked for an erase, holds the subsector header
+#define ERASE_CHECK_LAST_WORD 255u                                              //!< Last word of a subsector checked for an erase, as SubsectorErase checks it
+#define EVENTLOG_LAYOUT_VERSION 2u                                              //!< Layout of the event log with its index, an erased word is layout 1
 #define MORRISON_INSTRUMENT_TYPE 0xAAAA                                         //!< Morrison instrument type TODO: update it
 #define INTERNAL_EVENT_LENGTH 97                                                //!< Internal event length TODO: update it
 #define EXTERNAL_EVENT_LENGTH 97                                                //!< External event length TODO: update it
+#define EVENT_ID_OFFSET 0                                                       //!< Offset of the event ID in an event
+#define EVENT_MONTH_OFFSET 1                                                    //!< Offset of the month in an event
+#define EVENT_DAY_OFFSET 2                                                      //!< Offset of the day in an event
+#define EVENT_YEAR_OFFSET 3                                                     //!< Offset of the year in an event
+#define EVENT_HOUR_OFFSET 4                                                     //!< Offset of the hour in an event
+#define EVENT_MINUTE_OFFSET 5                                                   //!< Offset of the minutes in an event
+#define EVENT_SECOND_OFFSET 6                                                   //!< Offset of the seconds in an event
+#define EVENT_LENGTH_OFFSET 7                                                   //!< Offset of the event length in an event
+#define EVENT_HEADER_LENGTH 8                                                   //!< Event ID, time stamp and event length bytes
+#define EVENT_SEQUENCE_OFFSET 120                                               //!< Offset of the sequence number in an event
+#define EVENT_CRC_OFFSET 124                                                    //!< Offset of the CRC in an event, it covers the bytes before it
+#define SENSOR_STATUS_LENGTH 5                                                  //!< Type, units, status and reading bytes of a sensor
+#define TOTAL_SENSOR_STATUS_LENGTH (TOTAL_NUMBER_OF_SENSORS*SENSOR_STATUS_LENGTH) //!< Sensor bytes of an event
+#define TOTAL_NUMBER_OF_EVENT_IDS (EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT+1)         //!< Rows of the event descriptor table
+#define EVENT_FIELD_DEVICE_ID 0x01u                                             //!< Event carries the device ID
+#define EVENT_FIELD_USER_NAME 0x02u                                             //!< Event carries the user name
+#define EVENT_FIELD_SITE_NAME 0x04u                                             //!< Event carries the site name
+#define EVENT_FIELD_SENSOR_STATUS 0x08u                                         //!< Event carries the sensor status
+#define EVENT_FIELD_LP_DATA 0x10u                                               //!< Event carries LP data (GPS, IMEI, RSSI or error)
+#define GPS_DATA_LENGTH 8                                                       //!< Length of LP GPS data
+#define IMEI_DATA_LENGTH 15                                                     //!< Length of LP IMEI data
+#define RSSI_DATA_LENGTH 2                                                      //!< Length of LP RSSI data
+#define ERROR_DATA_LENGTH 2                                                     //!< Length of LP error status data
+#define EVENTS_PER_PAGE (EVENT_LOG_WRITE_ARRAY_LENGTH/ONE_EVENT_SIZE)           //!< Events in one RAM page and subsector
+#define EVENT_LOG_RING_SLOTS (EVENT_LOG_RAM_PAGES*EVENTS_PER_PAGE)              //!< Event slots of the RAM ring
+#define RING_WAIT_SLEEP_TICKS 1                                                 //!< Ticks slept while waiting on TaskEventLog
+#define WRITER_STATE_CLOSED 0x1u                                                //!< Writer state bit set while the event log is not initialized or shut down
+#define WRITER_STATE_ONE_WRITER 0x2u                                            //!< Writer state count of one writer holding reserved slots
+#define TIME_KEY_YEAR_SHIFT 26                                                  //!< Position of the year in a time key
+#define TIME_KEY_MONTH_SHIFT 22                                                 //!< Position of the month in a time key
+#define TIME_KEY_DAY_SHIFT 17                                                   //!< Position of the day in a time key
+#define TIME_KEY_HOUR_SHIFT 12                                                  //!< Position of the hour in a time key
+#define TIME_KEY_MINUTE_SHIFT 6                                                 //!< Position of the minutes in a time key
+#define PACKED_SUBSECTOR_MARKER 0xA5                                            //!< First byte of a subsector of packed events
+#define SLOTS_FORMAT_VERSION 1                                                  //!< Format of the subsectors of fixed slots
+#define PACKED_FORMAT_VERSION 2                                                 //!< Format of the subsectors of packed events
+#define COMPRESSED_FORMAT_VERSION 3                                             //!< Format of the subsectors of compressed events
+#define PACKED_MARKER_OFFSET 0                                                  //!< Offset of the marker in a packed subsector
+#define PACKED_VERSION_OFFSET 1                                                 //!< Offset of the format version in a packed subsector
+#define PACKED_FIRST_SEQUENCE_OFFSET 2                                          //!< Offset of the first sequence number in a packed subsector
+#define PACKED_EVENTS_OFFSET 6                                                  //!< Offset of the number of events in a packed subsector
+#define PACKED_FLAGS_OFFSET 8                                                   //!< Offset of the flags in a packed subsector
+#define PACKED_BASE_TIME_OFFSET 9                                               //!< Offset of the seconds of the first event in a compressed subsector
+#define PACKED_DICTIONARY_OFFSET 13                                             //!< Offset of the number of dictionary entries in a compressed subsector
+#define PACKED_HEADER_CRC_OFFSET 14                                             //!< Offset of the CRC of the header in a packed subsector
+#define PACKED_HEADER_LENGTH 16                                                 //!< Header bytes of a packed subsector
+#define PACKED_FLAG_OPEN 0x00                                                   //!< Events will be added to the packed subsector
+#define PACKED_FLAG_CLOSED 0x01                                                 //!< No event will be added to the packed subsector
+#define PACKED_TRAILER_LENGTH 6                                                 //!< Sequence number and CRC bytes after a packed event
+#define COMPRESSED_DELTA_OFFSET 1                                               //!< Offset of the seconds after the first event in a compressed event
+#define COMPRESSED_LENGTH_OFFSET 3                                              //!< Offset of the length before the sequence number in a compressed event
+#define COMPRESSED_HEADER_LENGTH 4                                              //!< Event ID, time offset and length bytes of a compressed event
+#define MAXIMUM_TIME_DELTA 0xFFFFu                                              //!< Largest time offset of a compressed event in seconds
+#define DICTIONARY_ENTRY_LENGTH 16                                              //!< Bytes of a device ID or a name in the dictionary
+#define DICTIONARY_FIELDS 3                                                     //!< Device ID, user name and site name
+#define MAXIMUM_DICTIONARY_ENTRIES 255                                          //!< Dictionary entries of one subsector
+#define DAYS_PER_YEAR 365u                                                      //!< Days in a year which is not a leap year
+#define MONTHS_PER_YEAR 12u                                                     //!< Months in a year
+#define FEBRUARY 2u                                                             //!< Month with a leap day
+#define SECONDS_PER_MINUTE 60u                                                  //!< Seconds in a minute
+#define SECONDS_PER_HOUR 3600u                                                  //!< Seconds in an hour
+#define SECONDS_PER_DAY 86400u                                                  //!< Seconds in a day
+#define CURSOR_LOCATE_ATTEMPTS 2                                                //!< Attempts to locate the event of a cursor
+#define ERASE_AHEAD_MAX_SUBSECTORS (EVENTLOG_ERASE_AHEAD_SUBSECTORS+DATAFLASH_SUBSECTORS_PER_BLOCK-1u) //!< Most subsectors erased ahead, after a block erase started one below the limit
+#if defined(__ICCARM__)
+#define EVENT_ATOMIC volatile                                                   //!< Qualifier of counters shared by the writers (LDREX/STREX)
+#else
+#define EVENT_ATOMIC _Atomic                                                    //!< Qualifier of counters shared by the writers (C11 atomics)
+#endif
 
 //==============================================================================
 //  LOCAL DATA STRUCTURE DEFINITION
 //==============================================================================
-   
+//Structure describing the layout of one event type
+typedef struct
+{
+   unsigned char eventLength;                                                   //!< Event length saved in the event header
+   unsigned char eventFields;                                                   //!< EVENT_FIELD_* slots present after the header
+   unsigned char lpDataLength;                                                  //!< Length of the LP data slot
+}EVENT_DESCRIPTOR_STRUCT;
+//Structure describing the header of one event log subsector
+typedef struct
+{
+   unsigned int firstSequence;                                                  //!< Sequence number of the first event
+   unsigned short numberOfEvents;                                               //!< Events in the subsector
+   unsigned int baseSeconds;                                                    //!< Seconds of the first compressed event since 2000
+   unsigned char formatVersion;                                                 //!< Format of the subsector
+   unsigned char dictionaryEntries;                                             //!< Dictionary entries of a compressed subsector
+   bool isClosed;                                                               //!< True if no event will be added to the subsector
+}SUBSECTOR_HEADER_STRUCT;
+
 //==============================================================================
 //  GLOBAL DATA DECLARATIONS
 //==============================================================================
 
 unsigned int subsectorNumber = 0u;                                              //!< Next subsector number in which the event log will be saved
-static unsigned short ramArrayIndex = 0u;                                       //!< RAM array index for storing the event log
-unsigned char eventLogWriteArray[EVENT_LOG_WRITE_ARRAY_LENGTH] = {0xFFu};       //!< Array for storing the event log in the RAM
+unsigned char eventLogWriteArray[EVENT_LOG_RAM_PAGES][EVENT_LOG_WRITE_ARRAY_LENGTH]; //!< RAM pages for storing the event log
 unsigned char eventLogReadArray[EVENT_LOG_READ_ARRAY_LENGTH] = {0u};            //!< Array for reading the event log
-static bool isEventLogInit = false;                                             //!< To track if the event log has been initialized
-static unsigned int eventCount = 0u;                                           //!< For counting the event
+static EVENT_ATOMIC bool isEventLogInit = false;                                //!< To track if the event log has been initialized
+static EVENT_ATOMIC unsigned int writerState = WRITER_STATE_CLOSED;             //!< Closed bit and count of the writers holding unpublished slots
+static EVENT_ATOMIC unsigned int eventCount = 0u;                               //!< For counting the event
+static EVENT_ATOMIC unsigned int reservedSlots = 0u;                            //!< Ring slots reserved by the writers so far
+static EVENT_ATOMIC unsigned int releasedSlots = 0u;                            //!< Ring slots committed and released by TaskEventLog so far
+static EVENT_ATOMIC unsigned int pagePublishedSlots[EVENT_LOG_RAM_PAGES];       //!< Slots of each RAM page completely written
+static unsigned char flushPage = 0u;                                            //!< Next RAM page to be committed
+static unsigned int ringBaseSequence = 0u;                                      //!< Sequence number of the first slot of the ring
+static unsigned char packedArray[EVENT_LOG_WRITE_ARRAY_LENGTH];                 //!< Subsector of packed events being filled by TaskEventLog
+static unsigned short packedLength = PACKED_HEADER_LENGTH;                      //!< Bytes used in the packed subsector
+static unsigned short packedEvents = 0u;                                        //!< Events in the packed subsector
+static unsigned int packedFirstSequence = 0u;                                   //!< Sequence number of the first packed event
+static unsigned int packedFirstTime = 0u;                                       //!< Time key of the first packed event
+static unsigned int packedLastTime = 0u;                                        //!< Time key of the last packed event
+static unsigned int packedBaseSeconds = 0u;                                     //!< Seconds of the first packed event since 2000
+static unsigned char packedDictionaryEntries = 0u;                              //!< Dictionary entries of the packed subsector
+static unsigned int committedSequence = 0u;                                     //!< Sequence number after the last event in the dataflash
+static GateMutex_Handle consumerGateHandle = NULL;                              //!< Serializes TaskEventLog and the shut down
+static bool isHeadErased = false;                                               //!< True if the subsector being filled is erased in the dataflash
+static unsigned int erasedAheadCount = 0u;                                      //!< Erased subsectors following the subsector being filled
+static DATAFLASH_REQUEST_STRUCT commitRequests[2];                              //!< Dataflash requests of a commit, the events and the dictionary
+static Semaphore_Handle commitSemaphoreHandle = NULL;                           //!< Posted when the last request of a commit is completed
+static DATAFLASH_REQUEST_STRUCT eraseAheadRequest;                              //!< Dataflash request of the erase started by EventLogEraseAhead
+static bool isEraseAheadPending = false;                                        //!< True until the erase ahead request is collected
 
 
 //==============================================================================
 //  LOCAL DATA DECLARATIONS
 //==============================================================================
+//Layout of every event, indexed by the event ID
+static const EVENT_DESCRIPTOR_STRUCT eventDescriptorTable[TOTAL_NUMBER_OF_EVENT_IDS] =
+{
+   [EVENTLOG_ID_NO_EVENT]              = { 0u, 0u, 0u },
+   [EVENTLOG_ID_INST_LOST_EVENT]       = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_LPONLINE_EVENT]        = { 8u, 0u, 0u },
+   [EVENTLOG_ID_LPOFFLINE_EVENT]       = { 8u, 0u, 0u },
+   [EVENTLOG_ID_LB_CREATE_EVENT]       = { 8u, 0u, 0u },
+   [EVENTLOG_ID_NO_LB_EVENT]           = { 8u, 0u, 0u },
+   [EVENTLOG_ID_GPS_UPDATE_EVENT]      = { 16u, EVENT_FIELD_LP_DATA, GPS_DATA_LENGTH },
+   [EVENTLOG_ID_LP_KEEPALIVE_EVENT]    = { 8u, 0u, 0u },
+   [EVENTLOG_ID_SITE_UPDATE_EVENT]     = { 24u, EVENT_FIELD_SITE_NAME, 0u },
+   [EVENTLOG_ID_IMEI_UPDATE_EVENT]     = { 23u, EVENT_FIELD_LP_DATA, IMEI_DATA_LENGTH },
+   [EVENTLOG_ID_CELL_RSSI_EVENT]       = { 10u, EVENT_FIELD_LP_DATA, RSSI_DATA_LENGTH },
+   [EVENTLOG_ID_ERROR_STATUS_EVENT]    = { 10u, EVENT_FIELD_LP_DATA, ERROR_DATA_LENGTH },
+   [EVENTLOG_ID_LEAVE_GROUP_EVENT]     = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_JOIN_GROUP_EVENT]      = { 91u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_USER_NAME | EVENT_FIELD_SITE_NAME | EVENT_FIELD_SENSOR_STATUS, 0u },
+   [EVENTLOG_ID_MAN_DOWN_EVENT]        = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_MANDOWN_CLEAR_EVENT]   = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_USER_UPDATE_EVENT]     = { 40u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_USER_NAME, 0u },
+   [EVENTLOG_ID_PANIC_ALARM_EVENT]     = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_PANIC_CLEAR_EVENT]     = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_SENSOR_UPDATE_EVENT]   = { 59u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_SENSOR_STATUS, 0u },
+   [EVENTLOG_ID_PUMP_ERROR_EVENT]      = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_PUMP_READY_EVENT]      = { 24u, EVENT_FIELD_DEVICE_ID, 0u },
+   [EVENTLOG_ID_HIGH_ALARM_EVENT]      = { 59u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_SENSOR_STATUS, 0u },
+   [EVENTLOG_ID_LOW_ALARM_EVENT]       = { 59u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_SENSOR_STATUS, 0u },
+   [EVENTLOG_ID_STEL_ALARM_EVENT]      = { 59u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_SENSOR_STATUS, 0u },
+   [EVENTLOG_ID_TWA_ALARM_EVENT]       = { 59u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_SENSOR_STATUS, 0u },
+   [EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT] = { 59u, EVENT_FIELD_DEVICE_ID | EVENT_FIELD_SENSOR_STATUS, 0u },
+};
+//Event fields saved in the dictionary of a compressed subsector, in the
+//order of the event
+static const unsigned char dictionaryFieldTable[DICTIONARY_FIELDS] =
+{
+   EVENT_FIELD_DEVICE_ID, EVENT_FIELD_USER_NAME, EVENT_FIELD_SITE_NAME
+};
+//Days of the months of a year which is not a leap year
+static const unsigned char daysPerMonthTable[MONTHS_PER_YEAR + 1u] = {0u, 31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u};
 
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
-static unsigned char GetEventLength(EVENTLOG_ID_ENUM eventID);
+static const EVENT_DESCRIPTOR_STRUCT *GetEventDescriptor(EVENTLOG_ID_ENUM eventID);
+static void EncodeEvent(unsigned char *eventSlot, EVENTLOG_ID_ENUM eventID, DATE_TIME_STRUCT *dateTime, unsigned int sequenceNumber, unsigned short peerNumber, const unsigned char *lpData);
+static unsigned short GetEventCRC(const unsigned char *eventBytes, unsigned short length);
+static unsigned short GetPackedLength(unsigned char eventLength);
+static unsigned short GetSavedLength(const unsigned char *eventBytes, unsigned char formatVersion);
+static unsigned int GetSequenceNumber(const unsigned char *sequenceBytes);
+static bool IsEventValid(const unsigned char *eventBytes, unsigned char formatVersion, unsigned int sequenceNumber);
+static bool ParseSubsectorHeader(const unsigned char *subsectorBytes, SUBSECTOR_HEADER_STRUCT *header);
+static bool ReadSubsectorHeader(unsigned int subsector, SUBSECTOR_HEADER_STRUCT *header);
+static bool ReadEventSequence(unsigned int subsector, unsigned char slotIndex, unsigned int *sequenceNumber);
+static void CheckLayout(void);
+static bool RecoverHead(unsigned int *headSubsector, SUBSECTOR_HEADER_STRUCT *header);
+static void WriteEvents(const EVENTLOG_ID_ENUM *eventIDs, const unsigned short *peerNumbers, const unsigned char *lpData, unsigned short numberOfEvents);
+static void WriteEvent(EVENTLOG_ID_ENUM eventID, unsigned short peerNumber, const unsigned char *lpData);
+static unsigned int GetNextSubsector(unsigned int subsector);
+static unsigned int GetPreviousSubsector(unsigned int subsector);
+static bool IsSubsectorErased(unsigned int subsector);
+static unsigned int GetTimeKey(unsigned char year, unsigned char month, unsigned char day, unsigned char hour, unsigned char minute, unsigned char second);
+static unsigned int GetEventTimeKey(const unsigned char *eventSlot);
+static unsigned char GetDaysInMonth(unsigned char month, unsigned char year);
+static unsigned int GetEventSeconds(const unsigned char *eventSlot);
+static void SetEventTime(unsigned char *event, unsigned int eventSeconds);
+static unsigned short GetDictionaryAddress(unsigned char entryIndex);
+static bool FindDictionaryEntry(const unsigned char *field, unsigned char *entryIndex);
+static bool CompressEvent(const unsigned char *eventSlot);
+static void ResetPackedSubsector(void);
+static void ProgramPackedSubsector(void);
+static void CommitPackedSubsector(bool isClosed);
+static void CollectEraseAhead(bool isWaited);
+static void PackEvent(const unsigned char *eventSlot);
+static void PackPage(unsigned char pageIndex, unsigned int numberOfEvents);
+static unsigned int AtomicAdd(EVENT_ATOMIC unsigned int *value, unsigned int increment);
+static bool ReserveEventSlots(unsigned int numberOfSlots, unsigned int *slotNumber);
+static bool EnterWriter(void);
+static void LeaveWriter(void);
+static unsigned int GetPublishedSlots(void);
+static void ReleaseFlushPage(void);
+static void CommitFullPages(void);
+static void ReadCursorWindow(EVENT_LOG_CURSOR_STRUCT *cursor);
+static unsigned short GetCursorWindowLength(unsigned short windowAddress);
+static bool LoadCursorEvent(EVENT_LOG_CURSOR_STRUCT *cursor, unsigned int sequenceNumber, unsigned short *eventLength);
+static bool LocateCursor(EVENT_LOG_CURSOR_STRUCT *cursor);
+static bool DecompressEvent(EVENT_LOG_CURSOR_STRUCT *cursor, const unsigned char *compressedEvent);
 void CommitBufferToDataflash();
 void CopyDataToBuffer();
 //==============================================================================
 //  LOCAL FUNCTIONS IMPLEMENTATION
 //==============================================================================
 //------------------------------------------------------------------------------
-//   GetEventLength(EVENTLOG_ID_ENUM eventID)
+//   GetEventDescriptor(EVENTLOG_ID_ENUM eventID)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the descriptor table row of the given ID, unknown
+//!  IDs are mapped on the empty row
+//
+//------------------------------------------------------------------------------
+static const EVENT_DESCRIPTOR_STRUCT *GetEventDescriptor(
+                                                           EVENTLOG_ID_ENUM eventID //!< Event ID
+                                                       )
+{
+   //For the descriptor of the event
+   const EVENT_DESCRIPTOR_STRUCT *eventDescriptor = &eventDescriptorTable[EVENTLOG_ID_NO_EVENT];
+   //Check the range of the event ID
+   if ( (unsigned int) eventID < TOTAL_NUMBER_OF_EVENT_IDS )
+   {
+      eventDescriptor = &eventDescriptorTable[eventID];
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Return the descriptor
+   return eventDescriptor;
+}
+//------------------------------------------------------------------------------
+//   EncodeEvent(unsigned char *eventSlot, EVENTLOG_ID_ENUM eventID, DATE_TIME_STRUCT *dateTime, unsigned int sequenceNumber, unsigned short peerNumber, const unsigned char *lpData)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function serializes one event in a slot of ONE_EVENT_SIZE bytes as
+//!  described by its row of the descriptor table. The device ID carries the
+//!  peer number, high byte first. The user name, the site name and the
+//!  sensor status are not known by the event log and are left blank. The
+//!  sequence number and the CRC are saved at the end of the slot
+//
+//------------------------------------------------------------------------------
+static void EncodeEvent(
+                          unsigned char *eventSlot,                             //!< Slot of ONE_EVENT_SIZE bytes
+                          EVENTLOG_ID_ENUM eventID,                             //!< Event ID
+                          DATE_TIME_STRUCT *dateTime,                           //!< Time stamp of the event
+                          unsigned int sequenceNumber,                          //!< Sequence number of the event
+                          unsigned short peerNumber,                            //!< Peer number saved in the device ID
+                          const unsigned char *lpData                           //!< GPS, IMEI, RSSI or error bytes, NULL if none
+                       )
+{
+   //For the descriptor of the event
+   const EVENT_DESCRIPTOR_STRUCT *eventDescriptor = GetEventDescriptor(eventID);
+   //For indexing the slot
+   unsigned char slotIndex = 0u;
+   //For the CRC of the event
+   unsigned short eventCRC = 0u;
+   //Save the event Index byte and the time stamp
+   eventSlot[EVENT_ID_OFFSET] = (unsigned char) eventID;
+   eventSlot[EVENT_MONTH_OFFSET] = dateTime->monthId;
+   eventSlot[EVENT_DAY_OFFSET] = dateTime->dayId;
+   eventSlot[EVENT_YEAR_OFFSET] = (unsigned char) dateTime->yearId;
+   eventSlot[EVENT_HOUR_OFFSET] = dateTime->hourId;
+   eventSlot[EVENT_MINUTE_OFFSET] = dateTime->minId;
+   eventSlot[EVENT_SECOND_OFFSET] = dateTime->secondId;
+   //Save the event length
+   eventSlot[EVENT_LENGTH_OFFSET] = eventDescriptor->eventLength;
+   slotIndex = EVENT_HEADER_LENGTH;
+   //Blank the fields and the reminder of the event
+   memset(&eventSlot[slotIndex], 0x00, ONE_EVENT_SIZE - slotIndex);
+   //Save the peer number in the instrument serial number
+   if ( (eventDescriptor->eventFields & EVENT_FIELD_DEVICE_ID) != 0u )
+   {
+      eventSlot[slotIndex] = (unsigned char) (peerNumber >> 8);
+      eventSlot[slotIndex + 1] = (unsigned char) peerNumber;
+      slotIndex = slotIndex + DEVICE_ID_LENGTH;
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Skip the blank user name, site name and sensor information
+   if ( (eventDescriptor->eventFields & EVENT_FIELD_USER_NAME) != 0u )
+   {
+      slotIndex = slotIndex + USER_SITE_NAME_LENGTH;
+   }
+   else
+   {
+      //Do nothing
+   }
+   if ( (eventDescriptor->eventFields & EVENT_FIELD_SITE_NAME) != 0u )
+   {
+      slotIndex = slotIndex + USER_SITE_NAME_LENGTH;
+   }
+   else
+   {
+      //Do nothing
+   }
+   if ( (eventDescriptor->eventFields & EVENT_FIELD_SENSOR_STATUS) != 0u )
+   {
+      slotIndex = slotIndex + TOTAL_SENSOR_STATUS_LENGTH;
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Save the LP data
+   if ( ((eventDescriptor->eventFields & EVENT_FIELD_LP_DATA) != 0u) && (lpData != NULL) )
+   {
+      memcpy(&eventSlot[slotIndex], lpData, eventDescriptor->lpDataLength);
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Save the sequence number and the CRC used by the recovery
+   eventSlot[EVENT_SEQUENCE_OFFSET] = (unsigned char) (sequenceNumber >> 24);
+   eventSlot[EVENT_SEQUENCE_OFFSET + 1] = (unsigned char) (sequenceNumber >> 16);
+   eventSlot[EVENT_SEQUENCE_OFFSET + 2] = (unsigned char) (sequenceNumber >> 8);
+   eventSlot[EVENT_SEQUENCE_OFFSET + 3] = (unsigned char) sequenceNumber;
+   eventCRC = GetEventCRC(eventSlot, EVENT_CRC_OFFSET);
+   eventSlot[EVENT_CRC_OFFSET] = (unsigned char) (eventCRC >> 8);
+   eventSlot[EVENT_CRC_OFFSET + 1] = (unsigned char) eventCRC;
+}
+//------------------------------------------------------------------------------
+//   GetEventCRC(const unsigned char *eventBytes, unsigned short length)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the CRC of the given bytes of an event
+//
+//------------------------------------------------------------------------------
+static unsigned short GetEventCRC(
+                                    const unsigned char *eventBytes,            //!< Bytes of the event
+                                    unsigned short length                       //!< Bytes covered by the CRC
+                                 )
+{
+   return CRC16Calculate(eventBytes, length, INITIAL_CRC_VALUE);
+}
+//------------------------------------------------------------------------------
+//   GetPackedLength(unsigned char eventLength)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the bytes taken by an event in a packed subsector
+//
+//------------------------------------------------------------------------------
+static unsigned short GetPackedLength(
+                                        unsigned char eventLength               //!< Event length saved in the event header
+                                     )
+{
+   //For the length of the event data
+   unsigned short packedLength = eventLength;
+   //The header is always saved
+   if ( packedLength < EVENT_HEADER_LENGTH )
+   {
+      packedLength = EVENT_HEADER_LENGTH;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return packedLength + PACKED_TRAILER_LENGTH;
+}
+//------------------------------------------------------------------------------
+//   GetSavedLength(const unsigned char *eventBytes, unsigned char formatVersion)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the bytes taken by a saved event in a subsector of
+//!  the given format
+//
+//------------------------------------------------------------------------------
+static unsigned short GetSavedLength(
+                                       const unsigned char *eventBytes,         //!< Saved event, its header at least
+                                       unsigned char formatVersion              //!< Format of the subsector
+                                    )
+{
+   //For the bytes of the event
+   unsigned short savedLength = ONE_EVENT_SIZE;
+   if ( formatVersion == PACKED_FORMAT_VERSION )
+   {
+      savedLength = GetPackedLength(eventBytes[EVENT_LENGTH_OFFSET]);
+   }
+   else if ( formatVersion == COMPRESSED_FORMAT_VERSION )
+   {
+      savedLength = eventBytes[COMPRESSED_LENGTH_OFFSET] + PACKED_TRAILER_LENGTH;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return savedLength;
+}
+//------------------------------------------------------------------------------
+//   GetSequenceNumber(const unsigned char *sequenceBytes)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns a sequence number saved in big endian
+//
+//------------------------------------------------------------------------------
+static unsigned int GetSequenceNumber(
+                                        const unsigned char *sequenceBytes      //!< Saved sequence number
+                                     )
+{
+   return ((unsigned int) sequenceBytes[0] << 24) | ((unsigned int) sequenceBytes[1] << 16) |
+          ((unsigned int) sequenceBytes[2] << 8) | (unsigned int) sequenceBytes[3];
+}
+//------------------------------------------------------------------------------
+//   IsEventValid(const unsigned char *eventBytes, unsigned char formatVersion, unsigned int sequenceNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks the CRC and the sequence number of a saved event in
+//!  a subsector of the given format
+//
+//------------------------------------------------------------------------------
+static bool IsEventValid(
+                           const unsigned char *eventBytes,                     //!< Saved event
+                           unsigned char formatVersion,                         //!< Format of the subsector
+                           unsigned int sequenceNumber                          //!< Expected sequence number
+                        )
+{
+   //For the offsets of the sequence number and of the CRC
+   unsigned short sequenceOffset = EVENT_SEQUENCE_OFFSET;
+   unsigned short crcOffset = EVENT_CRC_OFFSET;
+   //For the saved CRC
+   unsigned short eventCRC = 0u;
+   if ( formatVersion != SLOTS_FORMAT_VERSION )
+   {
+      crcOffset = GetSavedLength(eventBytes, formatVersion) - 2u;
+      sequenceOffset = crcOffset - 4u;
+   }
+   else
+   {
+      //Do nothing
+   }
+   eventCRC = ((unsigned short) eventBytes[crcOffset] << 8) | eventBytes[crcOffset + 1u];
+   return ( (eventCRC == GetEventCRC(eventBytes, crcOffset)) && (GetSequenceNumber(&eventBytes[sequenceOffset]) == sequenceNumber) );
+}
+//------------------------------------------------------------------------------
+//   ParseSubsectorHeader(const unsigned char *subsectorBytes, SUBSECTOR_HEADER_STRUCT *header)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the header of a packed subsector, or the first event
+//!  of a subsector of fixed slots, from its first ONE_EVENT_SIZE bytes. It
+//!  returns false if the subsector holds no valid event
+//
+//------------------------------------------------------------------------------
+static bool ParseSubsectorHeader(
+                                   const unsigned char *subsectorBytes,         //!< First ONE_EVENT_SIZE bytes of the subsector
+                                   SUBSECTOR_HEADER_STRUCT *header              //!< Header of the subsector
+                                )
+{
+   //For the saved CRC
+   unsigned short headerCRC = ((unsigned short) subsectorBytes[PACKED_HEADER_CRC_OFFSET] << 8) | subsectorBytes[PACKED_HEADER_CRC_OFFSET + 1];
+   //To check if the header is valid
+   bool isValid = false;
+   if ( (subsectorBytes[PACKED_MARKER_OFFSET] == PACKED_SUBSECTOR_MARKER) &&
+        ((subsectorBytes[PACKED_VERSION_OFFSET] == PACKED_FORMAT_VERSION) || (subsectorBytes[PACKED_VERSION_OFFSET] == COMPRESSED_FORMAT_VERSION)) &&
+        (headerCRC == GetEventCRC(subsectorBytes, PACKED_HEADER_CRC_OFFSET)) )
+   {
+      header->firstSequence = GetSequenceNumber(&subsectorBytes[PACKED_FIRST_SEQUENCE_OFFSET]);
+      header->numberOfEvents = ((unsigned short) subsectorBytes[PACKED_EVENTS_OFFSET] << 8) | subsectorBytes[PACKED_EVENTS_OFFSET + 1];
+      header->baseSeconds = GetSequenceNumber(&subsectorBytes[PACKED_BASE_TIME_OFFSET]);
+      header->formatVersion = subsectorBytes[PACKED_VERSION_OFFSET];
+      header->dictionaryEntries = subsectorBytes[PACKED_DICTIONARY_OFFSET];
+      header->isClosed = ( subsectorBytes[PACKED_FLAGS_OFFSET] == PACKED_FLAG_CLOSED );
+      isValid = true;
+   }
+   else
+   {
+      //A subsector of fixed slots written before the packed format
+      header->firstSequence = GetSequenceNumber(&subsectorBytes[EVENT_SEQUENCE_OFFSET]);
+      header->numberOfEvents = EVENTS_PER_PAGE;
+      header->baseSeconds = 0u;
+      header->formatVersion = SLOTS_FORMAT_VERSION;
+      header->dictionaryEntries = 0u;
+      header->isClosed = true;
+      isValid = IsEventValid(subsectorBytes, SLOTS_FORMAT_VERSION, header->firstSequence);
+   }
+   return isValid;
+}
+//------------------------------------------------------------------------------
+//   ReadSubsectorHeader(unsigned int subsector, SUBSECTOR_HEADER_STRUCT *header)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the header of an event log subsector from the
+//!  dataflash. It returns false if the subsector holds no valid event
+//
+//------------------------------------------------------------------------------
+static bool ReadSubsectorHeader(
+                                  unsigned int subsector,                       //!< Event log subsector
+                                  SUBSECTOR_HEADER_STRUCT *header               //!< Header of the subsector
+                               )
+{
+   DataFlashReadBytes((unsigned short) subsector, 0u, eventLogReadArray, ONE_EVENT_SIZE);
+   return ParseSubsectorHeader(eventLogReadArray, header);
+}
+//------------------------------------------------------------------------------
+//   ReadEventSequence(unsigned int subsector, unsigned char slotIndex, unsigned int *sequenceNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads an event from a subsector of fixed slots and returns
+//!  its sequence number. It returns false if the slot does not hold a valid
+//!  event
+//
+//------------------------------------------------------------------------------
+static bool ReadEventSequence(
+                                unsigned int subsector,                         //!< Event log subsector
+                                unsigned char slotIndex,                        //!< Slot of the event in the subsector
+                                unsigned int *sequenceNumber                    //!< Sequence number of the event
+                             )
+{
+   //Read the event in the read array
+   DataFlashReadBytes((unsigned short) subsector, (unsigned short) (slotIndex * ONE_EVENT_SIZE), eventLogReadArray, ONE_EVENT_SIZE);
+   *sequenceNumber = GetSequenceNumber(&eventLogReadArray[EVENT_SEQUENCE_OFFSET]);
+   //An erased slot has a wrong CRC
+   return IsEventValid(eventLogReadArray, SLOTS_FORMAT_VERSION, *sequenceNumber);
+}
+//------------------------------------------------------------------------------
+//   CheckLayout(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function moves a dataflash written by the firmware of layout 1 to
+//!  the current layout. Layout 1 has the event log in subsectors 19 to 4089.
+//!  The subsectors after LAST_EVENTLOG_SUBSECTOR now hold the event log
+//!  index, their old events would be read as index entries, so they are
+//!  erased before the index is loaded. The subsectors before
+//!  FIRST_EVENTLOG_SUBSECTOR are now free subsectors of the wear level pool,
+//!  their old events carry no pool header and are erased when the pool takes
+//!  them. The version is written once the erase is complete, a power loss
+//!  before repeats it
+//
+//------------------------------------------------------------------------------
+static void CheckLayout(void)
+{
+   //For the layout version saved in the EEPROM
+   unsigned int layoutVersion = 0u;
+   //To check if the EEPROM write is correct
+   bool isWriteCorrect = false;
+   if ( (TM4CEEPROMReadData(&layoutVersion, (unsigned char) LAYOUT_BLOCK_INTERNAL_EEPROM, (unsigned char) LAYOUT_WORD_INTERNAL_EEPROM, (unsigned char) 1) == true) &&
+        (layoutVersion != EVENTLOG_LAYOUT_VERSION) )
+   {
+      DataFlashEraseSubsectors((unsigned short) FIRST_EVENTLOG_INDEX_SUBSECTOR, (unsigned short) (EVENTLOG_INDEX_GROUPS * 2));
+      layoutVersion = EVENTLOG_LAYOUT_VERSION;
+      isWriteCorrect = TM4CEEPROMWriteData(&layoutVersion, (unsigned char) LAYOUT_BLOCK_INTERNAL_EEPROM, (unsigned char) LAYOUT_WORD_INTERNAL_EEPROM, (unsigned char) 1);
+      //The index is erased again at the next start
+      if ( isWriteCorrect == false )
+      {
+         ErrorLogWrite(ERRORCODE_ENUM_EEPROM_WRITE_ERROR, ERRORTYPE_ENUM_WARNING);
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   RecoverHead(unsigned int *headSubsector, SUBSECTOR_HEADER_STRUCT *header)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function finds the last written subsector from the events saved in
+//!  the dataflash. The first sequence numbers of the subsectors increase up
+//!  to the last written subsector and are smaller or invalid after it, so it
+//!  is found with a binary search, as are the valid events of a subsector of
+//!  fixed slots. It returns false if no subsector holds a valid event
+//
+//------------------------------------------------------------------------------
+static bool RecoverHead(
+                          unsigned int *headSubsector,                          //!< Last written subsector
+                          SUBSECTOR_HEADER_STRUCT *header                       //!< Header of the last written subsector
+                       )
+{
+   //For the search range
+   unsigned int lowSubsector = FIRST_EVENTLOG_SUBSECTOR;
+   unsigned int highSubsector = LAST_EVENTLOG_SUBSECTOR;
+   unsigned int middleSubsector = 0u;
+   unsigned char lowSlot = 1u;
+   unsigned char highSlot = EVENTS_PER_PAGE;
+   unsigned char middleSlot = 0u;
+   //For the header of the first subsector
+   SUBSECTOR_HEADER_STRUCT firstHeader;
+   //For the sequence number of an event
+   unsigned int sequenceNumber = 0u;
+   //To check if the head has been found
+   bool isFound = false;
+   if ( ReadSubsectorHeader(FIRST_EVENTLOG_SUBSECTOR, &firstHeader) == true )
+   {
+      //Find the last subsector starting after the first one
+      while ( lowSubsector < highSubsector )
+      {
+         middleSubsector = lowSubsector + ((highSubsector - lowSubsector + 1u) / 2u);
+         if ( (ReadSubsectorHeader(middleSubsector, header) == true) && (header->firstSequence >= firstHeader.firstSequence) )
+         {
+            lowSubsector = middleSubsector;
+         }
+         else
+         {
+            highSubsector = middleSubsector - 1u;
+         }
+      }
+      *headSubsector = lowSubsector;
+   }
+   else
+   {
+      //The first subsector is being written again after the last one, or has
+      //been erased ahead while the last one is filled
+      *headSubsector = LAST_EVENTLOG_SUBSECTOR;
+      if ( ReadSubsectorHeader(LAST_EVENTLOG_SUBSECTOR, header) == false )
+      {
+         *headSubsector = LAST_EVENTLOG_SUBSECTOR - 1u;
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   isFound = ReadSubsectorHeader(*headSubsector, header);
+   //A subsector of fixed slots may be incomplete
+   if ( (isFound == true) && (header->formatVersion == SLOTS_FORMAT_VERSION) )
+   {
+      //Find the last valid event of the subsector
+      while ( lowSlot < highSlot )
+      {
+         middleSlot = lowSlot + ((highSlot - lowSlot + 1u) / 2u);
+         if ( (ReadEventSequence(*headSubsector, middleSlot - 1u, &sequenceNumber) == true) &&
+              (sequenceNumber == (header->firstSequence + middleSlot - 1u)) )
+         {
+            lowSlot = middleSlot;
+         }
+         else
+         {
+            highSlot = middleSlot - 1u;
+         }
+      }
+      header->numberOfEvents = lowSlot;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   WriteEvents(const EVENTLOG_ID_ENUM *eventIDs, const unsigned short *peerNumbers, const unsigned char *lpData, unsigned short numberOfEvents)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function time stamps the given events once, reserves their slots of
+//!  the RAM ring in one step without taking a lock and publishes them to
+//!  TaskEventLog. It may be called from any task
+//
+//------------------------------------------------------------------------------
+static void WriteEvents(
+                          const EVENTLOG_ID_ENUM *eventIDs,                     //!< Event IDs
+                          const unsigned short *peerNumbers,                    //!< Peer number of every event, NULL if none
+                          const unsigned char *lpData,                          //!< LP data of the events, NULL if none
+                          unsigned short numberOfEvents                         //!< Number of events
+                       )
+{
+   //For the first reserved ring slot
+   unsigned int slotNumber = 0u;
+   //For the slot of an event in the ring
+   unsigned int ringSlot = 0u;
+   //For the events reserved in one step
+   unsigned int reservedEvents = 0u;
+   //For indexing the loops
+   unsigned int eventIndex = 0u;
+   unsigned char pageIndex = 0u;
+   //For the peer number of an event
+   unsigned short peerNumber = 0u;
+   //For the slots written in every RAM page
+   unsigned int writtenSlots[EVENT_LOG_RAM_PAGES];
+   //To check if the slots have been reserved
+   bool isReserved = false;
+   //Date/time structure
+   DATE_TIME_STRUCT currentDateTime;
+   // Get the Updated real time
+   RTCGetCurrentDateTime(&currentDateTime);
+   while ( numberOfEvents > 0u )
+   {
+      //At most one page is reserved in one step
+      reservedEvents = numberOfEvents;
+      if ( reservedEvents > EVENTS_PER_PAGE )
+      {
+         reservedEvents = EVENTS_PER_PAGE;
+      }
+      else
+      {
+         //Do nothing
+      }
+      //Reserve the slots unless the event log is shut down, the writer only
+      //waits when the ring is waiting for TaskEventLog
+      isReserved = false;
+      while ( (isReserved == false) && (EnterWriter() == true) )
+      {
+         isReserved = ReserveEventSlots(reservedEvents, &slotNumber);
+         if ( isReserved == false )
+         {
+            LeaveWriter();
+            Task_sleep(RING_WAIT_SLEEP_TICKS);
+         }
+         else
+         {
+            //Do nothing
+         }
+      }
+      if ( isReserved == false )
+      {
+         //The event log is not initialized or is shut down, drop the events
+         break;
+      }
+      else
+      {
+         //Do nothing
+      }
+      memset(writtenSlots, 0, sizeof(writtenSlots));
+      //Serialize the events in the reserved slots
+      eventIndex = 0u;
+      while ( eventIndex < reservedEvents )
+      {
+         ringSlot = (slotNumber + eventIndex) % EVENT_LOG_RING_SLOTS;
+         pageIndex = (unsigned char) (ringSlot / EVENTS_PER_PAGE);
+         if ( peerNumbers != NULL )
+         {
+            peerNumber = peerNumbers[eventIndex];
+         }
+         else
+         {
+            //Do nothing
+         }
+         EncodeEvent(&eventLogWriteArray[pageIndex][(ringSlot % EVENTS_PER_PAGE) * ONE_EVENT_SIZE], eventIDs[eventIndex],\
+            &currentDateTime, (ringBaseSequence + slotNumber + eventIndex), peerNumber, lpData);
+         writtenSlots[pageIndex]++;
+         eventIndex++;
+      }
+      //Publish the slots to TaskEventLog
+      pageIndex = 0u;
+      while ( pageIndex < EVENT_LOG_RAM_PAGES )
+      {
+         if ( writtenSlots[pageIndex] != 0u )
+         {
+            AtomicAdd(&pagePublishedSlots[pageIndex], writtenSlots[pageIndex]);
+         }
+         else
+         {
+            //Do nothing
+         }
+         pageIndex++;
+      }
+      //increment in event log counter
+      AtomicAdd(&eventCount, reservedEvents);
+      //The shut down may go on once the slots are published
+      LeaveWriter();
+      eventIDs = &eventIDs[reservedEvents];
+      if ( peerNumbers != NULL )
+      {
+         peerNumbers = &peerNumbers[reservedEvents];
+      }
+      else
+      {
+         //Do nothing
+      }
+      numberOfEvents = numberOfEvents - (unsigned short) reservedEvents;
+   }
+}
+//------------------------------------------------------------------------------
+//   WriteEvent(EVENTLOG_ID_ENUM eventID, unsigned short peerNumber, const unsigned char *lpData)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes one event
+//
+//------------------------------------------------------------------------------
+static void WriteEvent(
+                         EVENTLOG_ID_ENUM eventID,                              //!< Event ID
+                         unsigned short peerNumber,                             //!< Peer number
+                         const unsigned char *lpData                            //!< LP data, NULL if none
+                      )
+{
+   WriteEvents(&eventID, &peerNumber, lpData, 1u);
+}
+//------------------------------------------------------------------------------
+//   GetNextSubsector(unsigned int subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the event log subsector following the given one
+//
+//------------------------------------------------------------------------------
+static unsigned int GetNextSubsector(
+                                       unsigned int subsector                   //!< Current subsector
+                                    )
+{
+   //Next subsector to be written in
+   subsector = subsector + 1;
+   //Check the range
+   if ( subsector > LAST_EVENTLOG_SUBSECTOR )
+   {
+      subsector = FIRST_EVENTLOG_SUBSECTOR;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return subsector;
+}
+//------------------------------------------------------------------------------
+//   GetPreviousSubsector(unsigned int subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the event log subsector preceding the given one
+//
+//------------------------------------------------------------------------------
+static unsigned int GetPreviousSubsector(
+                                           unsigned int subsector               //!< Current subsector
+                                        )
+{
+   //Check the range
+   if ( subsector <= FIRST_EVENTLOG_SUBSECTOR )
+   {
+      subsector = LAST_EVENTLOG_SUBSECTOR;
+   }
+   else
+   {
+      subsector = subsector - 1;
+   }
+   return subsector;
+}
+//------------------------------------------------------------------------------
+//   IsSubsectorErased(unsigned int subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if an event log subsector is erased in the
+//!  dataflash. Only the words 0 and 255 are read, as the driver checks an
+//!  erase; the header at word 0 is programmed first in a subsector
+//
+//------------------------------------------------------------------------------
+static bool IsSubsectorErased(
+                                unsigned int subsector                          //!< Event log subsector
+                             )
+{
+   //For the words read back
+   unsigned short firstWord = 0u;
+   unsigned short lastWord = 0u;
+   DataFlashReadWord((unsigned short) subsector, ERASE_CHECK_FIRST_WORD, &firstWord);
+   DataFlashReadWord((unsigned short) subsector, ERASE_CHECK_LAST_WORD, &lastWord);
+   return ( (firstWord == ERASED_DATAFLASH_WORD) && (lastWord == ERASED_DATAFLASH_WORD) );
+}
+//------------------------------------------------------------------------------
+//   GetTimeKey(unsigned char year, unsigned char month, unsigned char day, unsigned char hour, unsigned char minute, unsigned char second)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function packs a time stamp in a key which increases with the time
+//
+//------------------------------------------------------------------------------
+static unsigned int GetTimeKey(
+                                 unsigned char year,                            //!< Year since 2000
+                                 unsigned char month,                           //!< Month
+                                 unsigned char day,                             //!< Day
+                                 unsigned char hour,                            //!< Hour
+                                 unsigned char minute,                          //!< Minutes
+                                 unsigned char second                           //!< Seconds
+                              )
+{
+   return ( ((unsigned int) year << TIME_KEY_YEAR_SHIFT) | ((unsigned int) month << TIME_KEY_MONTH_SHIFT) |
+            ((unsigned int) day << TIME_KEY_DAY_SHIFT) | ((unsigned int) hour << TIME_KEY_HOUR_SHIFT) |
+            ((unsigned int) minute << TIME_KEY_MINUTE_SHIFT) | (unsigned int) second );
+}
+//------------------------------------------------------------------------------
+//   GetEventTimeKey(const unsigned char *eventSlot)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the time key of a saved event
+//
+//------------------------------------------------------------------------------
+static unsigned int GetEventTimeKey(
+                                      const unsigned char *eventSlot            //!< Slot of ONE_EVENT_SIZE bytes
+                                   )
+{
+   return GetTimeKey(eventSlot[EVENT_YEAR_OFFSET], eventSlot[EVENT_MONTH_OFFSET], eventSlot[EVENT_DAY_OFFSET],
+                     eventSlot[EVENT_HOUR_OFFSET], eventSlot[EVENT_MINUTE_OFFSET], eventSlot[EVENT_SECOND_OFFSET]);
+}
+//------------------------------------------------------------------------------
+//   GetDaysInMonth(unsigned char month, unsigned char year)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the days of a month, February has 29 days in the
+//!  years divisible by four
+//
+//------------------------------------------------------------------------------
+static unsigned char GetDaysInMonth(
+                                      unsigned char month,                      //!< Month
+                                      unsigned char year                        //!< Year since 2000
+                                   )
+{
+   //For the days of the month
+   unsigned char daysInMonth = daysPerMonthTable[month];
+   if ( (month == FEBRUARY) && ((year % 4u) == 0u) )
+   {
+      daysInMonth++;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return daysInMonth;
+}
+//------------------------------------------------------------------------------
+//   GetEventSeconds(const unsigned char *eventSlot)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the time stamp of an event in seconds since 2000
+//
+//------------------------------------------------------------------------------
+static unsigned int GetEventSeconds(
+                                      const unsigned char *eventSlot            //!< Slot of ONE_EVENT_SIZE bytes
+                                   )
+{
+   //For the days since 2000
+   unsigned int totalDays = 0u;
+   //For indexing the loop
+   unsigned char month = 1u;
+   //Add the days of the years and of the months before the event
+   totalDays = ((unsigned int) eventSlot[EVENT_YEAR_OFFSET] * DAYS_PER_YEAR) + (((unsigned int) eventSlot[EVENT_YEAR_OFFSET] + 3u) / 4u);
+   while ( (month < eventSlot[EVENT_MONTH_OFFSET]) && (month <= MONTHS_PER_YEAR) )
+   {
+      totalDays = totalDays + GetDaysInMonth(month, eventSlot[EVENT_YEAR_OFFSET]);
+      month++;
+   }
+   if ( eventSlot[EVENT_DAY_OFFSET] != 0u )
+   {
+      totalDays = totalDays + eventSlot[EVENT_DAY_OFFSET] - 1u;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return ( (totalDays * SECONDS_PER_DAY) + ((unsigned int) eventSlot[EVENT_HOUR_OFFSET] * SECONDS_PER_HOUR) +
+            ((unsigned int) eventSlot[EVENT_MINUTE_OFFSET] * SECONDS_PER_MINUTE) + eventSlot[EVENT_SECOND_OFFSET] );
+}
+//------------------------------------------------------------------------------
+//   SetEventTime(unsigned char *event, unsigned int eventSeconds)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function saves a time stamp given in seconds since 2000 in the
+//!  header of an event
+//
+//------------------------------------------------------------------------------
+static void SetEventTime(
+                           unsigned char *event,                                //!< Event header
+                           unsigned int eventSeconds                            //!< Seconds since 2000
+                        )
+{
+   //For the remaining days
+   unsigned int totalDays = eventSeconds / SECONDS_PER_DAY;
+   //For the seconds of the day
+   unsigned int daySeconds = eventSeconds % SECONDS_PER_DAY;
+   //For the date
+   unsigned char year = 0u;
+   unsigned char month = 1u;
+   //For the days of the year, 2000 is a leap year
+   unsigned short daysInYear = DAYS_PER_YEAR + 1u;
+   //Remove the days of the years and of the months before the event
+   while ( totalDays >= daysInYear )
+   {
+      totalDays = totalDays - daysInYear;
+      year++;
+      daysInYear = DAYS_PER_YEAR;
+      if ( (year % 4u) == 0u )
+      {
+         daysInYear++;
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   while ( totalDays >= GetDaysInMonth(month, year) )
+   {
+      totalDays = totalDays - GetDaysInMonth(month, year);
+      month++;
+   }
+   event[EVENT_MONTH_OFFSET] = month;
+   event[EVENT_DAY_OFFSET] = (unsigned char) (totalDays + 1u);
+   event[EVENT_YEAR_OFFSET] = year;
+   event[EVENT_HOUR_OFFSET] = (unsigned char) (daySeconds / SECONDS_PER_HOUR);
+   event[EVENT_MINUTE_OFFSET] = (unsigned char) ((daySeconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
+   event[EVENT_SECOND_OFFSET] = (unsigned char) (daySeconds % SECONDS_PER_MINUTE);
+}
+//------------------------------------------------------------------------------
+//   GetDictionaryAddress(unsigned char entryIndex)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the subsector offset of a dictionary entry, the
+//!  dictionary grows down from the end of the subsector
+//
+//------------------------------------------------------------------------------
+static unsigned short GetDictionaryAddress(
+                                             unsigned char entryIndex           //!< Index of the entry
+                                          )
+{
+   return (unsigned short) (EVENT_LOG_WRITE_ARRAY_LENGTH - (((unsigned short) entryIndex + 1u) * DICTIONARY_ENTRY_LENGTH));
+}
+//------------------------------------------------------------------------------
+//   FindDictionaryEntry(const unsigned char *field, unsigned char *entryIndex)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function searches a device ID or a name in the dictionary of the
+//!  packed subsector. It returns false if the dictionary does not hold it
+//
+//------------------------------------------------------------------------------
+static bool FindDictionaryEntry(
+                                  const unsigned char *field,                   //!< Field of DICTIONARY_ENTRY_LENGTH bytes
+                                  unsigned char *entryIndex                     //!< Index of the entry
+                               )
+{
+   //To check if the entry has been found
+   bool isFound = false;
+   *entryIndex = 0u;
+   while ( (isFound == false) && (*entryIndex < packedDictionaryEntries) )
+   {
+      if ( memcmp(&packedArray[GetDictionaryAddress(*entryIndex)], field, DICTIONARY_ENTRY_LENGTH) == 0 )
+      {
+         isFound = true;
+      }
+      else
+      {
+         (*entryIndex)++;
+      }
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   CompressEvent(const unsigned char *eventSlot)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function appends an event of the RAM ring to the packed subsector.
+//!  The device ID and the names are replaced by the index of their entry in
+//!  the dictionary of the subsector and the time stamp by the seconds after
+//!  the first event. It returns false without changing the subsector if the
+//!  event does not fit in it
+//
+//------------------------------------------------------------------------------
+static bool CompressEvent(
+                            const unsigned char *eventSlot                      //!< Slot of ONE_EVENT_SIZE bytes
+                         )
+{
+   //For the descriptor of the event
+   const EVENT_DESCRIPTOR_STRUCT *eventDescriptor = GetEventDescriptor((EVENTLOG_ID_ENUM) eventSlot[EVENT_ID_OFFSET]);
+   //For the time stamp and its offset from the first event
+   unsigned int eventSeconds = GetEventSeconds(eventSlot);
+   unsigned int timeDelta = 0u;
+   //For the dictionary fields of the event
+   const unsigned char *dictionaryFields[DICTIONARY_FIELDS];
+   unsigned char numberOfFields = 0u;
+   unsigned char newEntries = 0u;
+   unsigned char entryIndex = 0u;
+   //For indexing the slot and the loops
+   unsigned char slotIndex = EVENT_HEADER_LENGTH;
+   unsigned char fieldIndex = 0u;
+   //For the bytes copied from the slot
+   unsigned char rawLength = 0u;
+   //For the length of the compressed event before its sequence number
+   unsigned short compressedLength = 0u;
+   //For the compressed event and its CRC
+   unsigned char *compressedEvent = NULL;
+   unsigned short eventCRC = 0u;
+   //To check if the event fits in the subsector
+   bool isFitting = false;
+   //Find the device ID and the names in the dictionary
+   while ( fieldIndex < DICTIONARY_FIELDS )
+   {
+      if ( (eventDescriptor->eventFields & dictionaryFieldTable[fieldIndex]) != 0u )
+      {
+         dictionaryFields[numberOfFields] = &eventSlot[slotIndex];
+         if ( FindDictionaryEntry(&eventSlot[slotIndex], &entryIndex) == false )
+         {
+            newEntries++;
+         }
+         else
+         {
+            //Do nothing
+         }
+         slotIndex = slotIndex + DICTIONARY_ENTRY_LENGTH;
+         numberOfFields++;
+      }
+      else
+      {
+         //Do nothing
+      }
+      fieldIndex++;
+   }
+   //The sensor status and the LP data are copied
+   if ( eventDescriptor->eventLength > slotIndex )
+   {
+      rawLength = eventDescriptor->eventLength - slotIndex;
+   }
+   else
+   {
+      //Do nothing
+   }
+   compressedLength = COMPRESSED_HEADER_LENGTH + numberOfFields + rawLength;
+   timeDelta = eventSeconds - packedBaseSeconds;
+   //The time offset must fit in two bytes and the new entries in the
+   //dictionary, which is at the end of the subsector
+   isFitting = ( ((packedEvents == 0u) || ((eventSeconds >= packedBaseSeconds) && (timeDelta <= MAXIMUM_TIME_DELTA))) &&
+                 ((packedDictionaryEntries + newEntries) <= MAXIMUM_DICTIONARY_ENTRIES) &&
+                 ((packedLength + compressedLength + PACKED_TRAILER_LENGTH) <=
+                  (EVENT_LOG_WRITE_ARRAY_LENGTH - ((packedDictionaryEntries + newEntries) * DICTIONARY_ENTRY_LENGTH))) );
+   if ( isFitting == true )
+   {
+      if ( packedEvents == 0u )
+      {
+         packedFirstSequence = GetSequenceNumber(&eventSlot[EVENT_SEQUENCE_OFFSET]);
+         packedFirstTime = GetEventTimeKey(eventSlot);
+         packedBaseSeconds = eventSeconds;
+         timeDelta = 0u;
+      }
+      else
+      {
+         //Do nothing
+      }
+      packedLastTime = GetEventTimeKey(eventSlot);
+      //Save the event ID, the time offset and the length
+      compressedEvent = &packedArray[packedLength];
+      compressedEvent[EVENT_ID_OFFSET] = eventSlot[EVENT_ID_OFFSET];
+      compressedEvent[COMPRESSED_DELTA_OFFSET] = (unsigned char) (timeDelta >> 8);
+      compressedEvent[COMPRESSED_DELTA_OFFSET + 1] = (unsigned char) timeDelta;
+      compressedEvent[COMPRESSED_LENGTH_OFFSET] = (unsigned char) compressedLength;
+      //Save the dictionary entries, adding the new ones
+      fieldIndex = 0u;
+      while ( fieldIndex < numberOfFields )
+      {
+         if ( FindDictionaryEntry(dictionaryFields[fieldIndex], &entryIndex) == false )
+         {
+            memcpy(&packedArray[GetDictionaryAddress(entryIndex)], dictionaryFields[fieldIndex], DICTIONARY_ENTRY_LENGTH);
+            packedDictionaryEntries++;
+         }
+         else
+         {
+            //Do nothing
+         }
+         compressedEvent[COMPRESSED_HEADER_LENGTH + fieldIndex] = entryIndex;
+         fieldIndex++;
+      }
+      //Copy the remaining data, then the sequence number and a new CRC
+      memcpy(&compressedEvent[COMPRESSED_HEADER_LENGTH + numberOfFields], &eventSlot[slotIndex], rawLength);
+      memcpy(&compressedEvent[compressedLength], &eventSlot[EVENT_SEQUENCE_OFFSET], 4u);
+      eventCRC = GetEventCRC(compressedEvent, compressedLength + 4u);
+      compressedEvent[compressedLength + 4u] = (unsigned char) (eventCRC >> 8);
+      compressedEvent[compressedLength + 5u] = (unsigned char) eventCRC;
+      packedLength = packedLength + compressedLength + PACKED_TRAILER_LENGTH;
+      packedEvents++;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isFitting;
+}
+//------------------------------------------------------------------------------
+//   ResetPackedSubsector(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function empties the packed subsector in RAM
+//
+//------------------------------------------------------------------------------
+static void ResetPackedSubsector(void)
+{
+   memset(packedArray, 0xFF, EVENT_LOG_WRITE_ARRAY_LENGTH);
+   packedLength = PACKED_HEADER_LENGTH;
+   packedEvents = 0u;
+   packedDictionaryEntries = 0u;
+}
+//------------------------------------------------------------------------------
+//   ProgramPackedSubsector(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function queues the programs of the packed subsector to its erased
+//!  subsector of the dataflash. The events and the dictionary are programmed,
+//!  the free bytes between them are left erased. The semaphore of the commit
+//!  is posted by the last program
+//
+//------------------------------------------------------------------------------
+static void ProgramPackedSubsector(void)
+{
+   //For the address of the last dictionary entry
+   unsigned short dictionaryAddress = 0u;
+   commitRequests[0].operation = DATAFLASH_REQUEST_PROGRAM;
+   commitRequests[0].subsectorNumber = (unsigned short) subsectorNumber;
+   commitRequests[0].byteAddress = 0u;
+   commitRequests[0].data = packedArray;
+   commitRequests[0].nBytes = packedLength;
+   commitRequests[0].semaphore = commitSemaphoreHandle;
+   if ( packedDictionaryEntries != 0u )
+   {
+      dictionaryAddress = GetDictionaryAddress(packedDictionaryEntries - 1u);
+      commitRequests[0].semaphore = NULL;
+      commitRequests[1].operation = DATAFLASH_REQUEST_PROGRAM;
+      commitRequests[1].subsectorNumber = (unsigned short) subsectorNumber;
+      commitRequests[1].byteAddress = dictionaryAddress;
+      commitRequests[1].data = &packedArray[dictionaryAddress];
+      commitRequests[1].nBytes = (unsigned short) (EVENT_LOG_WRITE_ARRAY_LENGTH - dictionaryAddress);
+      commitRequests[1].semaphore = commitSemaphoreHandle;
+      DataFlashQueueSubmit(&commitRequests[0]);
+      DataFlashQueueSubmit(&commitRequests[1]);
+   }
+   else
+   {
+      DataFlashQueueSubmit(&commitRequests[0]);
+   }
+}
+//------------------------------------------------------------------------------
+//   CommitPackedSubsector(bool isClosed)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function commits the packed subsector to dataflash, indexes it and
+//!  journals the next subsector and the event count in the EEPROM. The next
+//!  events start the next subsector, a subsector holding committed events is
+//!  never erased to add events to it
+//
+//------------------------------------------------------------------------------
+static void CommitPackedSubsector(
+                                    bool isClosed                               //!< True if the subsector is full, false for the shut down
+                                 )
+{
+   //For the subsector following the page
+   unsigned int nextSubsector = 0u;
+   //To check if the EEPROM write is correct
+   bool isWriteCorrect = false;
+   //For the CRC of the header
+   unsigned short headerCRC = 0u;
+   //Build the header
+   packedArray[PACKED_MARKER_OFFSET] = PACKED_SUBSECTOR_MARKER;
+   packedArray[PACKED_VERSION_OFFSET] = COMPRESSED_FORMAT_VERSION;
+   packedArray[PACKED_FIRST_SEQUENCE_OFFSET] = (unsigned char) (packedFirstSequence >> 24);
+   packedArray[PACKED_FIRST_SEQUENCE_OFFSET + 1] = (unsigned char) (packedFirstSequence >> 16);
+   packedArray[PACKED_FIRST_SEQUENCE_OFFSET + 2] = (unsigned char) (packedFirstSequence >> 8);
+   packedArray[PACKED_FIRST_SEQUENCE_OFFSET + 3] = (unsigned char) packedFirstSequence;
+   packedArray[PACKED_EVENTS_OFFSET] = (unsigned char) (packedEvents >> 8);
+   packedArray[PACKED_EVENTS_OFFSET + 1] = (unsigned char) packedEvents;
+   packedArray[PACKED_BASE_TIME_OFFSET] = (unsigned char) (packedBaseSeconds >> 24);
+   packedArray[PACKED_BASE_TIME_OFFSET + 1] = (unsigned char) (packedBaseSeconds >> 16);
+   packedArray[PACKED_BASE_TIME_OFFSET + 2] = (unsigned char) (packedBaseSeconds >> 8);
+   packedArray[PACKED_BASE_TIME_OFFSET + 3] = (unsigned char) packedBaseSeconds;
+   packedArray[PACKED_DICTIONARY_OFFSET] = packedDictionaryEntries;
+   if ( isClosed == true )
+   {
+      packedArray[PACKED_FLAGS_OFFSET] = PACKED_FLAG_CLOSED;
+   }
+   else
+   {
+      packedArray[PACKED_FLAGS_OFFSET] = PACKED_FLAG_OPEN;
+   }
+   headerCRC = GetEventCRC(packedArray, PACKED_HEADER_CRC_OFFSET);
+   packedArray[PACKED_HEADER_CRC_OFFSET] = (unsigned char) (headerCRC >> 8);
+   packedArray[PACKED_HEADER_CRC_OFFSET + 1] = (unsigned char) headerCRC;
+   //An erase ahead of the subsector is waited for, it is then only
+   //programmed
+   if ( (isEraseAheadPending == true) && (subsectorNumber >= eraseAheadRequest.subsectorNumber) &&
+        (subsectorNumber < ((unsigned int) eraseAheadRequest.subsectorNumber + eraseAheadRequest.nSubsectors)) )
+   {
+      CollectEraseAhead(true);
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Write data to dataflash through the dataflash task, a subsector erased
+   //ahead is only programmed. The programs are carried out while an erase
+   //ahead of other subsectors goes on
+   if ( isHeadErased == true )
+   {
+      ProgramPackedSubsector();
+      isHeadErased = false;
+   }
+   else
+   {
+      commitRequests[0].operation = DATAFLASH_REQUEST_COMMIT;
+      commitRequests[0].subsectorNumber = (unsigned short) subsectorNumber;
+      commitRequests[0].data = packedArray;
+      commitRequests[0].semaphore = commitSemaphoreHandle;
+      DataFlashQueueSubmit(&commitRequests[0]);
+   }
+   (void) Semaphore_pend(commitSemaphoreHandle, BIOS_WAIT_FOREVER);
+   //The subsector is not written again, an open one included
+   EventLogIndexUpdate(subsectorNumber, packedFirstSequence, packedFirstTime, packedLastTime, packedEvents, true);
+   //Journal the subsector of the next events and the events in the dataflash
+   //once the page is in the dataflash
+   nextSubsector = GetNextSubsector(subsectorNumber);
+   isWriteCorrect = EventLogJournalAppend(nextSubsector, packedFirstSequence + packedEvents);
+   //A failed entry is written again by the next commit, the head is found in
+   //the dataflash if it never succeeds
+   if ( isWriteCorrect == false )
+   {
+      ErrorLogWrite(ERRORCODE_ENUM_EEPROM_WRITE_ERROR, ERRORTYPE_ENUM_WARNING);
+   }
+   else
+   {
+      //Do nothing
+   }
+   //The packed events can be read from the dataflash
+   committedSequence = packedFirstSequence + packedEvents;
+   //Events are now added to the next subsector, which may have been erased
+   //ahead
+   subsectorNumber = nextSubsector;
+   ResetPackedSubsector();
+   if ( erasedAheadCount != 0u )
+   {
+      isHeadErased = true;
+      erasedAheadCount--;
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   CollectEraseAhead(bool isWaited)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function counts the subsectors of the erase queued by
+//!  EventLogEraseAhead once it is completed, it waits for it if asked. The
+//!  erased subsectors are counted if they still follow the counted ones or
+//!  if the head has moved into them, the caller must hold the consumer gate
+//
+//------------------------------------------------------------------------------
+static void CollectEraseAhead(
+                                bool isWaited                                   //!< True to wait for the erase
+                             )
+{
+   //For the subsector following the counted ones
+   unsigned int nextErased = 0u;
+   //For the last erased subsector
+   unsigned int lastErased = 0u;
+   if ( (isEraseAheadPending == true) && (isWaited == true) )
+   {
+      DataFlashQueueWait(&eraseAheadRequest);
+   }
+   else
+   {
+      //Do nothing
+   }
+   if ( (isEraseAheadPending == true) && (DataFlashQueueIsCompleted(&eraseAheadRequest) == true) )
+   {
+      isEraseAheadPending = false;
+      nextErased = subsectorNumber + erasedAheadCount + 1u;
+      if ( nextErased > LAST_EVENTLOG_SUBSECTOR )
+      {
+         nextErased = nextErased - (LAST_EVENTLOG_SUBSECTOR - FIRST_EVENTLOG_SUBSECTOR + 1u);
+      }
+      else
+      {
+         //Do nothing
+      }
+      lastErased = (unsigned int) eraseAheadRequest.subsectorNumber + eraseAheadRequest.nSubsectors - 1u;
+      if ( (eraseAheadRequest.subsectorNumber == nextErased) && (eraseAheadRequest.subsectorNumber != subsectorNumber) )
+      {
+         erasedAheadCount = erasedAheadCount + eraseAheadRequest.nSubsectors;
+      }
+      else if ( (subsectorNumber >= eraseAheadRequest.subsectorNumber) && (subsectorNumber <= lastErased) )
+      {
+         //No commit of the head has been queued after the erase, the head
+         //would have moved
+         isHeadErased = true;
+         if ( erasedAheadCount < (lastErased - subsectorNumber) )
+         {
+            erasedAheadCount = lastErased - subsectorNumber;
+         }
+         else
+         {
+            //Do nothing
+         }
+      }
+      else
+      {
+         //The head has moved past the erased subsectors, they are left
+         //uncounted
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   PackEvent(const unsigned char *eventSlot)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function appends an event of the RAM ring to the packed subsector,
+//!  the subsector is committed first if the event does not fit in it
+//
+//------------------------------------------------------------------------------
+static void PackEvent(
+                        const unsigned char *eventSlot                          //!< Slot of ONE_EVENT_SIZE bytes
+                     )
+{
+   //Close the subsector if the event does not fit in it
+   if ( CompressEvent(eventSlot) == false )
+   {
+      CommitPackedSubsector(true);
+      (void) CompressEvent(eventSlot);
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   PackPage(unsigned char pageIndex, unsigned int numberOfEvents)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function appends the events of a RAM page to the packed subsector
+//
+//------------------------------------------------------------------------------
+static void PackPage(
+                       unsigned char pageIndex,                                 //!< RAM page to be packed
+                       unsigned int numberOfEvents                              //!< Events in the page
+                    )
+{
+   //For indexing the loop
+   unsigned int eventIndex = 0u;
+   while ( eventIndex < numberOfEvents )
+   {
+      PackEvent(&eventLogWriteArray[pageIndex][eventIndex * ONE_EVENT_SIZE]);
+      eventIndex++;
+   }
+}
+//------------------------------------------------------------------------------
+//   AtomicAdd(EVENT_ATOMIC unsigned int *value, unsigned int increment)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function atomically adds to a counter shared by the writers and
+//!  returns the new value. Earlier writes are visible before the new value
+//
+//------------------------------------------------------------------------------
+static unsigned int AtomicAdd(
+                                EVENT_ATOMIC unsigned int *value,               //!< Shared counter
+                                unsigned int increment                          //!< Value to be added
+                             )
+{
+   //For the new value of the counter
+   unsigned int newValue = 0u;
+#if defined(__ICCARM__)
+   //Complete the writes to the slot before the counter is updated
+   __DMB();
+   do
+   {
+      newValue = (unsigned int) __LDREX((unsigned long *) value) + increment;
+   }while ( __STREX((unsigned long) newValue, (unsigned long *) value) != 0u );
+   __DMB();
+#else
+   newValue = atomic_fetch_add(value, increment) + increment;
+#endif
+   return newValue;
+}
+//------------------------------------------------------------------------------
+//   ReserveEventSlots(unsigned int numberOfSlots, unsigned int *slotNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reserves the next slots of the RAM ring. It returns false
+//!  without reserving when not enough slots have been released by
+//!  TaskEventLog
+//
+//------------------------------------------------------------------------------
+static bool ReserveEventSlots(
+                                unsigned int numberOfSlots,                     //!< Slots to be reserved
+                                unsigned int *slotNumber                        //!< First reserved slot number
+                             )
+{
+   //For the slots reserved before this one
+   unsigned int reserved = 0u;
+   //To check if the ring is full
+   bool isRingFull = false;
+#if defined(__ICCARM__)
+   do
+   {
+      reserved = (unsigned int) __LDREX((unsigned long *) &reservedSlots);
+      isRingFull = ( (reserved - releasedSlots) > (EVENT_LOG_RING_SLOTS - numberOfSlots) );
+      if ( isRingFull == true )
+      {
+         //Drop the exclusive access
+         __CLREX();
+      }
+      else
+      {
+         //Do nothing
+      }
+   }while ( (isRingFull == false) && (__STREX((unsigned long) (reserved + numberOfSlots), (unsigned long *) &reservedSlots) != 0u) );
+   __DMB();
+#else
+   reserved = atomic_load(&reservedSlots);
+   do
+   {
+      isRingFull = ( (reserved - releasedSlots) > (EVENT_LOG_RING_SLOTS - numberOfSlots) );
+   }while ( (isRingFull == false) && (atomic_compare_exchange_weak(&reservedSlots, &reserved, reserved + numberOfSlots) == false) );
+#endif
+   *slotNumber = reserved;
+   return (isRingFull == false);
+}
+//------------------------------------------------------------------------------
+//   EnterWriter(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function counts a writer about to reserve slots of the RAM ring in
+//!  the writer state. It returns false without counting the writer once the
+//!  event log is closed, so that no slot is reserved after the shut down has
+//!  started
+//
+//------------------------------------------------------------------------------
+static bool EnterWriter(void)
+{
+   //For the writer state before this writer
+   unsigned int state = 0u;
+   //To check if the event log is closed
+   bool isClosed = false;
+#if defined(__ICCARM__)
+   do
+   {
+      state = (unsigned int) __LDREX((unsigned long *) &writerState);
+      isClosed = ( (state & WRITER_STATE_CLOSED) != 0u );
+      if ( isClosed == true )
+      {
+         //Drop the exclusive access
+         __CLREX();
+      }
+      else
+      {
+         //Do nothing
+      }
+   }while ( (isClosed == false) && (__STREX((unsigned long) (state + WRITER_STATE_ONE_WRITER), (unsigned long *) &writerState) != 0u) );
+   __DMB();
+#else
+   state = atomic_load(&writerState);
+   do
+   {
+      isClosed = ( (state & WRITER_STATE_CLOSED) != 0u );
+   }while ( (isClosed == false) && (atomic_compare_exchange_weak(&writerState, &state, state + WRITER_STATE_ONE_WRITER) == false) );
+#endif
+   return (isClosed == false);
+}
+//------------------------------------------------------------------------------
+//   LeaveWriter(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function removes a writer counted by EnterWriter, after it has
+//!  published its slots or failed to reserve them
+//
+//------------------------------------------------------------------------------
+static void LeaveWriter(void)
+{
+   AtomicAdd(&writerState, 0u - WRITER_STATE_ONE_WRITER);
+}
+//------------------------------------------------------------------------------
+//   GetPublishedSlots(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the slots published in the RAM pages which have not
+//!  been released yet
+//
+//------------------------------------------------------------------------------
+static unsigned int GetPublishedSlots(void)
+{
+   //For indexing the loop
+   unsigned char pageIndex = 0u;
+   //For the published slots
+   unsigned int publishedSlots = 0u;
+   while ( pageIndex < EVENT_LOG_RAM_PAGES )
+   {
+      publishedSlots = publishedSlots + pagePublishedSlots[pageIndex];
+      pageIndex++;
+   }
+   return publishedSlots;
+}
+//------------------------------------------------------------------------------
+//   ReleaseFlushPage(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function hands the committed flush page back to the writers
+//
+//------------------------------------------------------------------------------
+static void ReleaseFlushPage(void)
+{
+   //Reset the published slots of the page
+   pagePublishedSlots[flushPage] = 0u;
+   flushPage = (flushPage + 1u) % EVENT_LOG_RAM_PAGES;
+   //The slots of the page can be reserved again
+   AtomicAdd(&releasedSlots, EVENTS_PER_PAGE);
+}
+//------------------------------------------------------------------------------
+//   CommitFullPages(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function packs the completely written RAM pages in ring order, the
+//!  packed subsector is committed when it is full. The caller must hold the
+//!  consumer gate
+//
+//------------------------------------------------------------------------------
+static void CommitFullPages(void)
+{
+   //Pack while the next page in ring order is complete
+   while ( pagePublishedSlots[flushPage] == EVENTS_PER_PAGE )
+   {
+      PackPage(flushPage, EVENTS_PER_PAGE);
+      //Now Reset the page
+      memset(eventLogWriteArray[flushPage], 0xFF, EVENT_LOG_WRITE_ARRAY_LENGTH);
+      ReleaseFlushPage();
+   }
+}
+//------------------------------------------------------------------------------
+//   ReadCursorWindow(EVENT_LOG_CURSOR_STRUCT *cursor)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the window of a cursor from its event address
+//
+//------------------------------------------------------------------------------
+static void ReadCursorWindow(
+                               EVENT_LOG_CURSOR_STRUCT *cursor                  //!< Cursor
+                            )
+{
+   DataFlashReadBytes((unsigned short) cursor->subsector, cursor->eventAddress, cursor->window, GetCursorWindowLength(cursor->eventAddress));
+   cursor->windowAddress = cursor->eventAddress;
+   cursor->isWindowValid = true;
+}
+//------------------------------------------------------------------------------
+//   GetCursorWindowLength(unsigned short windowAddress)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the bytes of a window starting at the given
+//!  subsector offset, the window stops at the end of the subsector
+//
+//------------------------------------------------------------------------------
+static unsigned short GetCursorWindowLength(
+                                              unsigned short windowAddress      //!< Subsector offset of the window
+                                           )
+{
+   //For the length of the window
+   unsigned short windowLength = EVENT_LOG_CURSOR_WINDOW_LENGTH;
+   if ( (windowAddress + windowLength) > EVENT_LOG_WRITE_ARRAY_LENGTH )
+   {
+      windowLength = EVENT_LOG_WRITE_ARRAY_LENGTH - windowAddress;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return windowLength;
+}
+//------------------------------------------------------------------------------
+//   LoadCursorEvent(EVENT_LOG_CURSOR_STRUCT *cursor, unsigned int sequenceNumber, unsigned short *eventLength)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/14
+//   Date:     2026/10/17
 //
-//!  This function returns the length of the given ID
+//!  This function brings the event at the event address of a cursor in its
+//!  window, which is read again unless it holds the whole event. It returns
+//!  false if the event is not valid or has another sequence number
 //
 //------------------------------------------------------------------------------
-static unsigned char GetEventLength(
-                                       EVENTLOG_ID_ENUM eventID                 //!< Event ID
-                                   )
+static bool LoadCursorEvent(
+                              EVENT_LOG_CURSOR_STRUCT *cursor,                  //!< Cursor
+                              unsigned int sequenceNumber,                      //!< Expected sequence number
+                              unsigned short *eventLength                       //!< Bytes taken by the event in the subsector
+                           )
+{
+   //For the end of the window
+   unsigned short windowEnd = cursor->windowAddress + GetCursorWindowLength(cursor->windowAddress);
+   //To check if the event is valid
+   bool isValid = false;
+   *eventLength = ONE_EVENT_SIZE;
+   //The event header must be in the subsector
+   if ( (cursor->eventAddress + EVENT_HEADER_LENGTH) <= EVENT_LOG_WRITE_ARRAY_LENGTH )
+   {
+      //Read the window at the event unless it holds the event header
+      if ( (cursor->isWindowValid == false) || (cursor->eventAddress < cursor->windowAddress) ||
+           ((cursor->eventAddress + EVENT_HEADER_LENGTH) > windowEnd) )
+      {
+         ReadCursorWindow(cursor);
+         windowEnd = cursor->windowAddress + GetCursorWindowLength(cursor->windowAddress);
+      }
+      else
+      {
+         //Do nothing
+      }
+      *eventLength = GetSavedLength(&cursor->window[cursor->eventAddress - cursor->windowAddress], cursor->formatVersion);
+      //Read the window again unless it holds the whole event
+      if ( (cursor->eventAddress + *eventLength) > windowEnd )
+      {
+         ReadCursorWindow(cursor);
+      }
+      else
+      {
+         //Do nothing
+      }
+      if ( (cursor->eventAddress + *eventLength) <= EVENT_LOG_WRITE_ARRAY_LENGTH )
+      {
+         isValid = IsEventValid(&cursor->window[cursor->eventAddress - cursor->windowAddress], cursor->formatVersion, sequenceNumber);
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isValid;
+}
+//------------------------------------------------------------------------------
+//   LocateCursor(EVENT_LOG_CURSOR_STRUCT *cursor)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function finds the subsector and the address of the next event of
+//!  a cursor. If the event has been overwritten the cursor moves to the
+//!  oldest event, the caller must hold the consumer gate
+//
+//------------------------------------------------------------------------------
+static bool LocateCursor(
+                           EVENT_LOG_CURSOR_STRUCT *cursor                      //!< Cursor
+                        )
+{
+   //For the subsector of the event and its header
+   unsigned int eventSubsector = cursor->subsector;
+   SUBSECTOR_HEADER_STRUCT header;
+   //For the sequence numbers of the events before the one of the cursor
+   unsigned int sequenceNumber = 0u;
+   //For the bytes taken by an event
+   unsigned short eventLength = 0u;
+   //To check if the subsector has been found
+   bool isFound = false;
+   //Move to the following subsector if the subsector of the cursor has not
+   //been written again
+   if ( (cursor->firstSequence != EVENTLOG_INDEX_INVALID) && (ReadSubsectorHeader(cursor->subsector, &header) == true) &&
+        (header.firstSequence == cursor->firstSequence) )
+   {
+      eventSubsector = GetNextSubsector(cursor->subsector);
+      isFound = ( (ReadSubsectorHeader(eventSubsector, &header) == true) && (header.firstSequence > cursor->firstSequence) );
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Otherwise the event is in the open subsector or is found with the index
+   if ( isFound == false )
+   {
+      if ( (packedEvents != 0u) && (cursor->sequenceNumber >= packedFirstSequence) )
+      {
+         eventSubsector = subsectorNumber;
+      }
+      else if ( EventLogIndexFindSequence(subsectorNumber, cursor->sequenceNumber, &eventSubsector) == false )
+      {
+         //The event has been overwritten, move to the oldest event
+         if ( EventLogIndexFindOldest(subsectorNumber, &eventSubsector) == false )
+         {
+            eventSubsector = subsectorNumber;
+         }
+         else
+         {
+            //Do nothing
+         }
+      }
+      else
+      {
+         //Do nothing
+      }
+      isFound = ReadSubsectorHeader(eventSubsector, &header);
+      //The subsector of the event is not indexed, move to the next one
+      if ( (isFound == true) && (cursor->sequenceNumber >= (header.firstSequence + header.numberOfEvents)) )
+      {
+         sequenceNumber = header.firstSequence;
+         eventSubsector = GetNextSubsector(eventSubsector);
+         isFound = ( (ReadSubsectorHeader(eventSubsector, &header) == true) && (header.firstSequence > sequenceNumber) );
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+   if ( isFound == true )
+   {
+      //Skip the events which have been overwritten
+      if ( cursor->sequenceNumber < header.firstSequence )
+      {
+         cursor->sequenceNumber = header.firstSequence;
+      }
+      else
+      {
+         //Do nothing
+      }
+      cursor->subsector = eventSubsector;
+      cursor->firstSequence = header.firstSequence;
+      cursor->endSequence = header.firstSequence + header.numberOfEvents;
+      cursor->baseSeconds = header.baseSeconds;
+      cursor->formatVersion = header.formatVersion;
+      cursor->dictionaryEntries = header.dictionaryEntries;
+      //The window belongs to another subsector
+      cursor->isWindowValid = false;
+      if ( header.formatVersion != SLOTS_FORMAT_VERSION )
+      {
+         //Walk the packed events before the event of the cursor
+         cursor->eventAddress = PACKED_HEADER_LENGTH;
+         sequenceNumber = header.firstSequence;
+         while ( (isFound == true) && (sequenceNumber < cursor->sequenceNumber) )
+         {
+            isFound = LoadCursorEvent(cursor, sequenceNumber, &eventLength);
+            cursor->eventAddress = cursor->eventAddress + eventLength;
+            sequenceNumber++;
+         }
+      }
+      else
+      {
+         cursor->eventAddress = (unsigned short) ((cursor->sequenceNumber - header.firstSequence) * ONE_EVENT_SIZE);
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   DecompressEvent(EVENT_LOG_CURSOR_STRUCT *cursor, const unsigned char *compressedEvent)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function rebuilds a compressed event in the event buffer of a
+//!  cursor as it was saved in the RAM ring, the dictionary entries are read
+//!  from the subsector of the cursor. It returns false if an entry is not in
+//!  the dictionary
+//
+//------------------------------------------------------------------------------
+static bool DecompressEvent(
+                              EVENT_LOG_CURSOR_STRUCT *cursor,                  //!< Cursor
+                              const unsigned char *compressedEvent              //!< Event in the window of the cursor
+                           )
 {
-   //For event length
-   unsigned char eventLength = 0u;
-   //Get the Event length based on the given ID
-   switch(eventID)
-   {
-     case EVENTLOG_ID_INST_LOST_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_LPONLINE_EVENT:
-     eventLength = 8;
-     break;
-     case EVENTLOG_ID_LPOFFLINE_EVENT:
-     eventLength = 8;
-     break;
-     case EVENTLOG_ID_LB_CREATE_EVENT:
-     eventLength = 8;
-     break;
-     case EVENTLOG_ID_NO_LB_EVENT:
-     eventLength = 8;
-     break;
-     case EVENTLOG_ID_GPS_UPDATE_EVENT:
-     eventLength = 16;
-     break;
-     case EVENTLOG_ID_LP_KEEPALIVE_EVENT:
-     eventLength = 8;
-     break;
-     case EVENTLOG_ID_SITE_UPDATE_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_IMEI_UPDATE_EVENT:
-     eventLength = 23;
-     break;
-     case EVENTLOG_ID_CELL_RSSI_EVENT:
-     eventLength = 10;
-     break;
-     case EVENTLOG_ID_ERROR_STATUS_EVENT:
-     eventLength = 10;
-     break;
-     case EVENTLOG_ID_LEAVE_GROUP_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_JOIN_GROUP_EVENT:
-     eventLength = 91;
-     break;
-     case EVENTLOG_ID_MAN_DOWN_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_MANDOWN_CLEAR_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_USER_UPDATE_EVENT:
-     eventLength = 40;
-     break;
-     case EVENTLOG_ID_PANIC_ALARM_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_PANIC_CLEAR_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_SENSOR_UPDATE_EVENT:
-     eventLength = 59;
-     break;
-     case EVENTLOG_ID_PUMP_ERROR_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_PUMP_READY_EVENT:
-     eventLength = 24;
-     break;
-     case EVENTLOG_ID_HIGH_ALARM_EVENT:
-     eventLength = 59;
-     break;
-     case EVENTLOG_ID_LOW_ALARM_EVENT:
-     eventLength = 59;
-     break;
-     case EVENTLOG_ID_STEL_ALARM_EVENT:
-     eventLength = 59;
-     break;
-     case EVENTLOG_ID_TWA_ALARM_EVENT :
-     eventLength = 59;
-     break;
-     case EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT:
-     eventLength = 59;
-     break;
-   default:
-     break;
-   }
-   //Return the length
-   return eventLength;
+   //For the descriptor of the event
+   const EVENT_DESCRIPTOR_STRUCT *eventDescriptor = GetEventDescriptor((EVENTLOG_ID_ENUM) compressedEvent[EVENT_ID_OFFSET]);
+   //For indexing the event and the compressed event
+   unsigned char eventIndex = EVENT_HEADER_LENGTH;
+   unsigned char compressedIndex = COMPRESSED_HEADER_LENGTH;
+   unsigned char fieldIndex = 0u;
+   //For the CRC of the event
+   unsigned short eventCRC = 0u;
+   //To check if the event is valid
+   bool isValid = true;
+   //Rebuild the event ID, the time stamp and the event length
+   memset(cursor->event, 0x00, ONE_EVENT_SIZE);
+   cursor->event[EVENT_ID_OFFSET] = compressedEvent[EVENT_ID_OFFSET];
+   SetEventTime(cursor->event, cursor->baseSeconds +
+                (((unsigned int) compressedEvent[COMPRESSED_DELTA_OFFSET] << 8) | compressedEvent[COMPRESSED_DELTA_OFFSET + 1]));
+   cursor->event[EVENT_LENGTH_OFFSET] = eventDescriptor->eventLength;
+   //Read the device ID and the names from the dictionary
+   while ( (isValid == true) && (fieldIndex < DICTIONARY_FIELDS) )
+   {
+      if ( (eventDescriptor->eventFields & dictionaryFieldTable[fieldIndex]) != 0u )
+      {
+         isValid = ( compressedEvent[compressedIndex] < cursor->dictionaryEntries );
+         if ( isValid == true )
+         {
+            DataFlashReadBytes((unsigned short) cursor->subsector, GetDictionaryAddress(compressedEvent[compressedIndex]),\
+               &cursor->event[eventIndex], DICTIONARY_ENTRY_LENGTH);
+         }
+         else
+         {
+            //Do nothing
+         }
+         eventIndex = eventIndex + DICTIONARY_ENTRY_LENGTH;
+         compressedIndex++;
+      }
+      else
+      {
+         //Do nothing
+      }
+      fieldIndex++;
+   }
+   //Copy the remaining data
+   if ( (isValid == true) && (compressedEvent[COMPRESSED_LENGTH_OFFSET] > compressedIndex) )
+   {
+      isValid = ( (eventIndex + compressedEvent[COMPRESSED_LENGTH_OFFSET] - compressedIndex) <= EVENT_SEQUENCE_OFFSET );
+      if ( isValid == true )
+      {
+         memcpy(&cursor->event[eventIndex], &compressedEvent[compressedIndex], compressedEvent[COMPRESSED_LENGTH_OFFSET] - compressedIndex);
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Save the sequence number and the CRC as in the RAM ring
+   memcpy(&cursor->event[EVENT_SEQUENCE_OFFSET], &compressedEvent[compressedEvent[COMPRESSED_LENGTH_OFFSET]], 4u);
+   eventCRC = GetEventCRC(cursor->event, EVENT_CRC_OFFSET);
+   cursor->event[EVENT_CRC_OFFSET] = (unsigned char) (eventCRC >> 8);
+   cursor->event[EVENT_CRC_OFFSET + 1] = (unsigned char) eventCRC;
+   return isValid;
 }
 //------------------------------------------------------------------------------
 //  CommitBufferToDataflash(void)
@@ -200,34 +2087,34 @@ static unsigned char GetEventLength(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/16
 //
-//!  This function commits the RAM buffer to dataflash 
+//!  This function packs the incomplete flush page and commits the open
+//!  subsector to dataflash, the caller must hold the consumer gate
 //
 //------------------------------------------------------------------------------
 void CommitBufferToDataflash(void)
 {
-   //For indexing the loop
-   unsigned short loopIndex = 0;
-   //To check if the EEPROM write is correct
-   bool isWriteCorrect = false;
-   //Write data to dataflash
-   DataFlashCommitBuffer(eventLogWriteArray,subsectorNumber);
-   //Next subsector to be written in
-   subsectorNumber = subsectorNumber + 1;
-   //Check the range
-   if ( subsectorNumber > LAST_EVENTLOG_SUBSECTOR )
+   //Check if the page holds any event
+   if ( pagePublishedSlots[flushPage] != 0u )
+   {
+      PackPage(flushPage, pagePublishedSlots[flushPage]);
+      //Now Reset the page
+      memset(eventLogWriteArray[flushPage], 0xFF, EVENT_LOG_WRITE_ARRAY_LENGTH);
+      pagePublishedSlots[flushPage] = 0u;
+   }
+   else
+   {
+      //Do nothing
+   }
+   //Write the open subsector to dataflash, the events after the restart
+   //start the next one
+   if ( packedEvents != 0u )
    {
-      subsectorNumber = FIRST_EVENTLOG_SUBSECTOR;
+      CommitPackedSubsector(false);
    }
-   //Write in EEPROM
-   isWriteCorrect = TM4CEEPROMWriteData(&subsectorNumber,(unsigned char) SUBSECTOR_BLOCK_INTERNAL_EEPROM, (unsigned char) SUBSECTOR_WORD_INTERNAL_EEPROM, (unsigned char) 1 );
-   //Now Reset the write array
-   while( loopIndex < EVENT_LOG_WRITE_ARRAY_LENGTH )
+   else
    {
-       eventLogWriteArray[loopIndex] = 0xFF;
-       loopIndex++;
+      //Do nothing
    }
-   //Reset the index
-   ramArrayIndex = 0u;
 }
 //------------------------------------------------------------------------------
 //  CopyDataToBuffer(void)
@@ -235,22 +2122,67 @@ void CommitBufferToDataflash(void)
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/19
 //
-//!  This function copies data from incomplete sub-sector to RAM
+//!  This function copies data from incomplete sub-sector to RAM. The events
+//!  are copied up to the first one which is not valid
 //
 //------------------------------------------------------------------------------
 void CopyDataToBuffer()
 {
-   //For Getting the number of events
-   unsigned int numberOfEventsSaved = 0u;
-   //Get the number of events saved in the sub-sector
-   numberOfEventsSaved = eventCount%32;
+   //For the header of the sub-sector
+   SUBSECTOR_HEADER_STRUCT header;
+   //For the address and the length of an event
+   unsigned short eventAddress = PACKED_HEADER_LENGTH;
+   unsigned short eventLength = 0u;
+   //For the start of the dictionary
+   unsigned short dictionaryAddress = 0u;
+   //For the time stamp of an event
+   unsigned char eventHeader[EVENT_HEADER_LENGTH];
+   //To check if the event is valid
+   bool isValid = false;
    //Read the data from the given sub-sector
    DataFlashReadSector(subsectorNumber,eventLogReadArray);
-   //Copy the data to the RAM Array
-   for( ramArrayIndex = 0; ramArrayIndex < (numberOfEventsSaved*128); ramArrayIndex++ )
+   isValid = ( (ParseSubsectorHeader(eventLogReadArray, &header) == true) && (header.formatVersion == COMPRESSED_FORMAT_VERSION) );
+   packedFirstSequence = header.firstSequence;
+   packedBaseSeconds = header.baseSeconds;
+   dictionaryAddress = EVENT_LOG_WRITE_ARRAY_LENGTH - (header.dictionaryEntries * DICTIONARY_ENTRY_LENGTH);
+   while ( (isValid == true) && (packedEvents < header.numberOfEvents) &&
+           ((eventAddress + COMPRESSED_HEADER_LENGTH) <= dictionaryAddress) )
+   {
+      eventLength = GetSavedLength(&eventLogReadArray[eventAddress], COMPRESSED_FORMAT_VERSION);
+      isValid = ( ((eventAddress + eventLength) <= dictionaryAddress) &&
+                  (IsEventValid(&eventLogReadArray[eventAddress], COMPRESSED_FORMAT_VERSION, packedFirstSequence + packedEvents) == true) );
+      if ( isValid == true )
+      {
+         SetEventTime(eventHeader, packedBaseSeconds + (((unsigned int) eventLogReadArray[eventAddress + COMPRESSED_DELTA_OFFSET] << 8) |
+                      eventLogReadArray[eventAddress + COMPRESSED_DELTA_OFFSET + 1]));
+         if ( packedEvents == 0u )
+         {
+            packedFirstTime = GetEventTimeKey(eventHeader);
+         }
+         else
+         {
+            //Do nothing
+         }
+         packedLastTime = GetEventTimeKey(eventHeader);
+         eventAddress = eventAddress + eventLength;
+         packedEvents++;
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   //Copy the data and the dictionary to the packed subsector
+   memcpy(&packedArray[PACKED_HEADER_LENGTH], &eventLogReadArray[PACKED_HEADER_LENGTH], eventAddress - PACKED_HEADER_LENGTH);
+   packedLength = eventAddress;
+   if ( header.formatVersion == COMPRESSED_FORMAT_VERSION )
+   {
+      packedDictionaryEntries = header.dictionaryEntries;
+      memcpy(&packedArray[dictionaryAddress], &eventLogReadArray[dictionaryAddress], EVENT_LOG_WRITE_ARRAY_LENGTH - dictionaryAddress);
+   }
+   else
    {
-      //Copy data to RAM buffer
-      eventLogWriteArray[ramArrayIndex] = eventLogReadArray[ramArrayIndex];
+      //Do nothing
    }
 }
 //==============================================================================
@@ -269,10 +2201,80 @@ void EventLogInit()
 {
    //To check if the EEPROM read is correct
    bool isReadCorrect = false;
+   //For the event counter saved in the EEPROM
+   unsigned int savedEventCount = 0u;
+   //For the last written subsector found in the dataflash
+   unsigned int headSubsector = 0u;
+   SUBSECTOR_HEADER_STRUCT headHeader;
+   //For the first sequence number indexed for the subsector to be written
+   unsigned int indexedSequence = 0u;
+   //For indexing the loop
+   unsigned char pageIndex = 0u;
+   //For the subsectors checked for erased ones
+   unsigned int eraseSubsector = 0u;
+   //For the parameters of the commit semaphore
+   Semaphore_Params semaphoreParams;
    //Check if the event log has not been initialized yet
    if ( isEventLogInit == false )
    {
-      isReadCorrect = TM4CEEPROMReadData( &subsectorNumber, (unsigned char) SUBSECTOR_BLOCK_INTERNAL_EEPROM, (unsigned char) SUBSECTOR_WORD_INTERNAL_EEPROM, (unsigned char) 1 );
+      //Create the consumer gate on the first initialization only
+      if ( consumerGateHandle == NULL )
+      {
+         consumerGateHandle = GateMutex_create(NULL, NULL);
+         Semaphore_Params_init(&semaphoreParams);
+         semaphoreParams.mode = Semaphore_Mode_BINARY;
+         commitSemaphoreHandle = Semaphore_create(0, &semaphoreParams, NULL);
+      }
+      else
+      {
+         //Do nothing
+      }
+      //Start with an empty ring of erased RAM pages
+      memset(eventLogWriteArray, 0xFF, sizeof(eventLogWriteArray));
+      while ( pageIndex < EVENT_LOG_RAM_PAGES )
+      {
+         pagePublishedSlots[pageIndex] = 0u;
+         pageIndex++;
+      }
+      reservedSlots = 0u;
+      releasedSlots = 0u;
+      flushPage = 0u;
+      ResetPackedSubsector();
+      //The erased subsectors are found again once the head is known, after
+      //the erase ahead queued before a shut down
+      if ( isEraseAheadPending == true )
+      {
+         DataFlashQueueWait(&eraseAheadRequest);
+         isEraseAheadPending = false;
+      }
+      else
+      {
+         //Do nothing
+      }
+      isHeadErased = false;
+      erasedAheadCount = 0u;
+      //The dataflash of an older layout is moved first
+      CheckLayout();
+      //The journal holds the head of every commit, the words of block 0 are
+      //read when it is still empty after an update of the firmware
+      EventLogJournalInit();
+      if ( EventLogJournalGetLatest(&subsectorNumber, &savedEventCount) == true )
+      {
+         isReadCorrect = true;
+      }
+      else
+      {
+         isReadCorrect = TM4CEEPROMReadData( &subsectorNumber, (unsigned char) SUBSECTOR_BLOCK_INTERNAL_EEPROM, (unsigned char) SUBSECTOR_WORD_INTERNAL_EEPROM, (unsigned char) 1 );
+         if ( isReadCorrect == true )
+         {
+            //Now read the event counter
+            isReadCorrect = TM4CEEPROMReadData(&savedEventCount, (unsigned char) EVENT_COUNT_BLOCK_INTERNAL_EEPROM, (unsigned char) EVENT_COUNT_WORD_INTERNAL_EEPROM, (unsigned char) 1 );
+         }
+         else
+         {
+            //Do nothing
+         }
+      }
       //If there is no error 
       if ( isReadCorrect == true )
       {
@@ -284,46 +2286,90 @@ void EventLogInit()
          {
             //Do nothig
          }
+         //An EEPROM never written holds no event count, the erased word would be
+         //the sequence number of an empty index entry
+         if ( savedEventCount == ERASED_EEPROM_WORD )
+         {
+            savedEventCount = 0u;
+         }
+         else
+         {
+            //Do nothing
+         }
+         eventCount = savedEventCount;
       }
       else
       {
          //Initialize with default value
          subsectorNumber = FIRST_EVENTLOG_SUBSECTOR;
+         eventCount = 0u;
       }
-      //Now read the event counter
-      isReadCorrect = TM4CEEPROMReadData(&eventCount, (unsigned char) EVENT_COUNT_BLOCK_INTERNAL_EEPROM, (unsigned char) EVENT_COUNT_WORD_INTERNAL_EEPROM, (unsigned char) 1 );
-      //If there is no error 
-      if ( isReadCorrect == true )
+      //The events in the dataflash are trusted over the journal, a power loss
+      //can cut a commit before its entry. The journal is used for a log
+      //without sequence numbers only
+      if ( RecoverHead(&headSubsector, &headHeader) == true )
       {
-        //Do nothing TODO: Maximum value check
+         subsectorNumber = headSubsector;
+         //Copy the data of a compressed subsector to the packed subsector in
+         //RAM, a commit cut by a power loss keeps fewer events than its header
+         if ( headHeader.formatVersion == COMPRESSED_FORMAT_VERSION )
+         {
+            CopyDataToBuffer();
+            eventCount = headHeader.firstSequence + packedEvents;
+         }
+         else
+         {
+            eventCount = headHeader.firstSequence + headHeader.numberOfEvents;
+         }
+         //Events are added to the next subsector, the open subsector of the
+         //shut down and a cut one are not erased to be written again
+         subsectorNumber = GetNextSubsector(headSubsector);
       }
       else
       {
-         //Initialize with default value
-         eventCount = 0u;
+         //Do nothing
       }
-      //If complete sub-sector of the event log was written then we don't need it in 
-      //our RAM
-      if( (eventCount%32) == 0 )
+      //Load the index of the subsectors written before
+      EventLogIndexInit(GetPreviousSubsector(subsectorNumber));
+      //The events kept by a cut commit are indexed now, as are the ones of an
+      //open subsector written by an older firmware
+      if ( (packedEvents != 0u) && ((EventLogIndexGetFirstSequence(headSubsector, &indexedSequence) == false) ||
+                                   (indexedSequence != packedFirstSequence)) )
       {
-         //Reset the index
-         ramArrayIndex = 0u;     
+         EventLogIndexUpdate(headSubsector, packedFirstSequence, packedFirstTime, packedLastTime, packedEvents, true);
       }
       else
       {
-         //Decrement in Sub-sector number as  data will be written to previous sub-sector
-         if ( subsectorNumber != FIRST_EVENTLOG_SUBSECTOR )
-         {
-            subsectorNumber = subsectorNumber - 1;
-         }
-         else
-         {
-            //Do nothing
-         }
-         //Copy the incomplete subsector data to RAM buffer
-         CopyDataToBuffer();
+         //Do nothing
+      }
+      ResetPackedSubsector();
+      //A commit cut by a power loss may have erased the subsector to be
+      //written, its events are not indexed any more
+      if ( (EventLogIndexGetFirstSequence(subsectorNumber, &indexedSequence) == true) &&
+           ((ReadSubsectorHeader(subsectorNumber, &headHeader) == false) || (headHeader.firstSequence != indexedSequence)) )
+      {
+         EventLogIndexUpdate(subsectorNumber, EVENTLOG_INDEX_INVALID, 0u, 0u, 0u, false);
+      }
+      else
+      {
+         //Do nothing
+      }
+      //Find the subsectors erased before the restart, so that they are only
+      //programmed, the subsector to be filled first
+      isHeadErased = IsSubsectorErased(subsectorNumber);
+      eraseSubsector = GetNextSubsector(subsectorNumber);
+      while ( (erasedAheadCount < ERASE_AHEAD_MAX_SUBSECTORS) && (eraseSubsector != subsectorNumber) &&
+              (IsSubsectorErased(eraseSubsector) == true) )
+      {
+         erasedAheadCount++;
+         eraseSubsector = GetNextSubsector(eraseSubsector);
       }
+      //The ring is empty, every event counted so far is in the dataflash
+      ringBaseSequence = eventCount;
+      committedSequence = eventCount;
       isEventLogInit = true;
+      //The writers may reserve slots
+      writerState = 0u;
     }
     else
     {
@@ -339,97 +2385,12 @@ void EventLogInit()
 //!  This function writes instrument lost event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteInstrumentLostEvent( 
+void EventLogWriteInstrumentLostEvent(
                                         unsigned short peerNumber               //!< Peer Number
-                                     )
+                                      )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_INST_LOST_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_INST_LOST_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-    //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_INST_LOST_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteLeaveGroupEvent( unsigned short peerNumber )
@@ -440,97 +2401,12 @@ void EventLogWriteInstrumentLostEvent(
 //!  This function writes leave group event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteLeaveGroupEvent( 
-                                     unsigned short peerNumber                  //!< Peer Number
-                                 )
+void EventLogWriteLeaveGroupEvent(
+                                    unsigned short peerNumber                   //!< Peer Number
+                                  )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_LEAVE_GROUP_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_LEAVE_GROUP_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_LEAVE_GROUP_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteManDownEvent( unsigned short peerNumber )
@@ -541,97 +2417,12 @@ void EventLogWriteLeaveGroupEvent(
 //!  This function writes man down event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteManDownEvent( 
-                                  unsigned short peerNumber                     //!< Peer Number
-                              )
+void EventLogWriteManDownEvent(
+                                 unsigned short peerNumber                      //!< Peer Number
+                               )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_MAN_DOWN_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_MAN_DOWN_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_MAN_DOWN_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteManDownClearEvent( unsigned short peerNumber )
@@ -642,97 +2433,12 @@ void EventLogWriteManDownEvent(
 //!  This function writes man down clear event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteManDownClearEvent( 
+void EventLogWriteManDownClearEvent(
                                       unsigned short peerNumber                 //!< Peer Number
-                                   )
+                                    )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_MANDOWN_CLEAR_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_MANDOWN_CLEAR_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_MANDOWN_CLEAR_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWritePanicEvent( unsigned short peerNumber )
@@ -743,97 +2449,12 @@ void EventLogWriteManDownClearEvent(
 //!  This function writes panic event
 //
 //------------------------------------------------------------------------------
-void EventLogWritePanicEvent( 
-                                unsigned short peerNumber                       //!< Peer Number
-                            )
+void EventLogWritePanicEvent(
+                               unsigned short peerNumber                        //!< Peer Number
+                             )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_PANIC_ALARM_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_PANIC_ALARM_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_PANIC_ALARM_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWritePanicClearEvent( unsigned short peerNumber )
@@ -844,97 +2465,12 @@ void EventLogWritePanicEvent(
 //!  This function writes panic clear event
 //
 //------------------------------------------------------------------------------
-void EventLogWritePanicClearEvent( 
-                                     unsigned short peerNumber                  //!< Peer Number
-                                 )
+void EventLogWritePanicClearEvent(
+                                    unsigned short peerNumber                   //!< Peer Number
+                                  )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_PANIC_CLEAR_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_PANIC_CLEAR_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_PANIC_CLEAR_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWritePumpEvent( unsigned short peerNumber )
@@ -945,97 +2481,12 @@ void EventLogWritePanicClearEvent(
 //!  This function writes pump alarm event
 //
 //------------------------------------------------------------------------------
-void EventLogWritePumpEvent( 
-                               unsigned short peerNumber                        //!< Peer Number
-                           )
-{
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_PUMP_ERROR_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_PUMP_ERROR_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+void EventLogWritePumpEvent(
+                              unsigned short peerNumber                         //!< Peer Number
+                            )
+{
+   //Write the event
+   WriteEvent(EVENTLOG_ID_PUMP_ERROR_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWritePumpClearEvent( unsigned short peerNumber )
@@ -1046,97 +2497,12 @@ void EventLogWritePumpEvent(
 //!  This function writes pump alarm clear event
 //
 //------------------------------------------------------------------------------
-void EventLogWritePumpClearEvent( 
+void EventLogWritePumpClearEvent(
                                    unsigned short peerNumber                    //!< Peer Number
-                                )
+                                 )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_PUMP_READY_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_PUMP_READY_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_PUMP_READY_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteGasAlarmEvent( EVENTLOG_ID_ENUM eventID, unsigned short peerNumber )
@@ -1147,133 +2513,13 @@ void EventLogWritePumpClearEvent(
 //!  This function writes gas alarm event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteGasAlarmEvent( 
+void EventLogWriteGasAlarmEvent(
                                   EVENTLOG_ID_ENUM eventID,                     //!< event ID
                                   unsigned short peerNumber                     //!< Peer Number
-                               )
+                                )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //For Sensor Information (TODO: this is temp. and will be replaced with the actual data afterwards
-   SENSOR_STATUS_STRUCT sensorStaus[TOTAL_NUMBER_OF_SENSORS];
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) eventID;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(eventID);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the sensor information
-   while ( dataLength < TOTAL_NUMBER_OF_SENSORS )
-   {
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorType; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorUnits; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].senorStatusAndDecimal; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[0]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[1]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in datalength
-      dataLength = dataLength + 1;
-   }    
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(eventID, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteGasAlarmClearEvent(unsigned short peerNumber )
@@ -1284,132 +2530,12 @@ void EventLogWriteGasAlarmEvent(
 //!  This function writes pump alarm clear event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteGasAlarmClearEvent( 
+void EventLogWriteGasAlarmClearEvent(
                                        unsigned short peerNumber                //!< Peer Number
-                                    )
+                                     )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //For Sensor Information (TODO: this is temp. and will be replaced with the actual data afterwards
-   SENSOR_STATUS_STRUCT sensorStaus[TOTAL_NUMBER_OF_SENSORS];
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the sensor information
-   while ( dataLength < TOTAL_NUMBER_OF_SENSORS )
-   {
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorType; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorUnits; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].senorStatusAndDecimal; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[0]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[1]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in datalength
-      dataLength = dataLength + 1;
-   }    
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteInstrumentJoinEvent(unsigned short peerNumber )
@@ -1420,158 +2546,12 @@ void EventLogWriteGasAlarmClearEvent(
 //!  This function writes instrument join event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteInstrumentJoinEvent( 
-                                        unsigned short peerNumber                //!< Peer Number
-                                     )
+void EventLogWriteInstrumentJoinEvent(
+                                        unsigned short peerNumber               //!< Peer Number
+                                      )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //For Sensor Information (TODO: this is temp. and will be replaced with the actual data afterwards
-   SENSOR_STATUS_STRUCT sensorStaus[TOTAL_NUMBER_OF_SENSORS];
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_JOIN_GROUP_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_JOIN_GROUP_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the instrument user name
-   while ( dataLength < USER_SITE_NAME_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xAA; //TODO: add peer's user name here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the instrument serial number
-   while ( dataLength < USER_SITE_NAME_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xBB; //TODO: add peer's site name here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the sensor information
-   while ( dataLength < TOTAL_NUMBER_OF_SENSORS )
-   {
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorType; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorUnits; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].senorStatusAndDecimal; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[0]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[1]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in datalength
-      dataLength = dataLength + 1;
-   }    
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_JOIN_GROUP_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteUserUpdateEvent( unsigned short peerNumber )
@@ -1582,110 +2562,12 @@ void EventLogWriteInstrumentJoinEvent(
 //!  This function writes user update event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteUserUpdateEvent( 
-                                     unsigned short peerNumber                  //!< Peer Number
+void EventLogWriteUserUpdateEvent(
+                                    unsigned short peerNumber                   //!< Peer Number
                                   )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_USER_UPDATE_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_USER_UPDATE_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the instrument user name
-   while ( dataLength < USER_SITE_NAME_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xAA; //TODO: add peer's user name here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_USER_UPDATE_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteSensorUpdateEvent(unsigned short peerNumber )
@@ -1696,132 +2578,12 @@ void EventLogWriteUserUpdateEvent(
 //!  This function writes sensor update event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteSensorUpdateEvent( 
-                                       unsigned short peerNumber                //!< Peer Number
+void EventLogWriteSensorUpdateEvent(
+                                      unsigned short peerNumber                 //!< Peer Number
                                     )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //For Sensor Information (TODO: this is temp. and will be replaced with the actual data afterwards
-   SENSOR_STATUS_STRUCT sensorStaus[TOTAL_NUMBER_OF_SENSORS];
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_SENSOR_UPDATE_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_SENSOR_UPDATE_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument serial number
-   while ( dataLength < DEVICE_ID_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = eventLength; //TODO: add peer's SN here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Reset the datalength
-   dataLength = 0;
-   //Save the sensor information
-   while ( dataLength < TOTAL_NUMBER_OF_SENSORS )
-   {
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorType; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorUnits; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].senorStatusAndDecimal; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[0]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      eventLogWriteArray[ramArrayIndex] = sensorStaus[dataLength].sensorReading[1]; //TODO: add peer's sensor information here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in datalength
-      dataLength = dataLength + 1;
-   }    
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_SENSOR_UPDATE_EVENT, peerNumber, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteLPStatusEvent( EVENTLOG_ID_ENUM eventID )
@@ -1832,84 +2594,12 @@ void EventLogWriteSensorUpdateEvent(
 //!  This function writes LP online/offline/keep alive events lost event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteLPStatusEvent( 
-                                   EVENTLOG_ID_ENUM eventID                     //!< Event ID
-                               )
+void EventLogWriteLPStatusEvent(
+                                  EVENTLOG_ID_ENUM eventID                      //!< Event ID
+                                )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) eventID;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(eventID);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(eventID, 0u, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteLPBatteryEvent( EVENTLOG_ID_ENUM eventID )
@@ -1920,84 +2610,12 @@ void EventLogWriteLPStatusEvent(
 //!  This function writes LP battery create/clear event
 //
 //------------------------------------------------------------------------------
-void EventLogWriteLPBatteryEvent( 
-                                    EVENTLOG_ID_ENUM eventID                    //!< Event ID
-                                )
+void EventLogWriteLPBatteryEvent(
+                                   EVENTLOG_ID_ENUM eventID                     //!< Event ID
+                                 )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) eventID;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(eventID);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(eventID, 0u, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteLPSiteUpdateEvent(void)
@@ -2010,93 +2628,8 @@ void EventLogWriteLPBatteryEvent(
 //------------------------------------------------------------------------------
 void EventLogWriteLPSiteUpdateEvent(void)
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_SITE_UPDATE_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_SITE_UPDATE_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument site name
-   while ( dataLength < USER_SITE_NAME_LENGTH )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xBB; //TODO: add LP's site name here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_SITE_UPDATE_EVENT, 0u, NULL);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteLPSGPSEvent(unsigned char *GPSByte)
@@ -2108,96 +2641,11 @@ void EventLogWriteLPSiteUpdateEvent(void)
 //
 //------------------------------------------------------------------------------
 void EventLogWriteLPSGPSEvent(
-                                unsigned char *GPSByte                          //!< GPS Data                           
-                             )
+                                unsigned char *GPSByte                          //!< GPS Data
+                              )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_GPS_UPDATE_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_GPS_UPDATE_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument GPS Data
-   while ( dataLength < 8 )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xDD; //TODO: add LP's GPS Bytes here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_GPS_UPDATE_EVENT, 0u, GPSByte);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteIMEIUpdateEvent(unsigned char *IMEIInfo)
@@ -2209,96 +2657,11 @@ void EventLogWriteLPSGPSEvent(
 //
 //------------------------------------------------------------------------------
 void EventLogWriteIMEIUpdateEvent(
-                                    unsigned char *IMEIInfo                     //!< IMEI Infor                         
-                                 )
+                                    unsigned char *IMEIInfo                     //!< IMEI Infor
+                                  )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_IMEI_UPDATE_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_IMEI_UPDATE_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument GPS Data
-   while ( dataLength < 15 )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xCC; //TODO: add LP's IMEI Bytes here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //Write the event
+   WriteEvent(EVENTLOG_ID_IMEI_UPDATE_EVENT, 0u, IMEIInfo);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteRSSIUpdateEvent(unsigned short RSSI)
@@ -2310,96 +2673,15 @@ void EventLogWriteIMEIUpdateEvent(
 //
 //------------------------------------------------------------------------------
 void EventLogWriteRSSIUpdateEvent(
-                                    unsigned short RSSI                         //!< IMEI Infor                         
-                                 )
+                                    unsigned short RSSI                         //!< RSSI
+                                  )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_CELL_RSSI_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_CELL_RSSI_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument GPS Data
-   while ( dataLength < 2 )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xEE; //TODO: add LP's RSSI Bytes here
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //For the RSSI bytes, high byte first
+   unsigned char rssiBytes[RSSI_DATA_LENGTH];
+   rssiBytes[0] = (unsigned char) (RSSI >> 8);
+   rssiBytes[1] = (unsigned char) RSSI;
+   //Write the event
+   WriteEvent(EVENTLOG_ID_CELL_RSSI_EVENT, 0u, rssiBytes);
 }
 //------------------------------------------------------------------------------
 //   EventLogWriteErrorStatusEvent(unsigned short currentError)
@@ -2407,100 +2689,38 @@ void EventLogWriteRSSIUpdateEvent(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/14
 //
-//!  This function writes LP RSSI Update event
+//!  This function writes LP error status event
 //
 //------------------------------------------------------------------------------
 void EventLogWriteErrorStatusEvent(
-                                     unsigned short currentError                //!< current error                         
-                                  )
+                                     unsigned short currentError                //!< current error
+                                   )
 {
-   //For indexing the loop
-   unsigned char loopIndex = 0;
-   //For event length
-   unsigned char eventLength = 0u;
-   //For checking the data length
-   unsigned char dataLength = 0u;
-   //Date/time structure
-   DATE_TIME_STRUCT currentDateTime;
-   // Get the Updated real time
-   RTCGetCurrentDateTime(&currentDateTime);
-   //Save the event Index byte
-   eventLogWriteArray[ramArrayIndex] = (unsigned char) EVENTLOG_ID_ERROR_STATUS_EVENT;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current month
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.monthId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current day
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.dayId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current year
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.yearId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current hour
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.hourId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current minutes
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.minId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the current seconds
-   eventLogWriteArray[ramArrayIndex] = currentDateTime.secondId;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Get the event length
-   eventLength = GetEventLength(EVENTLOG_ID_ERROR_STATUS_EVENT);
-   //Save the event length
-   eventLogWriteArray[ramArrayIndex] = eventLength;
-   //Increment in arrayIndex
-   ramArrayIndex = ramArrayIndex + 1;
-   //Increment in loopIndex
-   loopIndex = loopIndex + 1;
-   //Save the instrument GPS Data
-   while ( dataLength < 2 )
-   {
-      eventLogWriteArray[ramArrayIndex] = 0xBC; //TODO: add LP's current error
-      //Increment in arrayIndex
-      ramArrayIndex = ramArrayIndex + 1;
-      //Increment in loopIndex
-      loopIndex = loopIndex + 1;
-      //Increment in data length index
-      dataLength = dataLength+1;
-   }
-   //Fill the reminder of the event with zeroes
-   while( loopIndex < ONE_EVENT_SIZE )
-   {
-       eventLogWriteArray[ramArrayIndex] = 0x00;
-       //Increment in arrayIndex
-       ramArrayIndex = ramArrayIndex + 1;
-       //Increment in loopIndex
-       loopIndex = loopIndex + 1;
-   }
-   //increment in event log counter
-    eventCount++;
-   //Check if the array has reached its limits
-   if ( ramArrayIndex >=  EVENT_LOG_WRITE_ARRAY_LENGTH )
-   {
-      CommitBufferToDataflash();
-   }   
+   //For the error bytes, high byte first
+   unsigned char errorBytes[ERROR_DATA_LENGTH];
+   errorBytes[0] = (unsigned char) (currentError >> 8);
+   errorBytes[1] = (unsigned char) currentError;
+   //Write the event
+   WriteEvent(EVENTLOG_ID_ERROR_STATUS_EVENT, 0u, errorBytes);
+}
+//------------------------------------------------------------------------------
+//   EventLogWriteBatch(const EVENTLOG_ID_ENUM *eventIDs, const unsigned short *peerNumbers, unsigned short numberOfEvents)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a burst of events, e.g. the join and sensor update
+//!  events of a group of peers, with one time stamp
+//
+//------------------------------------------------------------------------------
+void EventLogWriteBatch(
+                          const EVENTLOG_ID_ENUM *eventIDs,                     //!< Event IDs
+                          const unsigned short *peerNumbers,                    //!< Peer number of every event, NULL if none
+                          unsigned short numberOfEvents                         //!< Number of events
+                       )
+{
+   //Write the events
+   WriteEvents(eventIDs, peerNumbers, NULL, numberOfEvents);
 }
 //------------------------------------------------------------------------------
 //   EventLogGetNumberOfEvents(void)
@@ -2517,6 +2737,324 @@ unsigned int EventLogGetNumberOfEvents(void)
    return eventCount;
 }
 //------------------------------------------------------------------------------
+//   EventLogFindSequence(unsigned int sequenceNumber, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector holding the event with the
+//!  given sequence number, or the last subsector before it
+//
+//------------------------------------------------------------------------------
+bool EventLogFindSequence(
+                            unsigned int sequenceNumber,                        //!< Sequence number of the event
+                            unsigned int *subsector                             //!< Subsector found
+                         )
+{
+   //For the gate key
+   IArg gateKey;
+   //To check if the subsector has been found
+   bool isFound = false;
+   //Check if the event log has been initialized
+   if ( consumerGateHandle != NULL )
+   {
+      //The index must not change while it is searched
+      gateKey = GateMutex_enter(consumerGateHandle);
+      //The subsector to be written next holds the oldest events
+      isFound = EventLogIndexFindSequence(subsectorNumber, sequenceNumber, subsector);
+      GateMutex_leave(consumerGateHandle, gateKey);
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   EventLogFindTime(DATE_TIME_STRUCT *dateTime, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector holding the first events
+//!  written at the given time, or the last subsector before it
+//
+//------------------------------------------------------------------------------
+bool EventLogFindTime(
+                        DATE_TIME_STRUCT *dateTime,                             //!< Time to be found
+                        unsigned int *subsector                                 //!< Subsector found
+                     )
+{
+   //For the gate key
+   IArg gateKey;
+   //To check if the subsector has been found
+   bool isFound = false;
+   //For the time key
+   unsigned int timeKey = 0u;
+   //Check if the event log has been initialized
+   if ( consumerGateHandle != NULL )
+   {
+      timeKey = GetTimeKey((unsigned char) dateTime->yearId, dateTime->monthId, dateTime->dayId,
+                           dateTime->hourId, dateTime->minId, dateTime->secondId);
+      //The index must not change while it is searched
+      gateKey = GateMutex_enter(consumerGateHandle);
+      //The subsector to be written next holds the oldest events
+      isFound = EventLogIndexFindTime(subsectorNumber, timeKey, subsector);
+      GateMutex_leave(consumerGateHandle, gateKey);
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   EventLogCursorOpen(EVENT_LOG_CURSOR_STRUCT *cursor, unsigned int sequenceNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function opens a cursor on the event with the given sequence
+//!  number. Events which have been overwritten are skipped by the cursor
+//
+//------------------------------------------------------------------------------
+bool EventLogCursorOpen(
+                          EVENT_LOG_CURSOR_STRUCT *cursor,                      //!< Cursor
+                          unsigned int sequenceNumber                           //!< Sequence number of the first event
+                       )
+{
+   //The cursor is located on its first read
+   cursor->sequenceNumber = sequenceNumber;
+   cursor->subsector = FIRST_EVENTLOG_SUBSECTOR;
+   cursor->firstSequence = EVENTLOG_INDEX_INVALID;
+   cursor->endSequence = 0u;
+   cursor->eventAddress = 0u;
+   cursor->windowAddress = 0u;
+   cursor->baseSeconds = 0u;
+   cursor->formatVersion = SLOTS_FORMAT_VERSION;
+   cursor->dictionaryEntries = 0u;
+   cursor->isWindowValid = false;
+   cursor->isOpen = isEventLogInit;
+   return cursor->isOpen;
+}
+//------------------------------------------------------------------------------
+//   EventLogCursorNext(EVENT_LOG_CURSOR_STRUCT *cursor, const unsigned char **event, unsigned char *eventLength)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the next event of the cursor. The dataflash bytes
+//!  holding it are read in the window of the cursor unless they are already
+//!  there
+//
+//------------------------------------------------------------------------------
+bool EventLogCursorNext(
+                          EVENT_LOG_CURSOR_STRUCT *cursor,                      //!< Cursor
+                          const unsigned char **event,                          //!< Event in the window of the cursor
+                          unsigned char *eventLength                            //!< Length of the event
+                       )
+{
+   //For the gate key
+   IArg gateKey;
+   //For the bytes taken by the event in the subsector
+   unsigned short savedLength = 0u;
+   //For the attempts to locate the event
+   unsigned char locateAttempts = 0u;
+   //To check if an event has been read
+   bool isEventRead = false;
+   //Check if the cursor and the event log are open
+   if ( (cursor->isOpen == true) && (consumerGateHandle != NULL) )
+   {
+      //The subsector must not be written while it is read
+      gateKey = GateMutex_enter(consumerGateHandle);
+      //Only the events committed to the dataflash are read, the event is
+      //expected at the address following the previous one
+      isEventRead = ( (cursor->sequenceNumber < committedSequence) && (cursor->firstSequence != EVENTLOG_INDEX_INVALID) &&
+                      (cursor->sequenceNumber < cursor->endSequence) &&
+                      (LoadCursorEvent(cursor, cursor->sequenceNumber, &savedLength) == true) );
+      //Otherwise locate the event again, a subsector cut by a power loss may
+      //end before its last event
+      while ( (isEventRead == false) && (locateAttempts < CURSOR_LOCATE_ATTEMPTS) && (cursor->sequenceNumber < committedSequence) )
+      {
+         isEventRead = ( (LocateCursor(cursor) == true) && (cursor->sequenceNumber < committedSequence) &&
+                         (LoadCursorEvent(cursor, cursor->sequenceNumber, &savedLength) == true) );
+         locateAttempts++;
+      }
+      //A compressed event is rebuilt in the event buffer of the cursor
+      if ( (isEventRead == true) && (cursor->formatVersion == COMPRESSED_FORMAT_VERSION) )
+      {
+         isEventRead = DecompressEvent(cursor, &cursor->window[cursor->eventAddress - cursor->windowAddress]);
+         *event = cursor->event;
+      }
+      else
+      {
+         *event = &cursor->window[cursor->eventAddress - cursor->windowAddress];
+      }
+      if ( isEventRead == true )
+      {
+         *eventLength = (*event)[EVENT_LENGTH_OFFSET];
+         cursor->eventAddress = cursor->eventAddress + savedLength;
+         cursor->sequenceNumber++;
+      }
+      else
+      {
+         //Do nothing
+      }
+      GateMutex_leave(consumerGateHandle, gateKey);
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isEventRead;
+}
+//------------------------------------------------------------------------------
+//   EventLogCursorClose(EVENT_LOG_CURSOR_STRUCT *cursor)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function closes a cursor
+//
+//------------------------------------------------------------------------------
+void EventLogCursorClose(
+                           EVENT_LOG_CURSOR_STRUCT *cursor                      //!< Cursor
+                        )
+{
+   cursor->isOpen = false;
+   cursor->isWindowValid = false;
+}
+//------------------------------------------------------------------------------
+//   EventLogFlushFullPages(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function commits the RAM pages completed by the writers to the
+//!  dataflash. It is called from TaskEventLog only
+//
+//------------------------------------------------------------------------------
+void EventLogFlushFullPages(void)
+{
+   //For the gate key
+   IArg gateKey;
+   //Check if the event log has been initialized
+   if ( consumerGateHandle != NULL )
+   {
+      gateKey = GateMutex_enter(consumerGateHandle);
+      CommitFullPages();
+      GateMutex_leave(consumerGateHandle, gateKey);
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   EventLogEraseAhead(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases the next oldest subsectors of the event log while no
+//!  RAM page waits to be committed, so that the subsectors are only
+//!  programmed when they are committed. One subsector, or one whole block
+//!  starting on a block boundary, is erased per call. The subsectors after the
+//!  last one are erased only once it is being filled, as RecoverHead takes an
+//!  erased first subsector for a log written up to the last one.
+//!
+//!  The erase is queued to the dataflash task and the function returns, the
+//!  commits are carried out while it goes on. A later call counts the erased
+//!  subsectors once the erase is completed, no other erase is queued before
+//
+//------------------------------------------------------------------------------
+void EventLogEraseAhead(void)
+{
+   //For the gate key
+   IArg gateKey;
+   //For the geometry of the dataflash
+   DATAFLASH_GEOMETRY_STRUCT geometry;
+   //For the subsector to be erased
+   unsigned int eraseSubsector = 0u;
+   //For the subsectors erased at once, none if nothing is to be erased
+   unsigned int nSubsectors = 0u;
+   //For indexing the loop
+   unsigned int subsectorIndex = 0u;
+   //Check if the event log has been initialized
+   if ( isEventLogInit == true )
+   {
+      gateKey = GateMutex_enter(consumerGateHandle);
+      CollectEraseAhead(false);
+      eraseSubsector = subsectorNumber + erasedAheadCount + 1u;
+      //Erase only while no complete page waits to be committed and no erase
+      //is going on. The subsector being filled is erased first if none of its
+      //events has been written
+      if ( (pagePublishedSlots[flushPage] == EVENTS_PER_PAGE) || (isEraseAheadPending == true) )
+      {
+         //Do nothing
+      }
+      else if ( (isHeadErased == false) && (packedEvents == 0u) )
+      {
+         eraseSubsector = subsectorNumber;
+         nSubsectors = 1u;
+      }
+      else if ( (erasedAheadCount < EVENTLOG_ERASE_AHEAD_SUBSECTORS) &&
+                ((eraseSubsector <= LAST_EVENTLOG_SUBSECTOR) || (subsectorNumber == LAST_EVENTLOG_SUBSECTOR)) )
+      {
+         if ( eraseSubsector > LAST_EVENTLOG_SUBSECTOR )
+         {
+            eraseSubsector = eraseSubsector - (LAST_EVENTLOG_SUBSECTOR - FIRST_EVENTLOG_SUBSECTOR + 1u);
+         }
+         else
+         {
+            //Do nothing
+         }
+         //A whole block is erased at once if it is in the event log
+         nSubsectors = 1u;
+         DataFlashGetGeometry(&geometry);
+         if ( (geometry.isBlockEraseSupported == true) &&
+              ((eraseSubsector % DATAFLASH_SUBSECTORS_PER_BLOCK) == 0u) &&
+              ((eraseSubsector + DATAFLASH_SUBSECTORS_PER_BLOCK - 1u) <= LAST_EVENTLOG_SUBSECTOR) )
+         {
+            nSubsectors = DATAFLASH_SUBSECTORS_PER_BLOCK;
+         }
+         else
+         {
+            //Do nothing
+         }
+      }
+      else
+      {
+         //Do nothing
+      }
+      //The events of the erased subsectors cannot be read any more
+      while ( subsectorIndex < nSubsectors )
+      {
+         EventLogIndexUpdate(eraseSubsector + subsectorIndex, EVENTLOG_INDEX_INVALID, 0u, 0u, 0u, false);
+         subsectorIndex++;
+      }
+      if ( nSubsectors != 0u )
+      {
+         eraseAheadRequest.operation = DATAFLASH_REQUEST_ERASE;
+         eraseAheadRequest.subsectorNumber = (unsigned short) eraseSubsector;
+         eraseAheadRequest.nSubsectors = (unsigned short) nSubsectors;
+         eraseAheadRequest.callback = NULL;
+         eraseAheadRequest.semaphore = NULL;
+         isEraseAheadPending = true;
+         DataFlashQueueSubmit(&eraseAheadRequest);
+      }
+      else
+      {
+         //Do nothing
+      }
+      GateMutex_leave(consumerGateHandle, gateKey);
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
 //   EventLogShutDown(void)
 //
 //   Author:   Ali Zulqarnain Anjum
@@ -2527,14 +3065,33 @@ unsigned int EventLogGetNumberOfEvents(void)
 //------------------------------------------------------------------------------
 void EventLogShutDown(void)
 {
-    bool isWriteCorrect = false;
-   //Commit the available buffer to dataflash
-   CommitBufferToDataflash();
-   //Save the current event count in the EEPROM
-   isWriteCorrect = TM4CEEPROMWriteData(&eventCount,(unsigned char) EVENT_COUNT_BLOCK_INTERNAL_EEPROM, (unsigned char) EVENT_COUNT_WORD_INTERNAL_EEPROM, (unsigned char) 1 );
-   
-   isEventLogInit = false;
-   
+   //For the gate key
+   IArg gateKey;
+   //Check if the event log has been initialized
+   if ( isEventLogInit == true )
+   {
+      //Stop accepting new events, a writer counted in the writer state has
+      //reserved slots or is reserving them
+      isEventLogInit = false;
+      AtomicAdd(&writerState, WRITER_STATE_CLOSED);
+      gateKey = GateMutex_enter(consumerGateHandle);
+      //Wait for the writers to publish the slots they have reserved
+      while ( (writerState != WRITER_STATE_CLOSED) || (GetPublishedSlots() != (reservedSlots - releasedSlots)) )
+      {
+         Task_sleep(RING_WAIT_SLEEP_TICKS);
+      }
+      //Commit the complete pages and then the incomplete one
+      CommitFullPages();
+      CommitBufferToDataflash();
+      //The commit has journaled the event count in the EEPROM, the erase
+      //ahead is finished before the dataflash is left
+      CollectEraseAhead(true);
+      GateMutex_leave(consumerGateHandle, gateKey);
+   }
+   else
+   {
+      //Do nothing
+   }
 }
 //==============================================================================
 //  End Of File
@@ -47,6 +47,9 @@
 //==============================================================================
 
 #include <stdbool.h>
+#include "ErrorLog.h"
+#include "WearLevel.h"
+#include "TM4CRTC.h"
 
 //==============================================================================
 //  GLOBAL CONSTANTS, TYPEDEFS AND MACROS 
@@ -59,10 +62,15 @@
 #define SENSOR_READING_LENGTH 2                                                 //!< Sensor reading length
 #define TIME_STAMP_LENGTH 6                                                     //!< Time Stamp Length
 #define EVENT_LOG_WRITE_ARRAY_LENGTH 4096                                       //!< Write Array Length of event log (4k as index starts from zero)
+#define EVENT_LOG_RAM_PAGES 2                                                   //!< RAM pages of the event log (one written, one committed)
 #define EVENT_LOG_READ_ARRAY_LENGTH  4096                                       //!< READ Array Length of event log
-#define RESERVED_FOR_FUTURE_USE      37                                         //!< Bytes Reserved for future use
+#define RESERVED_FOR_FUTURE_USE      31                                         //!< Bytes Reserved for future use
 #define NO_PEER_NUMBER    -1                                                    //!< Dummy for no peer number
 #define ONE_EVENT_SIZE 128                                                      //!< Size for one event
+#define EVENT_LOG_CURSOR_WINDOW_LENGTH 256                                      //!< Dataflash page buffered by a cursor
+#define FIRST_EVENTLOG_SUBSECTOR (WEARLEVEL_LAST_SUBSECTOR+1)                   //!< First event log subsector, the error log pool is before it
+#define LAST_EVENTLOG_SUBSECTOR 4063                                            //!< Last event log subsector, the event log index follows it
+#define EVENTLOG_ERASE_AHEAD_SUBSECTORS 4                                      //!< Erased subsectors kept ahead of the subsector being filled, an erase starts below it
 
 //==============================================================================
 //  GLOBAL DATA STRUCTURES DEFINITION
@@ -92,7 +100,10 @@ typedef struct
    unsigned char userName[USER_SITE_NAME_LENGTH];                               //!< User Name
    unsigned char siteName[USER_SITE_NAME_LENGTH];                               //!< site Name
    SENSOR_STATUS_STRUCT sensorStatus[TOTAL_NUMBER_OF_SENSORS];                  //!< Sensor Status
-   unsigned char spareForFuture[37];                                             //!< Reserved for future use
+   unsigned char spareForFuture[29];                                            //!< Reserved for future use
+   unsigned char sequenceNumber[4];                                             //!< Sequence number of the event (big endian)
+   unsigned char eventCRC[2];                                                   //!< CRC of the bytes before it (big endian)
+   unsigned char spareForFutureEnd[2];                                          //!< Reserved for future use
 }EVENT_LOG_ENTRY_STRUCT;
 //Enumeration for the Event IDs
 typedef enum
@@ -125,12 +136,29 @@ typedef enum
    EVENTLOG_ID_TWA_ALARM_EVENT = 25u,                                           //!< Morrison twa gas alarm event
    EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT = 26u,                                     //!< Morrison gas alarm clear event
 }EVENTLOG_ID_ENUM;
+//Structure of a reader of the event log
+typedef struct
+{
+   unsigned int sequenceNumber;                                                 //!< Sequence number of the next event
+   unsigned int subsector;                                                      //!< Subsector of the next event
+   unsigned int firstSequence;                                                  //!< Sequence number of the first event of the subsector
+   unsigned int endSequence;                                                    //!< Sequence number after the last event of the subsector
+   unsigned short eventAddress;                                                 //!< Subsector offset of the next event
+   unsigned short windowAddress;                                                //!< Subsector offset of the window
+   unsigned int baseSeconds;                                                    //!< Seconds of the first event of a compressed subsector
+   unsigned char formatVersion;                                                 //!< Format of the subsector
+   unsigned char dictionaryEntries;                                             //!< Dictionary entries of a compressed subsector
+   bool isWindowValid;                                                          //!< True if the window holds the bytes at windowAddress
+   bool isOpen;                                                                 //!< True while the cursor is open
+   unsigned char window[EVENT_LOG_CURSOR_WINDOW_LENGTH];                        //!< Dataflash bytes holding the next events
+   unsigned char event[ONE_EVENT_SIZE];                                         //!< Last event rebuilt from a compressed subsector
+}EVENT_LOG_CURSOR_STRUCT;
 //
 //==============================================================================
 //  GLOBAL DATA
 //==============================================================================
 
-extern unsigned char eventLogWriteArray[EVENT_LOG_WRITE_ARRAY_LENGTH];       //!< Array for storing the event log in the RAM
+extern unsigned char eventLogWriteArray[EVENT_LOG_RAM_PAGES][EVENT_LOG_WRITE_ARRAY_LENGTH]; //!< RAM pages for storing the event log
 extern unsigned char eventLogReadArray[EVENT_LOG_READ_ARRAY_LENGTH];            //!< Array for reading the event log
 extern unsigned int subsectorNumber;
 
@@ -387,6 +415,21 @@ void EventLogWriteErrorStatusEvent(
                                      unsigned short currentError                //!< current error                         
                                   );
 //------------------------------------------------------------------------------
+//   EventLogWriteBatch(const EVENTLOG_ID_ENUM *eventIDs, const unsigned short *peerNumbers, unsigned short numberOfEvents)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a burst of events with one time stamp, the slots of
+//!  up to one page of events are reserved at once
+//
+//------------------------------------------------------------------------------
+void EventLogWriteBatch(
+                          const EVENTLOG_ID_ENUM *eventIDs,                     //!< Event IDs
+                          const unsigned short *peerNumbers,                    //!< Peer number of every event, NULL if none
+                          unsigned short numberOfEvents                         //!< Number of events
+                       );
+//------------------------------------------------------------------------------
 //   EventLogGetNumberOfEvents(void)
 //
 //   Author:   Ali Zulqarnain Anjum
@@ -397,6 +440,105 @@ void EventLogWriteErrorStatusEvent(
 //------------------------------------------------------------------------------
 unsigned int EventLogGetNumberOfEvents(void);
 //------------------------------------------------------------------------------
+//   EventLogFindSequence(unsigned int sequenceNumber, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector holding the event with the
+//!  given sequence number (the event counter before the event was written),
+//!  or the last subsector before it. It returns false if the event is older
+//!  than the event log, newer events may still be in the RAM pages
+//
+//------------------------------------------------------------------------------
+bool EventLogFindSequence(
+                            unsigned int sequenceNumber,                        //!< Sequence number of the event
+                            unsigned int *subsector                             //!< Subsector found
+                         );
+//------------------------------------------------------------------------------
+//   EventLogFindTime(DATE_TIME_STRUCT *dateTime, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector holding the first events
+//!  written at the given time, or the last subsector before it. It returns
+//!  false if the time is older than the event log
+//
+//------------------------------------------------------------------------------
+bool EventLogFindTime(
+                        DATE_TIME_STRUCT *dateTime,                             //!< Time to be found
+                        unsigned int *subsector                                 //!< Subsector found
+                     );
+//------------------------------------------------------------------------------
+//   EventLogCursorOpen(EVENT_LOG_CURSOR_STRUCT *cursor, unsigned int sequenceNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function opens a cursor on the event with the given sequence
+//!  number. Events which have been overwritten are skipped by the cursor
+//
+//------------------------------------------------------------------------------
+bool EventLogCursorOpen(
+                          EVENT_LOG_CURSOR_STRUCT *cursor,                      //!< Cursor
+                          unsigned int sequenceNumber                           //!< Sequence number of the first event
+                       );
+//------------------------------------------------------------------------------
+//   EventLogCursorNext(EVENT_LOG_CURSOR_STRUCT *cursor, const unsigned char **event, unsigned char *eventLength)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the next event of the cursor, compressed events
+//!  are rebuilt with their device ID, names and time stamp. The event points
+//!  in the cursor and is valid until the next call. It returns false when
+//!  every event committed to the dataflash has been read
+//
+//------------------------------------------------------------------------------
+bool EventLogCursorNext(
+                          EVENT_LOG_CURSOR_STRUCT *cursor,                      //!< Cursor
+                          const unsigned char **event,                          //!< Event in the window of the cursor
+                          unsigned char *eventLength                            //!< Length of the event
+                       );
+//------------------------------------------------------------------------------
+//   EventLogCursorClose(EVENT_LOG_CURSOR_STRUCT *cursor)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function closes a cursor
+//
+//------------------------------------------------------------------------------
+void EventLogCursorClose(
+                           EVENT_LOG_CURSOR_STRUCT *cursor                      //!< Cursor
+                        );
+//------------------------------------------------------------------------------
+//   EventLogFlushFullPages(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function commits the RAM pages completed by the writers to the
+//!  dataflash. It is called from TaskEventLog only
+//
+//------------------------------------------------------------------------------
+void EventLogFlushFullPages(void);
+//------------------------------------------------------------------------------
+//   EventLogEraseAhead(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases the next oldest subsectors of the event log while no
+//!  RAM page waits to be committed, so that the subsectors are only
+//!  programmed when they are committed. A block erase started below
+//!  EVENTLOG_ERASE_AHEAD_SUBSECTORS can leave up to 19 subsectors erased
+//!  ahead. It is called from TaskEventLog only
+//
+//------------------------------------------------------------------------------
+void EventLogEraseAhead(void);
+//------------------------------------------------------------------------------
 //   EventLogShutDown(void)
 //
 //   Author:   Ali Zulqarnain Anjum
@@ -0,0 +1,529 @@
+//==============================================================================
+//
+//  EventLogIndex.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogIndex.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module keeps an index of the event log. Every event log subsector has
+//! an entry with its first sequence number, its first and last time stamps
+//! and its number of events. The entries are saved in the subsectors after
+//! the event log and the sequence number and first time stamp of every entry
+//! are kept in RAM, a reader finds the subsector of an event with a binary
+//! search instead of reading the event log.
+//!
+//! The entries are split in groups of 256, each group has two subsectors. The
+//! entries are appended to the active subsector of the group, when an entry
+//! is already programmed the other subsector is erased and becomes active
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <string.h>
+#include "EventLogIndex.h"
+#include "Dataflash.h"
+#include "CRC16.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define EVENTLOG_INDEX_CRC_LENGTH (EVENTLOG_INDEX_ENTRY_SIZE-2)                 //!< Bytes of an entry covered by its CRC
+#define ENTRIES_PER_READ (DATAFLASH_PAGE_SIZE/EVENTLOG_INDEX_ENTRY_SIZE)        //!< Entries read from the dataflash at once
+#define ERASED_BYTE 0xFFu                                                       //!< Value of an erased dataflash byte
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+//Structure of an index entry in the dataflash
+typedef struct
+{
+   unsigned int firstSequence;                                                  //!< Sequence number of the first event
+   unsigned int firstTime;                                                      //!< Time key of the first event
+   unsigned int lastTime;                                                       //!< Time key of the last event
+   unsigned short numberOfEvents;                                               //!< Events in the subsector
+   unsigned short entryCRC;                                                     //!< CRC of the entry
+}EVENTLOG_INDEX_ENTRY_STRUCT;
+//Structure of an index entry in RAM
+typedef struct
+{
+   unsigned int firstSequence;                                                  //!< Sequence number of the first event
+   unsigned int firstTime;                                                      //!< Time key of the first event
+}EVENTLOG_INDEX_RAM_STRUCT;
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static EVENTLOG_INDEX_RAM_STRUCT indexTable[EVENTLOG_INDEX_SLOTS];              //!< RAM copy of the index
+static unsigned char activeHalf[EVENTLOG_INDEX_GROUPS];                         //!< Active subsector of every group
+static EVENTLOG_INDEX_ENTRY_STRUCT entryBuffer[ENTRIES_PER_READ];               //!< Entries read from the dataflash
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static unsigned short GetEntryCRC(const EVENTLOG_INDEX_ENTRY_STRUCT *entry);
+static unsigned short GetIndexSubsector(unsigned char group, unsigned char half);
+static unsigned int GetRingSlot(unsigned int oldestSubsector, unsigned int position);
+static bool FindInRing(unsigned int oldestSubsector, unsigned int key, bool isTimeKey, unsigned int *subsector);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetEntryCRC(const EVENTLOG_INDEX_ENTRY_STRUCT *entry)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the CRC of an index entry
+//
+//------------------------------------------------------------------------------
+static unsigned short GetEntryCRC(
+                                    const EVENTLOG_INDEX_ENTRY_STRUCT *entry    //!< Index entry
+                                 )
+{
+   return CRC16Calculate((const unsigned char *) entry, EVENTLOG_INDEX_CRC_LENGTH, INITIAL_CRC_VALUE);
+}
+//------------------------------------------------------------------------------
+//   GetIndexSubsector(unsigned char group, unsigned char half)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector of a group half
+//
+//------------------------------------------------------------------------------
+static unsigned short GetIndexSubsector(
+                                          unsigned char group,                  //!< Group of entries
+                                          unsigned char half                    //!< Subsector of the group (0 or 1)
+                                       )
+{
+   return (unsigned short) (FIRST_EVENTLOG_INDEX_SUBSECTOR + (group * 2u) + half);
+}
+//------------------------------------------------------------------------------
+//   GetRingSlot(unsigned int oldestSubsector, unsigned int position)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the index slot at the given position of the ring,
+//!  position zero is the oldest subsector
+//
+//------------------------------------------------------------------------------
+static unsigned int GetRingSlot(
+                                  unsigned int oldestSubsector,                 //!< Subsector holding the oldest events
+                                  unsigned int position                         //!< Position in the ring
+                               )
+{
+   return ((oldestSubsector - FIRST_EVENTLOG_SUBSECTOR) + position) % EVENTLOG_INDEX_SLOTS;
+}
+//------------------------------------------------------------------------------
+//   FindInRing(unsigned int oldestSubsector, unsigned int key, bool isTimeKey, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function searches the last indexed subsector in ring order whose
+//!  first sequence number or first time key is not greater than the key.
+//!  Empty slots are skipped by moving forward from the middle of the range
+//
+//------------------------------------------------------------------------------
+static bool FindInRing(
+                         unsigned int oldestSubsector,                          //!< Subsector holding the oldest events
+                         unsigned int key,                                      //!< Sequence number or time key
+                         bool isTimeKey,                                        //!< True to compare the time keys
+                         unsigned int *subsector                                //!< Subsector found
+                      )
+{
+   //For the search range in ring positions
+   unsigned int lowPosition = 0u;
+   unsigned int highPosition = EVENTLOG_INDEX_SLOTS;
+   //For the middle of the range
+   unsigned int position = 0u;
+   //For the slot at a position
+   unsigned int slot = 0u;
+   //For the key of a slot
+   unsigned int slotKey = 0u;
+   //To check if a subsector has been found
+   bool isFound = false;
+   //The range is [lowPosition, highPosition)
+   while ( lowPosition < highPosition )
+   {
+      position = lowPosition + ((highPosition - lowPosition) / 2u);
+      slot = GetRingSlot(oldestSubsector, position);
+      //Move forward to the first indexed slot of the upper half
+      while ( (position < highPosition) && (indexTable[slot].firstSequence == EVENTLOG_INDEX_INVALID) )
+      {
+         position++;
+         slot = GetRingSlot(oldestSubsector, position);
+      }
+      if ( position == highPosition )
+      {
+         //No indexed slot in the upper half
+         highPosition = lowPosition + ((highPosition - lowPosition) / 2u);
+      }
+      else
+      {
+         if ( isTimeKey == true )
+         {
+            slotKey = indexTable[slot].firstTime;
+         }
+         else
+         {
+            slotKey = indexTable[slot].firstSequence;
+         }
+         if ( slotKey <= key )
+         {
+            //Candidate, look for a later one
+            *subsector = FIRST_EVENTLOG_SUBSECTOR + slot;
+            isFound = true;
+            lowPosition = position + 1u;
+         }
+         else
+         {
+            highPosition = lowPosition + ((highPosition - lowPosition) / 2u);
+         }
+      }
+   }
+   return isFound;
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   EventLogIndexInit(unsigned int newestSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function loads the index from the dataflash to RAM and drops the
+//!  entries which are older than the subsectors written before them
+//
+//------------------------------------------------------------------------------
+void EventLogIndexInit(
+                         unsigned int newestSubsector                           //!< Last event log subsector written
+                      )
+{
+   //For indexing the groups, halves and entries
+   unsigned char group = 0u;
+   unsigned char half = 0u;
+   unsigned short entryIndex = 0u;
+   unsigned char readIndex = 0u;
+   //For the slot of an entry
+   unsigned int slot = 0u;
+   //For the newest sequence number of every half of a group
+   unsigned int halfSequence[2];
+   //For the ring position and the newest sequence number before it
+   unsigned int position = 0u;
+   unsigned int newestSequence = EVENTLOG_INDEX_INVALID;
+   //Start with an empty index
+   memset(indexTable, ERASED_BYTE, sizeof(indexTable));
+   while ( group < EVENTLOG_INDEX_GROUPS )
+   {
+      half = 0u;
+      while ( half < 2u )
+      {
+         halfSequence[half] = 0u;
+         entryIndex = 0u;
+         while ( entryIndex < EVENTLOG_INDEX_ENTRIES_PER_SUBSECTOR )
+         {
+            DataFlashReadBytes(GetIndexSubsector(group, half), (unsigned short) (entryIndex * EVENTLOG_INDEX_ENTRY_SIZE),\
+               (unsigned char *) entryBuffer, (unsigned short) sizeof(entryBuffer));
+            readIndex = 0u;
+            while ( readIndex < ENTRIES_PER_READ )
+            {
+               slot = ((unsigned int) group * EVENTLOG_INDEX_ENTRIES_PER_SUBSECTOR) + entryIndex + readIndex;
+               //Keep the newest valid entry of the slot
+               if ( (slot < EVENTLOG_INDEX_SLOTS) &&
+                    (entryBuffer[readIndex].firstSequence != EVENTLOG_INDEX_INVALID) &&
+                    (entryBuffer[readIndex].entryCRC == GetEntryCRC(&entryBuffer[readIndex])) )
+               {
+                  if ( (indexTable[slot].firstSequence == EVENTLOG_INDEX_INVALID) ||
+                       (entryBuffer[readIndex].firstSequence > indexTable[slot].firstSequence) )
+                  {
+                     indexTable[slot].firstSequence = entryBuffer[readIndex].firstSequence;
+                     indexTable[slot].firstTime = entryBuffer[readIndex].firstTime;
+                  }
+                  else
+                  {
+                     //Do nothing
+                  }
+                  if ( entryBuffer[readIndex].firstSequence > halfSequence[half] )
+                  {
+                     halfSequence[half] = entryBuffer[readIndex].firstSequence;
+                  }
+                  else
+                  {
+                     //Do nothing
+                  }
+               }
+               else
+               {
+                  //Do nothing
+               }
+               readIndex++;
+            }
+            entryIndex = entryIndex + ENTRIES_PER_READ;
+         }
+         half++;
+      }
+      //The half holding the newest entry is appended to
+      if ( halfSequence[1] > halfSequence[0] )
+      {
+         activeHalf[group] = 1u;
+      }
+      else
+      {
+         activeHalf[group] = 0u;
+      }
+      group++;
+   }
+   //The sequence numbers must increase in ring order, an entry not newer than
+   //the entries before it belongs to a subsector rewritten after the entry
+   //was programmed
+   while ( position < EVENTLOG_INDEX_SLOTS )
+   {
+      slot = GetRingSlot(newestSubsector, position + 1u);
+      if ( indexTable[slot].firstSequence != EVENTLOG_INDEX_INVALID )
+      {
+         if ( (newestSequence != EVENTLOG_INDEX_INVALID) && (indexTable[slot].firstSequence <= newestSequence) )
+         {
+            indexTable[slot].firstSequence = EVENTLOG_INDEX_INVALID;
+         }
+         else
+         {
+            newestSequence = indexTable[slot].firstSequence;
+         }
+      }
+      else
+      {
+         //Do nothing
+      }
+      position++;
+   }
+}
+//------------------------------------------------------------------------------
+//   EventLogIndexUpdate(unsigned int subsector, unsigned int firstSequence, unsigned int firstTime, unsigned int lastTime, unsigned short numberOfEvents, bool isPersistent)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function updates the index entry of an event log subsector, the
+//!  entry is also programmed in the dataflash if it is persistent
+//
+//------------------------------------------------------------------------------
+void EventLogIndexUpdate(
+                           unsigned int subsector,                              //!< Event log subsector
+                           unsigned int firstSequence,                          //!< Sequence number of the first event
+                           unsigned int firstTime,                              //!< Time key of the first event
+                           unsigned int lastTime,                               //!< Time key of the last event
+                           unsigned short numberOfEvents,                       //!< Events in the subsector
+                           bool isPersistent                                    //!< True for a subsector which will not be written again
+                        )
+{
+   //For the slot of the subsector
+   unsigned int slot = 0u;
+   //For the group of the slot
+   unsigned char group = 0u;
+   //For the address of the entry in its subsector
+   unsigned short entryAddress = 0u;
+   //For the entry
+   EVENTLOG_INDEX_ENTRY_STRUCT entry;
+   //For indexing the loop
+   unsigned char byteIndex = 0u;
+   //To check if the entry is erased
+   bool isErased = true;
+   //Check the range of the subsector
+   if ( (subsector >= FIRST_EVENTLOG_SUBSECTOR) && (subsector <= LAST_EVENTLOG_SUBSECTOR) )
+   {
+      slot = subsector - FIRST_EVENTLOG_SUBSECTOR;
+      indexTable[slot].firstSequence = firstSequence;
+      indexTable[slot].firstTime = firstTime;
+      if ( isPersistent == true )
+      {
+         group = (unsigned char) (slot / EVENTLOG_INDEX_ENTRIES_PER_SUBSECTOR);
+         entryAddress = (unsigned short) ((slot % EVENTLOG_INDEX_ENTRIES_PER_SUBSECTOR) * EVENTLOG_INDEX_ENTRY_SIZE);
+         //Check if the entry can be programmed in the active half
+         DataFlashReadBytes(GetIndexSubsector(group, activeHalf[group]), entryAddress, (unsigned char *) &entry, (unsigned short) sizeof(entry));
+         while ( byteIndex < EVENTLOG_INDEX_ENTRY_SIZE )
+         {
+            if ( ((unsigned char *) &entry)[byteIndex] != ERASED_BYTE )
+            {
+               isErased = false;
+            }
+            else
+            {
+               //Do nothing
+            }
+            byteIndex++;
+         }
+         if ( isErased == false )
+         {
+            //The entries of the active half have been written again in the
+            //other half since it was erased, append to the other half
+            activeHalf[group] = activeHalf[group] ^ 1u;
+            DataFlashErasePage(GetIndexSubsector(group, activeHalf[group]));
+         }
+         else
+         {
+            //Do nothing
+         }
+         entry.firstSequence = firstSequence;
+         entry.firstTime = firstTime;
+         entry.lastTime = lastTime;
+         entry.numberOfEvents = numberOfEvents;
+         entry.entryCRC = GetEntryCRC(&entry);
+         DataFlashProgramBytes(GetIndexSubsector(group, activeHalf[group]), entryAddress, (const unsigned char *) &entry, (unsigned short) sizeof(entry));
+      }
+      else
+      {
+         //Do nothing
+      }
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   EventLogIndexGetFirstSequence(unsigned int subsector, unsigned int *firstSequence)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the first sequence number of an event log
+//!  subsector. It returns false if the subsector is not indexed
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexGetFirstSequence(
+                                     unsigned int subsector,                    //!< Event log subsector
+                                     unsigned int *firstSequence                //!< Sequence number of the first event
+                                  )
+{
+   //To check if the subsector is indexed
+   bool isIndexed = false;
+   if ( (subsector >= FIRST_EVENTLOG_SUBSECTOR) && (subsector <= LAST_EVENTLOG_SUBSECTOR) )
+   {
+      *firstSequence = indexTable[subsector - FIRST_EVENTLOG_SUBSECTOR].firstSequence;
+      isIndexed = ( *firstSequence != EVENTLOG_INDEX_INVALID );
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isIndexed;
+}
+//------------------------------------------------------------------------------
+//   EventLogIndexFindOldest(unsigned int oldestSubsector, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the first indexed subsector in ring order. It
+//!  returns false if no subsector is indexed
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexFindOldest(
+                               unsigned int oldestSubsector,                    //!< Subsector holding the oldest events
+                               unsigned int *subsector                          //!< Subsector found
+                            )
+{
+   //For the ring position
+   unsigned int position = 0u;
+   //For the slot at the position
+   unsigned int slot = 0u;
+   //To check if a subsector has been found
+   bool isFound = false;
+   while ( (position < EVENTLOG_INDEX_SLOTS) && (isFound == false) )
+   {
+      slot = GetRingSlot(oldestSubsector, position);
+      if ( indexTable[slot].firstSequence != EVENTLOG_INDEX_INVALID )
+      {
+         *subsector = FIRST_EVENTLOG_SUBSECTOR + slot;
+         isFound = true;
+      }
+      else
+      {
+         //Do nothing
+      }
+      position++;
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   EventLogIndexFindSequence(unsigned int oldestSubsector, unsigned int sequenceNumber, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the last indexed subsector starting at or before
+//!  the given sequence number. It returns false if every indexed subsector
+//!  starts after it
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexFindSequence(
+                                 unsigned int oldestSubsector,                  //!< Subsector holding the oldest events
+                                 unsigned int sequenceNumber,                   //!< Sequence number to be found
+                                 unsigned int *subsector                        //!< Subsector found
+                              )
+{
+   return FindInRing(oldestSubsector, sequenceNumber, false, subsector);
+}
+//------------------------------------------------------------------------------
+//   EventLogIndexFindTime(unsigned int oldestSubsector, unsigned int timeKey, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the last indexed subsector starting at or before
+//!  the given time key. It returns false if every indexed subsector starts
+//!  after it
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexFindTime(
+                             unsigned int oldestSubsector,                      //!< Subsector holding the oldest events
+                             unsigned int timeKey,                              //!< Time key to be found
+                             unsigned int *subsector                            //!< Subsector found
+                          )
+{
+   return FindInRing(oldestSubsector, timeKey, true, subsector);
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
\ No newline at end of file
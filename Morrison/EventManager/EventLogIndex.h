@@ -0,0 +1,170 @@
+//==============================================================================
+//
+//  EventLogIndex.h
+//
+//  Copyright (C) 2026 by Industrial Scientific.
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogIndex.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the global functions and constant of the event log
+//! index. The index keeps the first sequence number and the time stamps of
+//! every event log subsector so that a reader can seek without scanning
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __EVENTLOGINDEX_H__
+#define __EVENTLOGINDEX_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include "EventLog.h"
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define FIRST_EVENTLOG_INDEX_SUBSECTOR (LAST_EVENTLOG_SUBSECTOR+1)              //!< First subsector of the event log index
+#define EVENTLOG_INDEX_SLOTS (LAST_EVENTLOG_SUBSECTOR-FIRST_EVENTLOG_SUBSECTOR+1) //!< One index entry per event log subsector
+#define EVENTLOG_INDEX_ENTRY_SIZE 16                                            //!< Size of one index entry in the dataflash
+#define EVENTLOG_INDEX_ENTRIES_PER_SUBSECTOR 256                                //!< Index entries in one subsector
+#define EVENTLOG_INDEX_GROUPS 16                                                //!< Groups of 256 entries, each uses two subsectors
+#define EVENTLOG_INDEX_INVALID 0xFFFFFFFFu                                      //!< Sequence number of an empty entry
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   EventLogIndexInit(unsigned int newestSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function loads the index from the dataflash to RAM and drops the
+//!  entries which are older than the subsectors written before them
+//
+//------------------------------------------------------------------------------
+void EventLogIndexInit(
+                         unsigned int newestSubsector                           //!< Last event log subsector written
+                      );
+//------------------------------------------------------------------------------
+//   EventLogIndexUpdate(unsigned int subsector, unsigned int firstSequence, unsigned int firstTime, unsigned int lastTime, unsigned short numberOfEvents, bool isPersistent)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function updates the index entry of an event log subsector, the
+//!  entry is also programmed in the dataflash if it is persistent
+//
+//------------------------------------------------------------------------------
+void EventLogIndexUpdate(
+                           unsigned int subsector,                              //!< Event log subsector
+                           unsigned int firstSequence,                          //!< Sequence number of the first event
+                           unsigned int firstTime,                              //!< Time key of the first event
+                           unsigned int lastTime,                               //!< Time key of the last event
+                           unsigned short numberOfEvents,                       //!< Events in the subsector
+                           bool isPersistent                                    //!< True for a subsector which will not be written again
+                        );
+//------------------------------------------------------------------------------
+//   EventLogIndexGetFirstSequence(unsigned int subsector, unsigned int *firstSequence)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the first sequence number of an event log
+//!  subsector. It returns false if the subsector is not indexed
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexGetFirstSequence(
+                                     unsigned int subsector,                    //!< Event log subsector
+                                     unsigned int *firstSequence                //!< Sequence number of the first event
+                                  );
+//------------------------------------------------------------------------------
+//   EventLogIndexFindOldest(unsigned int oldestSubsector, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the first indexed subsector in ring order. It
+//!  returns false if no subsector is indexed
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexFindOldest(
+                               unsigned int oldestSubsector,                    //!< Subsector holding the oldest events
+                               unsigned int *subsector                          //!< Subsector found
+                            );
+//------------------------------------------------------------------------------
+//   EventLogIndexFindSequence(unsigned int oldestSubsector, unsigned int sequenceNumber, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the last indexed subsector starting at or before
+//!  the given sequence number. It returns false if every indexed subsector
+//!  starts after it
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexFindSequence(
+                                 unsigned int oldestSubsector,                  //!< Subsector holding the oldest events
+                                 unsigned int sequenceNumber,                   //!< Sequence number to be found
+                                 unsigned int *subsector                        //!< Subsector found
+                              );
+//------------------------------------------------------------------------------
+//   EventLogIndexFindTime(unsigned int oldestSubsector, unsigned int timeKey, unsigned int *subsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the last indexed subsector starting at or before
+//!  the given time key. It returns false if every indexed subsector starts
+//!  after it
+//
+//------------------------------------------------------------------------------
+bool EventLogIndexFindTime(
+                             unsigned int oldestSubsector,                      //!< Subsector holding the oldest events
+                             unsigned int timeKey,                              //!< Time key to be found
+                             unsigned int *subsector                            //!< Subsector found
+                          );
+
+#endif /* __EVENTLOGINDEX_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
\ No newline at end of file
@@ -0,0 +1,304 @@
+//==============================================================================
+//
+//  EventLogJournal.c
+//
+//  Copyright (C) 2017 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogJournal.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module keeps the subsector of the next events and the number of
+//! events in the dataflash in a journal in the internal EEPROM. Every commit
+//! appends an entry of two words after the latest one instead of writing the
+//! same words again, the entries go round the journal blocks.
+//!
+//! The first word of an entry is the event count. The second word has an 8
+//! bit sequence number, the subsector and an 8 bit check of the entry, it is
+//! programmed after the first one. An entry cut by a power loss fails its
+//! check and the latest entry is the last one whose sequence number is not
+//! continued by the entry after it
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include "EventLogJournal.h"
+#include "CRC16.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define JOURNAL_WORDS (EVENTLOG_JOURNAL_ENTRIES*EVENTLOG_JOURNAL_WORDS_PER_ENTRY) //!< EEPROM words of the journal
+#define ENTRIES_PER_BLOCK (BLOCK_NUMBER_OF_WORDS/EVENTLOG_JOURNAL_WORDS_PER_ENTRY) //!< Journal entries in an EEPROM block
+#define ERASED_WORD 0xFFFFFFFFu                                                 //!< Value of an erased EEPROM word
+#define NO_LATEST_ENTRY 0xFFFFu                                                 //!< Latest entry of an empty journal
+#define SEQUENCE_SHIFT 24                                                       //!< Position of the sequence number in the second word
+#define SUBSECTOR_SHIFT 8                                                       //!< Position of the subsector in the second word
+#define SUBSECTOR_MASK 0xFFFFu                                                  //!< Bits of the subsector
+#define CHECK_MASK 0xFFu                                                        //!< Bits of the check
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static unsigned int journalArray[JOURNAL_WORDS];                                //!< Journal read from the EEPROM at the start
+static unsigned short latestEntry = NO_LATEST_ENTRY;                            //!< Entry written last
+static unsigned char latestSequence = 0u;                                       //!< Sequence number of the entry written last
+static unsigned int latestSubsector = 0u;                                       //!< Subsector of the entry written last
+static unsigned int latestEventCount = 0u;                                      //!< Event count of the entry written last
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static unsigned char GetEntryCheck(unsigned int eventCount, unsigned char sequence, unsigned int subsectorNumber);
+static bool IsEntryValid(unsigned short entry);
+static unsigned char GetEntrySequence(unsigned short entry);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetEntryCheck(unsigned int eventCount, unsigned char sequence, unsigned int subsectorNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the check of a journal entry, the low byte of the
+//!  CRC of its fields
+//
+//------------------------------------------------------------------------------
+static unsigned char GetEntryCheck(
+                                     unsigned int eventCount,                   //!< Events in the dataflash
+                                     unsigned char sequence,                    //!< Sequence number of the entry
+                                     unsigned int subsectorNumber               //!< Subsector of the next events
+                                  )
+{
+   //For the fields covered by the check
+   unsigned char entryBytes[7];
+   entryBytes[0] = (unsigned char) (eventCount >> 24);
+   entryBytes[1] = (unsigned char) (eventCount >> 16);
+   entryBytes[2] = (unsigned char) (eventCount >> 8);
+   entryBytes[3] = (unsigned char) eventCount;
+   entryBytes[4] = sequence;
+   entryBytes[5] = (unsigned char) (subsectorNumber >> 8);
+   entryBytes[6] = (unsigned char) subsectorNumber;
+   return (unsigned char) CRC16Calculate(entryBytes, sizeof(entryBytes), CRC16_INITIAL_VALUE);
+}
+//------------------------------------------------------------------------------
+//   IsEntryValid(unsigned short entry)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if an entry of the journal read at the start
+//!  has been programmed completely
+//
+//------------------------------------------------------------------------------
+static bool IsEntryValid(
+                           unsigned short entry                                 //!< Entry of the journal
+                        )
+{
+   //For the first word of the entry
+   unsigned int countWord = journalArray[entry * EVENTLOG_JOURNAL_WORDS_PER_ENTRY];
+   //For the second word of the entry
+   unsigned int headWord = journalArray[(entry * EVENTLOG_JOURNAL_WORDS_PER_ENTRY) + 1u];
+   //For the status of the entry
+   bool isValid = false;
+   if ( (headWord != ERASED_WORD) &&
+        ((unsigned char) (headWord & CHECK_MASK) ==
+         GetEntryCheck(countWord, (unsigned char) (headWord >> SEQUENCE_SHIFT), (headWord >> SUBSECTOR_SHIFT) & SUBSECTOR_MASK)) )
+   {
+      isValid = true;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isValid;
+}
+//------------------------------------------------------------------------------
+//   GetEntrySequence(unsigned short entry)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the sequence number of an entry of the journal read
+//!  at the start
+//
+//------------------------------------------------------------------------------
+static unsigned char GetEntrySequence(
+                                        unsigned short entry                    //!< Entry of the journal
+                                     )
+{
+   return (unsigned char) (journalArray[(entry * EVENTLOG_JOURNAL_WORDS_PER_ENTRY) + 1u] >> SEQUENCE_SHIFT);
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   EventLogJournalInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the journal from the EEPROM at once and finds its
+//!  latest entry. The entries are written in order, so only the latest valid
+//!  entry is not followed by the entry of the next sequence number
+//
+//------------------------------------------------------------------------------
+void EventLogJournalInit(void)
+{
+   //For indexing the loop
+   unsigned short entry = 0u;
+   //For the entry after the one checked
+   unsigned short nextEntry = 0u;
+   latestEntry = NO_LATEST_ENTRY;
+   latestSequence = 0u;
+   if ( TM4CEEPROMReadData(journalArray, (unsigned char) EVENTLOG_JOURNAL_FIRST_BLOCK, (unsigned char) FIRST_WORD, (unsigned char) JOURNAL_WORDS) == true )
+   {
+      while ( (entry < EVENTLOG_JOURNAL_ENTRIES) && (latestEntry == NO_LATEST_ENTRY) )
+      {
+         nextEntry = (unsigned short) ((entry + 1u) % EVENTLOG_JOURNAL_ENTRIES);
+         if ( (IsEntryValid(entry) == true) &&
+              ((IsEntryValid(nextEntry) == false) ||
+               (GetEntrySequence(nextEntry) != (unsigned char) (GetEntrySequence(entry) + 1u))) )
+         {
+            latestEntry = entry;
+            latestSequence = GetEntrySequence(entry);
+            latestEventCount = journalArray[entry * EVENTLOG_JOURNAL_WORDS_PER_ENTRY];
+            latestSubsector = (journalArray[(entry * EVENTLOG_JOURNAL_WORDS_PER_ENTRY) + 1u] >> SUBSECTOR_SHIFT) & SUBSECTOR_MASK;
+         }
+         else
+         {
+            //Do nothing
+         }
+         entry++;
+      }
+   }
+   else
+   {
+      //Do nothing, the journal is started again
+   }
+}
+//------------------------------------------------------------------------------
+//   EventLogJournalGetLatest(unsigned int *subsectorNumber, unsigned int *eventCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the subsector and event count of the latest entry.
+//!  It returns false if the journal has no valid entry
+//
+//------------------------------------------------------------------------------
+bool EventLogJournalGetLatest(
+                                unsigned int *subsectorNumber,                  //!< Subsector of the next events
+                                unsigned int *eventCount                        //!< Events in the dataflash
+                             )
+{
+   //For the status of the journal
+   bool isFound = false;
+   if ( latestEntry != NO_LATEST_ENTRY )
+   {
+      *subsectorNumber = latestSubsector;
+      *eventCount = latestEventCount;
+      isFound = true;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isFound;
+}
+//------------------------------------------------------------------------------
+//   EventLogJournalAppend(unsigned int subsectorNumber, unsigned int eventCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a new entry after the latest one, the oldest entry
+//!  is overwritten. The two words are programmed in order, the second one
+//!  completes the entry
+//
+//------------------------------------------------------------------------------
+bool EventLogJournalAppend(
+                             unsigned int subsectorNumber,                      //!< Subsector of the next events
+                             unsigned int eventCount                            //!< Events in the dataflash
+                          )
+{
+   //For the entry to be written
+   unsigned short entry = 0u;
+   //For the sequence number of the entry
+   unsigned char sequence = 0u;
+   //For the words of the entry
+   unsigned int entryWords[EVENTLOG_JOURNAL_WORDS_PER_ENTRY];
+   //To check if the EEPROM write is correct
+   bool isWriteCorrect = false;
+   if ( latestEntry != NO_LATEST_ENTRY )
+   {
+      entry = (unsigned short) ((latestEntry + 1u) % EVENTLOG_JOURNAL_ENTRIES);
+      sequence = (unsigned char) (latestSequence + 1u);
+   }
+   else
+   {
+      //Do nothing, an empty journal starts at its first entry
+   }
+   entryWords[0] = eventCount;
+   entryWords[1] = ((unsigned int) sequence << SEQUENCE_SHIFT) | ((subsectorNumber & SUBSECTOR_MASK) << SUBSECTOR_SHIFT) |
+                   GetEntryCheck(eventCount, sequence, subsectorNumber & SUBSECTOR_MASK);
+   isWriteCorrect = TM4CEEPROMWriteData(entryWords, (unsigned char) (EVENTLOG_JOURNAL_FIRST_BLOCK + (entry / ENTRIES_PER_BLOCK)),
+                                        (unsigned char) ((entry % ENTRIES_PER_BLOCK) * EVENTLOG_JOURNAL_WORDS_PER_ENTRY), (unsigned char) EVENTLOG_JOURNAL_WORDS_PER_ENTRY);
+   //A failed entry is written again by the next commit, an entry skipped
+   //would break the sequence numbers
+   if ( isWriteCorrect == true )
+   {
+      latestEntry = entry;
+      latestSequence = sequence;
+      latestSubsector = subsectorNumber;
+      latestEventCount = eventCount;
+   }
+   else
+   {
+      //Do nothing
+   }
+   return isWriteCorrect;
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
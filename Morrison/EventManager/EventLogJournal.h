@@ -0,0 +1,115 @@
+//==============================================================================
+//
+//  EventLogJournal.h
+//
+//  Copyright (C) 2017 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogJournal.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the global functions and constants of the event log
+//! journal, which keeps the event log head in the internal EEPROM
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __EVENTLOGJOURNAL_H__
+#define __EVENTLOGJOURNAL_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include "TM4CEEPROM.h"
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define EVENTLOG_JOURNAL_FIRST_BLOCK 1                                          //!< First EEPROM block of the journal, block 0 holds the words written before it
+#define EVENTLOG_JOURNAL_BLOCKS 8                                               //!< EEPROM blocks of the journal
+#define EVENTLOG_JOURNAL_WORDS_PER_ENTRY 2                                      //!< EEPROM words of a journal entry
+#define EVENTLOG_JOURNAL_ENTRIES ((EVENTLOG_JOURNAL_BLOCKS*BLOCK_NUMBER_OF_WORDS)/EVENTLOG_JOURNAL_WORDS_PER_ENTRY) //!< Entries of the journal
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   EventLogJournalInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the journal from the EEPROM at once and finds its
+//!  latest entry
+//
+//------------------------------------------------------------------------------
+void EventLogJournalInit(void);
+//------------------------------------------------------------------------------
+//   EventLogJournalGetLatest(unsigned int *subsectorNumber, unsigned int *eventCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the subsector and event count of the latest entry.
+//!  It returns false if the journal has no valid entry
+//
+//------------------------------------------------------------------------------
+bool EventLogJournalGetLatest(
+                                unsigned int *subsectorNumber,                  //!< Subsector of the next events
+                                unsigned int *eventCount                        //!< Events in the dataflash
+                             );
+//------------------------------------------------------------------------------
+//   EventLogJournalAppend(unsigned int subsectorNumber, unsigned int eventCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a new entry after the latest one, the oldest entry
+//!  is overwritten. It returns false if the EEPROM write fails
+//
+//------------------------------------------------------------------------------
+bool EventLogJournalAppend(
+                             unsigned int subsectorNumber,                      //!< Subsector of the next events
+                             unsigned int eventCount                            //!< Events in the dataflash
+                          );
+
+#endif /* __EVENTLOGJOURNAL_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,373 @@
+//==============================================================================
+//
+//  WearLevel.c
+//
+//  Copyright (C) 2017 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        WearLevel.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module spreads the erases of the error log over a pool of dataflash
+//! subsectors. The error log erases one of its subsectors every twenty
+//! errors, while an event log subsector is erased once every time the event
+//! log wraps, so the error log subsectors wear out first.
+//!
+//! The pool holds the logical subsectors of the error log and some free
+//! subsectors. When a logical subsector has to be erased the least erased
+//! free subsector is erased instead and takes its place. The last bytes of
+//! every pool subsector hold a header with the logical subsector, the order
+//! in which it was taken over and its erase count. The map is rebuilt from
+//! the headers at start up, the newest header of a logical subsector wins.
+//! A logical subsector without a header is still in its own subsector.
+//!
+//! The pool covers the error log only. Its subsectors are protected in the
+//! dataflash driver, so every erase of them goes through
+//! WearLevelEraseSubsector and a header is never lost to another erase. The
+//! free subsectors of the pool held events in the layout before it, they
+//! have no header and are erased when they are taken
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <string.h>
+#include "WearLevel.h"
+#include "Dataflash.h"
+#include "CRC16.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define WEARLEVEL_HEADER_ADDRESS (DATAFLASH_SUBSECTOR_SIZE-WEARLEVEL_HEADER_SIZE) //!< Address of the header in a pool subsector
+#define WEARLEVEL_HEADER_CRC_LENGTH (WEARLEVEL_HEADER_SIZE-2u)                  //!< Bytes of a header covered by its CRC
+#define WEARLEVEL_HEADER_MARKER 0x5A17u                                         //!< Marker of a valid header
+#define ERASED_BYTE 0xFFu                                                       //!< Value of an erased dataflash byte
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+//Structure of the header of a pool subsector
+typedef struct
+{
+   unsigned int generation;                                                     //!< Order in which the subsector was taken over
+   unsigned int eraseCount;                                                     //!< Erases of the subsector
+   unsigned short logicalSubsector;                                             //!< Logical subsector held by the subsector
+   unsigned short marker;                                                       //!< Marker of a valid header
+   unsigned short reserved;                                                     //!< Left erased
+   unsigned short headerCRC;                                                    //!< CRC of the header
+}WEARLEVEL_HEADER_STRUCT;
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static bool isWearLevelInit = false;                                            //!< This flag is used to indicate that the map has been rebuilt
+static unsigned char poolOfLogical[WEARLEVEL_LOGICAL_SUBSECTORS];               //!< Pool position of every logical subsector
+static unsigned int eraseCount[WEARLEVEL_POOL_SUBSECTORS];                      //!< Erase count of every pool subsector
+static unsigned int nextGeneration = 1u;                                        //!< Generation of the next subsector taken over
+static unsigned char nextPosition = 0u;                                         //!< Pool position where the search for a free subsector starts
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static unsigned short GetHeaderCRC(const WEARLEVEL_HEADER_STRUCT *header);
+static bool IsPoolPositionFree(unsigned char position);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetHeaderCRC(const WEARLEVEL_HEADER_STRUCT *header)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the CRC of a pool subsector header
+//
+//------------------------------------------------------------------------------
+static unsigned short GetHeaderCRC(
+                                     const WEARLEVEL_HEADER_STRUCT *header      //!< Pool subsector header
+                                  )
+{
+   return CRC16Calculate((const unsigned char *) header, WEARLEVEL_HEADER_CRC_LENGTH, INITIAL_CRC_VALUE);
+}
+//------------------------------------------------------------------------------
+//   IsPoolPositionFree(unsigned char position)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if no logical subsector is held by the pool
+//!  subsector at the given position
+//
+//------------------------------------------------------------------------------
+static bool IsPoolPositionFree(
+                                 unsigned char position                         //!< Position in the pool
+                              )
+{
+   //For indexing the logical subsectors
+   unsigned char logicalIndex = 0u;
+   //To check if the position is free
+   bool isFree = true;
+   while ( (logicalIndex < WEARLEVEL_LOGICAL_SUBSECTORS) && (isFree == true) )
+   {
+      if ( poolOfLogical[logicalIndex] == position )
+      {
+         isFree = false;
+      }
+      else
+      {
+         logicalIndex++;
+      }
+   }
+   return isFree;
+}
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   WearLevelInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function protects the pool in the dataflash driver, reads the
+//!  headers of the pool and rebuilds the map of the logical subsectors and
+//!  the erase counts
+//
+//------------------------------------------------------------------------------
+void WearLevelInit(void)
+{
+   //For indexing the pool and the logical subsectors
+   unsigned char position = 0u;
+   unsigned char logicalIndex = 0u;
+   //For the generation of the subsector holding every logical subsector
+   unsigned int logicalGeneration[WEARLEVEL_LOGICAL_SUBSECTORS];
+   //For the header of a pool subsector
+   WEARLEVEL_HEADER_STRUCT header;
+   if ( isWearLevelInit == false )
+   {
+      //Only the wear level erases the pool from now on
+      DataFlashProtectSubsectors((unsigned short) WEARLEVEL_FIRST_SUBSECTOR, (unsigned short) WEARLEVEL_LAST_SUBSECTOR);
+      //Every logical subsector starts in its own subsector
+      while ( logicalIndex < WEARLEVEL_LOGICAL_SUBSECTORS )
+      {
+         poolOfLogical[logicalIndex] = logicalIndex;
+         logicalGeneration[logicalIndex] = 0u;
+         logicalIndex++;
+      }
+      memset(eraseCount, 0, sizeof(eraseCount));
+      nextGeneration = 1u;
+      while ( position < WEARLEVEL_POOL_SUBSECTORS )
+      {
+         DataFlashReadBytes((unsigned short) (WEARLEVEL_FIRST_SUBSECTOR + position), WEARLEVEL_HEADER_ADDRESS,\
+            (unsigned char *) &header, (unsigned short) sizeof(header));
+         if ( (header.marker == WEARLEVEL_HEADER_MARKER) &&
+              (header.headerCRC == GetHeaderCRC(&header)) &&
+              (header.logicalSubsector >= WEARLEVEL_FIRST_SUBSECTOR) &&
+              (header.logicalSubsector < (WEARLEVEL_FIRST_SUBSECTOR + WEARLEVEL_LOGICAL_SUBSECTORS)) )
+         {
+            eraseCount[position] = header.eraseCount;
+            logicalIndex = (unsigned char) (header.logicalSubsector - WEARLEVEL_FIRST_SUBSECTOR);
+            //Keep the newest subsector of the logical subsector
+            if ( header.generation > logicalGeneration[logicalIndex] )
+            {
+               poolOfLogical[logicalIndex] = position;
+               logicalGeneration[logicalIndex] = header.generation;
+            }
+            else
+            {
+               //Do nothing
+            }
+            if ( header.generation >= nextGeneration )
+            {
+               nextGeneration = header.generation + 1u;
+            }
+            else
+            {
+               //Do nothing
+            }
+         }
+         else
+         {
+            //Do nothing
+         }
+         position++;
+      }
+      // Set flag to indicate the map has been rebuilt
+      isWearLevelInit = true;
+   }
+   else
+   {
+      //Do nothing
+   }
+}
+//------------------------------------------------------------------------------
+//   WearLevelGetSubsector(unsigned short logicalSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector holding a logical
+//!  subsector, subsectors outside the pool are returned unchanged
+//
+//------------------------------------------------------------------------------
+unsigned short WearLevelGetSubsector(
+                                       unsigned short logicalSubsector          //!< Logical subsector
+                                    )
+{
+   //For the dataflash subsector
+   unsigned short subsector = logicalSubsector;
+   WearLevelInit();
+   if ( (logicalSubsector >= WEARLEVEL_FIRST_SUBSECTOR) &&
+        (logicalSubsector < (WEARLEVEL_FIRST_SUBSECTOR + WEARLEVEL_LOGICAL_SUBSECTORS)) )
+   {
+      subsector = WEARLEVEL_FIRST_SUBSECTOR + poolOfLogical[logicalSubsector - WEARLEVEL_FIRST_SUBSECTOR];
+   }
+   else
+   {
+      //Do nothing
+   }
+   return subsector;
+}
+//------------------------------------------------------------------------------
+//   WearLevelEraseSubsector(unsigned short logicalSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases the least erased free subsector of the pool, moves
+//!  the logical subsector to it and returns it. The old subsector becomes
+//!  free and keeps its data until it is taken again
+//
+//------------------------------------------------------------------------------
+unsigned short WearLevelEraseSubsector(
+                                         unsigned short logicalSubsector        //!< Logical subsector
+                                      )
+{
+   //For the dataflash subsector
+   unsigned short subsector = logicalSubsector;
+   //For the pool positions searched
+   unsigned char position = 0u;
+   unsigned char searchCount = 0u;
+   //For the least erased free position
+   unsigned char freePosition = 0u;
+   bool isFreeFound = false;
+   //For the header of the subsector taken over
+   WEARLEVEL_HEADER_STRUCT header;
+   WearLevelInit();
+   if ( (logicalSubsector >= WEARLEVEL_FIRST_SUBSECTOR) &&
+        (logicalSubsector < (WEARLEVEL_FIRST_SUBSECTOR + WEARLEVEL_LOGICAL_SUBSECTORS)) )
+   {
+      //Search from the position after the last subsector taken over, free
+      //subsectors with the same erase count are then taken in turn
+      position = nextPosition;
+      while ( searchCount < WEARLEVEL_POOL_SUBSECTORS )
+      {
+         if ( (IsPoolPositionFree(position) == true) &&
+              ((isFreeFound == false) || (eraseCount[position] < eraseCount[freePosition])) )
+         {
+            freePosition = position;
+            isFreeFound = true;
+         }
+         else
+         {
+            //Do nothing
+         }
+         position = (unsigned char) ((position + 1u) % WEARLEVEL_POOL_SUBSECTORS);
+         searchCount++;
+      }
+      //There are always spare subsectors, the logical subsector keeps its old
+      //subsector until the header of the new one is programmed
+      subsector = WEARLEVEL_FIRST_SUBSECTOR + freePosition;
+      DataFlashEraseProtectedSubsector(subsector);
+      eraseCount[freePosition]++;
+      memset(&header, ERASED_BYTE, sizeof(header));
+      header.generation = nextGeneration;
+      header.eraseCount = eraseCount[freePosition];
+      header.logicalSubsector = logicalSubsector;
+      header.marker = WEARLEVEL_HEADER_MARKER;
+      header.headerCRC = GetHeaderCRC(&header);
+      DataFlashProgramBytes(subsector, WEARLEVEL_HEADER_ADDRESS, (const unsigned char *) &header, (unsigned short) sizeof(header));
+      nextGeneration++;
+      poolOfLogical[logicalSubsector - WEARLEVEL_FIRST_SUBSECTOR] = freePosition;
+      nextPosition = (unsigned char) ((freePosition + 1u) % WEARLEVEL_POOL_SUBSECTORS);
+   }
+   else
+   {
+      DataFlashErasePage(logicalSubsector);
+   }
+   return subsector;
+}
+//------------------------------------------------------------------------------
+//   WearLevelGetEraseCounts(unsigned int *maximumCount, unsigned int *meanCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the highest and the mean erase count of the pool
+//
+//------------------------------------------------------------------------------
+void WearLevelGetEraseCounts(
+                               unsigned int *maximumCount,                      //!< Highest erase count
+                               unsigned int *meanCount                          //!< Mean erase count
+                            )
+{
+   //For indexing the pool
+   unsigned char position = 0u;
+   //For the sum of the erase counts
+   unsigned long long totalCount = 0u;
+   WearLevelInit();
+   *maximumCount = 0u;
+   while ( position < WEARLEVEL_POOL_SUBSECTORS )
+   {
+      totalCount = totalCount + eraseCount[position];
+      if ( eraseCount[position] > *maximumCount )
+      {
+         *maximumCount = eraseCount[position];
+      }
+      else
+      {
+         //Do nothing
+      }
+      position++;
+   }
+   *meanCount = (unsigned int) (totalCount / WEARLEVEL_POOL_SUBSECTORS);
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
\ No newline at end of file
@@ -0,0 +1,135 @@
+//==============================================================================
+//
+//  WearLevel.h
+//
+//  Copyright (C) 2017 by Industrial Scientific.
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        WearLevel.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the global functions and constants of the wear level
+//! allocator. The allocator maps the logical subsectors of the error log to
+//! a pool of dataflash subsectors and moves a logical subsector to the least
+//! erased free subsector of the pool every time it has to be erased. The
+//! pool covers the error log only, the event log and the other dataflash
+//! users erase their own subsectors. Every erase of a pool subsector goes
+//! through WearLevelEraseSubsector
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __WEARLEVEL_H__
+#define __WEARLEVEL_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include "ErrorLog.h"
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define WEARLEVEL_FIRST_SUBSECTOR WHISPER_DEVICE_ERROR_SUBSECTOR                //!< First subsector of the pool
+#define WEARLEVEL_LOGICAL_SUBSECTORS (TOTAL_NUMBER_OF_ERRORS*PAGES_PER_ERROR_LOG) //!< Logical subsectors mapped to the pool
+#define WEARLEVEL_SPARE_SUBSECTORS 14u                                          //!< Free subsectors of the pool
+#define WEARLEVEL_POOL_SUBSECTORS (WEARLEVEL_LOGICAL_SUBSECTORS+WEARLEVEL_SPARE_SUBSECTORS) //!< Subsectors in the pool
+#define WEARLEVEL_LAST_SUBSECTOR (WEARLEVEL_FIRST_SUBSECTOR+WEARLEVEL_POOL_SUBSECTORS-1u) //!< Last subsector of the pool
+#define WEARLEVEL_HEADER_SIZE 16u                                               //!< Header at the end of every pool subsector
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   WearLevelInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function protects the pool in the dataflash driver, reads the
+//!  headers of the pool and rebuilds the map of the logical subsectors and
+//!  the erase counts
+//
+//------------------------------------------------------------------------------
+void WearLevelInit(void);
+//------------------------------------------------------------------------------
+//   WearLevelGetSubsector(unsigned short logicalSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the dataflash subsector holding a logical
+//!  subsector, subsectors outside the pool are returned unchanged
+//
+//------------------------------------------------------------------------------
+unsigned short WearLevelGetSubsector(
+                                       unsigned short logicalSubsector          //!< Logical subsector
+                                    );
+//------------------------------------------------------------------------------
+//   WearLevelEraseSubsector(unsigned short logicalSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases the least erased free subsector of the pool, moves
+//!  the logical subsector to it and returns it. The old subsector becomes
+//!  free and keeps its data until it is taken again
+//
+//------------------------------------------------------------------------------
+unsigned short WearLevelEraseSubsector(
+                                         unsigned short logicalSubsector        //!< Logical subsector
+                                      );
+//------------------------------------------------------------------------------
+//   WearLevelGetEraseCounts(unsigned int *maximumCount, unsigned int *meanCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the highest and the mean erase count of the pool
+//
+//------------------------------------------------------------------------------
+void WearLevelGetEraseCounts(
+                               unsigned int *maximumCount,                      //!< Highest erase count
+                               unsigned int *meanCount                          //!< Mean erase count
+                            );
+
+#endif /* __WEARLEVEL_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
\ No newline at end of file
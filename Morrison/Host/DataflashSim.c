@@ -0,0 +1,891 @@
+//==============================================================================
+//
+//  DataflashSim.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashSim.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module simulates the N25Q128 behind the dataflash SPI. It implements
+//! SPI_open, SPI_transfer and SPITivaDMA_transferSG for the host build.
+//!
+//! The chip follows the data sheet where Dataflash.c depends on it:
+//! - a program or an erase needs the write enable latch, which it clears
+//! - a program only clears bits and wraps at the end of its page
+//! - an erase sets every byte of the subsector or the block to 0xFF
+//! - the chip is busy for the typical time of a program or an erase, every
+//!   command but a status read is ignored meanwhile
+//! - an erase can be suspended, the chip is ready after the suspend latency
+//!   and programs and reads the other subsectors. A program or an erase of
+//!   the suspended area is ignored until the erase is resumed
+//!
+//! The time of every byte sent at the SPI bit rate is added to the simulated
+//! time. A power cut armed with HostSetPowerCut applies part of the program
+//! or erase it cuts and ends the process. A stuck chip reports busy for ever
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "HostRTOS.h"
+#include "TM4CSPI.h"
+#include "SPITivaDMA.h"
+#include "DataflashSim.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define OPCODE_WRITE_STATUS 0x01u                                               //!< Write status register
+#define OPCODE_PAGE_PROGRAM 0x02u                                               //!< Page program
+#define OPCODE_READ 0x03u                                                       //!< Read
+#define OPCODE_WRITE_DISABLE 0x04u                                              //!< Write disable
+#define OPCODE_READ_STATUS 0x05u                                                //!< Read status register
+#define OPCODE_WRITE_ENABLE 0x06u                                               //!< Write enable
+#define OPCODE_FAST_READ 0x0Bu                                                  //!< Fast read, one dummy byte
+#define OPCODE_SUBSECTOR_ERASE 0x20u                                            //!< 4 Kbyte subsector erase
+#define OPCODE_READ_SFDP 0x5Au                                                  //!< Read SFDP, one dummy byte
+#define OPCODE_SUSPEND 0x75u                                                    //!< Program or erase suspend
+#define OPCODE_RESUME 0x7Au                                                     //!< Program or erase resume
+#define OPCODE_READ_ID 0x9Fu                                                    //!< Read identification
+#define OPCODE_BLOCK_ERASE 0xD8u                                                //!< 64 Kbyte sector erase
+#define STATUS_WIP 0x01u                                                        //!< Write in progress bit
+#define STATUS_WEL 0x02u                                                        //!< Write enable latch bit
+#define ADDRESS_LENGTH 4u                                                       //!< Opcode and three address bytes
+#define DUMMY_LENGTH 5u                                                         //!< Opcode, three address bytes and a dummy byte
+#define SUBSECTOR_SIZE 0x1000u                                                  //!< Bytes of a subsector
+#define BLOCK_SIZE 0x10000u                                                     //!< Bytes of a block
+#define SUBSECTORS (DATAFLASH_SIM_SIZE/SUBSECTOR_SIZE)                          //!< Subsectors of the chip
+#define SFDP_SIZE 0x100u                                                        //!< Bytes of the simulated SFDP area
+#define SFDP_TABLE_ADDRESS 0x30u                                                //!< Address of the basic flash parameter table
+#define SFDP_TABLE_WORDS 16u                                                    //!< Words of the basic flash parameter table (JESD216B)
+#define DMA_TRANSFER_LIMIT 1024u                                                //!< Most frames of one uDMA transfer
+#define TRANSFER_BUFFER_SIZE (DMA_TRANSFER_LIMIT*2u)                            //!< Bytes of the largest simulated transfer
+#define DEFAULT_BIT_RATE 1000000u                                               //!< SPI bit rate if none is given
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static unsigned char *simMemory = NULL;                                         //!< Mapped file of the dataflash
+static unsigned char sfdpArea[SFDP_SIZE];                                       //!< SFDP area of the chip
+static bool hasSFDPTable = true;                                                //!< True if the SFDP table is answered
+static unsigned short simPageSize = DATAFLASH_SIM_PAGE_SIZE;                    //!< Program page size
+static bool isWriteEnabled = false;                                             //!< Write enable latch
+static bool isStuckBusy = false;                                                //!< True if the chip stays busy
+static uint64_t busyUntil = 0u;                                                 //!< Simulated time at which the chip is ready
+static unsigned int eraseAddress = 0u;                                          //!< Start of the area of the last erase
+static unsigned int eraseSize = 0u;                                             //!< Bytes of the area of the last erase, zero after a program
+static bool isEraseSuspended = false;                                           //!< True while the last erase is suspended
+static uint64_t suspendedEraseTime = 0u;                                        //!< Time the suspended erase still takes
+static uint32_t simBitRate = DEFAULT_BIT_RATE;                                  //!< SPI bit rate given to SPI_open
+static DATAFLASH_SIM_STATISTICS_STRUCT simStatistics;                           //!< Statistics since the last reset
+static unsigned int eraseCounts[SUBSECTORS];                                    //!< Erases of every subsector
+static pthread_mutex_t simMutex = PTHREAD_MUTEX_INITIALIZER;                    //!< Serializes the transfers
+static SPI_Config simConfig = {NULL, NULL, NULL};                               //!< Handle given by SPI_open
+static unsigned char transferTx[TRANSFER_BUFFER_SIZE];                          //!< Bytes sent by a transfer
+static unsigned char transferRx[TRANSFER_BUFFER_SIZE];                          //!< Bytes received by a transfer
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void BuildSFDPArea(void);
+static unsigned int GetAddress(const unsigned char *command);
+static bool IsBusy(void);
+static void ProgramPage(const unsigned char *command, size_t nBytes);
+static void EraseArea(unsigned int address, unsigned int size, uint64_t eraseTime);
+static bool IsInSuspendedArea(unsigned int address);
+static void SuspendErase(void);
+static void ResumeErase(void);
+static void RunCommand(const unsigned char *tx, unsigned char *rx, size_t nBytes);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   BuildSFDPArea(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function builds the SFDP header and the basic flash parameter table
+//!  of an N25Q128 with the selected page size
+//
+//------------------------------------------------------------------------------
+static void BuildSFDPArea(void)
+{
+    //For the basic flash parameter table
+    unsigned char *table = &sfdpArea[SFDP_TABLE_ADDRESS];
+    //For the page size as a power of two
+    unsigned char pageExponent = 0u;
+    while ( (1u << pageExponent) < simPageSize )
+    {
+        pageExponent++;
+    }
+    memset(sfdpArea, 0xFF, sizeof(sfdpArea));
+    //SFDP header, revision 1.6 with one parameter header
+    memcpy(sfdpArea, "SFDP", 4u);
+    sfdpArea[4] = 0x06u;
+    sfdpArea[5] = 0x01u;
+    sfdpArea[6] = 0x00u;
+    //Parameter header of the basic flash parameter table
+    sfdpArea[8] = 0x00u;
+    sfdpArea[9] = 0x06u;
+    sfdpArea[10] = 0x01u;
+    sfdpArea[11] = (unsigned char) SFDP_TABLE_WORDS;
+    sfdpArea[12] = (unsigned char) SFDP_TABLE_ADDRESS;
+    sfdpArea[13] = 0x00u;
+    sfdpArea[14] = 0x00u;
+    memset(table, 0x00, SFDP_TABLE_WORDS * 4u);
+    //4 Kbyte erase, write granularity of 64 bytes or more, 3 byte addresses
+    table[0] = 0x01u | ((simPageSize >= 64u) ? 0x04u : 0x00u);
+    table[1] = OPCODE_SUBSECTOR_ERASE;
+    //Fast reads 1-1-2, 1-2-2, 1-4-4 and 1-1-4
+    table[2] = 0x71u;
+    table[3] = 0xFFu;
+    //Density in bits minus one
+    table[4] = 0xFFu;
+    table[5] = 0xFFu;
+    table[6] = 0xFFu;
+    table[7] = 0x07u;
+    //Erase types, 4 Kbyte and 64 Kbyte
+    table[28] = 12u;
+    table[29] = OPCODE_SUBSECTOR_ERASE;
+    table[30] = 16u;
+    table[31] = OPCODE_BLOCK_ERASE;
+    table[33] = 0xFFu;
+    table[35] = 0xFFu;
+    //Page size
+    table[40] = (unsigned char) (pageExponent << 4);
+}
+//------------------------------------------------------------------------------
+//   GetAddress(const unsigned char *command)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the three byte address following the opcode
+//
+//------------------------------------------------------------------------------
+static unsigned int GetAddress(
+                                 const unsigned char *command                   //!< Command bytes
+                              )
+{
+    return (((unsigned int) command[1] << 16) | ((unsigned int) command[2] << 8) | command[3]) % DATAFLASH_SIM_SIZE;
+}
+//------------------------------------------------------------------------------
+//   IsBusy(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true while a program or an erase is in progress
+//
+//------------------------------------------------------------------------------
+static bool IsBusy(void)
+{
+    return ( (isStuckBusy == true) || (HostGetMicroseconds() < busyUntil) );
+}
+//------------------------------------------------------------------------------
+//   ProgramPage(const unsigned char *command, size_t nBytes)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs the data bytes of a page program. The address
+//!  wraps at the end of the page and only the last page size bytes are kept,
+//!  as on the N25Q. A power cut programs a part of the bytes
+//
+//------------------------------------------------------------------------------
+static void ProgramPage(
+                          const unsigned char *command,                         //!< Command and data bytes
+                          size_t nBytes                                         //!< Bytes of the transfer
+                       )
+{
+    //For the address of the first byte
+    unsigned int address = GetAddress(command);
+    //For the start of the page
+    unsigned int pageAddress = address & ~((unsigned int) simPageSize - 1u);
+    //For the data bytes and the ones programmed
+    size_t dataBytes = nBytes - ADDRESS_LENGTH;
+    size_t programmedBytes = 0u;
+    //For indexing the loop
+    size_t byteIndex = 0u;
+    //For the offset of a byte in the page
+    unsigned int pageOffset = 0u;
+    //To check if the power is cut
+    bool isCut = HostIsPowerCut();
+    if ( ((address - pageAddress) + dataBytes) > simPageSize )
+    {
+        simStatistics.pageWraps++;
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( dataBytes > simPageSize )
+    {
+        //Only the last bytes latched are programmed
+        byteIndex = dataBytes - simPageSize;
+    }
+    else
+    {
+        //Do nothing
+    }
+    programmedBytes = dataBytes;
+    if ( isCut == true )
+    {
+        programmedBytes = byteIndex + (HostRandom() % ((dataBytes - byteIndex) + 1u));
+    }
+    else
+    {
+        //Do nothing
+    }
+    while ( byteIndex < programmedBytes )
+    {
+        pageOffset = ((address - pageAddress) + (unsigned int) byteIndex) & ((unsigned int) simPageSize - 1u);
+        simMemory[pageAddress + pageOffset] &= command[ADDRESS_LENGTH + byteIndex];
+        byteIndex++;
+    }
+    if ( isCut == true )
+    {
+        //The byte being programmed keeps some of its bits
+        if ( byteIndex < dataBytes )
+        {
+            pageOffset = ((address - pageAddress) + (unsigned int) byteIndex) & ((unsigned int) simPageSize - 1u);
+            simMemory[pageAddress + pageOffset] &= (unsigned char) (command[ADDRESS_LENGTH + byteIndex] | HostRandom());
+        }
+        else
+        {
+            //Do nothing
+        }
+        HostPowerOff();
+    }
+    else
+    {
+        //Do nothing
+    }
+    simStatistics.pagePrograms++;
+    busyUntil = HostGetMicroseconds() + DATAFLASH_SIM_PROGRAM_US;
+    //A program during a suspended erase leaves the erase to be resumed
+    if ( isEraseSuspended == false )
+    {
+        eraseSize = 0u;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   EraseArea(unsigned int address, unsigned int size, uint64_t eraseTime)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases the subsector or the block holding the address. A
+//!  power cut leaves a random part of its bytes erased
+//
+//------------------------------------------------------------------------------
+static void EraseArea(
+                        unsigned int address,                                   //!< Address in the area
+                        unsigned int size,                                      //!< Bytes of the area
+                        uint64_t eraseTime                                      //!< Typical erase time
+                     )
+{
+    //For the start of the area
+    unsigned int areaAddress = address & ~(size - 1u);
+    //For indexing the loops
+    unsigned int byteIndex = 0u;
+    unsigned int subsectorIndex = 0u;
+    if ( HostIsPowerCut() == true )
+    {
+        for ( byteIndex = 0u; byteIndex < size; byteIndex++ )
+        {
+            if ( (HostRandom() & 1u) != 0u )
+            {
+                simMemory[areaAddress + byteIndex] = 0xFFu;
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+        HostPowerOff();
+    }
+    else
+    {
+        //Do nothing
+    }
+    memset(&simMemory[areaAddress], 0xFF, size);
+    for ( subsectorIndex = 0u; subsectorIndex < (size / SUBSECTOR_SIZE); subsectorIndex++ )
+    {
+        eraseCounts[(areaAddress / SUBSECTOR_SIZE) + subsectorIndex]++;
+    }
+    busyUntil = HostGetMicroseconds() + eraseTime;
+    eraseAddress = areaAddress;
+    eraseSize = size;
+}
+//------------------------------------------------------------------------------
+//   IsInSuspendedArea(unsigned int address)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if the address is in the area of a suspended
+//!  erase, the chip neither programs nor erases it
+//
+//------------------------------------------------------------------------------
+static bool IsInSuspendedArea(
+                                unsigned int address                            //!< Address of the command
+                             )
+{
+    return ( (isEraseSuspended == true) && (address >= eraseAddress) && (address < (eraseAddress + eraseSize)) );
+}
+//------------------------------------------------------------------------------
+//   SuspendErase(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function suspends the erase in progress. The time it still takes is
+//!  saved and the chip is ready after the suspend latency. A suspend without
+//!  an erase in progress is ignored
+//
+//------------------------------------------------------------------------------
+static void SuspendErase(void)
+{
+    //For the simulated time
+    uint64_t now = HostGetMicroseconds();
+    if ( (isEraseSuspended == false) && (eraseSize != 0u) && (now < busyUntil) )
+    {
+        suspendedEraseTime = busyUntil - now;
+        busyUntil = now + DATAFLASH_SIM_SUSPEND_US;
+        isEraseSuspended = true;
+        simStatistics.eraseSuspends++;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   ResumeErase(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function resumes a suspended erase for the time it still takes
+//
+//------------------------------------------------------------------------------
+static void ResumeErase(void)
+{
+    if ( isEraseSuspended == true )
+    {
+        busyUntil = HostGetMicroseconds() + suspendedEraseTime;
+        isEraseSuspended = false;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   RunCommand(const unsigned char *tx, unsigned char *rx, size_t nBytes)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs one command, from the chip select to its release. The
+//!  received bytes are 0xFF where the chip does not drive the line
+//
+//------------------------------------------------------------------------------
+static void RunCommand(
+                         const unsigned char *tx,                               //!< Bytes sent
+                         unsigned char *rx,                                     //!< Bytes received
+                         size_t nBytes                                          //!< Bytes of the transfer
+                      )
+{
+    //For indexing the loop
+    size_t byteIndex = 0u;
+    //For the address of a command
+    unsigned int address = 0u;
+    memset(rx, 0xFF, nBytes);
+    HostAdvanceMicroseconds((((uint64_t) nBytes * 8u * 1000000u) + simBitRate - 1u) / simBitRate);
+    simStatistics.transfers++;
+    if ( tx[0] == OPCODE_READ_STATUS )
+    {
+        for ( byteIndex = 1u; byteIndex < nBytes; byteIndex++ )
+        {
+            rx[byteIndex] = (IsBusy() ? STATUS_WIP : 0u) | (isWriteEnabled ? STATUS_WEL : 0u);
+        }
+        simStatistics.statusReads++;
+    }
+    else if ( (tx[0] == OPCODE_SUSPEND) && (isStuckBusy == false) )
+    {
+        SuspendErase();
+    }
+    else if ( IsBusy() == true )
+    {
+        simStatistics.busyCommands++;
+    }
+    else
+    {
+        switch ( tx[0] )
+        {
+            case OPCODE_WRITE_ENABLE:
+                isWriteEnabled = true;
+                break;
+            case OPCODE_WRITE_DISABLE:
+                isWriteEnabled = false;
+                break;
+            case OPCODE_READ_ID:
+                if ( nBytes > 1u )
+                {
+                    rx[1] = 0x20u;
+                }
+                if ( nBytes > 2u )
+                {
+                    rx[2] = 0xBAu;
+                }
+                if ( nBytes > 3u )
+                {
+                    rx[3] = 0x18u;
+                }
+                break;
+            case OPCODE_READ:
+            case OPCODE_FAST_READ:
+                address = GetAddress(tx);
+                for ( byteIndex = (tx[0] == OPCODE_READ) ? ADDRESS_LENGTH : DUMMY_LENGTH; byteIndex < nBytes; byteIndex++ )
+                {
+                    rx[byteIndex] = simMemory[address % DATAFLASH_SIM_SIZE];
+                    address++;
+                }
+                break;
+            case OPCODE_READ_SFDP:
+                address = GetAddress(tx);
+                for ( byteIndex = DUMMY_LENGTH; (byteIndex < nBytes) && (hasSFDPTable == true); byteIndex++ )
+                {
+                    rx[byteIndex] = (address < SFDP_SIZE) ? sfdpArea[address] : 0xFFu;
+                    address++;
+                }
+                break;
+            case OPCODE_WRITE_STATUS:
+                isWriteEnabled = false;
+                break;
+            case OPCODE_RESUME:
+                ResumeErase();
+                break;
+            case OPCODE_PAGE_PROGRAM:
+            case OPCODE_SUBSECTOR_ERASE:
+            case OPCODE_BLOCK_ERASE:
+                if ( (isWriteEnabled == false) || (nBytes < ADDRESS_LENGTH) )
+                {
+                    simStatistics.unlatchedCommands++;
+                }
+                else if ( (isEraseSuspended == true) &&
+                          ((tx[0] != OPCODE_PAGE_PROGRAM) || (IsInSuspendedArea(GetAddress(tx)) == true)) )
+                {
+                    isWriteEnabled = false;
+                    simStatistics.suspendedCommands++;
+                }
+                else if ( tx[0] == OPCODE_PAGE_PROGRAM )
+                {
+                    isWriteEnabled = false;
+                    ProgramPage(tx, nBytes);
+                }
+                else if ( tx[0] == OPCODE_SUBSECTOR_ERASE )
+                {
+                    isWriteEnabled = false;
+                    EraseArea(GetAddress(tx), SUBSECTOR_SIZE, DATAFLASH_SIM_SUBSECTOR_ERASE_US);
+                    simStatistics.subsectorErases++;
+                }
+                else
+                {
+                    isWriteEnabled = false;
+                    EraseArea(GetAddress(tx), BLOCK_SIZE, DATAFLASH_SIM_BLOCK_ERASE_US);
+                    simStatistics.blockErases++;
+                }
+                break;
+            default:
+                simStatistics.unknownCommands++;
+                break;
+        }
+    }
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   DataflashSimOpen(const char *path)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function maps the file holding the dataflash, a new file is an
+//!  erased chip. It returns false if the file cannot be mapped
+//
+//------------------------------------------------------------------------------
+bool DataflashSimOpen(
+                        const char *path                                        //!< File of the dataflash
+                     )
+{
+    //For the file and its size
+    int file = open(path, O_RDWR | O_CREAT, 0644);
+    struct stat fileStatus;
+    //To check if the file is new
+    bool isNew = false;
+    //For the mapping
+    void *mapping = MAP_FAILED;
+    if ( (file >= 0) && (fstat(file, &fileStatus) == 0) )
+    {
+        isNew = (fileStatus.st_size != (off_t) DATAFLASH_SIM_SIZE);
+        if ( (isNew == false) || (ftruncate(file, (off_t) DATAFLASH_SIM_SIZE) == 0) )
+        {
+            mapping = mmap(NULL, DATAFLASH_SIM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( file >= 0 )
+    {
+        (void) close(file);
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( mapping != MAP_FAILED )
+    {
+        simMemory = mapping;
+        if ( isNew == true )
+        {
+            memset(simMemory, 0xFF, DATAFLASH_SIM_SIZE);
+        }
+        else
+        {
+            //Do nothing
+        }
+        memset(eraseCounts, 0, sizeof(eraseCounts));
+        memset(&simStatistics, 0, sizeof(simStatistics));
+        isWriteEnabled = false;
+        busyUntil = 0u;
+        eraseSize = 0u;
+        isEraseSuspended = false;
+        BuildSFDPArea();
+    }
+    else
+    {
+        //Do nothing
+    }
+    return (mapping != MAP_FAILED);
+}
+//------------------------------------------------------------------------------
+//   DataflashSimClose(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the dataflash to its file and unmaps it
+//
+//------------------------------------------------------------------------------
+void DataflashSimClose(void)
+{
+    if ( simMemory != NULL )
+    {
+        (void) msync(simMemory, DATAFLASH_SIM_SIZE, MS_SYNC);
+        (void) munmap(simMemory, DATAFLASH_SIM_SIZE);
+        simMemory = NULL;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   DataflashSimSetSFDP(bool hasTable, unsigned short pageSize)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function selects whether the chip has an SFDP table and its program
+//!  page size
+//
+//------------------------------------------------------------------------------
+void DataflashSimSetSFDP(
+                           bool hasTable,                                       //!< True if the SFDP table is answered
+                           unsigned short pageSize                              //!< Program page size, a power of two up to 256
+                        )
+{
+    (void) pthread_mutex_lock(&simMutex);
+    hasSFDPTable = hasTable;
+    simPageSize = pageSize;
+    BuildSFDPArea();
+    (void) pthread_mutex_unlock(&simMutex);
+}
+//------------------------------------------------------------------------------
+//   DataflashSimSetStuckBusy(bool isStuck)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function makes the chip report busy for ever and ignore every other
+//!  command, or releases it
+//
+//------------------------------------------------------------------------------
+void DataflashSimSetStuckBusy(
+                                bool isStuck                                    //!< True to keep the chip busy
+                             )
+{
+    (void) pthread_mutex_lock(&simMutex);
+    isStuckBusy = isStuck;
+    (void) pthread_mutex_unlock(&simMutex);
+}
+//------------------------------------------------------------------------------
+//   DataflashSimGetMemory(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the mapped content of the dataflash
+//
+//------------------------------------------------------------------------------
+unsigned char *DataflashSimGetMemory(void)
+{
+    return simMemory;
+}
+//------------------------------------------------------------------------------
+//   DataflashSimGetStatistics(DATAFLASH_SIM_STATISTICS_STRUCT *statistics)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the statistics since the last reset
+//
+//------------------------------------------------------------------------------
+void DataflashSimGetStatistics(
+                                 DATAFLASH_SIM_STATISTICS_STRUCT *statistics    //!< Statistics
+                              )
+{
+    (void) pthread_mutex_lock(&simMutex);
+    *statistics = simStatistics;
+    (void) pthread_mutex_unlock(&simMutex);
+}
+//------------------------------------------------------------------------------
+//   DataflashSimResetStatistics(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function clears the statistics
+//
+//------------------------------------------------------------------------------
+void DataflashSimResetStatistics(void)
+{
+    (void) pthread_mutex_lock(&simMutex);
+    memset(&simStatistics, 0, sizeof(simStatistics));
+    (void) pthread_mutex_unlock(&simMutex);
+}
+//------------------------------------------------------------------------------
+//   DataflashSimGetEraseCount(unsigned short subsectorNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the erases of a subsector since the file was opened
+//
+//------------------------------------------------------------------------------
+unsigned int DataflashSimGetEraseCount(
+                                         unsigned short subsectorNumber         //!< Subsector
+                                      )
+{
+    return (subsectorNumber < SUBSECTORS) ? eraseCounts[subsectorNumber] : 0u;
+}
+//------------------------------------------------------------------------------
+//   SPI_Params_init(SPI_Params *params)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sets the default SPI parameters
+//
+//------------------------------------------------------------------------------
+void SPI_Params_init(
+                       SPI_Params *params                                       //!< SPI parameters
+                    )
+{
+    memset(params, 0, sizeof(SPI_Params));
+    params->bitRate = DEFAULT_BIT_RATE;
+    params->dataSize = 8u;
+}
+//------------------------------------------------------------------------------
+//   SPI_open(unsigned int index, SPI_Params *params)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function opens the SPI of the simulated dataflash, whatever the
+//!  index, and keeps its bit rate for the transfer times
+//
+//------------------------------------------------------------------------------
+SPI_Handle SPI_open(
+                      unsigned int index,                                       //!< Board SPI
+                      SPI_Params *params                                        //!< SPI parameters
+                   )
+{
+    (void) index;
+    if ( (params != NULL) && (params->bitRate != 0u) )
+    {
+        simBitRate = params->bitRate;
+    }
+    else
+    {
+        //Do nothing
+    }
+    return &simConfig;
+}
+//------------------------------------------------------------------------------
+//   SPI_transfer(SPI_Handle handle, SPI_Transaction *transaction)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sends and receives the bytes of one command
+//
+//------------------------------------------------------------------------------
+bool SPI_transfer(
+                    SPI_Handle handle,                                          //!< SPI handle
+                    SPI_Transaction *transaction                                //!< Transaction
+                 )
+{
+    //To check if the transfer is done
+    bool isDone = false;
+    (void) pthread_mutex_lock(&simMutex);
+    if ( (handle == &simConfig) && (simMemory != NULL) && (transaction->count > 0u) &&
+         (transaction->count <= TRANSFER_BUFFER_SIZE) && (transaction->txBuf != NULL) )
+    {
+        memcpy(transferTx, transaction->txBuf, transaction->count);
+        RunCommand(transferTx, transferRx, transaction->count);
+        if ( transaction->rxBuf != NULL )
+        {
+            memcpy(transaction->rxBuf, transferRx, transaction->count);
+        }
+        else
+        {
+            //Do nothing
+        }
+        isDone = true;
+    }
+    else
+    {
+        simStatistics.failedTransfers++;
+    }
+    transaction->status = isDone ? SPI_TRANSFER_COMPLETED : SPI_TRANSFER_FAILED;
+    (void) pthread_mutex_unlock(&simMutex);
+    return isDone;
+}
+//------------------------------------------------------------------------------
+//   SPITivaDMA_transferSG(SPI_Handle handle, SPITivaDMA_SGTransaction *sgTransaction)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sends the command segment and then the data segment under
+//!  one chip select. The received data bytes are the ones after the command,
+//!  a segment over the uDMA limit fails as on the target
+//
+//------------------------------------------------------------------------------
+bool SPITivaDMA_transferSG(
+                             SPI_Handle handle,                                 //!< SPI handle
+                             SPITivaDMA_SGTransaction *sgTransaction            //!< Command and data segments
+                          )
+{
+    //For the bytes of the segments
+    size_t commandBytes = sgTransaction->cmdCount;
+    size_t dataBytes = sgTransaction->transaction.count;
+    //To check if the transfer is done
+    bool isDone = false;
+    (void) pthread_mutex_lock(&simMutex);
+    if ( (handle == &simConfig) && (simMemory != NULL) && (commandBytes > 0u) && (commandBytes <= DMA_TRANSFER_LIMIT) &&
+         (dataBytes > 0u) && (dataBytes <= DMA_TRANSFER_LIMIT) && (sgTransaction->cmdBuf != NULL) )
+    {
+        memcpy(transferTx, sgTransaction->cmdBuf, commandBytes);
+        if ( sgTransaction->transaction.txBuf != NULL )
+        {
+            memcpy(&transferTx[commandBytes], sgTransaction->transaction.txBuf, dataBytes);
+        }
+        else
+        {
+            memset(&transferTx[commandBytes], 0xFF, dataBytes);
+        }
+        RunCommand(transferTx, transferRx, commandBytes + dataBytes);
+        if ( sgTransaction->transaction.rxBuf != NULL )
+        {
+            memcpy(sgTransaction->transaction.rxBuf, &transferRx[commandBytes], dataBytes);
+        }
+        else
+        {
+            //Do nothing
+        }
+        isDone = true;
+    }
+    else
+    {
+        simStatistics.failedTransfers++;
+    }
+    sgTransaction->transaction.status = isDone ? SPI_TRANSFER_COMPLETED : SPI_TRANSFER_FAILED;
+    (void) pthread_mutex_unlock(&simMutex);
+    return isDone;
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,195 @@
+//==============================================================================
+//
+//  DataflashSim.h
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashSim.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the simulated N25Q128 dataflash of the host build. The
+//! simulator answers the SPI transfers of Dataflash.c from a file mapped in
+//! memory, so the content survives the end of a process like a real chip
+//! survives a power cut
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __DATAFLASHSIM_H__
+#define __DATAFLASHSIM_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define DATAFLASH_SIM_SIZE 0x1000000u                                           //!< Bytes of the N25Q128
+#define DATAFLASH_SIM_PAGE_SIZE 256u                                            //!< Bytes of a program page of the N25Q128
+#define DATAFLASH_SIM_PROGRAM_US 500u                                           //!< Typical page program time
+#define DATAFLASH_SIM_SUBSECTOR_ERASE_US 250000u                                //!< Typical 4 Kbyte subsector erase time
+#define DATAFLASH_SIM_BLOCK_ERASE_US 700000u                                    //!< Typical 64 Kbyte sector erase time
+#define DATAFLASH_SIM_SUSPEND_US 20u                                            //!< Erase suspend latency
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! This data structure counts what the simulated dataflash has been asked to do
+typedef struct
+{
+    unsigned int transfers;                                                     //!< SPI transfers, a segmented transfer counts once
+    unsigned int statusReads;                                                   //!< Status register reads
+    unsigned int pagePrograms;                                                  //!< Page programs done
+    unsigned int subsectorErases;                                               //!< Subsector erases done
+    unsigned int blockErases;                                                   //!< Block erases done
+    unsigned int pageWraps;                                                     //!< Page programs whose bytes went past the end of the page
+    unsigned int busyCommands;                                                  //!< Commands other than a status read sent while busy, ignored
+    unsigned int unlatchedCommands;                                             //!< Program or erase commands sent without write enable, ignored
+    unsigned int unknownCommands;                                               //!< Commands not simulated, ignored
+    unsigned int eraseSuspends;                                                 //!< Erases suspended
+    unsigned int suspendedCommands;                                             //!< Erases and programs of the suspended area sent during a suspend, ignored
+    unsigned int failedTransfers;                                               //!< Segmented transfers over the uDMA limit, failed
+
+} DATAFLASH_SIM_STATISTICS_STRUCT;
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   DataflashSimOpen(const char *path)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function maps the file holding the dataflash, a new file is an
+//!  erased chip. It returns false if the file cannot be mapped
+//
+//------------------------------------------------------------------------------
+bool DataflashSimOpen(
+                        const char *path                                        //!< File of the dataflash
+                     );
+//------------------------------------------------------------------------------
+//   DataflashSimClose(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the dataflash to its file and unmaps it
+//
+//------------------------------------------------------------------------------
+void DataflashSimClose(void);
+//------------------------------------------------------------------------------
+//   DataflashSimSetSFDP(bool hasTable, unsigned short pageSize)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function selects whether the chip has an SFDP table and its program
+//!  page size, a program wraps at the end of the page as on a real chip. The
+//!  default is an N25Q128 with its table and 256 byte pages
+//
+//------------------------------------------------------------------------------
+void DataflashSimSetSFDP(
+                           bool hasTable,                                       //!< True if the SFDP table is answered
+                           unsigned short pageSize                              //!< Program page size, a power of two up to 256
+                        );
+//------------------------------------------------------------------------------
+//   DataflashSimSetStuckBusy(bool isStuck)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function makes the chip report busy for ever and ignore every other
+//!  command, or releases it
+//
+//------------------------------------------------------------------------------
+void DataflashSimSetStuckBusy(
+                                bool isStuck                                    //!< True to keep the chip busy
+                             );
+//------------------------------------------------------------------------------
+//   DataflashSimGetMemory(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the mapped content of the dataflash, for the tests
+//!  to check it or damage it
+//
+//------------------------------------------------------------------------------
+unsigned char *DataflashSimGetMemory(void);
+//------------------------------------------------------------------------------
+//   DataflashSimGetStatistics(DATAFLASH_SIM_STATISTICS_STRUCT *statistics)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the statistics since the last reset
+//
+//------------------------------------------------------------------------------
+void DataflashSimGetStatistics(
+                                 DATAFLASH_SIM_STATISTICS_STRUCT *statistics    //!< Statistics
+                              );
+//------------------------------------------------------------------------------
+//   DataflashSimResetStatistics(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function clears the statistics
+//
+//------------------------------------------------------------------------------
+void DataflashSimResetStatistics(void);
+//------------------------------------------------------------------------------
+//   DataflashSimGetEraseCount(unsigned short subsectorNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the erases of a subsector since the file was opened,
+//!  a block erase counts for each of its subsectors
+//
+//------------------------------------------------------------------------------
+unsigned int DataflashSimGetEraseCount(
+                                         unsigned short subsectorNumber         //!< Subsector
+                                      );
+
+#endif /* __DATAFLASHSIM_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
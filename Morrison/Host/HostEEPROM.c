@@ -0,0 +1,339 @@
+//==============================================================================
+//
+//  HostEEPROM.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostEEPROM.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module implements the TivaWare EEPROM calls used by TM4CEEPROM.c over
+//! a file mapped in memory, 96 blocks of 16 words erased to 0xFFFFFFFF. A
+//! word is programmed at once, a power cut armed with HostSetPowerCut leaves
+//! the word it cuts with some bytes of the old value and some of the new one
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "HostRTOS.h"
+#include "HostEEPROM.h"
+#include "driverlib/eeprom.h"
+#include "driverlib/sysctl.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define EEPROM_BLOCKS 96u                                                       //!< Blocks of the TM4C1294 EEPROM
+#define EEPROM_BLOCK_WORDS 16u                                                  //!< Words of a block
+#define EEPROM_SIZE (EEPROM_BLOCKS*EEPROM_BLOCK_WORDS*4u)                       //!< Bytes of the EEPROM
+#define EEPROM_PROGRAM_US 110u                                                  //!< Typical word program time
+#define EEPROM_RW_ERROR 0x01u                                                   //!< Error returned for an access outside the EEPROM
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static uint32_t *eepromWords = NULL;                                            //!< Mapped file of the EEPROM
+static pthread_mutex_t eepromMutex = PTHREAD_MUTEX_INITIALIZER;                 //!< Serializes the accesses
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   HostEEPROMOpen(const char *path)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function maps the file holding the EEPROM, a new file is an erased
+//!  EEPROM. It returns false if the file cannot be mapped
+//
+//------------------------------------------------------------------------------
+bool HostEEPROMOpen(
+                      const char *path                                          //!< File of the EEPROM
+                   )
+{
+    //For the file and its size
+    int file = open(path, O_RDWR | O_CREAT, 0644);
+    struct stat fileStatus;
+    //To check if the file is new
+    bool isNew = false;
+    //For the mapping
+    void *mapping = MAP_FAILED;
+    if ( (file >= 0) && (fstat(file, &fileStatus) == 0) )
+    {
+        isNew = (fileStatus.st_size != (off_t) EEPROM_SIZE);
+        if ( (isNew == false) || (ftruncate(file, (off_t) EEPROM_SIZE) == 0) )
+        {
+            mapping = mmap(NULL, EEPROM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( file >= 0 )
+    {
+        (void) close(file);
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( mapping != MAP_FAILED )
+    {
+        eepromWords = mapping;
+        if ( isNew == true )
+        {
+            memset(eepromWords, 0xFF, EEPROM_SIZE);
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    return (mapping != MAP_FAILED);
+}
+//------------------------------------------------------------------------------
+//   HostEEPROMClose(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the EEPROM to its file and unmaps it
+//
+//------------------------------------------------------------------------------
+void HostEEPROMClose(void)
+{
+    if ( eepromWords != NULL )
+    {
+        (void) msync(eepromWords, EEPROM_SIZE, MS_SYNC);
+        (void) munmap(eepromWords, EEPROM_SIZE);
+        eepromWords = NULL;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function does nothing, the simulated peripherals are always on
+//
+//------------------------------------------------------------------------------
+void SysCtlPeripheralEnable(
+                              uint32_t ui32Peripheral                           //!< Peripheral
+                           )
+{
+    (void) ui32Peripheral;
+}
+//------------------------------------------------------------------------------
+//   EEPROMInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns EEPROM_INIT_OK once the file is mapped
+//
+//------------------------------------------------------------------------------
+uint32_t EEPROMInit(void)
+{
+    return (eepromWords != NULL) ? EEPROM_INIT_OK : EEPROM_RW_ERROR;
+}
+//------------------------------------------------------------------------------
+//   EEPROMSizeGet(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the bytes of the EEPROM
+//
+//------------------------------------------------------------------------------
+uint32_t EEPROMSizeGet(void)
+{
+    return EEPROM_SIZE;
+}
+//------------------------------------------------------------------------------
+//   EEPROMBlockCountGet(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the blocks of the EEPROM
+//
+//------------------------------------------------------------------------------
+uint32_t EEPROMBlockCountGet(void)
+{
+    return EEPROM_BLOCKS;
+}
+//------------------------------------------------------------------------------
+//   EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads words, the bytes outside the EEPROM read as erased
+//
+//------------------------------------------------------------------------------
+void EEPROMRead(
+                  uint32_t *pui32Data,                                          //!< Words read
+                  uint32_t ui32Address,                                         //!< Byte address, a multiple of 4
+                  uint32_t ui32Count                                            //!< Bytes, a multiple of 4
+               )
+{
+    //For indexing the loop
+    uint32_t wordIndex = 0u;
+    (void) pthread_mutex_lock(&eepromMutex);
+    for ( wordIndex = 0u; wordIndex < (ui32Count / 4u); wordIndex++ )
+    {
+        if ( (eepromWords != NULL) && ((ui32Address + (wordIndex * 4u)) < EEPROM_SIZE) )
+        {
+            pui32Data[wordIndex] = eepromWords[(ui32Address / 4u) + wordIndex];
+        }
+        else
+        {
+            pui32Data[wordIndex] = 0xFFFFFFFFu;
+        }
+    }
+    (void) pthread_mutex_unlock(&eepromMutex);
+}
+//------------------------------------------------------------------------------
+//   EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs words in order. It returns 0 if they are all
+//!  programmed
+//
+//------------------------------------------------------------------------------
+uint32_t EEPROMProgram(
+                         uint32_t *pui32Data,                                   //!< Words to be programmed
+                         uint32_t ui32Address,                                  //!< Byte address, a multiple of 4
+                         uint32_t ui32Count                                     //!< Bytes, a multiple of 4
+                      )
+{
+    //For indexing the loop
+    uint32_t wordIndex = 0u;
+    //For the bytes of the new value kept by a power cut
+    uint32_t keptMask = 0u;
+    //For the status returned
+    uint32_t status = 0u;
+    (void) pthread_mutex_lock(&eepromMutex);
+    if ( (eepromWords == NULL) || ((ui32Address + ui32Count) > EEPROM_SIZE) )
+    {
+        status = EEPROM_RW_ERROR;
+    }
+    else
+    {
+        for ( wordIndex = 0u; wordIndex < (ui32Count / 4u); wordIndex++ )
+        {
+            if ( HostIsPowerCut() == true )
+            {
+                keptMask = HostRandom() & 0x01010101u;
+                keptMask = keptMask * 0xFFu;
+                eepromWords[(ui32Address / 4u) + wordIndex] = (pui32Data[wordIndex] & keptMask) |
+                                                             (eepromWords[(ui32Address / 4u) + wordIndex] & ~keptMask);
+                HostPowerOff();
+            }
+            else
+            {
+                eepromWords[(ui32Address / 4u) + wordIndex] = pui32Data[wordIndex];
+            }
+            HostAdvanceMicroseconds(EEPROM_PROGRAM_US);
+        }
+    }
+    (void) pthread_mutex_unlock(&eepromMutex);
+    return status;
+}
+//------------------------------------------------------------------------------
+//   EEPROMMassErase(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases every word, it returns 0 as the TivaWare call
+//
+//------------------------------------------------------------------------------
+uint32_t EEPROMMassErase(void)
+{
+    (void) pthread_mutex_lock(&eepromMutex);
+    if ( eepromWords != NULL )
+    {
+        memset(eepromWords, 0xFF, EEPROM_SIZE);
+    }
+    else
+    {
+        //Do nothing
+    }
+    (void) pthread_mutex_unlock(&eepromMutex);
+    return 0u;
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,94 @@
+//==============================================================================
+//
+//  HostEEPROM.h
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostEEPROM.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the simulated internal EEPROM of the host build. The
+//! TivaWare EEPROM calls of TM4CEEPROM.c are answered from a file mapped in
+//! memory
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __HOSTEEPROM_H__
+#define __HOSTEEPROM_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   HostEEPROMOpen(const char *path)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function maps the file holding the EEPROM, a new file is an erased
+//!  EEPROM. It returns false if the file cannot be mapped
+//
+//------------------------------------------------------------------------------
+bool HostEEPROMOpen(
+                      const char *path                                          //!< File of the EEPROM
+                   );
+//------------------------------------------------------------------------------
+//   HostEEPROMClose(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the EEPROM to its file and unmaps it
+//
+//------------------------------------------------------------------------------
+void HostEEPROMClose(void);
+
+#endif /* __HOSTEEPROM_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
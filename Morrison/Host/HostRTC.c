@@ -0,0 +1,90 @@
+//==============================================================================
+//
+//  HostRTC.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostRTC.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module implements the RTC call used by the logs in the host build.
+//! The date and time follow the simulated time from 2026/10/17 00:00:00, the
+//! years are counted from 2000 and the months from 1 as the event log
+//! expects them
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <time.h>
+#include "HostRTOS.h"
+#include "TM4CRTC.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define START_TIME 1792195200                                                   //!< 2026/10/17 00:00:00 UTC in seconds since 1970
+#define MICROSECONDS_PER_SECOND 1000000u                                        //!< Microseconds in a second
+#define YEARS_TO_2000 100                                                       //!< Years of struct tm before 2000
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   RTCGetCurrentDateTime(DATE_TIME_STRUCT *dateTime)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the simulated date and time
+//
+//------------------------------------------------------------------------------
+void RTCGetCurrentDateTime(
+                             DATE_TIME_STRUCT *dateTime                         //!< Date and time
+                          )
+{
+    //For the simulated time in seconds since 1970
+    time_t currentTime = (time_t) START_TIME + (time_t) (HostGetMicroseconds() / MICROSECONDS_PER_SECOND);
+    //For the calendar time
+    struct tm calendarTime;
+    (void) gmtime_r(&currentTime, &calendarTime);
+    dateTime->monthId = (unsigned char) (calendarTime.tm_mon + 1);
+    dateTime->dayId = (unsigned char) calendarTime.tm_mday;
+    dateTime->yearId = (unsigned short) (calendarTime.tm_year - YEARS_TO_2000);
+    dateTime->hourId = (unsigned char) calendarTime.tm_hour;
+    dateTime->minId = (unsigned char) calendarTime.tm_min;
+    dateTime->secondId = (unsigned char) calendarTime.tm_sec;
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,608 @@
+//==============================================================================
+//
+//  HostRTOS.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostRTOS.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module implements the part of TI-RTOS used by the dataflash and the
+//! logs on a Linux host. The simulated time only moves forward when a thread
+//! sleeps or a byte is sent over the simulated SPI, so a run does not depend
+//! on the speed of the host
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "HostRTOS.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define SLEEP_HOST_NANOSECONDS 20000L                                           //!< Host time given to the other threads by a sleep
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+
+struct GateMutex_Object
+{
+    pthread_mutex_t mutex;                                                      //!< Recursive mutex of the gate
+};
+
+struct Semaphore_Object
+{
+    pthread_mutex_t mutex;                                                      //!< Serializes the count
+    pthread_cond_t condition;                                                   //!< Signalled by a post
+    unsigned int count;                                                         //!< Posts not taken yet
+    Semaphore_Mode mode;                                                        //!< Counting or binary semaphore
+};
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+UInt32 Clock_tickPeriod = HOST_TICK_PERIOD_US;                                  //!< Microseconds of a clock tick
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static _Atomic uint64_t localMicroseconds = 0u;                                 //!< Simulated time of this process only
+static _Atomic uint64_t *simulatedMicroseconds = &localMicroseconds;            //!< Simulated time since the start
+static _Atomic unsigned int powerCutCountdown = 0u;                             //!< Operations up to the power cut, zero if none is armed
+static pthread_mutex_t hwiMutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;       //!< Lock standing for the disabled interrupts
+static pthread_mutex_t randomMutex = PTHREAD_MUTEX_INITIALIZER;                 //!< Serializes the random numbers
+static uint32_t randomState = 2463534242u;                                      //!< State of the random numbers
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   Error_init(Error_Block *errorBlock)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function clears an error block
+//
+//------------------------------------------------------------------------------
+void Error_init(
+                  Error_Block *errorBlock                                       //!< Error block
+               )
+{
+    errorBlock->unused = 0;
+}
+//------------------------------------------------------------------------------
+//   System_printf(const char *format, ...)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function prints to the standard output
+//
+//------------------------------------------------------------------------------
+int System_printf(
+                    const char *format,                                         //!< Format of the text
+                    ...
+                 )
+{
+    //For the arguments of the format
+    va_list arguments;
+    //For the characters printed
+    int length = 0;
+    va_start(arguments, format);
+    length = vprintf(format, arguments);
+    va_end(arguments);
+    return length;
+}
+//------------------------------------------------------------------------------
+//   System_flush(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function flushes the standard output
+//
+//------------------------------------------------------------------------------
+void System_flush(void)
+{
+    (void) fflush(stdout);
+}
+//------------------------------------------------------------------------------
+//   System_abort(const char *message)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function prints the message and aborts the process
+//
+//------------------------------------------------------------------------------
+void System_abort(
+                    const char *message                                         //!< Reason of the abort
+                 )
+{
+    (void) fprintf(stderr, "System_abort: %s\n", message);
+    abort();
+}
+//------------------------------------------------------------------------------
+//   BIOS_getThreadType(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the thread type, every host thread is a task
+//
+//------------------------------------------------------------------------------
+BIOS_ThreadType BIOS_getThreadType(void)
+{
+    return BIOS_ThreadType_Task;
+}
+//------------------------------------------------------------------------------
+//   Task_sleep(UInt32 ticks)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function advances the simulated time by the ticks and lets the other
+//!  threads run for a short host time
+//
+//------------------------------------------------------------------------------
+void Task_sleep(
+                  UInt32 ticks                                                  //!< Ticks to sleep
+               )
+{
+    //For the host time given to the other threads
+    struct timespec hostSleep = {0, SLEEP_HOST_NANOSECONDS};
+    HostAdvanceMicroseconds((uint64_t) ticks * Clock_tickPeriod);
+    (void) nanosleep(&hostSleep, NULL);
+}
+//------------------------------------------------------------------------------
+//   Task_yield(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function lets the other threads run
+//
+//------------------------------------------------------------------------------
+void Task_yield(void)
+{
+    (void) sched_yield();
+}
+//------------------------------------------------------------------------------
+//   Clock_getTicks(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the simulated time in ticks
+//
+//------------------------------------------------------------------------------
+UInt32 Clock_getTicks(void)
+{
+    return (UInt32) (HostGetMicroseconds() / Clock_tickPeriod);
+}
+//------------------------------------------------------------------------------
+//   Hwi_disable(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function takes the lock standing for the interrupts being disabled
+//
+//------------------------------------------------------------------------------
+UInt Hwi_disable(void)
+{
+    (void) pthread_mutex_lock(&hwiMutex);
+    return 0u;
+}
+//------------------------------------------------------------------------------
+//   Hwi_restore(UInt key)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function leaves the lock taken by Hwi_disable
+//
+//------------------------------------------------------------------------------
+void Hwi_restore(
+                   UInt key                                                     //!< Key returned by Hwi_disable
+                )
+{
+    (void) key;
+    (void) pthread_mutex_unlock(&hwiMutex);
+}
+//------------------------------------------------------------------------------
+//   GateMutex_create(const GateMutex_Params *params, Error_Block *errorBlock)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates a gate, which the owner thread may enter again as
+//!  a GateMutex of TI-RTOS
+//
+//------------------------------------------------------------------------------
+GateMutex_Handle GateMutex_create(
+                                    const GateMutex_Params *params,             //!< Parameters, not used
+                                    Error_Block *errorBlock                     //!< Error block, not used
+                                 )
+{
+    //For the attributes of the mutex
+    pthread_mutexattr_t attributes;
+    //For the gate created
+    GateMutex_Handle gate = malloc(sizeof(struct GateMutex_Object));
+    (void) params;
+    (void) errorBlock;
+    if ( gate != NULL )
+    {
+        (void) pthread_mutexattr_init(&attributes);
+        (void) pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+        (void) pthread_mutex_init(&gate->mutex, &attributes);
+        (void) pthread_mutexattr_destroy(&attributes);
+    }
+    else
+    {
+        System_abort("GateMutex_create: out of memory");
+    }
+    return gate;
+}
+//------------------------------------------------------------------------------
+//   GateMutex_enter(GateMutex_Handle gate)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function enters a gate, waiting for the other threads to leave it
+//
+//------------------------------------------------------------------------------
+IArg GateMutex_enter(
+                       GateMutex_Handle gate                                    //!< Gate
+                    )
+{
+    (void) pthread_mutex_lock(&gate->mutex);
+    return 0;
+}
+//------------------------------------------------------------------------------
+//   GateMutex_leave(GateMutex_Handle gate, IArg key)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function leaves a gate
+//
+//------------------------------------------------------------------------------
+void GateMutex_leave(
+                       GateMutex_Handle gate,                                   //!< Gate
+                       IArg key                                                 //!< Key returned by GateMutex_enter
+                    )
+{
+    (void) key;
+    (void) pthread_mutex_unlock(&gate->mutex);
+}
+//------------------------------------------------------------------------------
+//   Semaphore_Params_init(Semaphore_Params *params)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sets the parameters of a counting semaphore
+//
+//------------------------------------------------------------------------------
+void Semaphore_Params_init(
+                             Semaphore_Params *params                           //!< Parameters
+                          )
+{
+    params->mode = Semaphore_Mode_COUNTING;
+}
+//------------------------------------------------------------------------------
+//   Semaphore_create(Int count, const Semaphore_Params *params, Error_Block *errorBlock)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates a semaphore with its initial count
+//
+//------------------------------------------------------------------------------
+Semaphore_Handle Semaphore_create(
+                                    Int count,                                  //!< Initial count
+                                    const Semaphore_Params *params,             //!< Parameters, NULL for a counting semaphore
+                                    Error_Block *errorBlock                     //!< Error block, not used
+                                 )
+{
+    //For the semaphore created
+    Semaphore_Handle semaphore = malloc(sizeof(struct Semaphore_Object));
+    (void) errorBlock;
+    if ( semaphore != NULL )
+    {
+        (void) pthread_mutex_init(&semaphore->mutex, NULL);
+        (void) pthread_cond_init(&semaphore->condition, NULL);
+        semaphore->count = (unsigned int) count;
+        semaphore->mode = (params != NULL) ? params->mode : Semaphore_Mode_COUNTING;
+    }
+    else
+    {
+        System_abort("Semaphore_create: out of memory");
+    }
+    return semaphore;
+}
+//------------------------------------------------------------------------------
+//   Semaphore_pend(Semaphore_Handle semaphore, UInt32 timeout)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function takes a count of the semaphore. A thread waiting for ever
+//!  blocks on the condition, the simulated time does not move for it. A
+//!  thread waiting up to a timeout sleeps one tick at a time, as the timeout
+//!  is simulated time
+//
+//------------------------------------------------------------------------------
+Bool Semaphore_pend(
+                      Semaphore_Handle semaphore,                               //!< Semaphore
+                      UInt32 timeout                                            //!< Ticks to wait, BIOS_NO_WAIT or BIOS_WAIT_FOREVER
+                   )
+{
+    //For the ticks waited
+    UInt32 waitedTicks = 0u;
+    //For the result
+    Bool isTaken = false;
+    (void) pthread_mutex_lock(&semaphore->mutex);
+    if ( timeout == BIOS_WAIT_FOREVER )
+    {
+        while ( semaphore->count == 0u )
+        {
+            (void) pthread_cond_wait(&semaphore->condition, &semaphore->mutex);
+        }
+    }
+    else
+    {
+        while ( (semaphore->count == 0u) && (waitedTicks < timeout) )
+        {
+            (void) pthread_mutex_unlock(&semaphore->mutex);
+            Task_sleep(1u);
+            waitedTicks++;
+            (void) pthread_mutex_lock(&semaphore->mutex);
+        }
+    }
+    if ( semaphore->count != 0u )
+    {
+        semaphore->count--;
+        isTaken = true;
+    }
+    else
+    {
+        //Do nothing
+    }
+    (void) pthread_mutex_unlock(&semaphore->mutex);
+    return isTaken;
+}
+//------------------------------------------------------------------------------
+//   Semaphore_post(Semaphore_Handle semaphore)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function adds a count to the semaphore and wakes a waiting thread
+//
+//------------------------------------------------------------------------------
+void Semaphore_post(
+                      Semaphore_Handle semaphore                                //!< Semaphore
+                   )
+{
+    (void) pthread_mutex_lock(&semaphore->mutex);
+    if ( (semaphore->mode == Semaphore_Mode_COUNTING) || (semaphore->count == 0u) )
+    {
+        semaphore->count++;
+    }
+    else
+    {
+        //Do nothing
+    }
+    (void) pthread_cond_signal(&semaphore->condition);
+    (void) pthread_mutex_unlock(&semaphore->mutex);
+}
+//------------------------------------------------------------------------------
+//   HostGetMicroseconds(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the simulated time in microseconds
+//
+//------------------------------------------------------------------------------
+uint64_t HostGetMicroseconds(void)
+{
+    return atomic_load(simulatedMicroseconds);
+}
+//------------------------------------------------------------------------------
+//   HostAdvanceMicroseconds(uint64_t microseconds)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function advances the simulated time
+//
+//------------------------------------------------------------------------------
+void HostAdvanceMicroseconds(
+                               uint64_t microseconds                            //!< Time to be added
+                            )
+{
+    (void) atomic_fetch_add(simulatedMicroseconds, microseconds);
+}
+//------------------------------------------------------------------------------
+//   HostShareClock(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function moves the simulated time to a shared mapping, the child
+//!  processes started next share it with this one
+//
+//------------------------------------------------------------------------------
+void HostShareClock(void)
+{
+    //For the shared mapping
+    void *mapping = mmap(NULL, sizeof(localMicroseconds), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if ( (mapping != MAP_FAILED) && (simulatedMicroseconds == &localMicroseconds) )
+    {
+        simulatedMicroseconds = mapping;
+        atomic_store(simulatedMicroseconds, atomic_load(&localMicroseconds));
+    }
+    else
+    {
+        //Do nothing, the time stays local
+    }
+}
+//------------------------------------------------------------------------------
+//   HostSeedRandom(uint32_t seed)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function seeds the random numbers of the simulated faults
+//
+//------------------------------------------------------------------------------
+void HostSeedRandom(
+                      uint32_t seed                                             //!< Seed, not zero
+                   )
+{
+    (void) pthread_mutex_lock(&randomMutex);
+    randomState = (seed != 0u) ? seed : 1u;
+    (void) pthread_mutex_unlock(&randomMutex);
+}
+//------------------------------------------------------------------------------
+//   HostRandom(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the next number of a xorshift generator, the runs
+//!  are repeated with the same seed
+//
+//------------------------------------------------------------------------------
+uint32_t HostRandom(void)
+{
+    //For the number returned
+    uint32_t value = 0u;
+    (void) pthread_mutex_lock(&randomMutex);
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    value = randomState;
+    (void) pthread_mutex_unlock(&randomMutex);
+    return value;
+}
+//------------------------------------------------------------------------------
+//   HostSetPowerCut(unsigned int operations)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function arms a power cut, the given program or erase operation of
+//!  the dataflash or the EEPROM is cut. Zero disarms it
+//
+//------------------------------------------------------------------------------
+void HostSetPowerCut(
+                       unsigned int operations                                  //!< Operations up to the one cut, counting it
+                    )
+{
+    atomic_store(&powerCutCountdown, operations);
+}
+//------------------------------------------------------------------------------
+//   HostIsPowerCut(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function counts a program or erase operation. It returns true if the
+//!  power is cut during it
+//
+//------------------------------------------------------------------------------
+bool HostIsPowerCut(void)
+{
+    //For the operations left before this one
+    unsigned int countdown = atomic_load(&powerCutCountdown);
+    //To check if the power is cut
+    bool isCut = false;
+    while ( (countdown != 0u) &&
+            (atomic_compare_exchange_weak(&powerCutCountdown, &countdown, countdown - 1u) == false) )
+    {
+        //Do nothing, the count is read again
+    }
+    if ( countdown == 1u )
+    {
+        isCut = true;
+    }
+    else
+    {
+        //Do nothing
+    }
+    return isCut;
+}
+//------------------------------------------------------------------------------
+//   HostPowerOff(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function ends the process at once, the files of the dataflash and
+//!  the EEPROM are shared mappings and keep every byte written so far
+//
+//------------------------------------------------------------------------------
+void HostPowerOff(void)
+{
+    _exit(HOST_POWER_CUT_EXIT_CODE);
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
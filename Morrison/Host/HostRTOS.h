@@ -0,0 +1,429 @@
+//==============================================================================
+//
+//  HostRTOS.h
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostRTOS.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the part of TI-RTOS used by the dataflash and the logs
+//! when they are built on a Linux host. The tasks are POSIX threads, the gates
+//! are recursive mutexes, the semaphores are counters under a mutex and the
+//! time is simulated, it advances with the sleeps and the SPI transfers. It
+//! also declares the power cut of the simulated board
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __HOSTRTOS_H__
+#define __HOSTRTOS_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define TRUE 1                                                                  //!< XDC true
+#define FALSE 0                                                                 //!< XDC false
+#define BIOS_WAIT_FOREVER (~(0u))                                               //!< Wait until the object is available
+#define BIOS_NO_WAIT 0u                                                         //!< Do not wait
+#define HOST_TICK_PERIOD_US 1000u                                               //!< Microseconds of a clock tick, as in Morrison.cfg
+#define HOST_POWER_CUT_EXIT_CODE 77                                             //!< Exit code of a process whose power has been cut
+
+typedef void *Ptr;                                                              //!< XDC pointer
+typedef int Int;                                                                //!< XDC integer
+typedef unsigned int UInt;                                                      //!< XDC unsigned integer
+typedef uint32_t UInt32;                                                        //!< XDC 32 bit unsigned integer
+typedef uintptr_t UArg;                                                         //!< XDC argument
+typedef intptr_t IArg;                                                          //!< XDC gate key
+typedef bool Bool;                                                              //!< XDC boolean
+typedef char Char;                                                              //!< XDC character
+typedef size_t SizeT;                                                           //!< XDC size
+
+typedef enum
+{
+    BIOS_ThreadType_Hwi,                                                        //!< Hardware interrupt
+    BIOS_ThreadType_Swi,                                                        //!< Software interrupt
+    BIOS_ThreadType_Task,                                                       //!< Task
+    BIOS_ThreadType_Main                                                        //!< Start up before BIOS_start
+} BIOS_ThreadType;
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+typedef struct
+{
+    int unused;                                                                 //!< Errors are not reported on the host
+} Error_Block;
+
+typedef struct
+{
+    int unused;                                                                 //!< Semaphores are only created on the host
+} Semaphore_Struct;
+
+typedef enum
+{
+    Semaphore_Mode_COUNTING,                                                    //!< Every post is counted
+    Semaphore_Mode_BINARY                                                       //!< The count is at most one
+} Semaphore_Mode;
+
+typedef struct
+{
+    Semaphore_Mode mode;                                                        //!< Counting or binary semaphore
+} Semaphore_Params;
+
+typedef struct
+{
+    int unused;                                                                 //!< Interrupts are not used on the host
+} ti_sysbios_family_arm_m3_Hwi_Struct;
+
+typedef struct
+{
+    int unused;                                                                 //!< Gates have no parameter on the host
+} GateMutex_Params;
+
+typedef struct GateMutex_Object *GateMutex_Handle;                              //!< Gate, a recursive mutex on the host
+typedef struct Semaphore_Object *Semaphore_Handle;                              //!< Semaphore, a counter under a mutex on the host
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+extern UInt32 Clock_tickPeriod;                                                 //!< Microseconds of a clock tick
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   Error_init(Error_Block *errorBlock)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function clears an error block
+//
+//------------------------------------------------------------------------------
+void Error_init(
+                  Error_Block *errorBlock                                       //!< Error block
+               );
+//------------------------------------------------------------------------------
+//   System_printf(const char *format, ...)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function prints to the standard output
+//
+//------------------------------------------------------------------------------
+int System_printf(
+                    const char *format,                                         //!< Format of the text
+                    ...
+                 );
+//------------------------------------------------------------------------------
+//   System_flush(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function flushes the standard output
+//
+//------------------------------------------------------------------------------
+void System_flush(void);
+//------------------------------------------------------------------------------
+//   System_abort(const char *message)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function prints the message and aborts the process
+//
+//------------------------------------------------------------------------------
+void System_abort(
+                    const char *message                                         //!< Reason of the abort
+                 );
+//------------------------------------------------------------------------------
+//   BIOS_getThreadType(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the thread type, every host thread is a task
+//
+//------------------------------------------------------------------------------
+BIOS_ThreadType BIOS_getThreadType(void);
+//------------------------------------------------------------------------------
+//   Task_sleep(UInt32 ticks)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function advances the simulated time by the ticks and lets the other
+//!  threads run
+//
+//------------------------------------------------------------------------------
+void Task_sleep(
+                  UInt32 ticks                                                  //!< Ticks to sleep
+               );
+//------------------------------------------------------------------------------
+//   Task_yield(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function lets the other threads run
+//
+//------------------------------------------------------------------------------
+void Task_yield(void);
+//------------------------------------------------------------------------------
+//   Clock_getTicks(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the simulated time in ticks
+//
+//------------------------------------------------------------------------------
+UInt32 Clock_getTicks(void);
+//------------------------------------------------------------------------------
+//   Hwi_disable(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function takes the lock standing for the interrupts being disabled
+//
+//------------------------------------------------------------------------------
+UInt Hwi_disable(void);
+//------------------------------------------------------------------------------
+//   Hwi_restore(UInt key)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function leaves the lock taken by Hwi_disable
+//
+//------------------------------------------------------------------------------
+void Hwi_restore(
+                   UInt key                                                     //!< Key returned by Hwi_disable
+                );
+//------------------------------------------------------------------------------
+//   GateMutex_create(const GateMutex_Params *params, Error_Block *errorBlock)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates a gate, which the owner thread may enter again
+//
+//------------------------------------------------------------------------------
+GateMutex_Handle GateMutex_create(
+                                    const GateMutex_Params *params,             //!< Parameters, not used
+                                    Error_Block *errorBlock                     //!< Error block, not used
+                                 );
+//------------------------------------------------------------------------------
+//   GateMutex_enter(GateMutex_Handle gate)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function enters a gate, waiting for the other threads to leave it
+//
+//------------------------------------------------------------------------------
+IArg GateMutex_enter(
+                       GateMutex_Handle gate                                    //!< Gate
+                    );
+//------------------------------------------------------------------------------
+//   GateMutex_leave(GateMutex_Handle gate, IArg key)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function leaves a gate
+//
+//------------------------------------------------------------------------------
+void GateMutex_leave(
+                       GateMutex_Handle gate,                                   //!< Gate
+                       IArg key                                                 //!< Key returned by GateMutex_enter
+                    );
+//------------------------------------------------------------------------------
+//   Semaphore_Params_init(Semaphore_Params *params)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sets the parameters of a counting semaphore
+//
+//------------------------------------------------------------------------------
+void Semaphore_Params_init(
+                             Semaphore_Params *params                           //!< Parameters
+                          );
+//------------------------------------------------------------------------------
+//   Semaphore_create(Int count, const Semaphore_Params *params, Error_Block *errorBlock)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates a semaphore with its initial count
+//
+//------------------------------------------------------------------------------
+Semaphore_Handle Semaphore_create(
+                                    Int count,                                  //!< Initial count
+                                    const Semaphore_Params *params,             //!< Parameters, NULL for a counting semaphore
+                                    Error_Block *errorBlock                     //!< Error block, not used
+                                 );
+//------------------------------------------------------------------------------
+//   Semaphore_pend(Semaphore_Handle semaphore, UInt32 timeout)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function takes a count of the semaphore, waiting up to the timeout
+//!  in ticks. It returns false if the count is still zero at the timeout
+//
+//------------------------------------------------------------------------------
+Bool Semaphore_pend(
+                      Semaphore_Handle semaphore,                               //!< Semaphore
+                      UInt32 timeout                                            //!< Ticks to wait, BIOS_NO_WAIT or BIOS_WAIT_FOREVER
+                   );
+//------------------------------------------------------------------------------
+//   Semaphore_post(Semaphore_Handle semaphore)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function adds a count to the semaphore and wakes a waiting thread
+//
+//------------------------------------------------------------------------------
+void Semaphore_post(
+                      Semaphore_Handle semaphore                                //!< Semaphore
+                   );
+//------------------------------------------------------------------------------
+//   HostGetMicroseconds(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the simulated time in microseconds
+//
+//------------------------------------------------------------------------------
+uint64_t HostGetMicroseconds(void);
+//------------------------------------------------------------------------------
+//   HostAdvanceMicroseconds(uint64_t microseconds)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function advances the simulated time
+//
+//------------------------------------------------------------------------------
+void HostAdvanceMicroseconds(
+                               uint64_t microseconds                            //!< Time to be added
+                            );
+//------------------------------------------------------------------------------
+//   HostShareClock(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function shares the simulated time with the child processes started
+//!  next, so that the time goes on across a simulated restart
+//
+//------------------------------------------------------------------------------
+void HostShareClock(void);
+//------------------------------------------------------------------------------
+//   HostSeedRandom(uint32_t seed)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function seeds the random numbers of the simulated faults
+//
+//------------------------------------------------------------------------------
+void HostSeedRandom(
+                      uint32_t seed                                             //!< Seed, not zero
+                   );
+//------------------------------------------------------------------------------
+//   HostRandom(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the next random number of the simulated faults
+//
+//------------------------------------------------------------------------------
+uint32_t HostRandom(void);
+//------------------------------------------------------------------------------
+//   HostSetPowerCut(unsigned int operations)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function arms a power cut, the given program or erase operation of
+//!  the dataflash or the EEPROM is cut. Zero disarms it
+//
+//------------------------------------------------------------------------------
+void HostSetPowerCut(
+                       unsigned int operations                                  //!< Operations up to the one cut, counting it
+                    );
+//------------------------------------------------------------------------------
+//   HostIsPowerCut(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function counts a program or erase operation. It returns true if the
+//!  power is cut during it, the caller applies part of it and calls
+//!  HostPowerOff
+//
+//------------------------------------------------------------------------------
+bool HostIsPowerCut(void);
+//------------------------------------------------------------------------------
+//   HostPowerOff(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function ends the process at once with HOST_POWER_CUT_EXIT_CODE,
+//!  nothing held in RAM is saved
+//
+//------------------------------------------------------------------------------
+void HostPowerOff(void);
+
+#endif /* __HOSTRTOS_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,13 @@
+//! \file
+//! Host build: the EEPROM driver is implemented by HostEEPROM over a file
+#ifndef __HOST_EEPROM_H__
+#define __HOST_EEPROM_H__
+#include <stdint.h>
+#define EEPROM_INIT_OK 0                                                        //!< The EEPROM is ready
+uint32_t EEPROMInit(void);
+uint32_t EEPROMSizeGet(void);
+uint32_t EEPROMBlockCountGet(void);
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count);
+uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count);
+uint32_t EEPROMMassErase(void);
+#endif
@@ -0,0 +1,2 @@
+//! \file
+//! Host build: no peripheral register is used
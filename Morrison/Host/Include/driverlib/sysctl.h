@@ -0,0 +1,8 @@
+//! \file
+//! Host build: the peripheral clocks are always on
+#ifndef __HOST_SYSCTL_H__
+#define __HOST_SYSCTL_H__
+#include <stdint.h>
+#define SYSCTL_PERIPH_EEPROM0 0xf0005800                                        //!< EEPROM 0
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+#endif
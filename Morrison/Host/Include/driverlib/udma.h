@@ -0,0 +1,14 @@
+//! \file
+//! Host build: the uDMA control table type used by SPITivaDMA.h, the
+//! transfers are done by DataflashSim
+#ifndef __HOST_UDMA_H__
+#define __HOST_UDMA_H__
+#include <stdint.h>
+typedef struct
+{
+    volatile void *pvSrcEndAddr;                                                //!< Source end address
+    volatile void *pvDstEndAddr;                                                //!< Destination end address
+    volatile uint32_t ui32Control;                                              //!< Control word
+    volatile uint32_t ui32Spare;                                                //!< Unused
+} tDMAControlTable;
+#endif
@@ -0,0 +1,2 @@
+//! \file
+//! Host build: the Cortex-M intrinsics are not used by the host branches
@@ -0,0 +1,3 @@
+//! \file
+//! Host build: TI-RTOS is replaced by HostRTOS
+#include "HostRTOS.h"
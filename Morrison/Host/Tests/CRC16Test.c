@@ -0,0 +1,342 @@
+//==============================================================================
+//
+//  CRC16Test.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        CRC16Test.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test checks CRC16Calculate against the check value of the Modbus
+//! CRC16 and against a bit by bit Modbus CRC16 over random buffers, offsets
+//! and initial values. DataFlashGetCumulativeCRC must give the same CRC one
+//! byte at a time. The cycles per byte of CRC16Calculate are then measured
+//! against the byte loop on the high and low byte tables it has replaced
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "HostRTOS.h"
+#include "HostTest.h"
+#include "CRC16.h"
+#include "Dataflash.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CHECK_STRING "123456789"                                                //!< Bytes of the standard CRC check
+#define CHECK_LENGTH 9u                                                         //!< Length of the check string
+#define CHECK_VALUE 0x374Bu                                                     //!< Modbus check value 0x4B37 in the byte order of the records
+#define RANDOM_BUFFERS 200000u                                                  //!< Random buffers compared
+#define BUFFER_LENGTH 64u                                                       //!< Longest random buffer
+#define MODBUS_POLYNOMIAL 0xA001u                                               //!< Reflected Modbus polynomial
+#define BENCHMARK_LENGTH 4096u                                                  //!< Bytes of the benchmark buffer, one subsector
+#define BENCHMARK_ROUNDS 200u                                                   //!< CRCs of the buffer in one measure
+#define BENCHMARK_MEASURES 5u                                                   //!< Measures of a CRC, the fastest is kept
+
+typedef unsigned short (*CRC_FUNCTION)(const unsigned char *data, unsigned int length, unsigned short crcValue); //!< CRC of a buffer
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static unsigned char byteTableHigh[256];                                        //!< High byte table of the byte loop replaced by CRC16Calculate
+static unsigned char byteTableLow[256];                                         //!< Low byte table of the byte loop replaced by CRC16Calculate
+static unsigned char benchmarkBuffer[BENCHMARK_LENGTH];                         //!< Bytes of the benchmark, aligned as a record page
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static unsigned short GetReferenceCRC(const unsigned char *data, unsigned int length, unsigned short crcValue);
+static void BuildByteTables(void);
+static unsigned short GetByteTableCRC(const unsigned char *data, unsigned int length, unsigned short crcValue);
+static uint64_t ReadCycles(void);
+static double MeasureCyclesPerByte(CRC_FUNCTION crcFunction);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetReferenceCRC(const unsigned char *data, unsigned int length, unsigned short crcValue)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the Modbus CRC16 of the bytes computed bit by bit,
+//!  in the byte order of CRC16Calculate
+//
+//------------------------------------------------------------------------------
+static unsigned short GetReferenceCRC(
+                                        const unsigned char *data,              //!< Bytes to be added to the CRC
+                                        unsigned int length,                    //!< Number of bytes
+                                        unsigned short crcValue                 //!< CRC of the bytes before
+                                     )
+{
+    //For the CRC in the byte order of the calculation
+    unsigned int crc = ((crcValue >> 8) | (crcValue << 8)) & 0xFFFFu;
+    //For indexing the bytes and the bits
+    unsigned int byteIndex = 0u;
+    unsigned int bitIndex = 0u;
+    for ( byteIndex = 0u; byteIndex < length; byteIndex++ )
+    {
+        crc = crc ^ data[byteIndex];
+        for ( bitIndex = 0u; bitIndex < 8u; bitIndex++ )
+        {
+            if ( (crc & 1u) != 0u )
+            {
+                crc = (crc >> 1) ^ MODBUS_POLYNOMIAL;
+            }
+            else
+            {
+                crc = crc >> 1;
+            }
+        }
+    }
+    return (unsigned short) (((crc >> 8) | (crc << 8)) & 0xFFFFu);
+}
+//------------------------------------------------------------------------------
+//   BuildByteTables(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function builds the high and low byte tables of the byte loop, from
+//!  the bit by bit CRC of every byte
+//
+//------------------------------------------------------------------------------
+static void BuildByteTables(void)
+{
+    //For the byte and its CRC
+    unsigned char byte = 0u;
+    unsigned short crc = 0u;
+    //For indexing the tables
+    unsigned int tableIndex = 0u;
+    for ( tableIndex = 0u; tableIndex < 256u; tableIndex++ )
+    {
+        byte = (unsigned char) tableIndex;
+        crc = GetReferenceCRC(&byte, 1u, 0u);
+        byteTableHigh[tableIndex] = (unsigned char) (crc >> 8);
+        byteTableLow[tableIndex] = (unsigned char) (crc & 0xFFu);
+    }
+}
+//------------------------------------------------------------------------------
+//   GetByteTableCRC(const unsigned char *data, unsigned int length, unsigned short crcValue)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the Modbus CRC16 of the bytes one byte at a time,
+//!  as the dataflash driver did with its high and low byte tables before
+//!  CRC16Calculate
+//
+//------------------------------------------------------------------------------
+static unsigned short GetByteTableCRC(
+                                        const unsigned char *data,              //!< Bytes to be added to the CRC
+                                        unsigned int length,                    //!< Number of bytes
+                                        unsigned short crcValue                 //!< CRC of the bytes before
+                                     )
+{
+    //For the bytes of the CRC
+    unsigned char crcHighByte = (unsigned char) (crcValue >> 8);
+    unsigned char crcLowByte = (unsigned char) (crcValue & 0xFFu);
+    //For the index in the tables
+    unsigned char crcIndex = 0u;
+    //For indexing the bytes
+    unsigned int byteIndex = 0u;
+    for ( byteIndex = 0u; byteIndex < length; byteIndex++ )
+    {
+        crcIndex = crcHighByte ^ data[byteIndex];
+        crcHighByte = crcLowByte ^ byteTableHigh[crcIndex];
+        crcLowByte = byteTableLow[crcIndex];
+    }
+    return (unsigned short) ((crcHighByte << 8) | crcLowByte);
+}
+//------------------------------------------------------------------------------
+//   ReadCycles(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the time stamp counter of the processor, or the
+//!  nanoseconds of the host where there is none
+//
+//------------------------------------------------------------------------------
+static uint64_t ReadCycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return HostTestGetNanoseconds();
+#endif
+}
+//------------------------------------------------------------------------------
+//   MeasureCyclesPerByte(CRC_FUNCTION crcFunction)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the cycles per byte of a CRC of the benchmark
+//!  buffer, the fastest of BENCHMARK_MEASURES measures
+//
+//------------------------------------------------------------------------------
+static double MeasureCyclesPerByte(
+                                     CRC_FUNCTION crcFunction                   //!< CRC measured
+                                  )
+{
+    //For the CRC, kept so the rounds are not optimized away
+    volatile unsigned short crc = CRC16_INITIAL_VALUE;
+    //For the cycles of a measure
+    uint64_t startCycles = 0u;
+    uint64_t cycles = 0u;
+    uint64_t fewestCycles = UINT64_MAX;
+    //For indexing the measures and the rounds
+    unsigned int measureIndex = 0u;
+    unsigned int roundIndex = 0u;
+    for ( measureIndex = 0u; measureIndex < BENCHMARK_MEASURES; measureIndex++ )
+    {
+        startCycles = ReadCycles();
+        for ( roundIndex = 0u; roundIndex < BENCHMARK_ROUNDS; roundIndex++ )
+        {
+            crc = crcFunction(benchmarkBuffer, BENCHMARK_LENGTH, crc);
+        }
+        cycles = ReadCycles() - startCycles;
+        if ( cycles < fewestCycles )
+        {
+            fewestCycles = cycles;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    return (double) fewestCycles / ((double) BENCHMARK_ROUNDS * (double) BENCHMARK_LENGTH);
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    //For the random bytes, with room for an unaligned start
+    unsigned char buffer[BUFFER_LENGTH + 4u];
+    //For the random buffer and its CRC
+    unsigned int offset = 0u;
+    unsigned int length = 0u;
+    unsigned short initialValue = 0u;
+    unsigned short byteCRC = 0u;
+    //For counting the mismatches
+    unsigned int mismatches = 0u;
+    unsigned int byteMismatches = 0u;
+    unsigned int tableMismatches = 0u;
+    //For the cycles per byte of both CRCs
+    double sliceCycles = 0.0;
+    double byteTableCycles = 0.0;
+    //For indexing the loops
+    unsigned int bufferIndex = 0u;
+    unsigned int byteIndex = 0u;
+    HostTestStart("CRC16Test", true);
+    BuildByteTables();
+    HOST_TEST_CHECK(CRC16Calculate((const unsigned char *) CHECK_STRING, CHECK_LENGTH, CRC16_INITIAL_VALUE) == CHECK_VALUE);
+    HOST_TEST_CHECK(GetReferenceCRC((const unsigned char *) CHECK_STRING, CHECK_LENGTH, CRC16_INITIAL_VALUE) == CHECK_VALUE);
+    HostSeedRandom(0x2545F491u);
+    for ( bufferIndex = 0u; bufferIndex < RANDOM_BUFFERS; bufferIndex++ )
+    {
+        for ( byteIndex = 0u; byteIndex < sizeof(buffer); byteIndex++ )
+        {
+            buffer[byteIndex] = (unsigned char) HostRandom();
+        }
+        offset = HostRandom() % 4u;
+        length = HostRandom() % (BUFFER_LENGTH + 1u);
+        initialValue = (unsigned short) HostRandom();
+        if ( CRC16Calculate(&buffer[offset], length, initialValue) != GetReferenceCRC(&buffer[offset], length, initialValue) )
+        {
+            mismatches++;
+        }
+        else
+        {
+            //Do nothing
+        }
+        byteCRC = initialValue;
+        for ( byteIndex = 0u; byteIndex < length; byteIndex++ )
+        {
+            DataFlashGetCumulativeCRC(buffer[offset + byteIndex], &byteCRC);
+        }
+        if ( byteCRC != GetReferenceCRC(&buffer[offset], length, initialValue) )
+        {
+            byteMismatches++;
+        }
+        else
+        {
+            //Do nothing
+        }
+        if ( GetByteTableCRC(&buffer[offset], length, initialValue) != GetReferenceCRC(&buffer[offset], length, initialValue) )
+        {
+            tableMismatches++;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    HOST_TEST_CHECK(mismatches == 0u);
+    HOST_TEST_CHECK(byteMismatches == 0u);
+    HOST_TEST_CHECK(tableMismatches == 0u);
+    for ( byteIndex = 0u; byteIndex < BENCHMARK_LENGTH; byteIndex++ )
+    {
+        benchmarkBuffer[byteIndex] = (unsigned char) HostRandom();
+    }
+    HOST_TEST_CHECK(CRC16Calculate(benchmarkBuffer, BENCHMARK_LENGTH, CRC16_INITIAL_VALUE) ==
+                    GetByteTableCRC(benchmarkBuffer, BENCHMARK_LENGTH, CRC16_INITIAL_VALUE));
+    sliceCycles = MeasureCyclesPerByte(CRC16Calculate);
+    byteTableCycles = MeasureCyclesPerByte(GetByteTableCRC);
+    (void) printf("CRC16 of %u bytes: slicing by 4 %.2f cycles/byte, byte tables %.2f cycles/byte, %.2f times faster\n",
+                  BENCHMARK_LENGTH, sliceCycles, byteTableCycles, byteTableCycles / sliceCycles);
+    (void) fflush(stdout);
+    HOST_TEST_CHECK(sliceCycles < byteTableCycles);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
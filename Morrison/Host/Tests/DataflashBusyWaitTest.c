@@ -0,0 +1,207 @@
+//==============================================================================
+//
+//  DataflashBusyWaitTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashBusyWaitTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test measures the CPU time given back to the other tasks by the busy
+//! waits of the dataflash driver. It erases subsectors and programs pages
+//! and reads the status polls and the ticks slept from
+//! DataFlashGetBusyWaitStatistics. The time slept is the time a polling
+//! wait would have kept the CPU busy
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdio.h>
+#include <string.h>
+#include "HostRTOS.h"
+#include "HostTest.h"
+#include "DataflashSim.h"
+#include "Dataflash.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define FIRST_SUBSECTOR 3200u                                                   //!< First subsector erased and programmed by the test
+#define ERASED_SUBSECTORS 16u                                                   //!< Subsectors erased one at a time
+#define PROGRAMMED_PAGES 256u                                                   //!< Pages programmed one at a time
+#define PAGE_LENGTH 256u                                                        //!< Bytes of a page program
+#define MOST_ERASE_POLLS 20u                                                    //!< Most status polls of one subsector erase
+#define MOST_PROGRAM_POLLS 16u                                                  //!< Most status polls of one page program
+#define LEAST_ERASE_SLEEP_PERCENT 90u                                           //!< Least share of an erase slept
+#define LEAST_PROGRAM_SLEEP_PERCENT 50u                                         //!< Least share of a program slept
+
+//! This data structure holds the busy waits of a series of operations
+typedef struct
+{
+    unsigned int statusPolls;                                                   //!< Status polls of the busy waits
+    unsigned int sleepTicks;                                                    //!< Ticks slept by the busy waits
+    unsigned int statusReads;                                                   //!< Status reads seen by the simulated dataflash
+    uint64_t elapsedMicroseconds;                                               //!< Simulated time of the operations
+
+} BUSY_WAIT_STRUCT;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void StartBusyWaits(BUSY_WAIT_STRUCT *busyWait);
+static unsigned int StopBusyWaits(BUSY_WAIT_STRUCT *busyWait, const char *name, unsigned int operations);
+static void MeasureBusyWaits(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   StartBusyWaits(BUSY_WAIT_STRUCT *busyWait)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function saves the counters before a series of operations
+//
+//------------------------------------------------------------------------------
+static void StartBusyWaits(
+                             BUSY_WAIT_STRUCT *busyWait                         //!< Counters of the series
+                          )
+{
+    DataFlashGetBusyWaitStatistics(&busyWait->statusPolls, &busyWait->sleepTicks);
+    DataflashSimResetStatistics();
+    busyWait->elapsedMicroseconds = HostGetMicroseconds();
+}
+//------------------------------------------------------------------------------
+//   StopBusyWaits(BUSY_WAIT_STRUCT *busyWait, const char *name, unsigned int operations)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function gets the counters of a series of operations, prints them
+//!  and returns the percentage of the time of the series slept
+//
+//------------------------------------------------------------------------------
+static unsigned int StopBusyWaits(
+                                    BUSY_WAIT_STRUCT *busyWait,                 //!< Counters of the series
+                                    const char *name,                           //!< Name of the operations
+                                    unsigned int operations                     //!< Number of operations
+                                 )
+{
+    //For the counters after the series
+    unsigned int statusPolls = 0u;
+    unsigned int sleepTicks = 0u;
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    //For the time slept
+    uint64_t sleptMicroseconds = 0u;
+    busyWait->elapsedMicroseconds = HostGetMicroseconds() - busyWait->elapsedMicroseconds;
+    DataFlashGetBusyWaitStatistics(&statusPolls, &sleepTicks);
+    DataflashSimGetStatistics(&statistics);
+    busyWait->statusPolls = statusPolls - busyWait->statusPolls;
+    busyWait->sleepTicks = sleepTicks - busyWait->sleepTicks;
+    busyWait->statusReads = statistics.statusReads;
+    sleptMicroseconds = (uint64_t) busyWait->sleepTicks * Clock_tickPeriod;
+    (void) printf("%u %s: %.1f status polls each, %.1f of %.1f ms slept, CPU busy %.1f ms instead of %.1f ms\n",
+                  operations, name, (double) busyWait->statusPolls / (double) operations,
+                  (double) sleptMicroseconds / 1000.0, (double) busyWait->elapsedMicroseconds / 1000.0,
+                  (double) (busyWait->elapsedMicroseconds - sleptMicroseconds) / 1000.0,
+                  (double) busyWait->elapsedMicroseconds / 1000.0);
+    (void) fflush(stdout);
+    return (unsigned int) ((sleptMicroseconds * 100u) / (busyWait->elapsedMicroseconds + 1u));
+}
+//------------------------------------------------------------------------------
+//   MeasureBusyWaits(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases subsectors and programs pages one at a time and
+//!  checks the polls and the share of their time slept
+//
+//------------------------------------------------------------------------------
+static void MeasureBusyWaits(
+                               void *argument                                   //!< Not used
+                            )
+{
+    //For the counters of a series
+    BUSY_WAIT_STRUCT busyWait;
+    //For the share of the series slept
+    unsigned int sleptPercent = 0u;
+    //For the bytes of a page
+    unsigned char page[PAGE_LENGTH];
+    //For indexing the operations
+    unsigned int operationIndex = 0u;
+    (void) argument;
+    memset(page, 0x5A, sizeof(page));
+    StartBusyWaits(&busyWait);
+    for ( operationIndex = 0u; operationIndex < ERASED_SUBSECTORS; operationIndex++ )
+    {
+        DataFlashEraseSubsectors((unsigned short) (FIRST_SUBSECTOR + operationIndex), 1u);
+    }
+    sleptPercent = StopBusyWaits(&busyWait, "subsector erases", ERASED_SUBSECTORS);
+    //Every poll is a status read of the dataflash, the erase is read back
+    HOST_TEST_CHECK(busyWait.statusPolls <= busyWait.statusReads);
+    HOST_TEST_CHECK(busyWait.statusPolls <= (ERASED_SUBSECTORS * MOST_ERASE_POLLS));
+    HOST_TEST_CHECK(sleptPercent >= LEAST_ERASE_SLEEP_PERCENT);
+    StartBusyWaits(&busyWait);
+    for ( operationIndex = 0u; operationIndex < PROGRAMMED_PAGES; operationIndex++ )
+    {
+        DataFlashProgramBytes((unsigned short) (FIRST_SUBSECTOR + (operationIndex / (DATAFLASH_SUBSECTOR_SIZE / PAGE_LENGTH))),
+                              (unsigned short) ((operationIndex * PAGE_LENGTH) % DATAFLASH_SUBSECTOR_SIZE), page, (unsigned short) PAGE_LENGTH);
+    }
+    sleptPercent = StopBusyWaits(&busyWait, "page programs", PROGRAMMED_PAGES);
+    HOST_TEST_CHECK(busyWait.statusPolls <= busyWait.statusReads);
+    HOST_TEST_CHECK(busyWait.statusPolls <= (PROGRAMMED_PAGES * MOST_PROGRAM_POLLS));
+    HOST_TEST_CHECK(sleptPercent >= LEAST_PROGRAM_SLEEP_PERCENT);
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    HostTestStart("DataflashBusyWaitTest", true);
+    HOST_TEST_CHECK(HostTestRunBoot(MeasureBusyWaits, NULL) == 0);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,240 @@
+//==============================================================================
+//
+//  DataflashGeometryTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashGeometryTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test checks the geometry read from the SFDP table of the simulated
+//! chip, or taken from its identification without the table. It checks that
+//! the programs are split at the page size of the table and that a range of
+//! subsectors is erased with block erases where it covers whole blocks
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <string.h>
+#include "HostRTOS.h"
+#include "DataflashSim.h"
+#include "HostTest.h"
+#include "Dataflash.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define SMALL_PAGE_SIZE 64u                                                     //!< Page size of the SFDP table of the second chip
+#define ALIGNED_SUBSECTOR 3008u                                                 //!< First subsector of a block, far ahead of the first events logged
+#define UNALIGNED_SUBSECTOR 3058u                                               //!< Subsector in the middle of a block
+#define ERASED_SUBSECTORS 40u                                                   //!< Subsectors of an erased range
+#define PROGRAM_SUBSECTOR 3100u                                                 //!< Subsector programmed by the test
+#define PATTERN_OFFSET 200u                                                     //!< Offset of the pattern, it starts in the middle of a page
+#define PATTERN_LENGTH 300u                                                     //!< Bytes of the pattern
+
+//! This data structure describes the chip simulated for a boot
+typedef struct
+{
+    bool hasSFDPTable;                                                          //!< True if the chip has an SFDP table
+    unsigned short pageSize;                                                    //!< Program page size of the chip
+
+} CHIP_STRUCT;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CheckErase(unsigned short firstSubsector, unsigned int blockErases, unsigned int subsectorErases);
+static void CheckProgram(unsigned short pageSize);
+static void CheckChip(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CheckErase(unsigned short firstSubsector, unsigned int blockErases, unsigned int subsectorErases)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases a range of subsectors and checks the erase commands
+//!  sent and that every subsector of the range, and only them, is erased once
+//
+//------------------------------------------------------------------------------
+static void CheckErase(
+                         unsigned short firstSubsector,                         //!< First subsector of the range
+                         unsigned int blockErases,                              //!< Block erases expected
+                         unsigned int subsectorErases                           //!< Subsector erases expected
+                      )
+{
+    //For the statistics of the simulated dataflash
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    //For the simulated content
+    unsigned char *memory = DataflashSimGetMemory();
+    //For indexing the subsectors
+    unsigned int subsectorIndex = 0u;
+    //For counting the bytes not erased
+    unsigned int programmedBytes = 0u;
+    unsigned int byteIndex = 0u;
+    //Program the range and the subsectors around it
+    memset(&memory[(firstSubsector - 1u) * DATAFLASH_SUBSECTOR_SIZE], 0, (ERASED_SUBSECTORS + 2u) * DATAFLASH_SUBSECTOR_SIZE);
+    DataflashSimResetStatistics();
+    DataFlashEraseSubsectors(firstSubsector, (unsigned short) ERASED_SUBSECTORS);
+    DataflashSimGetStatistics(&statistics);
+    HOST_TEST_CHECK(statistics.blockErases == blockErases);
+    HOST_TEST_CHECK(statistics.subsectorErases == subsectorErases);
+    for ( subsectorIndex = 0u; subsectorIndex < ERASED_SUBSECTORS; subsectorIndex++ )
+    {
+        HOST_TEST_CHECK(DataflashSimGetEraseCount((unsigned short) (firstSubsector + subsectorIndex)) == 1u);
+        for ( byteIndex = 0u; byteIndex < DATAFLASH_SUBSECTOR_SIZE; byteIndex++ )
+        {
+            if ( memory[((firstSubsector + subsectorIndex) * DATAFLASH_SUBSECTOR_SIZE) + byteIndex] != 0xFFu )
+            {
+                programmedBytes++;
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+    }
+    HOST_TEST_CHECK(programmedBytes == 0u);
+    HOST_TEST_CHECK(DataflashSimGetEraseCount((unsigned short) (firstSubsector - 1u)) == 0u);
+    HOST_TEST_CHECK(DataflashSimGetEraseCount((unsigned short) (firstSubsector + ERASED_SUBSECTORS)) == 0u);
+    HOST_TEST_CHECK(statistics.busyCommands == 0u);
+    HOST_TEST_CHECK(statistics.unlatchedCommands == 0u);
+}
+//------------------------------------------------------------------------------
+//   CheckProgram(unsigned short pageSize)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs a pattern crossing pages and checks that no
+//!  program has wrapped in its page of the chip
+//
+//------------------------------------------------------------------------------
+static void CheckProgram(
+                           unsigned short pageSize                              //!< Program page size of the chip
+                        )
+{
+    //For the statistics of the simulated dataflash
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    //For the pattern and the bytes read back
+    unsigned char pattern[PATTERN_LENGTH];
+    unsigned char data[PATTERN_LENGTH];
+    //For indexing the bytes
+    unsigned int byteIndex = 0u;
+    for ( byteIndex = 0u; byteIndex < PATTERN_LENGTH; byteIndex++ )
+    {
+        pattern[byteIndex] = (unsigned char) ((byteIndex * 7u) + 3u);
+    }
+    DataFlashEraseSubsectors((unsigned short) PROGRAM_SUBSECTOR, 1u);
+    DataflashSimResetStatistics();
+    DataFlashProgramBytes((unsigned short) PROGRAM_SUBSECTOR, (unsigned short) PATTERN_OFFSET, pattern, (unsigned short) PATTERN_LENGTH);
+    DataflashSimGetStatistics(&statistics);
+    HOST_TEST_CHECK(statistics.pageWraps == 0u);
+    //One program for every page the pattern touches
+    HOST_TEST_CHECK(statistics.pagePrograms == ((((PATTERN_OFFSET + PATTERN_LENGTH) - 1u) / pageSize) - (PATTERN_OFFSET / pageSize) + 1u));
+    DataFlashReadBytes((unsigned short) PROGRAM_SUBSECTOR, (unsigned short) PATTERN_OFFSET, data, (unsigned short) PATTERN_LENGTH);
+    HOST_TEST_CHECK(memcmp(data, pattern, PATTERN_LENGTH) == 0);
+}
+//------------------------------------------------------------------------------
+//   CheckChip(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks the geometry, the programs and the erases of a chip
+//
+//------------------------------------------------------------------------------
+static void CheckChip(
+                        void *argument                                          //!< Chip simulated
+                     )
+{
+    //For the chip simulated and the geometry found by the driver
+    const CHIP_STRUCT *chip = (const CHIP_STRUCT *) argument;
+    DATAFLASH_GEOMETRY_STRUCT geometry;
+    DataFlashGetGeometry(&geometry);
+    HOST_TEST_CHECK(geometry.isSFDPFound == chip->hasSFDPTable);
+    HOST_TEST_CHECK(geometry.pageSize == chip->pageSize);
+    HOST_TEST_CHECK(geometry.programSize == chip->pageSize);
+    HOST_TEST_CHECK(geometry.isBlockEraseSupported == true);
+    if ( chip->hasSFDPTable == true )
+    {
+        HOST_TEST_CHECK(geometry.capacity == DATAFLASH_SIM_SIZE);
+        HOST_TEST_CHECK(geometry.isDualReadSupported == true);
+        HOST_TEST_CHECK(geometry.isQuadReadSupported == true);
+    }
+    else
+    {
+        //Do nothing
+    }
+    CheckProgram(chip->pageSize);
+    //40 subsectors from the start of a block are two blocks and 8 subsectors
+    CheckErase((unsigned short) ALIGNED_SUBSECTOR, 2u, 8u);
+    //From the middle of a block they are 6 subsectors, a block and 18 subsectors
+    CheckErase((unsigned short) UNALIGNED_SUBSECTOR, 1u, 24u);
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    //For the chips simulated
+    CHIP_STRUCT chip;
+    HostTestStart("DataflashGeometryTest", true);
+    chip.hasSFDPTable = true;
+    chip.pageSize = (unsigned short) DATAFLASH_PAGE_SIZE;
+    DataflashSimSetSFDP(chip.hasSFDPTable, chip.pageSize);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckChip, &chip) == 0);
+    chip.pageSize = (unsigned short) SMALL_PAGE_SIZE;
+    DataflashSimSetSFDP(chip.hasSFDPTable, chip.pageSize);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckChip, &chip) == 0);
+    chip.hasSFDPTable = false;
+    chip.pageSize = (unsigned short) DATAFLASH_PAGE_SIZE;
+    DataflashSimSetSFDP(chip.hasSFDPTable, chip.pageSize);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckChip, &chip) == 0);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,477 @@
+//==============================================================================
+//
+//  DataflashQueueTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashQueueTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test measures the throughput of the dataflash queue under the traffic
+//! of the event log, the error log and the debug writes at once. Writer
+//! threads write events while a thread runs the loop of TaskEventLog, whose
+//! erases ahead are queued. A thread writes errors of every kind, and a
+//! thread writes debug words, flushes them with a callback and reads them
+//! back with adjacent reads. The events, errors and flushes per second of
+//! simulated time, the error write latency and the counters of the queue
+//! are printed. The erases must be suspended for the other requests, the
+//! adjacent reads merged and every event and error read back
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HostRTOS.h"
+#include "HostTest.h"
+#include "DataflashSim.h"
+#include "Dataflash.h"
+#include "DataflashQueue.h"
+#include "ErrorLog.h"
+#include "EventLog.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define WRITERS 2u                                                              //!< Event writer threads
+#define EVENTS_PER_WRITER 4000u                                                 //!< Events written by every writer
+#define WRITER_SLEEP_TICKS 2u                                                   //!< Sleep of a writer between its events
+#define CONSUMER_SLEEP_TICKS 1u                                                 //!< Sleep of TaskEventLog between its loops
+#define TOTAL_EVENTS (WRITERS*EVENTS_PER_WRITER)                                //!< Events written by the test
+#define ERROR_CODES 8u                                                          //!< Error codes written, one per error log
+#define ERRORS_PER_CODE 8u                                                      //!< Errors written of every code
+#define TOTAL_ERRORS (ERROR_CODES*ERRORS_PER_CODE)                              //!< Errors written by the test
+#define ERROR_SLEEP_TICKS (ERRLOG_TOKEN_PERIOD_MS / ERROR_CODES)                //!< Sleep between two errors, every code gets a token between its errors
+#define DEBUG_SUBSECTOR (LAST_EVENTLOG_SUBSECTOR - 1u)                          //!< Subsector of the debug words, not reached by the events of the test
+#define DEBUG_PASSES 64u                                                        //!< Debug words written and flushed this many times
+#define DEBUG_WORDS_PER_PASS 32u                                                //!< Debug words written before a flush
+#define DEBUG_SLEEP_TICKS 20u                                                   //!< Sleep of the debug thread between its passes
+#define DEBUG_READS 4u                                                          //!< Adjacent reads of the words of a pass
+#define DEBUG_READ_LENGTH ((DEBUG_WORDS_PER_PASS * 2u) / DEBUG_READS)           //!< Bytes of one of the adjacent reads
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//! Error codes written by the test, each has its own error log
+static const ERRORCODE_ENUM writtenCodes[ERROR_CODES] =
+{
+    ERRORCODE_ENUM_WHISPER_DEVICE_ERROR,
+    ERRORCODE_ENUM_ETHERNET_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_WIFI_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_CELLULAR_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_DATAFLASH_READ_WRITE_ERROR,
+    ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR
+};
+
+static atomic_bool isConsumerStopped = false;                                   //!< Set to stop the consumer thread
+static atomic_uint completedFlushes = 0u;                                       //!< Flushes completed, counted by their callback
+static uint64_t errorLatency[TOTAL_ERRORS];                                     //!< Nanoseconds spent in every error write
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static int CompareLatency(const void *first, const void *second);
+static void SleepTicks(unsigned int ticks);
+static void CountFlush(DATAFLASH_REQUEST_STRUCT *request);
+static void *RunWriter(void *argument);
+static void *RunConsumer(void *argument);
+static void *RunErrors(void *argument);
+static void *RunDebug(void *argument);
+static void WriteTraffic(void *argument);
+static void CheckTraffic(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CompareLatency(const void *first, const void *second)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function orders two latencies for qsort
+//
+//------------------------------------------------------------------------------
+static int CompareLatency(
+                            const void *first,                                  //!< First latency
+                            const void *second                                  //!< Second latency
+                         )
+{
+    //For the latencies
+    uint64_t firstLatency = *(const uint64_t *) first;
+    uint64_t secondLatency = *(const uint64_t *) second;
+    return (firstLatency > secondLatency) - (firstLatency < secondLatency);
+}
+//------------------------------------------------------------------------------
+//   SleepTicks(unsigned int ticks)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sleeps one tick at a time. Every sleep gives the same host
+//!  time to the other threads, so the simulated time goes on evenly for all
+//!  of them and the requests of every thread reach the erases
+//
+//------------------------------------------------------------------------------
+static void SleepTicks(
+                         unsigned int ticks                                     //!< Ticks to sleep
+                      )
+{
+    //For indexing the ticks
+    unsigned int tickIndex = 0u;
+    for ( tickIndex = 0u; tickIndex < ticks; tickIndex++ )
+    {
+        Task_sleep(1u);
+    }
+}
+//------------------------------------------------------------------------------
+//   CountFlush(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function is the callback of the flushes of the debug thread, it
+//!  counts them
+//
+//------------------------------------------------------------------------------
+static void CountFlush(
+                         DATAFLASH_REQUEST_STRUCT *request                      //!< Flush completed
+                      )
+{
+    (void) request;
+    (void) atomic_fetch_add(&completedFlushes, 1u);
+}
+//------------------------------------------------------------------------------
+//   RunWriter(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the events of a writer
+//
+//------------------------------------------------------------------------------
+static void *RunWriter(
+                         void *argument                                         //!< Index of the writer
+                      )
+{
+    //For the index of the writer
+    unsigned int writerIndex = (unsigned int) (uintptr_t) argument;
+    //For indexing the events
+    unsigned int eventIndex = 0u;
+    for ( eventIndex = 0u; eventIndex < EVENTS_PER_WRITER; eventIndex++ )
+    {
+        EventLogWritePanicEvent((unsigned short) writerIndex);
+        SleepTicks(WRITER_SLEEP_TICKS);
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   RunConsumer(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the loop of TaskEventLog until it is stopped, the
+//!  erases ahead go through the queue
+//
+//------------------------------------------------------------------------------
+static void *RunConsumer(
+                           void *argument                                       //!< Not used
+                        )
+{
+    (void) argument;
+    while ( atomic_load(&isConsumerStopped) == false )
+    {
+        EventLogFlushFullPages();
+        EventLogEraseAhead();
+        Task_sleep(CONSUMER_SLEEP_TICKS);
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   RunErrors(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the errors of every code in turn and saves the time
+//!  spent in every write
+//
+//------------------------------------------------------------------------------
+static void *RunErrors(
+                         void *argument                                         //!< Not used
+                      )
+{
+    //For the start of a write
+    uint64_t startTime = 0u;
+    //For indexing the errors
+    unsigned int errorIndex = 0u;
+    (void) argument;
+    for ( errorIndex = 0u; errorIndex < TOTAL_ERRORS; errorIndex++ )
+    {
+        startTime = HostTestGetNanoseconds();
+        ErrorLogWrite(writtenCodes[errorIndex % ERROR_CODES], ERRORTYPE_ENUM_CRITICAL);
+        errorLatency[errorIndex] = HostTestGetNanoseconds() - startTime;
+        SleepTicks(ERROR_SLEEP_TICKS);
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   RunDebug(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the debug words of every pass to the page cache,
+//!  queues their flush and reads them back with adjacent reads
+//
+//------------------------------------------------------------------------------
+static void *RunDebug(
+                        void *argument                                          //!< Not used
+                     )
+{
+    //For the flush and the reads of a pass
+    DATAFLASH_REQUEST_STRUCT flushRequest;
+    DATAFLASH_REQUEST_STRUCT readRequests[DEBUG_READS];
+    Semaphore_Handle flushSemaphoreHandle = Semaphore_create(0, NULL, NULL);
+    //For the words of a pass
+    unsigned short dataWord = 0u;
+    unsigned short wordAddress = 0u;
+    unsigned char readBytes[DEBUG_WORDS_PER_PASS * 2u];
+    unsigned char expectedBytes[DEBUG_WORDS_PER_PASS * 2u];
+    //For indexing the passes, the words and the reads
+    unsigned int passIndex = 0u;
+    unsigned int wordIndex = 0u;
+    unsigned int readIndex = 0u;
+    (void) argument;
+    memset(&flushRequest, 0, sizeof(flushRequest));
+    flushRequest.operation = DATAFLASH_REQUEST_FLUSH;
+    flushRequest.callback = CountFlush;
+    flushRequest.semaphore = flushSemaphoreHandle;
+    for ( passIndex = 0u; passIndex < DEBUG_PASSES; passIndex++ )
+    {
+        //The debug functions take the byte offset of the word
+        for ( wordIndex = 0u; wordIndex < DEBUG_WORDS_PER_PASS; wordIndex++ )
+        {
+            wordAddress = (unsigned short) ((passIndex * DEBUG_WORDS_PER_PASS) + wordIndex);
+            dataWord = (unsigned short) ~wordAddress;
+            DataFlashDebugWrite(DEBUG_SUBSECTOR, (unsigned short) (wordAddress * 2u), &dataWord);
+        }
+        DataFlashQueueSubmit(&flushRequest);
+        DataFlashQueueWait(&flushRequest);
+        //The reads go on from one another in the dataflash and in RAM
+        wordAddress = (unsigned short) (passIndex * DEBUG_WORDS_PER_PASS);
+        for ( readIndex = 0u; readIndex < DEBUG_READS; readIndex++ )
+        {
+            memset(&readRequests[readIndex], 0, sizeof(readRequests[readIndex]));
+            readRequests[readIndex].operation = DATAFLASH_REQUEST_READ;
+            readRequests[readIndex].subsectorNumber = DEBUG_SUBSECTOR;
+            readRequests[readIndex].byteAddress = (unsigned short) ((wordAddress * 2u) + (readIndex * DEBUG_READ_LENGTH));
+            readRequests[readIndex].data = &readBytes[readIndex * DEBUG_READ_LENGTH];
+            readRequests[readIndex].nBytes = (unsigned short) DEBUG_READ_LENGTH;
+            DataFlashQueueSubmit(&readRequests[readIndex]);
+        }
+        for ( readIndex = 0u; readIndex < DEBUG_READS; readIndex++ )
+        {
+            DataFlashQueueWait(&readRequests[readIndex]);
+        }
+        DataFlashReadBytes(DEBUG_SUBSECTOR, (unsigned short) (wordAddress * 2u), expectedBytes, (unsigned short) sizeof(expectedBytes));
+        HOST_TEST_CHECK(memcmp(readBytes, expectedBytes, sizeof(readBytes)) == 0);
+        SleepTicks(DEBUG_SLEEP_TICKS);
+    }
+    //Every word is in the dataflash
+    for ( wordAddress = 0u; wordAddress < (DEBUG_PASSES * DEBUG_WORDS_PER_PASS); wordAddress++ )
+    {
+        DataFlashDebugRead(DEBUG_SUBSECTOR, (unsigned short) (wordAddress * 2u), &dataWord);
+        HOST_TEST_CHECK(dataWord == (unsigned short) ~wordAddress);
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   WriteTraffic(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the events, the errors and the debug words at once,
+//!  prints their throughput and the counters of the queue and checks them
+//
+//------------------------------------------------------------------------------
+static void WriteTraffic(
+                           void *argument                                       //!< Not used
+                        )
+{
+    //For the threads
+    pthread_t writers[WRITERS];
+    pthread_t consumer;
+    pthread_t errors;
+    pthread_t debug;
+    //For the events before the run
+    unsigned int startEvents = EventLogGetNumberOfEvents();
+    //For the simulated time of the run
+    uint64_t elapsedMicroseconds = HostGetMicroseconds();
+    double elapsedSeconds = 0.0;
+    //For the counters of the queue and of the driver
+    unsigned int requests = 0u;
+    unsigned int mergedReads = 0u;
+    unsigned int pipelinedRequests = 0u;
+    unsigned int maximumDepth = 0u;
+    unsigned int erasesStarted = 0u;
+    unsigned int eraseSuspends = 0u;
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    //For the erase of the debug words
+    DATAFLASH_REQUEST_STRUCT eraseRequest;
+    //For indexing the writers
+    unsigned int writerIndex = 0u;
+    (void) argument;
+    DataflashSimResetStatistics();
+    HOST_TEST_CHECK(pthread_create(&consumer, NULL, RunConsumer, NULL) == 0);
+    HOST_TEST_CHECK(pthread_create(&errors, NULL, RunErrors, NULL) == 0);
+    HOST_TEST_CHECK(pthread_create(&debug, NULL, RunDebug, NULL) == 0);
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        HOST_TEST_CHECK(pthread_create(&writers[writerIndex], NULL, RunWriter, (void *) (uintptr_t) writerIndex) == 0);
+    }
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        (void) pthread_join(writers[writerIndex], NULL);
+    }
+    (void) pthread_join(errors, NULL);
+    (void) pthread_join(debug, NULL);
+    HOST_TEST_CHECK(EventLogGetNumberOfEvents() == (startEvents + TOTAL_EVENTS));
+    EventLogShutDown();
+    atomic_store(&isConsumerStopped, true);
+    (void) pthread_join(consumer, NULL);
+    HostTestWaitDataflash();
+    elapsedMicroseconds = HostGetMicroseconds() - elapsedMicroseconds;
+    elapsedSeconds = (double) elapsedMicroseconds / 1000000.0;
+    DataFlashQueueGetStatistics(&requests, &mergedReads, &pipelinedRequests, &maximumDepth);
+    DataFlashGetEraseSuspendStatistics(&erasesStarted, &eraseSuspends);
+    DataflashSimGetStatistics(&statistics);
+    qsort(errorLatency, TOTAL_ERRORS, sizeof(uint64_t), CompareLatency);
+    (void) printf("%.1f events/s, %.1f errors/s, %.1f flushes/s in %.1f s\n", (double) TOTAL_EVENTS / elapsedSeconds,
+                  (double) TOTAL_ERRORS / elapsedSeconds, (double) atomic_load(&completedFlushes) / elapsedSeconds, elapsedSeconds);
+    (void) printf("Error writes: median %.1f us, longest %.1f us\n", (double) errorLatency[TOTAL_ERRORS / 2u] / 1000.0,
+                  (double) errorLatency[TOTAL_ERRORS - 1u] / 1000.0);
+    (void) printf("%u requests, %u reads merged, %u requests during %u erases, %u suspends, deepest queue %u\n",
+                  requests, mergedReads, pipelinedRequests, erasesStarted, eraseSuspends, maximumDepth);
+    (void) fflush(stdout);
+    HOST_TEST_CHECK(atomic_load(&completedFlushes) == DEBUG_PASSES);
+    HOST_TEST_CHECK(mergedReads > 0u);
+    HOST_TEST_CHECK(pipelinedRequests > 0u);
+    HOST_TEST_CHECK(eraseSuspends > 0u);
+    HOST_TEST_CHECK(statistics.eraseSuspends == eraseSuspends);
+    //No program or erase reaches the suspended subsectors
+    HOST_TEST_CHECK(statistics.suspendedCommands == 0u);
+    //The debug words are erased, the event log of the next start finds its
+    //subsectors as it left them
+    memset(&eraseRequest, 0, sizeof(eraseRequest));
+    eraseRequest.operation = DATAFLASH_REQUEST_ERASE;
+    eraseRequest.subsectorNumber = DEBUG_SUBSECTOR;
+    eraseRequest.nSubsectors = 1u;
+    DataFlashQueueSubmit(&eraseRequest);
+    DataFlashQueueWait(&eraseRequest);
+}
+//------------------------------------------------------------------------------
+//   CheckTraffic(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the events and the errors back after the restart
+//
+//------------------------------------------------------------------------------
+static void CheckTraffic(
+                           void *argument                                       //!< Not used
+                        )
+{
+    //For the cursor and the events read
+    EVENT_LOG_CURSOR_STRUCT cursor;
+    const unsigned char *event = NULL;
+    unsigned char eventLength = 0u;
+    //For counting the events
+    unsigned int panicEvents = 0u;
+    //For the latest error of a code
+    unsigned short identifier = 0u;
+    //For indexing the codes
+    unsigned int codeIndex = 0u;
+    (void) argument;
+    HOST_TEST_CHECK(EventLogCursorOpen(&cursor, 0u) == true);
+    while ( EventLogCursorNext(&cursor, &event, &eventLength) == true )
+    {
+        if ( event[0] == (unsigned char) EVENTLOG_ID_PANIC_ALARM_EVENT )
+        {
+            panicEvents++;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    EventLogCursorClose(&cursor);
+    HOST_TEST_CHECK(panicEvents == TOTAL_EVENTS);
+    for ( codeIndex = 0u; codeIndex < ERROR_CODES; codeIndex++ )
+    {
+        identifier = 0u;
+        ErrorLogFindLatestIdentifier(&identifier, writtenCodes[codeIndex]);
+        HOST_TEST_CHECK(identifier == ERRORS_PER_CODE);
+    }
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    HostTestStart("DataflashQueueTest", true);
+    HOST_TEST_CHECK(HostTestRunBoot(WriteTraffic, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckTraffic, NULL) == 0);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,361 @@
+//==============================================================================
+//
+//  DataflashSimTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashSimTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test runs the dataflash driver on the simulated N25Q128. It checks
+//! the identification, the program and erase commands, the content kept
+//! across a restart and the power cut and stuck busy faults
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <string.h>
+#include "HostRTOS.h"
+#include "DataflashSim.h"
+#include "HostTest.h"
+#include "Dataflash.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define TEST_SUBSECTOR 3000u                                                    //!< Subsector used by the test, far ahead of the first events logged
+#define CUT_SUBSECTOR (TEST_SUBSECTOR+1u)                                       //!< Subsector whose program is cut
+#define STUCK_SUBSECTOR (TEST_SUBSECTOR+2u)                                     //!< Subsector programmed while the chip is stuck busy
+#define PATTERN_OFFSET 200u                                                     //!< Offset of the pattern, so that it crosses a page
+#define PATTERN_LENGTH 300u                                                     //!< Bytes of the pattern
+#define CLEARED_MASK 0x0Fu                                                      //!< Bits kept by the second program of the pattern
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static bool hasSFDPTable = true;                                                //!< Argument of CheckGeometry for a chip with an SFDP table
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static unsigned char GetPatternByte(unsigned short byteIndex);
+static unsigned char *GetSubsector(unsigned short subsectorNumber);
+static void CheckNoCommandIgnored(void);
+static void CheckGeometry(void *argument);
+static void CheckProgramAndErase(void *argument);
+static void CheckRestart(void *argument);
+static void CutProgram(void *argument);
+static void CheckStuckBusy(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetPatternByte(unsigned short byteIndex)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns a byte of the pattern programmed by the test
+//
+//------------------------------------------------------------------------------
+static unsigned char GetPatternByte(
+                                      unsigned short byteIndex                  //!< Index of the byte in the pattern
+                                   )
+{
+    return (unsigned char) ((byteIndex * 37u) + 11u);
+}
+//------------------------------------------------------------------------------
+//   GetSubsector(unsigned short subsectorNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the simulated content of a subsector
+//
+//------------------------------------------------------------------------------
+static unsigned char *GetSubsector(
+                                     unsigned short subsectorNumber             //!< Subsector
+                                  )
+{
+    return &DataflashSimGetMemory()[(unsigned int) subsectorNumber * DATAFLASH_SUBSECTOR_SIZE];
+}
+//------------------------------------------------------------------------------
+//   CheckNoCommandIgnored(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks that the driver has not sent a command the chip
+//!  ignores, while it is busy or without write enable, nor a program wrapping
+//!  in its page
+//
+//------------------------------------------------------------------------------
+static void CheckNoCommandIgnored(void)
+{
+    //For the statistics of the simulated dataflash
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    DataflashSimGetStatistics(&statistics);
+    HOST_TEST_CHECK(statistics.busyCommands == 0u);
+    HOST_TEST_CHECK(statistics.unlatchedCommands == 0u);
+    HOST_TEST_CHECK(statistics.unknownCommands == 0u);
+    HOST_TEST_CHECK(statistics.failedTransfers == 0u);
+    HOST_TEST_CHECK(statistics.pageWraps == 0u);
+}
+//------------------------------------------------------------------------------
+//   CheckGeometry(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks the geometry found by DataFlashInit, read from the
+//!  SFDP table if the argument is not NULL
+//
+//------------------------------------------------------------------------------
+static void CheckGeometry(
+                            void *argument                                      //!< Not NULL if the chip has an SFDP table
+                         )
+{
+    //For the geometry found by the driver
+    DATAFLASH_GEOMETRY_STRUCT geometry;
+    DataFlashGetGeometry(&geometry);
+    HOST_TEST_CHECK(geometry.isSFDPFound == (argument != NULL));
+    HOST_TEST_CHECK(geometry.pageSize == DATAFLASH_PAGE_SIZE);
+    HOST_TEST_CHECK(geometry.programSize == DATAFLASH_PAGE_SIZE);
+    HOST_TEST_CHECK(geometry.isBlockEraseSupported == true);
+    if ( argument != NULL )
+    {
+        HOST_TEST_CHECK(geometry.capacity == DATAFLASH_SIM_SIZE);
+    }
+    else
+    {
+        //Do nothing
+    }
+    CheckNoCommandIgnored();
+}
+//------------------------------------------------------------------------------
+//   CheckProgramAndErase(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases a subsector, programs a pattern crossing a page and
+//!  reads it back, then programs it again to check that a program only clears
+//!  bits
+//
+//------------------------------------------------------------------------------
+static void CheckProgramAndErase(
+                                   void *argument                               //!< Not used
+                                )
+{
+    //For the pattern and the bytes read back
+    unsigned char pattern[PATTERN_LENGTH];
+    unsigned char data[PATTERN_LENGTH];
+    //For indexing the bytes
+    unsigned short byteIndex = 0u;
+    //For counting the erased bytes
+    unsigned int erasedBytes = 0u;
+    //For the subsector in the simulated dataflash
+    unsigned char *subsector = GetSubsector((unsigned short) TEST_SUBSECTOR);
+    (void) argument;
+    DataflashSimResetStatistics();
+    memset(subsector, 0x5A, DATAFLASH_SUBSECTOR_SIZE);
+    DataFlashEraseSubsectors((unsigned short) TEST_SUBSECTOR, 1u);
+    for ( byteIndex = 0u; byteIndex < DATAFLASH_SUBSECTOR_SIZE; byteIndex++ )
+    {
+        if ( subsector[byteIndex] == 0xFFu )
+        {
+            erasedBytes++;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    HOST_TEST_CHECK(erasedBytes == DATAFLASH_SUBSECTOR_SIZE);
+    HOST_TEST_CHECK(DataflashSimGetEraseCount((unsigned short) TEST_SUBSECTOR) == 1u);
+    for ( byteIndex = 0u; byteIndex < PATTERN_LENGTH; byteIndex++ )
+    {
+        pattern[byteIndex] = GetPatternByte(byteIndex);
+    }
+    DataFlashProgramBytes((unsigned short) TEST_SUBSECTOR, (unsigned short) PATTERN_OFFSET, pattern, (unsigned short) PATTERN_LENGTH);
+    DataFlashReadBytes((unsigned short) TEST_SUBSECTOR, (unsigned short) PATTERN_OFFSET, data, (unsigned short) PATTERN_LENGTH);
+    HOST_TEST_CHECK(memcmp(data, pattern, PATTERN_LENGTH) == 0);
+    HOST_TEST_CHECK(subsector[PATTERN_OFFSET - 1u] == 0xFFu);
+    HOST_TEST_CHECK(subsector[PATTERN_OFFSET + PATTERN_LENGTH] == 0xFFu);
+    for ( byteIndex = 0u; byteIndex < PATTERN_LENGTH; byteIndex++ )
+    {
+        data[byteIndex] = (unsigned char) (CLEARED_MASK | (~pattern[byteIndex]));
+    }
+    DataFlashProgramBytes((unsigned short) TEST_SUBSECTOR, (unsigned short) PATTERN_OFFSET, data, (unsigned short) PATTERN_LENGTH);
+    for ( byteIndex = 0u; byteIndex < PATTERN_LENGTH; byteIndex++ )
+    {
+        HOST_TEST_CHECK(subsector[PATTERN_OFFSET + byteIndex] == (pattern[byteIndex] & CLEARED_MASK));
+    }
+    DataFlashEraseSubsectors((unsigned short) TEST_SUBSECTOR, 1u);
+    DataFlashProgramBytes((unsigned short) TEST_SUBSECTOR, (unsigned short) PATTERN_OFFSET, pattern, (unsigned short) PATTERN_LENGTH);
+    CheckNoCommandIgnored();
+}
+//------------------------------------------------------------------------------
+//   CheckRestart(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads back after a restart the pattern programmed before it
+//
+//------------------------------------------------------------------------------
+static void CheckRestart(
+                           void *argument                                       //!< Not used
+                        )
+{
+    //For the bytes read back
+    unsigned char data[PATTERN_LENGTH];
+    //For indexing the bytes
+    unsigned short byteIndex = 0u;
+    (void) argument;
+    DataFlashReadBytes((unsigned short) TEST_SUBSECTOR, (unsigned short) PATTERN_OFFSET, data, (unsigned short) PATTERN_LENGTH);
+    for ( byteIndex = 0u; byteIndex < PATTERN_LENGTH; byteIndex++ )
+    {
+        HOST_TEST_CHECK(data[byteIndex] == GetPatternByte(byteIndex));
+    }
+}
+//------------------------------------------------------------------------------
+//   CutProgram(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs a page of zeros and cuts the power during it
+//
+//------------------------------------------------------------------------------
+static void CutProgram(
+                         void *argument                                         //!< Not used
+                      )
+{
+    //For the zeros programmed
+    unsigned char zeros[DATAFLASH_PAGE_SIZE];
+    (void) argument;
+    memset(zeros, 0, sizeof(zeros));
+    DataFlashEraseSubsectors((unsigned short) CUT_SUBSECTOR, 1u);
+    HostSeedRandom(0x1234567u);
+    HostSetPowerCut(1u);
+    DataFlashProgramBytes((unsigned short) CUT_SUBSECTOR, 0u, zeros, (unsigned short) DATAFLASH_PAGE_SIZE);
+    //The power is cut before here
+    HOST_TEST_CHECK(false);
+}
+//------------------------------------------------------------------------------
+//   CheckStuckBusy(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs while the chip stays busy, the driver must give up
+//!  after the program timeout instead of hanging
+//
+//------------------------------------------------------------------------------
+static void CheckStuckBusy(
+                             void *argument                                     //!< Not used
+                          )
+{
+    //For the zeros programmed
+    unsigned char zeros[DATAFLASH_PAGE_SIZE];
+    //For the statistics of the simulated dataflash
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    //For the time taken by the program
+    uint64_t startMicroseconds = 0u;
+    //For indexing the bytes
+    unsigned short byteIndex = 0u;
+    //For the subsector in the simulated dataflash
+    unsigned char *subsector = GetSubsector((unsigned short) STUCK_SUBSECTOR);
+    (void) argument;
+    memset(zeros, 0, sizeof(zeros));
+    DataFlashEraseSubsectors((unsigned short) STUCK_SUBSECTOR, 1u);
+    DataflashSimResetStatistics();
+    DataflashSimSetStuckBusy(true);
+    startMicroseconds = HostGetMicroseconds();
+    DataFlashProgramBytes((unsigned short) STUCK_SUBSECTOR, 0u, zeros, (unsigned short) DATAFLASH_PAGE_SIZE);
+    DataflashSimSetStuckBusy(false);
+    DataflashSimGetStatistics(&statistics);
+    HOST_TEST_CHECK(statistics.busyCommands > 0u);
+    HOST_TEST_CHECK(statistics.pagePrograms == 0u);
+    HOST_TEST_CHECK((HostGetMicroseconds() - startMicroseconds) < 60000000u);
+    for ( byteIndex = 0u; byteIndex < DATAFLASH_PAGE_SIZE; byteIndex++ )
+    {
+        HOST_TEST_CHECK(subsector[byteIndex] == 0xFFu);
+    }
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    //For the bytes of the cut page
+    const unsigned char *page = NULL;
+    //For indexing the bytes and the first byte not programmed
+    unsigned short byteIndex = 0u;
+    unsigned short clearedBytes = 0u;
+    HostTestStart("DataflashSimTest", true);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckGeometry, (void *) &hasSFDPTable) == 0);
+    DataflashSimSetSFDP(false, (unsigned short) DATAFLASH_PAGE_SIZE);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckGeometry, NULL) == 0);
+    DataflashSimSetSFDP(true, (unsigned short) DATAFLASH_PAGE_SIZE);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckProgramAndErase, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckRestart, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(CutProgram, NULL) == HOST_POWER_CUT_EXIT_CODE);
+    //The cut page holds zeros, at most one partly programmed byte and erased bytes
+    page = GetSubsector((unsigned short) CUT_SUBSECTOR);
+    while ( (clearedBytes < DATAFLASH_PAGE_SIZE) && (page[clearedBytes] == 0u) )
+    {
+        clearedBytes++;
+    }
+    for ( byteIndex = clearedBytes + 1u; byteIndex < DATAFLASH_PAGE_SIZE; byteIndex++ )
+    {
+        HOST_TEST_CHECK(page[byteIndex] == 0xFFu);
+    }
+    HOST_TEST_CHECK(HostTestRunBoot(CheckStuckBusy, NULL) == 0);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,373 @@
+//==============================================================================
+//
+//  ErrorLogTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        ErrorLogTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test writes errors over many restarts of the instrument. After each
+//! restart it checks that the error log finds the latest identifier and entry
+//! of every error, and that an error is scanned with one dataflash transfer
+//! per page. Some runs end with a power cut during the write of an error, the
+//! error is then either complete or skipped, and the next errors are written
+//! after it
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdio.h>
+#include <sys/mman.h>
+#include "HostRTOS.h"
+#include "DataflashSim.h"
+#include "HostTest.h"
+#include "TM4CRTC.h"
+#include "ErrorLog.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define RESTARTS 120u                                                           //!< Restarts of the instrument
+#define LONGEST_RUN 30u                                                         //!< Most errors written between two restarts
+#define WRITTEN_CODES 11u                                                       //!< Error codes written by the test
+#define LEGACY_ERROR_INDEX (TOTAL_NUMBER_OF_ERRORS - 1u)                        //!< Error log shared by the legacy errors
+#define READ_WORDS (TOTAL_ERROR_ENTRIES * (WORDS_PER_ERRLOG - 1u))              //!< Most words returned by ErrorLogRead
+#define CUT_RUN_PERIOD 3u                                                       //!< One run in this many ends with a power cut in a write
+#define LAST_CUT_OPERATION 3u                                                   //!< Last program or erase of the write at which the power may be cut
+
+//! This data structure holds the latest entry of an error log, as written
+typedef struct
+{
+    unsigned short identifier;                                                  //!< Identifier of the latest entry, 0 if none
+    ERRORCODE_ENUM errorCode;                                                   //!< Error code of the latest entry
+    DATE_TIME_STRUCT dateTime;                                                  //!< Time of the latest entry
+
+} LATEST_ERROR_STRUCT;
+
+//! This data structure holds what the runs have written, it is shared by the
+//! processes of the runs
+typedef struct
+{
+    unsigned int run;                                                           //!< Index of the run
+    unsigned int writtenErrors;                                                 //!< Errors written by all the runs
+    LATEST_ERROR_STRUCT latestErrors[TOTAL_NUMBER_OF_ERRORS];                   //!< Latest entry of each error log
+    bool isCutPending;                                                          //!< True if the last run was cut during a write
+    unsigned int cutErrorIndex;                                                 //!< Error log of the write cut
+    LATEST_ERROR_STRUCT cutError;                                               //!< Entry of the write cut
+    unsigned int cutWrites;                                                     //!< Writes cut by a power loss
+    unsigned int skippedWrites;                                                 //!< Writes cut before their entry was complete
+
+} ERROR_STATE_STRUCT;
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//! Error codes written by the test, the last two go to the legacy error log
+static const ERRORCODE_ENUM writtenCodes[WRITTEN_CODES] =
+{
+    ERRORCODE_ENUM_WHISPER_DEVICE_ERROR,
+    ERRORCODE_ENUM_ETHERNET_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_WIFI_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_CELLULAR_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_DATAFLASH_READ_WRITE_ERROR,
+    ERRORCODE_ENUM_NETWORK_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_NFC_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_BTLE_COMMUNICATION_ERROR,
+    ERRORCODE_ENUM_UNDEFINED_MODBUS_REGISTER,
+    ERRORCODE_ENUM_I2C_LOCKUP_ERROR,
+    ERRORCODE_ENUM_MICRO_VDD_ERROR
+};
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CheckErrorLog(ERROR_STATE_STRUCT *state);
+static void WriteRandomError(ERROR_STATE_STRUCT *state, LATEST_ERROR_STRUCT *writtenError, unsigned int *errorIndex);
+static void RunInstrument(void *argument);
+static void CheckLegacyRates(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CheckErrorLog(ERROR_STATE_STRUCT *state)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks the latest identifier and entry of every error log
+//!  against the errors written
+//
+//------------------------------------------------------------------------------
+static void CheckErrorLog(
+                            ERROR_STATE_STRUCT *state                           //!< Errors written by the runs
+                         )
+{
+    //For the statistics of the simulated dataflash
+    DATAFLASH_SIM_STATISTICS_STRUCT statistics;
+    //For the latest entry of an error log
+    const LATEST_ERROR_STRUCT *latestError = NULL;
+    unsigned short identifier = 0u;
+    unsigned short data[READ_WORDS];
+    //For indexing the error logs
+    unsigned int errorIndex = 0u;
+    //The entry of a write cut by a power loss is either complete or skipped
+    if ( state->isCutPending == true )
+    {
+        identifier = 0u;
+        ErrorLogFindLatestIdentifier(&identifier, state->cutError.errorCode);
+        HOST_TEST_CHECK((identifier == state->cutError.identifier) ||
+                        (identifier == state->latestErrors[state->cutErrorIndex].identifier));
+        if ( identifier == state->cutError.identifier )
+        {
+            state->latestErrors[state->cutErrorIndex] = state->cutError;
+        }
+        else
+        {
+            state->skippedWrites++;
+        }
+        state->isCutPending = false;
+    }
+    else
+    {
+        //Do nothing
+    }
+    for ( errorIndex = 0u; errorIndex < TOTAL_NUMBER_OF_ERRORS; errorIndex++ )
+    {
+        latestError = &state->latestErrors[errorIndex];
+        identifier = 0u;
+        DataflashSimResetStatistics();
+        ErrorLogFindLatestIdentifier(&identifier, writtenCodes[errorIndex]);
+        DataflashSimGetStatistics(&statistics);
+        HOST_TEST_CHECK(identifier == latestError->identifier);
+        //Each page of the error is read at once, after the status read of the
+        //wait for the chip
+        HOST_TEST_CHECK((statistics.transfers - statistics.statusReads) == PAGES_PER_ERROR_LOG);
+        if ( latestError->identifier != 0u )
+        {
+            ErrorLogRead(data, writtenCodes[errorIndex]);
+            HOST_TEST_CHECK(data[0] == (unsigned short) latestError->errorCode);
+            HOST_TEST_CHECK(data[1] == (unsigned short) ((latestError->dateTime.monthId << 8) | latestError->dateTime.dayId));
+            HOST_TEST_CHECK(data[2] == latestError->dateTime.yearId);
+            HOST_TEST_CHECK(data[3] == (unsigned short) ((latestError->dateTime.hourId << 8) | latestError->dateTime.minId));
+            HOST_TEST_CHECK(data[4] == latestError->dateTime.secondId);
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+}
+//------------------------------------------------------------------------------
+//   WriteRandomError(ERROR_STATE_STRUCT *state, LATEST_ERROR_STRUCT *writtenError, unsigned int *errorIndex)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a random error once the rate limit of its error
+//!  allows it to be written. The entry and its error log are returned before
+//!  the write starts
+//
+//------------------------------------------------------------------------------
+static void WriteRandomError(
+                               ERROR_STATE_STRUCT *state,                       //!< Errors written by the runs
+                               LATEST_ERROR_STRUCT *writtenError,               //!< Entry written
+                               unsigned int *errorIndex                         //!< Error log of the entry
+                            )
+{
+    //For the error written
+    unsigned int codeIndex = HostRandom() % WRITTEN_CODES;
+    *errorIndex = codeIndex;
+    if ( codeIndex >= TOTAL_NUMBER_OF_ERRORS )
+    {
+        *errorIndex = LEGACY_ERROR_INDEX;
+    }
+    else
+    {
+        //Do nothing
+    }
+    writtenError->identifier = state->latestErrors[*errorIndex].identifier + 1u;
+    writtenError->errorCode = writtenCodes[codeIndex];
+    Task_sleep(ERRLOG_TOKEN_PERIOD_MS);
+    //The error log takes the same time, the program of the error before is
+    //not moving the simulated time on meanwhile
+    HostTestWaitDataflash();
+    RTCGetCurrentDateTime(&writtenError->dateTime);
+    ErrorLogWrite(writtenCodes[codeIndex], ERRORTYPE_ENUM_CRITICAL);
+}
+//------------------------------------------------------------------------------
+//   RunInstrument(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks the error log, then writes random errors. Some runs
+//!  end with a power cut during the write of their last error
+//
+//------------------------------------------------------------------------------
+static void RunInstrument(
+                            void *argument                                      //!< Errors written by the runs
+                         )
+{
+    //For the state shared by the runs
+    ERROR_STATE_STRUCT *state = (ERROR_STATE_STRUCT *) argument;
+    //For the errors of the run
+    LATEST_ERROR_STRUCT writtenError;
+    unsigned int runErrors = 0u;
+    unsigned int errorIndex = 0u;
+    CheckErrorLog(state);
+    HostSeedRandom((state->run + 1u) * 2654435761u);
+    runErrors = (HostRandom() % LONGEST_RUN) + 1u;
+    while ( runErrors > 0u )
+    {
+        WriteRandomError(state, &writtenError, &errorIndex);
+        state->latestErrors[errorIndex] = writtenError;
+        state->writtenErrors++;
+        runErrors--;
+    }
+    if ( (HostRandom() % CUT_RUN_PERIOD) == 0u )
+    {
+        //The entry is recorded before any of it can reach the dataflash, the
+        //next run finds out whether it is complete
+        state->isCutPending = true;
+        state->cutWrites++;
+        //The power is cut in this write, not in the programs of the errors
+        //still queued
+        HostTestWaitDataflash();
+        HostSetPowerCut((HostRandom() % LAST_CUT_OPERATION) + 1u);
+        WriteRandomError(state, &state->cutError, &state->cutErrorIndex);
+        //The write is queued, the power is cut while TaskDataflash carries
+        //it out
+        HostTestWaitDataflash();
+        HostPowerOff();
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   CheckLegacyRates(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes bursts of two legacy errors, they share an error log
+//!  but each has its own rate. An error over the rate of its code is written
+//!  once its code gets a token again
+//
+//------------------------------------------------------------------------------
+static void CheckLegacyRates(
+                               void *argument                                   //!< Not used
+                            )
+{
+    //For the identifiers of the legacy error log
+    unsigned short startIdentifier = 0u;
+    unsigned short identifier = 0u;
+    unsigned short data[READ_WORDS];
+    //For indexing the errors
+    unsigned int errorIndex = 0u;
+    (void) argument;
+    //Both codes start with a full bucket
+    Task_sleep(ERRLOG_BUCKET_TOKENS * ERRLOG_TOKEN_PERIOD_MS);
+    HostTestWaitDataflash();
+    ErrorLogFindLatestIdentifier(&startIdentifier, ERRORCODE_ENUM_I2C_LOCKUP_ERROR);
+    for ( errorIndex = 0u; errorIndex < ERRLOG_BUCKET_TOKENS; errorIndex++ )
+    {
+        ErrorLogWrite(ERRORCODE_ENUM_I2C_LOCKUP_ERROR, ERRORTYPE_ENUM_CRITICAL);
+        ErrorLogWrite(ERRORCODE_ENUM_MICRO_VDD_ERROR, ERRORTYPE_ENUM_CRITICAL);
+    }
+    //The bucket of the first code is empty, this error is counted as repeated
+    ErrorLogWrite(ERRORCODE_ENUM_I2C_LOCKUP_ERROR, ERRORTYPE_ENUM_CRITICAL);
+    HostTestWaitDataflash();
+    ErrorLogFindLatestIdentifier(&identifier, ERRORCODE_ENUM_I2C_LOCKUP_ERROR);
+    HOST_TEST_CHECK(identifier == (startIdentifier + (2u * ERRLOG_BUCKET_TOKENS)));
+    Task_sleep(ERRLOG_TOKEN_PERIOD_MS);
+    ErrorLogFlushRepeated();
+    HostTestWaitDataflash();
+    ErrorLogFindLatestIdentifier(&identifier, ERRORCODE_ENUM_I2C_LOCKUP_ERROR);
+    HOST_TEST_CHECK(identifier == (startIdentifier + (2u * ERRLOG_BUCKET_TOKENS) + 1u));
+    ErrorLogRead(data, ERRORCODE_ENUM_I2C_LOCKUP_ERROR);
+    HOST_TEST_CHECK(data[0] == (unsigned short) ERRORCODE_ENUM_I2C_LOCKUP_ERROR);
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    //For the state shared with the runs
+    ERROR_STATE_STRUCT *state = mmap(NULL, sizeof(ERROR_STATE_STRUCT), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    //For the exit code of a run
+    int exitCode = 0;
+    //For indexing the error logs
+    unsigned int errorIndex = 0u;
+    HostTestStart("ErrorLogTest", true);
+    HOST_TEST_CHECK(state != MAP_FAILED);
+    if ( state != MAP_FAILED )
+    {
+        for ( state->run = 0u; state->run < RESTARTS; state->run++ )
+        {
+            exitCode = HostTestRunBoot(RunInstrument, state);
+            HOST_TEST_CHECK((exitCode == 0) || (exitCode == HOST_POWER_CUT_EXIT_CODE));
+        }
+        //The last run is only checked
+        HOST_TEST_CHECK(HostTestRunBoot((HOST_TEST_BOOT_FUNCTION) CheckErrorLog, state) == 0);
+        //Every error log has wrapped around its entries
+        for ( errorIndex = 0u; errorIndex < TOTAL_NUMBER_OF_ERRORS; errorIndex++ )
+        {
+            HOST_TEST_CHECK(state->latestErrors[errorIndex].identifier > TOTAL_ERROR_ENTRIES);
+        }
+        HOST_TEST_CHECK(state->skippedWrites > 0u);
+        HOST_TEST_CHECK(HostTestRunBoot(CheckLegacyRates, NULL) == 0);
+        (void) printf("%u errors, %u writes cut, %u of them skipped\n", state->writtenErrors, state->cutWrites, state->skippedWrites);
+    }
+    else
+    {
+        //Do nothing
+    }
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,402 @@
+//==============================================================================
+//
+//  EventEncodeTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventEncodeTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test builds EventLog.c in and checks EncodeEvent for every row of
+//! the descriptor table against an encoder written like the writers were
+//! before the table, one switch on the event ID and one loop per field. It
+//! then measures the events per second of both encoders
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include "EventLog.c"
+#include <stdio.h>
+#include "HostTest.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define RANDOM_ROUNDS 2000u                                                     //!< Random encodings compared for every event ID
+#define LONGEST_LP_DATA 16u                                                     //!< Room for the longest LP data
+#define BENCHMARK_EVENTS 4000000u                                               //!< Events encoded by every benchmark run
+#define BENCHMARK_SLOTS 64u                                                     //!< Slots the benchmark encodes in turn
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static unsigned char GetSwitchEventLength(EVENTLOG_ID_ENUM eventID);
+static void EncodeSwitchEvent(unsigned char *eventSlot, EVENTLOG_ID_ENUM eventID, DATE_TIME_STRUCT *dateTime, unsigned int sequenceNumber, unsigned short peerNumber, const unsigned char *lpData);
+static void GetRandomEvent(DATE_TIME_STRUCT *dateTime, unsigned short *peerNumber, unsigned char *lpData);
+static double GetEventsPerSecond(bool isSwitch, const unsigned char *lpData, unsigned int *checkSum);
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static unsigned char benchmarkSlots[BENCHMARK_SLOTS][ONE_EVENT_SIZE];           //!< Slots filled by the benchmark
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetSwitchEventLength(EVENTLOG_ID_ENUM eventID)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the length of the given ID from the switch used
+//!  before the descriptor table
+//
+//------------------------------------------------------------------------------
+static unsigned char GetSwitchEventLength(
+                                            EVENTLOG_ID_ENUM eventID            //!< Event ID
+                                         )
+{
+    //For event length
+    unsigned char eventLength = 0u;
+    //Get the Event length based on the given ID
+    switch ( eventID )
+    {
+        case EVENTLOG_ID_LPONLINE_EVENT:
+        case EVENTLOG_ID_LPOFFLINE_EVENT:
+        case EVENTLOG_ID_LB_CREATE_EVENT:
+        case EVENTLOG_ID_NO_LB_EVENT:
+        case EVENTLOG_ID_LP_KEEPALIVE_EVENT:
+            eventLength = 8u;
+            break;
+        case EVENTLOG_ID_CELL_RSSI_EVENT:
+        case EVENTLOG_ID_ERROR_STATUS_EVENT:
+            eventLength = 10u;
+            break;
+        case EVENTLOG_ID_GPS_UPDATE_EVENT:
+            eventLength = 16u;
+            break;
+        case EVENTLOG_ID_IMEI_UPDATE_EVENT:
+            eventLength = 23u;
+            break;
+        case EVENTLOG_ID_INST_LOST_EVENT:
+        case EVENTLOG_ID_SITE_UPDATE_EVENT:
+        case EVENTLOG_ID_LEAVE_GROUP_EVENT:
+        case EVENTLOG_ID_MAN_DOWN_EVENT:
+        case EVENTLOG_ID_MANDOWN_CLEAR_EVENT:
+        case EVENTLOG_ID_PANIC_ALARM_EVENT:
+        case EVENTLOG_ID_PANIC_CLEAR_EVENT:
+        case EVENTLOG_ID_PUMP_ERROR_EVENT:
+        case EVENTLOG_ID_PUMP_READY_EVENT:
+            eventLength = 24u;
+            break;
+        case EVENTLOG_ID_USER_UPDATE_EVENT:
+            eventLength = 40u;
+            break;
+        case EVENTLOG_ID_SENSOR_UPDATE_EVENT:
+        case EVENTLOG_ID_HIGH_ALARM_EVENT:
+        case EVENTLOG_ID_LOW_ALARM_EVENT:
+        case EVENTLOG_ID_STEL_ALARM_EVENT:
+        case EVENTLOG_ID_TWA_ALARM_EVENT:
+        case EVENTLOG_ID_GAS_ALARM_CLEAR_EVENT:
+            eventLength = 59u;
+            break;
+        case EVENTLOG_ID_JOIN_GROUP_EVENT:
+            eventLength = 91u;
+            break;
+        default:
+            break;
+    }
+    return eventLength;
+}
+//------------------------------------------------------------------------------
+//   EncodeSwitchEvent(unsigned char *eventSlot, EVENTLOG_ID_ENUM eventID, DATE_TIME_STRUCT *dateTime, unsigned int sequenceNumber, unsigned short peerNumber, const unsigned char *lpData)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function serializes one event the way the writers did before the
+//!  descriptor table: the fields of every event ID are written one byte at a
+//!  time by a branch of a switch. The sequence number and the CRC follow
+//
+//------------------------------------------------------------------------------
+static void EncodeSwitchEvent(
+                                unsigned char *eventSlot,                       //!< Slot of ONE_EVENT_SIZE bytes
+                                EVENTLOG_ID_ENUM eventID,                       //!< Event ID
+                                DATE_TIME_STRUCT *dateTime,                     //!< Time stamp of the event
+                                unsigned int sequenceNumber,                    //!< Sequence number of the event
+                                unsigned short peerNumber,                      //!< Peer number saved in the device ID
+                                const unsigned char *lpData                     //!< GPS, IMEI, RSSI or error bytes
+                             )
+{
+    //For the length of the fields
+    unsigned int fieldLength = 0u;
+    //For indexing the slot and the fields
+    unsigned int slotIndex = 0u;
+    unsigned int dataIndex = 0u;
+    //For the CRC of the event
+    unsigned short eventCRC = 0u;
+    eventSlot[slotIndex++] = (unsigned char) eventID;
+    eventSlot[slotIndex++] = dateTime->monthId;
+    eventSlot[slotIndex++] = dateTime->dayId;
+    eventSlot[slotIndex++] = (unsigned char) dateTime->yearId;
+    eventSlot[slotIndex++] = dateTime->hourId;
+    eventSlot[slotIndex++] = dateTime->minId;
+    eventSlot[slotIndex++] = dateTime->secondId;
+    eventSlot[slotIndex++] = GetSwitchEventLength(eventID);
+    switch ( eventID )
+    {
+        case EVENTLOG_ID_GPS_UPDATE_EVENT:
+        case EVENTLOG_ID_IMEI_UPDATE_EVENT:
+        case EVENTLOG_ID_CELL_RSSI_EVENT:
+        case EVENTLOG_ID_ERROR_STATUS_EVENT:
+            //The LP data fills the event
+            fieldLength = GetSwitchEventLength(eventID) - EVENT_HEADER_LENGTH;
+            for ( dataIndex = 0u; dataIndex < fieldLength; dataIndex++ )
+            {
+                eventSlot[slotIndex++] = lpData[dataIndex];
+            }
+            break;
+        case EVENTLOG_ID_SITE_UPDATE_EVENT:
+            //Blank site name
+            for ( dataIndex = 0u; dataIndex < USER_SITE_NAME_LENGTH; dataIndex++ )
+            {
+                eventSlot[slotIndex++] = 0x00u;
+            }
+            break;
+        case EVENTLOG_ID_LPONLINE_EVENT:
+        case EVENTLOG_ID_LPOFFLINE_EVENT:
+        case EVENTLOG_ID_LB_CREATE_EVENT:
+        case EVENTLOG_ID_NO_LB_EVENT:
+        case EVENTLOG_ID_LP_KEEPALIVE_EVENT:
+        case EVENTLOG_ID_NO_EVENT:
+            break;
+        default:
+            //Every other event starts with the device ID, the user name,
+            //site name and sensor status that follow it are blank
+            fieldLength = GetSwitchEventLength(eventID);
+            if ( fieldLength != 0u )
+            {
+                eventSlot[slotIndex++] = (unsigned char) (peerNumber >> 8);
+                eventSlot[slotIndex++] = (unsigned char) peerNumber;
+                while ( slotIndex < fieldLength )
+                {
+                    eventSlot[slotIndex++] = 0x00u;
+                }
+            }
+            else
+            {
+                //Do nothing
+            }
+            break;
+    }
+    //Fill the reminder of the event with zeroes
+    while ( slotIndex < EVENT_SEQUENCE_OFFSET )
+    {
+        eventSlot[slotIndex++] = 0x00u;
+    }
+    eventSlot[slotIndex++] = (unsigned char) (sequenceNumber >> 24);
+    eventSlot[slotIndex++] = (unsigned char) (sequenceNumber >> 16);
+    eventSlot[slotIndex++] = (unsigned char) (sequenceNumber >> 8);
+    eventSlot[slotIndex++] = (unsigned char) sequenceNumber;
+    eventCRC = GetEventCRC(eventSlot, EVENT_CRC_OFFSET);
+    eventSlot[slotIndex++] = (unsigned char) (eventCRC >> 8);
+    eventSlot[slotIndex++] = (unsigned char) eventCRC;
+    while ( slotIndex < ONE_EVENT_SIZE )
+    {
+        eventSlot[slotIndex++] = 0x00u;
+    }
+}
+//------------------------------------------------------------------------------
+//   GetRandomEvent(DATE_TIME_STRUCT *dateTime, unsigned short *peerNumber, unsigned char *lpData)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function draws a random time stamp, peer number and LP data
+//
+//------------------------------------------------------------------------------
+static void GetRandomEvent(
+                             DATE_TIME_STRUCT *dateTime,                        //!< Time stamp
+                             unsigned short *peerNumber,                        //!< Peer number
+                             unsigned char *lpData                              //!< LONGEST_LP_DATA bytes of LP data
+                          )
+{
+    //For indexing the LP data
+    unsigned int dataIndex = 0u;
+    dateTime->yearId = (unsigned short) (HostRandom() % 100u);
+    dateTime->monthId = (unsigned char) ((HostRandom() % 12u) + 1u);
+    dateTime->dayId = (unsigned char) ((HostRandom() % 28u) + 1u);
+    dateTime->hourId = (unsigned char) (HostRandom() % 24u);
+    dateTime->minId = (unsigned char) (HostRandom() % 60u);
+    dateTime->secondId = (unsigned char) (HostRandom() % 60u);
+    *peerNumber = (unsigned short) HostRandom();
+    for ( dataIndex = 0u; dataIndex < LONGEST_LP_DATA; dataIndex++ )
+    {
+        lpData[dataIndex] = (unsigned char) HostRandom();
+    }
+}
+//------------------------------------------------------------------------------
+//   GetEventsPerSecond(bool isSwitch, const unsigned char *lpData, unsigned int *checkSum)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function encodes BENCHMARK_EVENTS events of every ID in turn with
+//!  EncodeEvent or with the switch and returns the events per second. The
+//!  bytes are summed so that the encodings cannot be left out
+//
+//------------------------------------------------------------------------------
+static double GetEventsPerSecond(
+                                   bool isSwitch,                               //!< True to time the switch
+                                   const unsigned char *lpData,                 //!< LP data of the events
+                                   unsigned int *checkSum                       //!< Sum of the encoded bytes
+                                )
+{
+    //For the time stamp of the events
+    DATE_TIME_STRUCT dateTime = { .yearId = 26u, .monthId = 10u, .dayId = 17u };
+    //For the event and its slot
+    EVENTLOG_ID_ENUM eventID = EVENTLOG_ID_NO_EVENT;
+    unsigned char *eventSlot = NULL;
+    //For timing the run
+    uint64_t startTime = 0u;
+    uint64_t runTime = 0u;
+    //For indexing the events
+    unsigned int eventIndex = 0u;
+    startTime = HostTestGetNanoseconds();
+    for ( eventIndex = 0u; eventIndex < BENCHMARK_EVENTS; eventIndex++ )
+    {
+        eventID = (EVENTLOG_ID_ENUM) ((eventIndex % (TOTAL_NUMBER_OF_EVENT_IDS - 1u)) + 1u);
+        eventSlot = benchmarkSlots[eventIndex % BENCHMARK_SLOTS];
+        if ( isSwitch == true )
+        {
+            EncodeSwitchEvent(eventSlot, eventID, &dateTime, eventIndex, (unsigned short) eventIndex, lpData);
+        }
+        else
+        {
+            EncodeEvent(eventSlot, eventID, &dateTime, eventIndex, (unsigned short) eventIndex, lpData);
+        }
+        *checkSum = *checkSum + eventSlot[EVENT_CRC_OFFSET];
+    }
+    runTime = HostTestGetNanoseconds() - startTime;
+    return ((double) BENCHMARK_EVENTS * 1.0e9) / (double) (runTime + 1u);
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    //For the two encodings of an event
+    unsigned char tableSlot[ONE_EVENT_SIZE];
+    unsigned char switchSlot[ONE_EVENT_SIZE];
+    //For the random parts of an event
+    DATE_TIME_STRUCT dateTime;
+    unsigned short peerNumber = 0u;
+    unsigned char lpData[LONGEST_LP_DATA];
+    unsigned int sequenceNumber = 0u;
+    //For counting the mismatches of every event ID
+    unsigned int mismatches[TOTAL_NUMBER_OF_EVENT_IDS + 1u];
+    //For the benchmark
+    unsigned int tableCheckSum = 0u;
+    unsigned int switchCheckSum = 0u;
+    double tableRate = 0.0;
+    double switchRate = 0.0;
+    double runRate = 0.0;
+    //For indexing the loops
+    unsigned int eventID = 0u;
+    unsigned int roundIndex = 0u;
+    HostTestStart("EventEncodeTest", true);
+    HostSeedRandom(0x6D2B79F5u);
+    memset(mismatches, 0, sizeof(mismatches));
+    //One ID past the table checks the row of the unknown IDs
+    for ( eventID = 0u; eventID <= TOTAL_NUMBER_OF_EVENT_IDS; eventID++ )
+    {
+        for ( roundIndex = 0u; roundIndex < RANDOM_ROUNDS; roundIndex++ )
+        {
+            GetRandomEvent(&dateTime, &peerNumber, lpData);
+            sequenceNumber = HostRandom();
+            memset(tableSlot, 0x5A, sizeof(tableSlot));
+            memset(switchSlot, 0xA5, sizeof(switchSlot));
+            EncodeEvent(tableSlot, (EVENTLOG_ID_ENUM) eventID, &dateTime, sequenceNumber, peerNumber, lpData);
+            EncodeSwitchEvent(switchSlot, (EVENTLOG_ID_ENUM) eventID, &dateTime, sequenceNumber, peerNumber, lpData);
+            if ( memcmp(tableSlot, switchSlot, ONE_EVENT_SIZE) != 0 )
+            {
+                mismatches[eventID]++;
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+        HOST_TEST_CHECK(mismatches[eventID] == 0u);
+        if ( eventID < TOTAL_NUMBER_OF_EVENT_IDS )
+        {
+            HOST_TEST_CHECK(eventDescriptorTable[eventID].eventLength == GetSwitchEventLength((EVENTLOG_ID_ENUM) eventID));
+            HOST_TEST_CHECK(GetPackedLength(eventDescriptorTable[eventID].eventLength) <= ONE_EVENT_SIZE);
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    //The device ID and the LP data are saved as given
+    EncodeEvent(tableSlot, EVENTLOG_ID_PANIC_ALARM_EVENT, &dateTime, 0u, 0x1234u, NULL);
+    HOST_TEST_CHECK((tableSlot[EVENT_HEADER_LENGTH] == 0x12u) && (tableSlot[EVENT_HEADER_LENGTH + 1u] == 0x34u));
+    EncodeEvent(tableSlot, EVENTLOG_ID_IMEI_UPDATE_EVENT, &dateTime, 0u, 0u, lpData);
+    HOST_TEST_CHECK(memcmp(&tableSlot[EVENT_HEADER_LENGTH], lpData, IMEI_DATA_LENGTH) == 0);
+    HOST_TEST_CHECK(tableSlot[EVENT_HEADER_LENGTH + IMEI_DATA_LENGTH] == 0x00u);
+    //Events per second of both encoders, the best of three runs
+    for ( roundIndex = 0u; roundIndex < 3u; roundIndex++ )
+    {
+        runRate = GetEventsPerSecond(true, lpData, &switchCheckSum);
+        switchRate = (runRate > switchRate) ? runRate : switchRate;
+        runRate = GetEventsPerSecond(false, lpData, &tableCheckSum);
+        tableRate = (runRate > tableRate) ? runRate : tableRate;
+    }
+    HOST_TEST_CHECK(tableCheckSum == switchCheckSum);
+    (void) printf("EncodeEvent %.2f Mevents/s, switch %.2f Mevents/s\n", tableRate / 1.0e6, switchRate / 1.0e6);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,297 @@
+//==============================================================================
+//
+//  EventLogLatencyTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogLatencyTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test measures the time a task spends in an event writer. The writer
+//! threads write one event every WRITER_SLEEP_TICKS, below the throughput of
+//! the dataflash. They first go through the lock-free ring while a thread
+//! runs the loop of TaskEventLog at a lower priority. They then go through
+//! one gate, as before the ring, where the writer whose event fills a RAM
+//! page commits it to the dataflash before leaving the gate. The median, the 99th percentile and the longest
+//! latency of both runs are printed, and every event must be read back
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "HostRTOS.h"
+#include "HostTest.h"
+#include "EventLog.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define WRITERS 4u                                                              //!< Writer threads
+#define EVENTS_PER_WRITER 2000u                                                 //!< Events written by every writer in a run
+#define WRITER_SLEEP_TICKS 8u                                                   //!< Sleep of a writer between its events
+#define CONSUMER_SLEEP_TICKS 1u                                                 //!< Sleep of TaskEventLog between its loops
+#define TOTAL_EVENTS (WRITERS*EVENTS_PER_WRITER)                                //!< Events written by a run
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static atomic_bool isConsumerStopped = false;                                   //!< Set to stop the consumer thread
+static bool isGated = false;                                                    //!< True if the writers go through the gate
+static GateMutex_Handle writerGateHandle = NULL;                                //!< Gate of the writers before the ring
+static uint64_t writerLatency[WRITERS][EVENTS_PER_WRITER];                      //!< Nanoseconds spent in every write
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static int CompareLatency(const void *first, const void *second);
+static void *RunWriter(void *argument);
+static void *RunConsumer(void *argument);
+static void WriteEvents(void *argument);
+static void CheckEvents(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CompareLatency(const void *first, const void *second)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function orders two latencies for qsort
+//
+//------------------------------------------------------------------------------
+static int CompareLatency(
+                            const void *first,                                  //!< First latency
+                            const void *second                                  //!< Second latency
+                         )
+{
+    //For the latencies
+    uint64_t firstLatency = *(const uint64_t *) first;
+    uint64_t secondLatency = *(const uint64_t *) second;
+    return (firstLatency > secondLatency) - (firstLatency < secondLatency);
+}
+//------------------------------------------------------------------------------
+//   RunWriter(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the events of a writer one at a time and saves the
+//!  time spent in every write. Through the gate, the write commits the full
+//!  RAM pages before the gate is left, as the writers did before the ring
+//
+//------------------------------------------------------------------------------
+static void *RunWriter(
+                         void *argument                                         //!< Index of the writer
+                      )
+{
+    //For the index of the writer
+    unsigned int writerIndex = (unsigned int) (uintptr_t) argument;
+    //For the start of a write
+    uint64_t startTime = 0u;
+    //For indexing the events
+    unsigned int eventIndex = 0u;
+    unsigned int sleepIndex = 0u;
+    for ( eventIndex = 0u; eventIndex < EVENTS_PER_WRITER; eventIndex++ )
+    {
+        startTime = HostTestGetNanoseconds();
+        if ( isGated == true )
+        {
+            (void) GateMutex_enter(writerGateHandle);
+            EventLogWritePanicEvent((unsigned short) writerIndex);
+            EventLogFlushFullPages();
+            EventLogEraseAhead();
+            GateMutex_leave(writerGateHandle, 0);
+        }
+        else
+        {
+            EventLogWritePanicEvent((unsigned short) writerIndex);
+        }
+        writerLatency[writerIndex][eventIndex] = HostTestGetNanoseconds() - startTime;
+        //Every sleep gives the same host time to the other threads, one tick
+        //at a time keeps the writers below the throughput of the dataflash
+        for ( sleepIndex = 0u; sleepIndex < WRITER_SLEEP_TICKS; sleepIndex++ )
+        {
+            Task_sleep(1u);
+        }
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   RunConsumer(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the loop of TaskEventLog until it is stopped
+//
+//------------------------------------------------------------------------------
+static void *RunConsumer(
+                           void *argument                                       //!< Not used
+                        )
+{
+    //For the priority of the thread
+    struct sched_param priority = { .sched_priority = 0 };
+    (void) argument;
+    //TaskEventLog runs below the writer tasks
+    (void) pthread_setschedparam(pthread_self(), SCHED_IDLE, &priority);
+    while ( atomic_load(&isConsumerStopped) == false )
+    {
+        EventLogFlushFullPages();
+        EventLogEraseAhead();
+        Task_sleep(CONSUMER_SLEEP_TICKS);
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   WriteEvents(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the writers through the ring or through the gate and
+//!  prints their latencies
+//
+//------------------------------------------------------------------------------
+static void WriteEvents(
+                          void *argument                                        //!< Non zero for the gate
+                       )
+{
+    //For the threads
+    pthread_t writers[WRITERS];
+    pthread_t consumer;
+    //For the events before the run
+    unsigned int startEvents = EventLogGetNumberOfEvents();
+    //For the sorted latencies
+    uint64_t *latency = &writerLatency[0][0];
+    //For indexing the writers
+    unsigned int writerIndex = 0u;
+    isGated = (argument != NULL);
+    writerGateHandle = GateMutex_create(NULL, NULL);
+    if ( isGated == false )
+    {
+        HOST_TEST_CHECK(pthread_create(&consumer, NULL, RunConsumer, NULL) == 0);
+    }
+    else
+    {
+        //Do nothing
+    }
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        HOST_TEST_CHECK(pthread_create(&writers[writerIndex], NULL, RunWriter, (void *) (uintptr_t) writerIndex) == 0);
+    }
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        (void) pthread_join(writers[writerIndex], NULL);
+    }
+    HOST_TEST_CHECK(EventLogGetNumberOfEvents() == (startEvents + TOTAL_EVENTS));
+    EventLogShutDown();
+    if ( isGated == false )
+    {
+        atomic_store(&isConsumerStopped, true);
+        (void) pthread_join(consumer, NULL);
+    }
+    else
+    {
+        //Do nothing
+    }
+    qsort(latency, TOTAL_EVENTS, sizeof(uint64_t), CompareLatency);
+    (void) printf("%s writers: median %.1f us, 99%% %.1f us, longest %.1f us\n", (isGated == true) ? "Gated" : "Ring",
+                  (double) latency[TOTAL_EVENTS / 2u] / 1000.0, (double) latency[(TOTAL_EVENTS * 99u) / 100u] / 1000.0,
+                  (double) latency[TOTAL_EVENTS - 1u] / 1000.0);
+    (void) fflush(stdout);
+}
+//------------------------------------------------------------------------------
+//   CheckEvents(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the events of both runs back after the restart
+//
+//------------------------------------------------------------------------------
+static void CheckEvents(
+                          void *argument                                        //!< Not used
+                       )
+{
+    //For the cursor and the events read
+    EVENT_LOG_CURSOR_STRUCT cursor;
+    const unsigned char *event = NULL;
+    unsigned char eventLength = 0u;
+    //For counting the events
+    unsigned int panicEvents = 0u;
+    (void) argument;
+    HOST_TEST_CHECK(EventLogCursorOpen(&cursor, 0u) == true);
+    while ( EventLogCursorNext(&cursor, &event, &eventLength) == true )
+    {
+        if ( event[0] == (unsigned char) EVENTLOG_ID_PANIC_ALARM_EVENT )
+        {
+            panicEvents++;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    EventLogCursorClose(&cursor);
+    HOST_TEST_CHECK(panicEvents == (2u * TOTAL_EVENTS));
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    HostTestStart("EventLogLatencyTest", true);
+    HOST_TEST_CHECK(HostTestRunBoot(WriteEvents, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(WriteEvents, (void *) 1) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckEvents, NULL) == 0);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
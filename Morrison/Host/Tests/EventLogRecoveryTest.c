@@ -0,0 +1,246 @@
+//==============================================================================
+//
+//  EventLogRecoveryTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogRecoveryTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test restarts the instrument many times while it logs events. A run
+//! ends with a clean shut down, with a power cut after the events or with a
+//! power cut during a program or erase of the dataflash or the EEPROM. After
+//! every restart the events recovered must be read back through a cursor
+//! with gap-free sequence numbers, and none committed by a clean shut down
+//! may be lost
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdio.h>
+#include <sys/mman.h>
+#include "HostRTOS.h"
+#include "HostTest.h"
+#include "EventLog.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define RESTARTS 300u                                                           //!< Restarts of the instrument
+#define LONGEST_RUN 120u                                                        //!< Most events written between two restarts
+#define LONGEST_BATCH 32u                                                       //!< Most events written at once, a RAM page
+#define LAST_CUT_OPERATION 24u                                                  //!< Last program or erase at which the power may be cut
+
+//! This enumeration lists the ways a run of the instrument ends
+typedef enum
+{
+    RUN_END_ENUM_SHUT_DOWN = 0,                                                 //!< Clean shut down
+    RUN_END_ENUM_POWER_OFF = 1,                                                 //!< Power cut after the events, nothing written at the time
+    RUN_END_ENUM_CUT_OPERATION = 2,                                             //!< Power cut during a program or erase
+    RUN_END_ENUMS = 3                                                           //!< Number of ways to end a run
+
+} RUN_END_ENUM;
+
+//! This data structure holds what the runs have logged, it is shared by the
+//! processes of the runs
+typedef struct
+{
+    unsigned int run;                                                           //!< Index of the run
+    unsigned int writtenEvents;                                                 //!< Events written by all the runs
+    unsigned int committedEvents;                                               //!< Events kept by the last clean shut down
+    unsigned int runEnds[RUN_END_ENUMS];                                        //!< Runs ended in each way
+
+} RECOVERY_STATE_STRUCT;
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void CheckRecoveredEvents(RECOVERY_STATE_STRUCT *state);
+static void RunInstrument(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CheckRecoveredEvents(RECOVERY_STATE_STRUCT *state)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads every event of the log from the first one, the
+//!  cursor checks the CRC and the sequence number of each of them
+//
+//------------------------------------------------------------------------------
+static void CheckRecoveredEvents(
+                                   RECOVERY_STATE_STRUCT *state                 //!< Events logged by the runs
+                                )
+{
+    //For the cursor and the events read
+    EVENT_LOG_CURSOR_STRUCT cursor;
+    const unsigned char *event = NULL;
+    unsigned char eventLength = 0u;
+    //For the events recovered
+    unsigned int numberOfEvents = EventLogGetNumberOfEvents();
+    HOST_TEST_CHECK(numberOfEvents >= state->committedEvents);
+    HOST_TEST_CHECK(numberOfEvents <= state->writtenEvents);
+    HOST_TEST_CHECK(EventLogCursorOpen(&cursor, 0u) == true);
+    while ( EventLogCursorNext(&cursor, &event, &eventLength) == true )
+    {
+        HOST_TEST_CHECK(event[0] == (unsigned char) EVENTLOG_ID_CELL_RSSI_EVENT);
+    }
+    HOST_TEST_CHECK(cursor.sequenceNumber == numberOfEvents);
+    EventLogCursorClose(&cursor);
+    if ( cursor.sequenceNumber != numberOfEvents )
+    {
+        (void) fprintf(stderr, "run %u: %u events read of %u\n", state->run, cursor.sequenceNumber, numberOfEvents);
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   RunInstrument(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks the events recovered, then logs events as
+//!  TaskEventLog would and ends the run in the way chosen for it
+//
+//------------------------------------------------------------------------------
+static void RunInstrument(
+                            void *argument                                      //!< Events logged by the runs
+                         )
+{
+    //For the state shared by the runs
+    RECOVERY_STATE_STRUCT *state = (RECOVERY_STATE_STRUCT *) argument;
+    //For the events of the run
+    EVENTLOG_ID_ENUM eventIDs[LONGEST_BATCH];
+    unsigned int runEvents = 0u;
+    unsigned int batchLength = 0u;
+    unsigned int eventIndex = 0u;
+    //For the way the run ends
+    RUN_END_ENUM runEnd = RUN_END_ENUM_SHUT_DOWN;
+    CheckRecoveredEvents(state);
+    HostSeedRandom((state->run + 1u) * 2654435761u);
+    runEnd = (RUN_END_ENUM) (HostRandom() % (unsigned int) RUN_END_ENUMS);
+    runEvents = (HostRandom() % LONGEST_RUN) + 1u;
+    //The events are counted as written before any of them can reach the
+    //dataflash
+    state->writtenEvents = EventLogGetNumberOfEvents() + runEvents;
+    state->runEnds[runEnd]++;
+    for ( eventIndex = 0u; eventIndex < LONGEST_BATCH; eventIndex++ )
+    {
+        eventIDs[eventIndex] = EVENTLOG_ID_CELL_RSSI_EVENT;
+    }
+    if ( runEnd == RUN_END_ENUM_CUT_OPERATION )
+    {
+        HostSetPowerCut((HostRandom() % LAST_CUT_OPERATION) + 1u);
+    }
+    else
+    {
+        //Do nothing
+    }
+    while ( runEvents > 0u )
+    {
+        batchLength = (HostRandom() % LONGEST_BATCH) + 1u;
+        if ( batchLength > runEvents )
+        {
+            batchLength = runEvents;
+        }
+        else
+        {
+            //Do nothing
+        }
+        EventLogWriteBatch(eventIDs, NULL, (unsigned short) batchLength);
+        runEvents = runEvents - batchLength;
+        //Loop of TaskEventLog
+        EventLogFlushFullPages();
+        EventLogEraseAhead();
+        Task_sleep(5u);
+    }
+    if ( runEnd == RUN_END_ENUM_POWER_OFF )
+    {
+        HostPowerOff();
+    }
+    else
+    {
+        //Do nothing
+    }
+    EventLogShutDown();
+    //The power was not cut before the end of the shut down
+    HostSetPowerCut(0u);
+    state->committedEvents = state->writtenEvents;
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    //For the state shared with the runs
+    RECOVERY_STATE_STRUCT *state = mmap(NULL, sizeof(RECOVERY_STATE_STRUCT), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    //For the exit code of a run
+    int exitCode = 0;
+    HostTestStart("EventLogRecoveryTest", true);
+    HOST_TEST_CHECK(state != MAP_FAILED);
+    if ( state != MAP_FAILED )
+    {
+        for ( state->run = 0u; state->run < RESTARTS; state->run++ )
+        {
+            exitCode = HostTestRunBoot(RunInstrument, state);
+            HOST_TEST_CHECK((exitCode == 0) || (exitCode == HOST_POWER_CUT_EXIT_CODE));
+        }
+        //The last run is only checked
+        HOST_TEST_CHECK(HostTestRunBoot((HOST_TEST_BOOT_FUNCTION) CheckRecoveredEvents, state) == 0);
+        (void) printf("%u events, %u clean shut downs, %u power offs, %u cut operations\n", state->writtenEvents,
+                      state->runEnds[RUN_END_ENUM_SHUT_DOWN], state->runEnds[RUN_END_ENUM_POWER_OFF], state->runEnds[RUN_END_ENUM_CUT_OPERATION]);
+    }
+    else
+    {
+        //Do nothing
+    }
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,357 @@
+//==============================================================================
+//
+//  EventLogStressTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        EventLogStressTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This test runs writer threads on the event log at the same time as the
+//! thread of TaskEventLog, through the C11 atomics of the ring. After a
+//! restart every event written must be read back once through a cursor, in
+//! sequence. The event log is then shut down while the writers are writing:
+//! after the next restart every event counted must be read back and none
+//! written after the shut down
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "HostRTOS.h"
+#include "HostTest.h"
+#include "EventLog.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define WRITERS 4u                                                              //!< Writer threads, writer n writes event ID n+1
+#define EVENTS_PER_WRITER 3000u                                                 //!< Events written by every writer
+#define LONGEST_BATCH 40u                                                       //!< Longest batch, longer than a RAM page
+#define CONSUMER_SLEEP_TICKS 5u                                                 //!< Sleep of TaskEventLog between its loops
+#define SHUT_DOWN_TICKS 50u                                                     //!< Writing time before the shut down of the race
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static atomic_bool isConsumerStopped = false;                                   //!< Set to stop the consumer thread
+static atomic_bool isWriterStopped = false;                                     //!< Set to stop the writers of the shut down race
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void *RunWriter(void *argument);
+static void *RunConsumer(void *argument);
+static void WriteEvents(void *argument);
+static void CheckEvents(void *argument);
+static void *RunEndlessWriter(void *argument);
+static void ShutDownWriters(void *argument);
+static void CheckShutDown(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   RunWriter(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes the events of a writer in batches of growing size,
+//!  single events go through EventLogWriteRSSIUpdateEvent for the last writer
+//
+//------------------------------------------------------------------------------
+static void *RunWriter(
+                         void *argument                                         //!< Index of the writer
+                      )
+{
+    //For the index of the writer and its event ID
+    unsigned int writerIndex = (unsigned int) (uintptr_t) argument;
+    EVENTLOG_ID_ENUM eventIDs[LONGEST_BATCH];
+    unsigned short peerNumbers[LONGEST_BATCH];
+    //For the events written and the next batch
+    unsigned int writtenEvents = 0u;
+    unsigned int batchLength = 0u;
+    //For indexing the batch
+    unsigned int eventIndex = 0u;
+    for ( eventIndex = 0u; eventIndex < LONGEST_BATCH; eventIndex++ )
+    {
+        eventIDs[eventIndex] = (EVENTLOG_ID_ENUM) (writerIndex + 1u);
+        peerNumbers[eventIndex] = (unsigned short) (eventIndex + 1u);
+    }
+    while ( writtenEvents < EVENTS_PER_WRITER )
+    {
+        batchLength = ((writtenEvents + writerIndex) % LONGEST_BATCH) + 1u;
+        if ( batchLength > (EVENTS_PER_WRITER - writtenEvents) )
+        {
+            batchLength = EVENTS_PER_WRITER - writtenEvents;
+        }
+        else
+        {
+            //Do nothing
+        }
+        EventLogWriteBatch(eventIDs, peerNumbers, (unsigned short) batchLength);
+        writtenEvents = writtenEvents + batchLength;
+        Task_yield();
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   RunConsumer(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the loop of TaskEventLog until it is stopped
+//
+//------------------------------------------------------------------------------
+static void *RunConsumer(
+                           void *argument                                       //!< Not used
+                        )
+{
+    (void) argument;
+    while ( atomic_load(&isConsumerStopped) == false )
+    {
+        EventLogFlushFullPages();
+        EventLogEraseAhead();
+        Task_sleep(CONSUMER_SLEEP_TICKS);
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   WriteEvents(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the writers and the consumer on an empty event log and
+//!  shuts the event log down
+//
+//------------------------------------------------------------------------------
+static void WriteEvents(
+                          void *argument                                        //!< Not used
+                       )
+{
+    //For the threads
+    pthread_t writers[WRITERS];
+    pthread_t consumer;
+    //For indexing the writers
+    unsigned int writerIndex = 0u;
+    (void) argument;
+    HOST_TEST_CHECK(EventLogGetNumberOfEvents() == 0u);
+    HOST_TEST_CHECK(pthread_create(&consumer, NULL, RunConsumer, NULL) == 0);
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        HOST_TEST_CHECK(pthread_create(&writers[writerIndex], NULL, RunWriter, (void *) (uintptr_t) writerIndex) == 0);
+    }
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        (void) pthread_join(writers[writerIndex], NULL);
+    }
+    HOST_TEST_CHECK(EventLogGetNumberOfEvents() == (WRITERS * EVENTS_PER_WRITER));
+    EventLogShutDown();
+    atomic_store(&isConsumerStopped, true);
+    (void) pthread_join(consumer, NULL);
+}
+//------------------------------------------------------------------------------
+//   CheckEvents(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads every event back after the restart
+//
+//------------------------------------------------------------------------------
+static void CheckEvents(
+                          void *argument                                        //!< Not used
+                       )
+{
+    //For the cursor and the events read
+    EVENT_LOG_CURSOR_STRUCT cursor;
+    const unsigned char *event = NULL;
+    unsigned char eventLength = 0u;
+    //For the events counted by ID
+    unsigned int eventsRead[WRITERS + 1u];
+    unsigned int otherEvents = 0u;
+    //For indexing the writers
+    unsigned int writerIndex = 0u;
+    (void) argument;
+    memset(eventsRead, 0, sizeof(eventsRead));
+    HOST_TEST_CHECK(EventLogGetNumberOfEvents() == (WRITERS * EVENTS_PER_WRITER));
+    //The cursor checks the CRC and the sequence number of every event
+    HOST_TEST_CHECK(EventLogCursorOpen(&cursor, 0u) == true);
+    while ( EventLogCursorNext(&cursor, &event, &eventLength) == true )
+    {
+        if ( (event[0] >= 1u) && (event[0] <= WRITERS) )
+        {
+            eventsRead[event[0]]++;
+        }
+        else
+        {
+            otherEvents++;
+        }
+    }
+    HOST_TEST_CHECK(cursor.sequenceNumber == (WRITERS * EVENTS_PER_WRITER));
+    EventLogCursorClose(&cursor);
+    HOST_TEST_CHECK(otherEvents == 0u);
+    for ( writerIndex = 1u; writerIndex <= WRITERS; writerIndex++ )
+    {
+        HOST_TEST_CHECK(eventsRead[writerIndex] == EVENTS_PER_WRITER);
+    }
+}
+//------------------------------------------------------------------------------
+//   RunEndlessWriter(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes batches of events until it is stopped, through the
+//!  shut down of the event log
+//
+//------------------------------------------------------------------------------
+static void *RunEndlessWriter(
+                                void *argument                                  //!< Index of the writer
+                             )
+{
+    //For the index of the writer and its event ID
+    unsigned int writerIndex = (unsigned int) (uintptr_t) argument;
+    EVENTLOG_ID_ENUM eventIDs[LONGEST_BATCH];
+    //For the next batch
+    unsigned int batchLength = 0u;
+    //For indexing the batch
+    unsigned int eventIndex = 0u;
+    for ( eventIndex = 0u; eventIndex < LONGEST_BATCH; eventIndex++ )
+    {
+        eventIDs[eventIndex] = (EVENTLOG_ID_ENUM) (writerIndex + 1u);
+    }
+    while ( atomic_load(&isWriterStopped) == false )
+    {
+        batchLength = (batchLength % LONGEST_BATCH) + 1u;
+        EventLogWriteBatch(eventIDs, NULL, (unsigned short) batchLength);
+        Task_yield();
+    }
+    return NULL;
+}
+//------------------------------------------------------------------------------
+//   ShutDownWriters(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function shuts the event log down while the writers are writing,
+//!  the writers go on after the shut down
+//
+//------------------------------------------------------------------------------
+static void ShutDownWriters(
+                              void *argument                                    //!< Not used
+                           )
+{
+    //For the threads
+    pthread_t writers[WRITERS];
+    pthread_t consumer;
+    //For indexing the writers
+    unsigned int writerIndex = 0u;
+    (void) argument;
+    HOST_TEST_CHECK(pthread_create(&consumer, NULL, RunConsumer, NULL) == 0);
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        HOST_TEST_CHECK(pthread_create(&writers[writerIndex], NULL, RunEndlessWriter, (void *) (uintptr_t) writerIndex) == 0);
+    }
+    Task_sleep(SHUT_DOWN_TICKS);
+    EventLogShutDown();
+    Task_sleep(SHUT_DOWN_TICKS);
+    atomic_store(&isWriterStopped, true);
+    for ( writerIndex = 0u; writerIndex < WRITERS; writerIndex++ )
+    {
+        (void) pthread_join(writers[writerIndex], NULL);
+    }
+    atomic_store(&isConsumerStopped, true);
+    (void) pthread_join(consumer, NULL);
+}
+//------------------------------------------------------------------------------
+//   CheckShutDown(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function checks after the restart that every event counted before
+//!  the shut down has been committed and that no event followed it
+//
+//------------------------------------------------------------------------------
+static void CheckShutDown(
+                            void *argument                                      //!< Not used
+                         )
+{
+    //For the cursor and the events read
+    EVENT_LOG_CURSOR_STRUCT cursor;
+    const unsigned char *event = NULL;
+    unsigned char eventLength = 0u;
+    unsigned int eventsRead = 0u;
+    (void) argument;
+    HOST_TEST_CHECK(EventLogGetNumberOfEvents() > (WRITERS * EVENTS_PER_WRITER));
+    HOST_TEST_CHECK(EventLogCursorOpen(&cursor, 0u) == true);
+    while ( EventLogCursorNext(&cursor, &event, &eventLength) == true )
+    {
+        eventsRead++;
+    }
+    HOST_TEST_CHECK(cursor.sequenceNumber == EventLogGetNumberOfEvents());
+    EventLogCursorClose(&cursor);
+    HOST_TEST_CHECK(eventsRead == EventLogGetNumberOfEvents());
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   main(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the test, it returns 0 if it passed
+//
+//------------------------------------------------------------------------------
+int main(void)
+{
+    HostTestStart("EventLogStressTest", true);
+    HOST_TEST_CHECK(HostTestRunBoot(WriteEvents, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckEvents, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(ShutDownWriters, NULL) == 0);
+    HOST_TEST_CHECK(HostTestRunBoot(CheckShutDown, NULL) == 0);
+    return HostTestFinish();
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
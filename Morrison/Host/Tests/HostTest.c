@@ -0,0 +1,326 @@
+//==============================================================================
+//
+//  HostTest.c
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostTest.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module implements the helpers shared by the host tests
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "HostRTOS.h"
+#include "HostEEPROM.h"
+#include "DataflashSim.h"
+#include "HostTest.h"
+#include "TM4CEEPROM.h"
+#include "Dataflash.h"
+#include "DataflashQueue.h"
+#include "ErrorLog.h"
+#include "EventLog.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define PATH_LENGTH 512                                                         //!< Longest path of a test file
+#define POWER_OFF_US 60000000u                                                  //!< Simulated time between a power off and the next start
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static const char *testName = "test";                                           //!< Name of the test
+static unsigned int failedChecks = 0u;                                          //!< Checks failed so far
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static void GetTestPath(char *path, const char *extension);
+static void *RunDataflashTask(void *argument);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   GetTestPath(char *path, const char *extension)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function builds the path of a file of the test in HOST_TEST_DIR, or
+//!  in the current directory
+//
+//------------------------------------------------------------------------------
+static void GetTestPath(
+                          char *path,                                           //!< Path built, PATH_LENGTH bytes
+                          const char *extension                                 //!< Extension of the file
+                       )
+{
+    //For the directory of the files
+    const char *directory = getenv("HOST_TEST_DIR");
+    if ( directory == NULL )
+    {
+        directory = ".";
+    }
+    else
+    {
+        //Do nothing
+    }
+    (void) snprintf(path, PATH_LENGTH, "%s/%s.%s", directory, testName, extension);
+}
+//------------------------------------------------------------------------------
+//   RunDataflashTask(void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function runs the loop of TaskDataflash until the boot exits
+//
+//------------------------------------------------------------------------------
+static void *RunDataflashTask(
+                                void *argument                                  //!< Not used
+                             )
+{
+    (void) argument;
+    while ( true )
+    {
+        DataFlashQueueProcess();
+    }
+    return NULL;
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   HostTestStart(const char *name, bool isErased)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function names the test and opens its dataflash and EEPROM files,
+//!  which are erased first if asked
+//
+//------------------------------------------------------------------------------
+void HostTestStart(
+                     const char *name,                                          //!< Name of the test and of its files
+                     bool isErased                                              //!< True to start with an erased dataflash and EEPROM
+                  )
+{
+    //For the paths of the files
+    char dataflashPath[PATH_LENGTH];
+    char eepromPath[PATH_LENGTH];
+    testName = name;
+    failedChecks = 0u;
+    GetTestPath(dataflashPath, "dataflash");
+    GetTestPath(eepromPath, "eeprom");
+    if ( isErased == true )
+    {
+        (void) unlink(dataflashPath);
+        (void) unlink(eepromPath);
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( (DataflashSimOpen(dataflashPath) == false) || (HostEEPROMOpen(eepromPath) == false) )
+    {
+        (void) fprintf(stderr, "%s: cannot map %s or %s\n", testName, dataflashPath, eepromPath);
+        exit(HOST_TEST_FAILED_EXIT_CODE);
+    }
+    else
+    {
+        //Do nothing
+    }
+    HostShareClock();
+    (void) setvbuf(stdout, NULL, _IONBF, 0);
+}
+//------------------------------------------------------------------------------
+//   HostTestBoot(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function initializes the EEPROM, the dataflash and the logs in the
+//!  order of the start up of the instrument and starts the thread of
+//!  TaskDataflash, the logs queue their dataflash requests to it
+//
+//------------------------------------------------------------------------------
+void HostTestBoot(void)
+{
+    //For the thread of TaskDataflash
+    pthread_t dataflashTask;
+    ErrorLogCreateGate();
+    DataFlashQueueInit();
+    (void) TM4CEEPROMInit();
+    DataFlashInit();
+    ErrorLogInit();
+    EventLogInit();
+    if ( pthread_create(&dataflashTask, NULL, RunDataflashTask, NULL) == 0 )
+    {
+        (void) pthread_detach(dataflashTask);
+    }
+    else
+    {
+        HOST_TEST_CHECK(false);
+    }
+}
+//------------------------------------------------------------------------------
+//   HostTestWaitDataflash(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function queues a flush and waits for it, the requests queued
+//!  before it are carried out by then
+//
+//------------------------------------------------------------------------------
+void HostTestWaitDataflash(void)
+{
+    //For the flush queued after the other requests
+    DATAFLASH_REQUEST_STRUCT flushRequest = { .operation = DATAFLASH_REQUEST_FLUSH };
+    DataFlashQueueSubmit(&flushRequest);
+    DataFlashQueueWait(&flushRequest);
+}
+//------------------------------------------------------------------------------
+//   HostTestCheck(bool isTrue, const char *condition, const char *file, int line)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function counts and prints a failed check
+//
+//------------------------------------------------------------------------------
+void HostTestCheck(
+                     bool isTrue,                                               //!< Result of the check
+                     const char *condition,                                     //!< Text of the condition
+                     const char *file,                                          //!< Source file of the check
+                     int line                                                   //!< Source line of the check
+                  )
+{
+    if ( isTrue == false )
+    {
+        failedChecks++;
+        (void) fprintf(stderr, "%s:%d: %s: check failed: %s\n", file, line, testName, condition);
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   HostTestRunBoot(HOST_TEST_BOOT_FUNCTION bootFunction, void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function starts the instrument in a child process on the files of
+//!  the test and runs the function until it returns or the power is cut. The
+//!  simulated time goes on by a minute of power off after it
+//
+//------------------------------------------------------------------------------
+int HostTestRunBoot(
+                      HOST_TEST_BOOT_FUNCTION bootFunction,                     //!< Work done after the start up
+                      void *argument                                            //!< Argument of the function
+                   )
+{
+    //For the child process and its status
+    pid_t child = fork();
+    int status = 0;
+    //For the exit code returned
+    int exitCode = HOST_TEST_FAILED_EXIT_CODE;
+    if ( child == 0 )
+    {
+        //The checks of the parent are counted by it
+        failedChecks = 0u;
+        HostTestBoot();
+        bootFunction(argument);
+        HostTestWaitDataflash();
+        _exit((failedChecks == 0u) ? 0 : HOST_TEST_FAILED_EXIT_CODE);
+    }
+    else if ( (child > 0) && (waitpid(child, &status, 0) == child) && WIFEXITED(status) )
+    {
+        exitCode = WEXITSTATUS(status);
+    }
+    else
+    {
+        (void) fprintf(stderr, "%s: the boot did not exit\n", testName);
+    }
+    HostAdvanceMicroseconds(POWER_OFF_US);
+    return exitCode;
+}
+//------------------------------------------------------------------------------
+//   HostTestFinish(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function closes the files and prints the result. It returns the exit
+//!  code of the test
+//
+//------------------------------------------------------------------------------
+int HostTestFinish(void)
+{
+    DataflashSimClose();
+    HostEEPROMClose();
+    (void) printf("%s: %s\n", testName, (failedChecks == 0u) ? "PASS" : "FAIL");
+    return (failedChecks == 0u) ? 0 : HOST_TEST_FAILED_EXIT_CODE;
+}
+//------------------------------------------------------------------------------
+//   HostTestGetNanoseconds(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the monotonic wall clock of the host in
+//!  nanoseconds, for timing the benchmarks of the tests
+//
+//------------------------------------------------------------------------------
+uint64_t HostTestGetNanoseconds(void)
+{
+    //For the time of the host
+    struct timespec now;
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000u) + (uint64_t) now.tv_nsec;
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,167 @@
+//==============================================================================
+//
+//  HostTest.h
+//
+//  Copyright (C) 2026 by Industrial Scientific
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        HostTest.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the helpers shared by the host tests. A test runs on a
+//! simulated dataflash and EEPROM kept in files of HOST_TEST_DIR, a restart
+//! of the instrument is a child process started on the same files
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __HOSTTEST_H__
+#define __HOSTTEST_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define HOST_TEST_CHECK(condition) HostTestCheck((condition), #condition, __FILE__, __LINE__) //!< Checks a condition of a test
+#define HOST_TEST_FAILED_EXIT_CODE 1                                            //!< Exit code of a boot whose checks failed
+
+typedef void (*HOST_TEST_BOOT_FUNCTION)(void *argument);                        //!< Work done by the instrument between a start and a power off
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   HostTestStart(const char *name, bool isErased)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function names the test and opens its dataflash and EEPROM files,
+//!  which are erased first if asked
+//
+//------------------------------------------------------------------------------
+void HostTestStart(
+                     const char *name,                                          //!< Name of the test and of its files
+                     bool isErased                                              //!< True to start with an erased dataflash and EEPROM
+                  );
+//------------------------------------------------------------------------------
+//   HostTestBoot(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function initializes the EEPROM, the dataflash and the logs in the
+//!  order of the start up of the instrument and starts the thread of
+//!  TaskDataflash
+//
+//------------------------------------------------------------------------------
+void HostTestBoot(void);
+//------------------------------------------------------------------------------
+//   HostTestWaitDataflash(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function waits until the dataflash requests queued so far are
+//!  carried out. A boot waits for them before it exits
+//
+//------------------------------------------------------------------------------
+void HostTestWaitDataflash(void);
+//------------------------------------------------------------------------------
+//   HostTestCheck(bool isTrue, const char *condition, const char *file, int line)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function counts and prints a failed check
+//
+//------------------------------------------------------------------------------
+void HostTestCheck(
+                     bool isTrue,                                               //!< Result of the check
+                     const char *condition,                                     //!< Text of the condition
+                     const char *file,                                          //!< Source file of the check
+                     int line                                                   //!< Source line of the check
+                  );
+//------------------------------------------------------------------------------
+//   HostTestRunBoot(HOST_TEST_BOOT_FUNCTION bootFunction, void *argument)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function starts the instrument in a child process on the files of
+//!  the test and runs the function until it returns or the power is cut. It
+//!  returns the exit code of the child: 0, HOST_POWER_CUT_EXIT_CODE or
+//!  HOST_TEST_FAILED_EXIT_CODE
+//
+//------------------------------------------------------------------------------
+int HostTestRunBoot(
+                      HOST_TEST_BOOT_FUNCTION bootFunction,                     //!< Work done after the start up
+                      void *argument                                            //!< Argument of the function
+                   );
+//------------------------------------------------------------------------------
+//   HostTestFinish(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function closes the files and prints the result. It returns the exit
+//!  code of the test
+//
+//------------------------------------------------------------------------------
+int HostTestFinish(void);
+//------------------------------------------------------------------------------
+//   HostTestGetNanoseconds(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the monotonic wall clock of the host in
+//!  nanoseconds, for timing the benchmarks of the tests
+//
+//------------------------------------------------------------------------------
+uint64_t HostTestGetNanoseconds(void);
+
+#endif /* __HOSTTEST_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -28,7 +28,7 @@
 //==============================================================================
 //
 //! \file
-//! The External Data Flash memory 0x0000 - 0x03FF Range of DataFlash (1024 
+//! The External Data Flash memory 0x0000 - 0x0FFF Range of DataFlash (4096 
 //! subsector, 4 Kbytes each) shall be written or read using this module functions.
 //! All communication between microcontroller and Data Flash memory is carried 
 //! out using SPI protocol.
@@ -54,6 +54,10 @@
 #include <xdc/runtime/Error.h>
 #include <xdc/runtime/System.h>
 #include <ti/sysbios/family/arm/m3/Hwi.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/gates/GateMutex.h>
 #include <inc/hw_ints.h>
 #include <inc/hw_memmap.h>
 #include <inc/hw_types.h>
@@ -69,9 +73,12 @@
 #include <driverlib/udma.h>
 //#include <//assert.h>
 #include "Dataflash.h"
+#include "CRC16.h"
 #include "TM4CSPI.h"
+#include "SPITivaDMA.h"
 #include "string.h"
 #include "ErrorLog.h"
+#include "WearLevel.h"
 #include "Board.h"
 #include "driverlib/sysctl.h"
 #include "EK_TM4C1294XL.h"
@@ -82,13 +89,17 @@
 
 // For new Dataflash SST/N25Q
 #define STATUS_READ_OPCODE                          0xD7U     //!< Code to read status of dataflash
-#define DATAFLASH_COMMAND_TABLE_SIZE                0x06U     //!< Number of dataflash commands i.e. one more than last DATAFLASH_COMMAND_ENUM
+#define DATAFLASH_COMMAND_TABLE_SIZE                0x07U     //!< Number of dataflash commands i.e. one more than last DATAFLASH_COMMAND_ENUM
 #define DATAFLASH_WRITE_EABLE                       0x06U     //!< Code to set the write enable latch bit
 #define DATAFLASH_READ_IDENTIFICATION               0x9FU     //!< Code to read the device identification data
 #define DATAFLASH_WRITE_STATUS_REGISTER             0x01U     //!< Code to write the status register
 #define DATAFLASH_PAGE_WRITE_OPCODE                 0x02U     //!< Code to write a data to dataflash page
 #define DATAFLASH_FAST_READ_OPCODE                  0x0Bu      //!< Code for fast read
 #define SUBSECTOR_ERASE_OPCODE                      0x20U     //!< Code to erase the 4 Kbyte of memory  
+#define BLOCK_ERASE_OPCODE                          0xD8U     //!< Code to erase the 64 Kbyte of memory
+#define PROGRAM_ERASE_SUSPEND_OPCODE                0x75U     //!< Code to suspend an erase of the N25Q
+#define PROGRAM_ERASE_RESUME_OPCODE                 0x7AU     //!< Code to resume a suspended erase of the N25Q
+#define DATAFLASH_READ_SFDP                         0x5AU     //!< Code to read the serial flash discoverable parameters
 #define DATAFLASH_PAGE_READ_OPCODE                  0x03U     //!< Code to read data of a page from dataflash
 #define DATAFLASH_SENSOR_PAGE_BYTES                 16U       //!< 16 number of bytes are used to store sensor parameter values    
 #define DATAFLASH_COMMANDS_RETRIES                  0X03U     //!< Maximum number of retries until a dataflash command becomes successful   
@@ -97,7 +108,6 @@
 #define COMMAND_STATUS_REGISTER_READ                0X05U     //!< Code to read the status of register 
 #define DONT_CARE                                   0x00U     //!< Optional argument code
 #define PAGE_SIZE                                   256U      //!< Define for number of bytes in a dataflash page
-#define RX_OFFSET                                   4U        //!< Number of bytes to b ignored during the read operation
 #define NEXT_PAGE_OFFSET                            0x0100U   //!< Define for the offset of next page
 #define NBYTES                                      4U        //!< Define for number of bytes to b written over SPI
 #define MANUFACTURER_IDENTIFICATION_N25Q            0x20U     //!< Code for the manufacturer identification of the device
@@ -125,6 +135,35 @@
 #define M25                                         3U        //!< Define for dataflash type - M25
 #define MX25                                        4U        //!< Define for dataflash type - MX25
 #define DATAFLASH_BUSY                              1U        //!< Define for status of busy dataflash
+#define DATAFLASH_DEVICE_TYPES                      5U        //!< Number of device types, unknown device included
+#define DATAFLASH_READY_SPIN_POLLS                  8U        //!< Status polls before a busy wait puts the task to sleep
+#define SPI_DMA_TRANSFER_LIMIT                      1024U     //!< Most bytes the uDMA moves in one SPI transfer
+#define FAST_READ_COMMAND_LENGTH                    5U        //!< Fast read opcode, three address bytes and a dummy byte
+#define DATAFLASH_CACHE_PAGES                       4U        //!< Pages held by the page cache
+#define SFDP_COMMAND_LENGTH                         5U        //!< SFDP read opcode, three address bytes and a dummy byte
+#define SFDP_SIGNATURE                              "SFDP"    //!< Signature at the start of the SFDP table
+#define SFDP_SIGNATURE_LENGTH                       4U        //!< Bytes of the SFDP signature
+#define SFDP_HEADER_LENGTH                          16U       //!< SFDP header and the first parameter header
+#define SFDP_PARAMETER_ID                           8U        //!< Offset of the ID of the first parameter table
+#define SFDP_PARAMETER_WORDS                        11U       //!< Offset of the length in words of the first parameter table
+#define SFDP_PARAMETER_POINTER                      12U       //!< Offset of the three byte address of the first parameter table
+#define SFDP_BASIC_TABLE_ID                         0x00U     //!< ID of the JEDEC basic flash parameter table
+#define SFDP_BASIC_TABLE_WORDS                      11U       //!< Words of the basic flash parameter table used, up to the page size
+#define SFDP_ERASE_TYPES_WORDS                      9U        //!< Words of the basic flash parameter table up to the erase types
+#define SFDP_ERASE_4K_MASK                          0x03U     //!< Bits of the first byte telling if 4 Kbyte erase is supported
+#define SFDP_ERASE_4K_SUPPORTED                     0x01U     //!< Value of the 4 Kbyte erase bits if it is supported
+#define SFDP_WRITE_GRANULARITY_BIT                  0x04U     //!< Set if the device programs 64 bytes or more with one command
+#define SFDP_ERASE_4K_OPCODE                        1U        //!< Offset of the 4 Kbyte erase opcode
+#define SFDP_FAST_READ_MODES                        2U        //!< Offset of the byte of the fast read modes
+#define SFDP_DUAL_READ_BITS                         0x11U     //!< Fast read modes 1-1-2 and 1-2-2
+#define SFDP_QUAD_READ_BITS                         0x60U     //!< Fast read modes 1-4-4 and 1-1-4
+#define SFDP_DENSITY                                4U        //!< Offset of the density word
+#define SFDP_DENSITY_EXPONENT_BIT                   0x80000000U   //!< Set if the density is given as a power of two
+#define SFDP_ERASE_TYPES                            28U       //!< Offset of the sizes and the opcodes of the four erase types
+#define SFDP_ERASE_TYPE_COUNT                       4U        //!< Number of erase types
+#define SFDP_PAGE_SIZE                              40U       //!< Offset of the byte of the page size exponent
+#define SUBSECTOR_SIZE_EXPONENT                     12U       //!< 4 Kbyte as a power of two
+#define BLOCK_SIZE_EXPONENT                         16U       //!< 64 Kbyte as a power of two
 
 //==============================================================================
 //  LOCAL DATA STRUCTURE DEFINITION
@@ -138,19 +177,36 @@ typedef struct
     
 } DATAFLASH_COMMAND_STRUCT;
 
+//! This data structure defines a page of the write-back page cache
 typedef struct  
 {
-    unsigned char generalBuffer1[GENERAL_BUFFER_LENGTH];      //!< Buffer1 for general read/write operation from dataflash
-    unsigned char generalBuffer2[GENERAL_BUFFER_LENGTH];      //!< Buffer2 for general read/write operation from dataflash
-    unsigned char generalBuffer3[GENERAL_BUFFER_LENGTH];      //!< Buffer3 for general read/write operation from dataflash
-
-}GENERAL_BUFFER_STRUCT;
+    unsigned char data[DATAFLASH_PAGE_SIZE];                  //!< Bytes of the page, newer than the dataflash if the page is dirty
+    unsigned short subsectorNumber;                           //!< Subsector of the page, NO_DATAFLASH_SUBSECTOR for a free page
+    unsigned char pageNumber;                                 //!< Page in the subsector
+    bool isDirty;                                             //!< True if some bytes are not written to the dataflash yet
+    bool isEraseNeeded;                                       //!< True if a dirty byte sets a bit which is cleared in the dataflash
+    unsigned short firstDirtyByte;                            //!< First byte of the page not written yet
+    unsigned short lastDirtyByte;                             //!< Last byte of the page not written yet
+    unsigned int lastUse;                                     //!< Cache clock of the last access, the oldest page is replaced first
+
+}DATAFLASH_CACHE_STRUCT;
+
+//! This data structure defines the typical and the longest busy time of a device in microseconds
+typedef struct
+{
+    unsigned int programTime;                                 //!< Typical time of a page program
+    unsigned int programTimeout;                              //!< Time after which a page program has failed
+    unsigned int eraseTime;                                   //!< Typical time of a subsector erase
+    unsigned int eraseTimeout;                                //!< Time after which a subsector erase has failed
+    unsigned int blockEraseTime;                              //!< Typical time of a 64 Kbyte block erase
+    unsigned int blockEraseTimeout;                           //!< Time after which a block erase has failed
+    
+} DATAFLASH_TIMING_STRUCT;
 
 //==============================================================================
 //  GLOBAL DATA DECLARATIONS
 //==============================================================================
 
-unsigned short generalBufferPageNumber = NO_DATAFLASH_SUBSECTOR;   //!< This variable contains current subsector number in general buffer
 bool isParametersClearAcknowledged = false;                     //!< This variable is used to tell if instrument parameters erased is finished
 // Datalog
 unsigned short startByteIndexForDatalog = 0u;                                     //!< This variable is used for starting address of backup RAM buffer from where data needs to be transfered to dataflash  
@@ -163,9 +219,10 @@ unsigned char firstSessionNumber = 1u;
 unsigned short address ; 
    
    
-//! This table provides the dataflash opcode and total length of dataflash command
+//! This table provides the dataflash opcode and total length of dataflash command,
+//! the erase opcodes are replaced by the ones of the SFDP table
 // For new Dataflash
-const DATAFLASH_COMMAND_STRUCT dataFlashCommandTable[DATAFLASH_COMMAND_TABLE_SIZE] =
+DATAFLASH_COMMAND_STRUCT dataFlashCommandTable[DATAFLASH_COMMAND_TABLE_SIZE] =
 {
     {DATAFLASH_PAGE_WRITE_OPCODE,             4U},   //!< GENERAL_BUFFER_TO_DATAFLASH_COMMAND = 0x00
     {DATAFLASH_PAGE_READ_OPCODE,              4U},   //!< DATAFLASH_TO_GENERAL_BUFFER_COMMAND = 0x01
@@ -173,92 +230,86 @@ const DATAFLASH_COMMAND_STRUCT dataFlashCommandTable[DATAFLASH_COMMAND_TABLE_SIZ
     {SUBSECTOR_ERASE_OPCODE,                  4U},   //!< ERASE_SUBSECTOR_COMMAND             = 0x03
     {DATAFLASH_PAGE_WRITE_OPCODE,             4U},   //!< WRITE_DATAFLASH_PAGE_COMMAND        = 0x04
     {DATAFLASH_FAST_READ_OPCODE,              4U},   //!< FAST READ Dataflah
+    {BLOCK_ERASE_OPCODE,                      4U},   //!< ERASE_BLOCK_COMMAND                 = 0x06
 
 };
 
-//! Table of CRC values for high-order byte
-const unsigned char dataFlashCRCTableHigh[] = 
-{
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U,
-    0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U, 0x80U, 0x41U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U,
-    0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U,
-    0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U,
-    0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U,
-    0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U,
-    0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U,
-    0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x00U, 0xC1U,
-    0x81U, 0x40U, 0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U,
-    0x00U, 0xC1U, 0x81U, 0x40U, 0x01U, 0xC0U, 0x80U, 0x41U, 0x01U, 0xC0U,
-    0x80U, 0x41U, 0x00U, 0xC1U, 0x81U, 0x40U
-}; 
-
-//! Table of CRC values for low-order byte
-const unsigned char dataFlashCRCTableLow[] = 
-{
-    0x00U, 0xC0U, 0xC1U, 0x01U, 0xC3U, 0x03U, 0x02U, 0xC2U, 0xC6U, 0x06U,
-    0x07U, 0xC7U, 0x05U, 0xC5U, 0xC4U, 0x04U, 0xCCU, 0x0CU, 0x0DU, 0xCDU,
-    0x0FU, 0xCFU, 0xCEU, 0x0EU, 0x0AU, 0xCAU, 0xCBU, 0x0BU, 0xC9U, 0x09U,
-    0x08U, 0xC8U, 0xD8U, 0x18U, 0x19U, 0xD9U, 0x1BU, 0xDBU, 0xDAU, 0x1AU,
-    0x1EU, 0xDEU, 0xDFU, 0x1FU, 0xDDU, 0x1DU, 0x1CU, 0xDCU, 0x14U, 0xD4U,
-    0xD5U, 0x15U, 0xD7U, 0x17U, 0x16U, 0xD6U, 0xD2U, 0x12U, 0x13U, 0xD3U,
-    0x11U, 0xD1U, 0xD0U, 0x10U, 0xF0U, 0x30U, 0x31U, 0xF1U, 0x33U, 0xF3U,
-    0xF2U, 0x32U, 0x36U, 0xF6U, 0xF7U, 0x37U, 0xF5U, 0x35U, 0x34U, 0xF4U,
-    0x3CU, 0xFCU, 0xFDU, 0x3DU, 0xFFU, 0x3FU, 0x3EU, 0xFEU, 0xFAU, 0x3AU,
-    0x3BU, 0xFBU, 0x39U, 0xF9U, 0xF8U, 0x38U, 0x28U, 0xE8U, 0xE9U, 0x29U,
-    0xEBU, 0x2BU, 0x2AU, 0xEAU, 0xEEU, 0x2EU, 0x2FU, 0xEFU, 0x2DU, 0xEDU,
-    0xECU, 0x2CU, 0xE4U, 0x24U, 0x25U, 0xE5U, 0x27U, 0xE7U, 0xE6U, 0x26U,
-    0x22U, 0xE2U, 0xE3U, 0x23U, 0xE1U, 0x21U, 0x20U, 0xE0U, 0xA0U, 0x60U,
-    0x61U, 0xA1U, 0x63U, 0xA3U, 0xA2U, 0x62U, 0x66U, 0xA6U, 0xA7U, 0x67U,
-    0xA5U, 0x65U, 0x64U, 0xA4U, 0x6CU, 0xACU, 0xADU, 0x6DU, 0xAFU, 0x6FU,
-    0x6EU, 0xAEU, 0xAAU, 0x6AU, 0x6BU, 0xABU, 0x69U, 0xA9U, 0xA8U, 0x68U,
-    0x78U, 0xB8U, 0xB9U, 0x79U, 0xBBU, 0x7BU, 0x7AU, 0xBAU, 0xBEU, 0x7EU,
-    0x7FU, 0xBFU, 0x7DU, 0xBDU, 0xBCU, 0x7CU, 0xB4U, 0x74U, 0x75U, 0xB5U,
-    0x77U, 0xB7U, 0xB6U, 0x76U, 0x72U, 0xB2U, 0xB3U, 0x73U, 0xB1U, 0x71U,
-    0x70U, 0xB0U, 0x50U, 0x90U, 0x91U, 0x51U, 0x93U, 0x53U, 0x52U, 0x92U,
-    0x96U, 0x56U, 0x57U, 0x97U, 0x55U, 0x95U, 0x94U, 0x54U, 0x9CU, 0x5CU,
-    0x5DU, 0x9DU, 0x5FU, 0x9FU, 0x9EU, 0x5EU, 0x5AU, 0x9AU, 0x9BU, 0x5BU,
-    0x99U, 0x59U, 0x58U, 0x98U, 0x88U, 0x48U, 0x49U, 0x89U, 0x4BU, 0x8BU,
-    0x8AU, 0x4AU, 0x4EU, 0x8EU, 0x8FU, 0x4FU, 0x8DU, 0x4DU, 0x4CU, 0x8CU,
-    0x44U, 0x84U, 0x85U, 0x45U, 0x87U, 0x47U, 0x46U, 0x86U, 0x82U, 0x42U,
-    0x43U, 0x83U, 0x41U, 0x81U, 0x80U, 0x40U
-};
 unsigned char deviceInstalled = 0u;           //!< This variable contains the type of dataflash device
-GENERAL_BUFFER_STRUCT generalBuffer;                        //!< Structure used as a general buffer for reading and writing data to dataflash   
-unsigned short currentSubSector = 2000u;                    //!< This variable contains the number of  sub-sector in buffer
-unsigned char dataBuffer[DATAFLASH_SUBSECTOR_SIZE];         //!< This variable contains the data of a sub-sector
-bool isDebugBufferUpadted=false;                         //!< This variable indicates that buffer has been updated
+unsigned char dataBuffer[DATAFLASH_SUBSECTOR_SIZE];         //!< This variable contains the data of a sub-sector being written again
 
 // This buffer contains the read data
 unsigned char receiveBuffer[5] = {8U};
+static unsigned char transferTxBuffer[NBYTES];                               //!< Command bytes of a segmented transfer
+static unsigned char fastReadTxBuffer[FAST_READ_COMMAND_LENGTH];            //!< Fast read command and its dummy byte
+static SPI_Handle dataFlashSPIHandle = NULL;                                 //!< SPI handle of the dataflash, opened once and kept
+static GateMutex_Handle dataFlashSPIGateHandle = NULL;                       //!< Serializes the transfers on the dataflash SPI handle
+static GateMutex_Handle dataFlashGateHandle = NULL;                          //!< Serializes the dataflash operations, the page cache and the command buffers
+static unsigned int dataFlashSPIOpenCount = 0u;                              //!< Number of times the dataflash SPI has been opened
+static unsigned int dataFlashSPITransferCount = 0u;                          //!< Number of transfers on the dataflash SPI
+static DATAFLASH_COMMAND_ENUM lastDataFlashCommand = READ_DATAFLASH_PAGE_COMMAND; //!< Last command built, a busy wait is for this command
+static unsigned int dataFlashStatusPollCount = 0u;                           //!< Number of status polls of the busy waits
+static unsigned int dataFlashSleepTicks = 0u;                                //!< Ticks slept by the busy waits instead of polling
+static unsigned short erasingFirstSubsector = NO_DATAFLASH_SUBSECTOR;       //!< First subsector of the erase started by DataFlashStartErase
+static unsigned short erasingSubsectors = 0u;                                //!< Subsectors of the erase started by DataFlashStartErase, 0 if none
+static DATAFLASH_COMMAND_ENUM erasingCommand = ERASE_SUBSECTOR_COMMAND;      //!< Command of the erase started by DataFlashStartErase
+static bool isEraseSuspended = false;                                        //!< True while the started erase is suspended
+static IArg suspendGateKey;                                                  //!< Key of the gate kept from DataFlashSuspendErase to DataFlashResumeErase
+static unsigned int dataFlashErasesStarted = 0u;                             //!< Number of erases started by DataFlashStartErase
+static unsigned int dataFlashEraseSuspends = 0u;                             //!< Number of times a started erase has been suspended
+static DATAFLASH_CACHE_STRUCT dataFlashCache[DATAFLASH_CACHE_PAGES] =        //!< Write-back page cache of the general and debug accesses
+{
+    {{0u}, NO_DATAFLASH_SUBSECTOR}, {{0u}, NO_DATAFLASH_SUBSECTOR}, {{0u}, NO_DATAFLASH_SUBSECTOR}, {{0u}, NO_DATAFLASH_SUBSECTOR}
+};
+static unsigned int dataFlashCacheClock = 0u;                                //!< Counts the cache accesses to order the pages by use
+static unsigned int dataFlashCacheHits = 0u;                                 //!< Number of accesses to a cached page
+static unsigned int dataFlashCacheMisses = 0u;                               //!< Number of pages read into the cache
+static unsigned int dataFlashCachePagePrograms = 0u;                         //!< Number of cached pages programmed
+static unsigned int dataFlashCacheRewrites = 0u;                             //!< Number of subsectors erased and written again for the cache
+static unsigned short protectedFirstSubsector = NO_DATAFLASH_SUBSECTOR;      //!< First subsector erased only by DataFlashEraseProtectedSubsector
+static unsigned short protectedLastSubsector = NO_DATAFLASH_SUBSECTOR;       //!< Last subsector erased only by DataFlashEraseProtectedSubsector
+static DATAFLASH_GEOMETRY_STRUCT dataFlashGeometry =                         //!< Geometry of the installed dataflash
+{
+    false, 0u, DATAFLASH_PAGE_SIZE, DATAFLASH_PAGE_SIZE, false, false, false
+};
+
+//! This table provides the busy times of every device type, indexed by deviceInstalled
+static const DATAFLASH_TIMING_STRUCT dataFlashTimingTable[DATAFLASH_DEVICE_TYPES] =
+{
+    {  800U,  10000U, 250000U, 2000000U, 1000000U, 4000000U },   //!< Unknown device, the slowest times
+    {  500U,  10000U, 250000U, 1600000U,  700000U, 3000000U },   //!< N25Q
+    {   10U,   1000U,  18000U,   50000U,   18000U,   50000U },   //!< SST
+    {  800U,  10000U,  70000U,  300000U,  700000U, 3000000U },   //!< M25
+    {  600U,   6000U,  40000U,  400000U,  700000U, 2000000U },   //!< MX25
+};
 //==============================================================================
 //  LOCAL FUNCTION PROTOTYPES
 //==============================================================================
 
 static int  IfDataFlashReady(void);
-static void TransferFlashToBuffer(BUFFERTYPE_ENUM bufferType, unsigned short subsectorNumber);
 static void ReadIdentification(void);
-static void WriteGeneralWord(unsigned short pageOffset, unsigned short data);
-static void ReadGeneralWord(unsigned short pageOffset, unsigned short *rxData);
 static void SubsectorErase(unsigned short sectortNumber);
 static void BuildDataFlashCommand( DATAFLASH_COMMAND_ENUM command,unsigned int dataFlashSubsector,unsigned short pageOffset,unsigned char *pBuffer, unsigned char *dataFlashCommandLength,bool isDatalog);
 static void GetDataFlashStatus(unsigned char *flashStatus);
 static void WriteDataFlashCommandBytes(unsigned char *commandByte,unsigned short commandLength, unsigned char rxOffset,unsigned char *rxData);
 static void WriteEnableDataflash(void);
+static void OpenDataFlashSPI(void);
+static unsigned int MicrosecondsToTicks(unsigned int microseconds);
+static void WriteDataFlashSegments(unsigned char *commandByte, unsigned char commandLength, const unsigned char *txData, unsigned char *rxData, unsigned short nBytes);
+static void ProgramSubsector(unsigned char *data, unsigned short subsectorNumber);
+static void ProgramBytes(unsigned short subsectorNumber, unsigned short byteAddress, const unsigned char *data, unsigned short nBytes);
+static void ReadBytes(unsigned short subsectorNumber, unsigned short byteAddress, unsigned char *data, unsigned short nBytes);
+static void BlockErase(unsigned short firstSubsector);
+static void ReadSFDPBytes(unsigned int address, unsigned char *data, unsigned short nBytes);
+static void ReadSFDP(void);
+static IArg EnterDataFlash(void);
+static void LeaveDataFlash(IArg gateKey);
+static void FlushCachedSubsector(unsigned short subsectorNumber, bool isDropped);
+static void DropCachedSubsector(unsigned short subsectorNumber);
+static void WriteCacheWord(unsigned short subsectorNumber, unsigned short byteAddress, unsigned short data);
+static unsigned short ReadCacheWord(unsigned short subsectorNumber, unsigned short byteAddress);
+static bool IsSubsectorProtected(unsigned short firstSubsector, unsigned short nSubsectors);
+static bool IsRewriteNeeded(unsigned short subsectorNumber);
+static bool IsEraseBlank(unsigned short firstSubsector, unsigned short nSubsectors);
 
 //==============================================================================
 //   LOCAL FUNCTIONS IMPLEMENTATION
@@ -290,6 +341,8 @@ static void BuildDataFlashCommand(
     //assert(pageOffset < DATAFLASH_SUBSECTOR_SIZE) ;
     // Get the opcode for instruction
     *pBuffer++ = dataFlashCommandTable[command].opCode ;
+    // Keep the command, the next busy wait is for it
+    lastDataFlashCommand = command;
     // Calculate the dataflash page number
     if(isDatalog == true)
     {
@@ -330,7 +383,7 @@ static void GetDataFlashStatus(
     // Writing status register, read command byte and then read status over SPI bus
     spiBuffer[commandLength++] = COMMAND_STATUS_REGISTER_READ;
     // Transfer the data through SPI
-    error = SPITransferData(SPI_DATAFLASH, spiBuffer, NBYTES_TO_WRITE, (unsigned short)commandLength, flashStatus);
+    error = SPITransferSegments(SPI_DATAFLASH, spiBuffer, (unsigned short)commandLength, NULL, flashStatus, (NBYTES_TO_WRITE - commandLength));
     //! \todo - What we should do if there is an error in SPI communication?
     if ( error != ERRORCODE_ENUM_NO_ERROR )
     {
@@ -339,13 +392,44 @@ static void GetDataFlashStatus(
     //TODO: Add resource release equvlent here
 }
 
+//------------------------------------------------------------------------------
+//   MicrosecondsToTicks(unsigned int microseconds)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function converts a time in microseconds to clock ticks, rounded up
+//!  to at least one tick
+//
+//------------------------------------------------------------------------------
+
+static unsigned int MicrosecondsToTicks(
+                                        unsigned int microseconds    //!< Time in microseconds
+                                        )
+{
+    // Number of ticks
+    unsigned int ticks = (microseconds + Clock_tickPeriod - 1u) / Clock_tickPeriod;
+    if ( ticks == 0u )
+    {
+        ticks = 1u;
+    }
+    else
+    {
+        //Do nothing
+    }
+    return ticks;
+}
+
 //------------------------------------------------------------------------------
 //   IfDataFlashReady(void)
 //   
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function is used to check if the dataflash is ready for read write operation or return error if timed out
+//!  This function is used to check if the dataflash is ready for read write operation or return error if timed out.
+//!  The status is polled a few times first. If the dataflash is still busy a task sleeps between the polls, it sleeps
+//!  a quarter of the typical time of the last command first and doubles the sleep up to half the typical time. The
+//!  caller keeps the dataflash gate while the task sleeps, the other tasks wait for the end of the command
 //
 //!  \return 0                                             - No Error
 //!  \return ERRORCODE_ENUM_DATAFLASH_TIMEOUT_OCCURRED     - Timeout, dataflash status is not read
@@ -361,21 +445,102 @@ static int IfDataFlashReady(void)
     unsigned char status = 0u;
     // Function return value for error code
     int returnValue = 0;
-
-    // Reading dataflash status i.e. 1st bit write in progress bit of the status byte for MAX_FLASH_READY_RETRIES
-    // time or 1st bit is 1
+    // Busy times of the installed device
+    const DATAFLASH_TIMING_STRUCT *timing = &dataFlashTimingTable[0];
+    // Typical time and timeout of the last command in ticks
+    unsigned int typicalTicks = 0u;
+    unsigned int timeoutTicks = 0u;
+    // Next sleep, longest sleep and the time slept in ticks
+    unsigned int sleepTicks = 0u;
+    unsigned int maximumSleepTicks = 0u;
+    unsigned int sleptTicks = 0u;
+
+    // Reading dataflash status i.e. 1st bit write in progress bit of the status byte, reads and SST byte programs
+    // are finished within these polls
     do
     {
         // Get the RDY/xBSY bit
         GetDataFlashStatus(&status);  
         flashStatus = status & WRITE_IN_PROGRESS_BIT;
         errorCount++;
-       /* for(int i=0;i<500;i++)
+    }
+    while( (flashStatus == DATAFLASH_BUSY) && (errorCount < DATAFLASH_READY_SPIN_POLLS)); 
+
+    if ( (flashStatus == DATAFLASH_BUSY) && (BIOS_getThreadType() == BIOS_ThreadType_Task) )
+    {
+        if ( deviceInstalled < DATAFLASH_DEVICE_TYPES )
+        {
+            timing = &dataFlashTimingTable[deviceInstalled];
+        }
+        else
+        {
+            //Do nothing
+        }
+        if ( lastDataFlashCommand == ERASE_SUBSECTOR_COMMAND )
+        {
+            typicalTicks = MicrosecondsToTicks(timing->eraseTime);
+            timeoutTicks = MicrosecondsToTicks(timing->eraseTimeout);
+        }
+        else if ( lastDataFlashCommand == ERASE_BLOCK_COMMAND )
+        {
+            typicalTicks = MicrosecondsToTicks(timing->blockEraseTime);
+            timeoutTicks = MicrosecondsToTicks(timing->blockEraseTimeout);
+        }
+        else
+        {
+            typicalTicks = MicrosecondsToTicks(timing->programTime);
+            timeoutTicks = MicrosecondsToTicks(timing->programTimeout);
+        }
+        sleepTicks = typicalTicks / 4u;
+        maximumSleepTicks = typicalTicks / 2u;
+        if ( sleepTicks == 0u )
+        {
+            sleepTicks = 1u;
+        }
+        else
+        {
+            //Do nothing
+        }
+        if ( maximumSleepTicks < sleepTicks )
+        {
+            maximumSleepTicks = sleepTicks;
+        }
+        else
+        {
+            //Do nothing
+        }
+        while ( (flashStatus == DATAFLASH_BUSY) && (sleptTicks < timeoutTicks) )
+        {
+            // Let the other tasks run while the dataflash is busy, the ones using it wait at the gate
+            Task_sleep(sleepTicks);
+            sleptTicks = sleptTicks + sleepTicks;
+            GetDataFlashStatus(&status);  
+            flashStatus = status & WRITE_IN_PROGRESS_BIT;
+            errorCount++;
+            // Back off up to half the typical time
+            sleepTicks = sleepTicks * 2u;
+            if ( sleepTicks > maximumSleepTicks )
+            {
+                sleepTicks = maximumSleepTicks;
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+        dataFlashSleepTicks = dataFlashSleepTicks + sleptTicks;
+    }
+    else
+    {
+        // The start up and the software interrupts cannot sleep, keep polling
+        while( (flashStatus == DATAFLASH_BUSY) && (errorCount < MAX_FLASH_READY_RETRIES) )
         {
-          ;        
-        }*/
+            GetDataFlashStatus(&status);  
+            flashStatus = status & WRITE_IN_PROGRESS_BIT;
+            errorCount++;
+        }
     }
-    while( (flashStatus == DATAFLASH_BUSY) && (errorCount < MAX_FLASH_READY_RETRIES)); 
+    dataFlashStatusPollCount = dataFlashStatusPollCount + errorCount;
 
     // Write Protection Pin of SPI is enabled 
     // Flash was still busy, but it timed out
@@ -420,180 +585,539 @@ static void WriteDataFlashCommandBytes(
 }
 
 //------------------------------------------------------------------------------
-//   TransferFlashToBuffer(BUFFERTYPE_ENUM bufferType, unsigned short subsectorNumber)
+//   WriteDataFlashSegments(unsigned char *commandByte, unsigned char commandLength, const unsigned char *txData, unsigned char *rxData, unsigned short nBytes)
 //   
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/02
+//   Date:     2026/10/17
 //
-//!  This function is used to transfer or copy the data from dataflash to buffer
-//!  This function is mostly called with requestResource == true.  Exception was 
-//!  made to allow the dataflash resource to also protect the general buffer cache
-//!  page.
+//!  This function is used to write a dataflash command followed by the data
+//!  bytes through SPI without copying the data next to the command
 //
 //------------------------------------------------------------------------------
 
-static void TransferFlashToBuffer(
-                                  BUFFERTYPE_ENUM bufferType,     //!< Type of the buffer to which data is to be copied
-                                  unsigned short subsectorNumber  //!< This variable contains the subsector address of dataflash
-                                  )
-{   
-    // This variable contains the length of dataFlash commands used in this function
+static void WriteDataFlashSegments(
+                                   unsigned char *commandByte,      //!< This variable contains the command byte
+                                   unsigned char commandLength,     //!< This variable contains the command length
+                                   const unsigned char *txData,     //!< Data bytes to be written, NULL for a read
+                                   unsigned char *rxData,           //!< Data bytes read from SPI bus, NULL for a write
+                                   unsigned short nBytes            //!< Number of data bytes
+                                   )
+{
+    // This variable is used to contain the error code
+    ERRORCODE_ENUM error = ERRORCODE_ENUM_NO_ERROR;
+    // Writes the command and the data through SPI
+    error = SPITransferSegments(SPI_DATAFLASH, commandByte, (unsigned short)commandLength, (unsigned char *)txData, rxData, nBytes);
+    //! \todo - What we should do if there is an error in SPI communication?
+    if ( error != ERRORCODE_ENUM_NO_ERROR )
+    {
+       //Do something here
+    } 
+}
+
+//------------------------------------------------------------------------------
+//   EnterDataFlash(void)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates the gate of the dataflash if it does not exist yet
+//!  and enters it. A task keeps the gate from the write enable of a command
+//!  to the end of its busy wait, so no other task reaches the dataflash or
+//!  the command buffers in between. The gate is entered again by the global
+//!  functions called from the owner task
+//
+//------------------------------------------------------------------------------
+
+static IArg EnterDataFlash(void)
+{
+    if ( dataFlashGateHandle == NULL )
+    {
+        dataFlashGateHandle = GateMutex_create(NULL, NULL);
+    }
+    else
+    {
+        //Do nothing
+    }
+    return GateMutex_enter(dataFlashGateHandle);
+}
+
+//------------------------------------------------------------------------------
+//   LeaveDataFlash(IArg gateKey)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function leaves the gate of the dataflash
+//
+//------------------------------------------------------------------------------
+
+static void LeaveDataFlash(
+                           IArg gateKey    //!< Key returned by EnterDataFlash
+                           )
+{
+    GateMutex_leave(dataFlashGateHandle, gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   ProgramCachePage(DATAFLASH_CACHE_STRUCT *cachePage)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs the dirty bytes of a cached page, in one page
+//!  program unless the device programs smaller pages or single bytes
+//
+//------------------------------------------------------------------------------
+
+static void ProgramCachePage(
+                             DATAFLASH_CACHE_STRUCT *cachePage  //!< Cached page to be programmed
+                             )
+{
+    // Offset of the page in the subsector
+    unsigned short byteAddress = (unsigned short)(cachePage->pageNumber * DATAFLASH_PAGE_SIZE);
+    // For indexing the dirty bytes
+    unsigned short index = cachePage->firstDirtyByte;
+    ProgramBytes(cachePage->subsectorNumber, (unsigned short)(byteAddress + index), &cachePage->data[index], \
+        (unsigned short)(cachePage->lastDirtyByte - index + 1u));
+    dataFlashCachePagePrograms++;
+}
+
+//------------------------------------------------------------------------------
+//   ProgramBytes(unsigned short subsectorNumber, unsigned short byteAddress, const unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs erased bytes of a subsector. The program is split
+//!  at the program size of the installed device, pages or single bytes
+//
+//------------------------------------------------------------------------------
+
+static void ProgramBytes(
+                         unsigned short subsectorNumber,  //!< Data is to be written to this subsector
+                         unsigned short byteAddress,      //!< Offset in the subsector, data write starts from here
+                         const unsigned char *data,       //!< Data to be written
+                         unsigned short nBytes            //!< Number of bytes to be written
+                         )
+{
+    // This variable contains the length of  dataFlash commands
     unsigned char commandLength = 0u;
-    // Data copy retries counter    
-    unsigned char numberOfTries = 0u;
-    // This variable is used to store the dataflash data copy operation status is successful or not
-    bool isWriteSuccessful = false;
-    // Copy data from dataflash operation repeats maximum DATAFLASH_COMMANDS_RETRIES times if it does not go successful
-    do
+    // Number of bytes programmed in one transfer
+    unsigned short transferLength = 0u;
+    while ( nBytes > 0u )
+    {
+        // A program must not cross the page boundary
+        transferLength = dataFlashGeometry.programSize - (byteAddress % dataFlashGeometry.programSize);
+        if ( transferLength > nBytes )
+        {
+            transferLength = nBytes;
+        }
+        else
+        {
+            //Do nothing
+        }
+        // Latch the write enable bit
+        WriteEnableDataflash();
+        BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber, byteAddress,\
+            transferTxBuffer, &commandLength, false);
+        // SPI operation to write command and data bytes
+        WriteDataFlashSegments(transferTxBuffer, commandLength, data, NULL, transferLength);
+        // Check the busy bit of dataflash
+        (void) IfDataFlashReady();
+        // Move to the next transfer
+        data = data + transferLength;
+        byteAddress = byteAddress + transferLength;
+        nBytes = nBytes - transferLength;
+    }
+}
+
+//------------------------------------------------------------------------------
+//   ReadBytes(unsigned short subsectorNumber, unsigned short byteAddress, unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads n bytes from the given subsector of the dataflash
+//!  without the page cache. The bytes are read with fast read transfers as
+//!  long as the uDMA allows and are received straight in the caller's buffer.
+//!  The dataflash gate must be entered before
+//
+//------------------------------------------------------------------------------
+
+static void ReadBytes(
+                      unsigned short subsectorNumber,  //!< Data is to be read from this subsector
+                      unsigned short byteAddress,      //!< Offset in the subsector, data read starts from here
+                      unsigned char *data,             //!< All data read will be placed here
+                      unsigned short nBytes            //!< Number of bytes to be read
+                      )
+{
+    // This variable contains the length of  dataFlash commands
+    unsigned char commandLength = 0u;
+    // Number of bytes read in one transfer
+    unsigned short transferLength = 0u;
+    // A read is not answered while the dataflash is busy
+    (void) IfDataFlashReady();
+    while ( nBytes > 0u )
+    {
+        // Read at most one uDMA transfer at a time
+        transferLength = nBytes;
+        if ( transferLength > SPI_DMA_TRANSFER_LIMIT )
+        {
+            transferLength = SPI_DMA_TRANSFER_LIMIT;
+        }
+        else
+        {
+            //Do nothing
+        }
+        BuildDataFlashCommand(READ_DATAFLASH_FAST_COMMAND, (unsigned int)subsectorNumber, byteAddress,\
+            fastReadTxBuffer, &commandLength, false);
+        fastReadTxBuffer[commandLength] = DONT_CARE;
+        // SPI operation to write command bytes and then read the data
+        WriteDataFlashSegments(fastReadTxBuffer, FAST_READ_COMMAND_LENGTH, NULL, data, transferLength);
+        // Move to the next transfer
+        data = data + transferLength;
+        byteAddress = byteAddress + transferLength;
+        nBytes = nBytes - transferLength;
+    }
+}
+
+//------------------------------------------------------------------------------
+//   RewriteCachedSubsector(unsigned short subsectorNumber)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads a subsector, places every cached page of it over the
+//!  data read and writes the subsector back after erasing it. It is used when
+//!  a dirty byte sets bits which a page program cannot set
+//
+//------------------------------------------------------------------------------
+
+static void RewriteCachedSubsector(
+                                   unsigned short subsectorNumber  //!< Subsector to be written again
+                                   )
+{
+    // For indexing the cache
+    unsigned char cacheIndex = 0u;
+    ReadBytes(subsectorNumber, 0u, dataBuffer, (unsigned short)DATAFLASH_SUBSECTOR_SIZE);
+    for ( cacheIndex = 0u; cacheIndex < DATAFLASH_CACHE_PAGES; cacheIndex++ )
+    {
+        if ( dataFlashCache[cacheIndex].subsectorNumber == subsectorNumber )
+        {
+            memcpy(&dataBuffer[dataFlashCache[cacheIndex].pageNumber * DATAFLASH_PAGE_SIZE], \
+                dataFlashCache[cacheIndex].data, DATAFLASH_PAGE_SIZE);
+            // The page will be the same as the dataflash after the rewrite
+            dataFlashCache[cacheIndex].isDirty = false;
+            dataFlashCache[cacheIndex].isEraseNeeded = false;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    ProgramSubsector(dataBuffer, subsectorNumber);
+    dataFlashCacheRewrites++;
+}
+
+//------------------------------------------------------------------------------
+//   WriteBackCachePage(DATAFLASH_CACHE_STRUCT *cachePage)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a dirty cached page to the dataflash, the page stays
+//!  in the cache
+//
+//------------------------------------------------------------------------------
+
+static void WriteBackCachePage(
+                               DATAFLASH_CACHE_STRUCT *cachePage  //!< Cached page to be written
+                               )
+{
+    if ( cachePage->isDirty == true )
     {
-        if (bufferType == GENERAL_BUFFER)
+        if ( cachePage->isEraseNeeded == true )
+        {
+            RewriteCachedSubsector(cachePage->subsectorNumber);
+        }
+        else
         {
-            // GB1
-            // Build a dataflash command for general buffer type
-            BuildDataFlashCommand(DATAFLASH_TO_GENERAL_BUFFER_COMMAND, (unsigned int)subsectorNumber, DONT_CARE, spiBuffer, &commandLength, false);
-            WriteDataFlashCommandBytes(spiBuffer,((unsigned short)commandLength+PAGE_SIZE), RX_OFFSET, generalBuffer.generalBuffer1);
-            
-            if (IfDataFlashReady() == ERRORCODE_ENUM_NO_ERROR)
+            ProgramCachePage(cachePage);
+            cachePage->isDirty = false;
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+
+//------------------------------------------------------------------------------
+//   FlushCachedSubsector(unsigned short subsectorNumber, bool isDropped)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes back the dirty cached pages of a subsector, or of
+//!  all subsectors for NO_DATAFLASH_SUBSECTOR, and drops the pages from the
+//!  cache if asked. The dataflash gate must be entered before
+//
+//------------------------------------------------------------------------------
+
+static void FlushCachedSubsector(
+                                 unsigned short subsectorNumber,  //!< Subsector to be flushed
+                                 bool isDropped                   //!< True to drop the pages after writing them
+                                 )
+{
+    // For indexing the cache
+    unsigned char cacheIndex = 0u;
+    for ( cacheIndex = 0u; cacheIndex < DATAFLASH_CACHE_PAGES; cacheIndex++ )
+    {
+        if ( (dataFlashCache[cacheIndex].subsectorNumber != NO_DATAFLASH_SUBSECTOR) && \
+             ((subsectorNumber == NO_DATAFLASH_SUBSECTOR) || (dataFlashCache[cacheIndex].subsectorNumber == subsectorNumber)) )
+        {
+            WriteBackCachePage(&dataFlashCache[cacheIndex]);
+            if ( isDropped == true )
             {
-                isWriteSuccessful = true;   
+                dataFlashCache[cacheIndex].subsectorNumber = NO_DATAFLASH_SUBSECTOR;
             }
             else
             {
-                isWriteSuccessful = false;   
-            }
-            
-            if (isWriteSuccessful)
-            {                 
-                // GB2
-                BuildDataFlashCommand(DATAFLASH_TO_GENERAL_BUFFER_COMMAND, (unsigned int)subsectorNumber, NEXT_PAGE_OFFSET, spiBuffer, &commandLength, false);
-                WriteDataFlashCommandBytes(spiBuffer,((unsigned short)commandLength+PAGE_SIZE), RX_OFFSET, generalBuffer.generalBuffer2);
-                
-                if (IfDataFlashReady() == ERRORCODE_ENUM_NO_ERROR)
-                {
-                    isWriteSuccessful = true;   
-                }
-                else
-                {
-                    isWriteSuccessful = false;   
-                }  
-                
+                //Do nothing
             }
-            
-            if (isWriteSuccessful)
-            {          
-                // GB3
-                BuildDataFlashCommand(DATAFLASH_TO_GENERAL_BUFFER_COMMAND, (unsigned int)subsectorNumber, \
-                  (2u*NEXT_PAGE_OFFSET), spiBuffer, &commandLength, false);
-                WriteDataFlashCommandBytes(spiBuffer,((unsigned short)commandLength+PAGE_SIZE), RX_OFFSET, generalBuffer.generalBuffer3);
-                
-                if (IfDataFlashReady() == ERRORCODE_ENUM_NO_ERROR)
-                {
-                    isWriteSuccessful = true;   
-                }
-                else
-                {
-                    isWriteSuccessful = false;   
-                }              
-            }
-        } 
-        numberOfTries++;
-        //Reset the watchdog once
-        //TODO:
-    } // Repeat the copy process DATAFLASH_COMMANDS_RETRIES times or until it is not successful
-    while ( (isWriteSuccessful == false) && (numberOfTries < DATAFLASH_COMMANDS_RETRIES) );
-    // If number of erase retries exceeds DATAFLASH_COMMANDS_RETRIES then this is an error
-    //
-   /* if ( numberOfTries >= DATAFLASH_COMMANDS_RETRIES )
-    {
-        ErrorLogWrite(ERRORCODE_ENUM_DFLASH_BUF_COPY_FAIL, ERRORTYPE_ENUM_CRITICAL);
-    }*/
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
 }
 
+//------------------------------------------------------------------------------
+//   DropCachedSubsector(unsigned short subsectorNumber)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function drops the cached pages of a subsector which is going to be
+//!  erased or overwritten, the dirty bytes are not written
+//
+//------------------------------------------------------------------------------
 
+static void DropCachedSubsector(
+                                unsigned short subsectorNumber  //!< Subsector to be dropped
+                                )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // For indexing the cache
+    unsigned char cacheIndex = 0u;
+    gateKey = EnterDataFlash();
+    for ( cacheIndex = 0u; cacheIndex < DATAFLASH_CACHE_PAGES; cacheIndex++ )
+    {
+        if ( dataFlashCache[cacheIndex].subsectorNumber == subsectorNumber )
+        {
+            dataFlashCache[cacheIndex].subsectorNumber = NO_DATAFLASH_SUBSECTOR;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    LeaveDataFlash(gateKey);
+}
 
 //------------------------------------------------------------------------------
-//   WriteGeneralWord(unsigned short pageOffset, unsigned short data)
+//   GetCachePage(unsigned short subsectorNumber, unsigned char pageNumber)
 //   
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/02
+//   Date:     2026/10/17
 //
-//!  This function is used to write the word data to general buffer
+//!  This function returns the cached page of a subsector. On a miss the least
+//!  recently used page is written back if it is dirty and the page is read
+//!  from the dataflash in its place. The dataflash gate must be entered before
 //
 //------------------------------------------------------------------------------
 
-static void WriteGeneralWord(
-                             unsigned short pageOffset,    //!< This variable contains the address in the page to start writing to
-                             unsigned short data           //!< Data to be written
-                             )
+static DATAFLASH_CACHE_STRUCT *GetCachePage(
+                                            unsigned short subsectorNumber,  //!< Subsector of the page
+                                            unsigned char pageNumber         //!< Page in the subsector
+                                            )
 {
-    // This variable is used as a index
-    unsigned short index = 0u;
-    
-    if (pageOffset < PAGE_SIZE)
+    // For indexing the cache
+    unsigned char cacheIndex = 0u;
+    // For the page found or replaced
+    DATAFLASH_CACHE_STRUCT *cachePage = NULL;
+    // For the least recently used page
+    DATAFLASH_CACHE_STRUCT *oldestPage = &dataFlashCache[0];
+    for ( cacheIndex = 0u; cacheIndex < DATAFLASH_CACHE_PAGES; cacheIndex++ )
     {
-        // GB1
-        index = pageOffset;
-        generalBuffer.generalBuffer1[index] = HIBYTE_WORD16(data);
-        generalBuffer.generalBuffer1[index + 1u] = LOBYTE_WORD16(data);
+        if ( (dataFlashCache[cacheIndex].subsectorNumber == subsectorNumber) && \
+             (dataFlashCache[cacheIndex].pageNumber == pageNumber) )
+        {
+            cachePage = &dataFlashCache[cacheIndex];
+        }
+        else if ( (oldestPage->subsectorNumber != NO_DATAFLASH_SUBSECTOR) && \
+                  ((dataFlashCache[cacheIndex].subsectorNumber == NO_DATAFLASH_SUBSECTOR) || \
+                   (dataFlashCache[cacheIndex].lastUse < oldestPage->lastUse)) )
+        {
+            // A free page is taken before any used page
+            oldestPage = &dataFlashCache[cacheIndex];
+        }
+        else
+        {
+            //Do nothing
+        }
     }
-    else if(pageOffset < (2u*PAGE_SIZE))
+    if ( cachePage == NULL )
     {
-        // GB2
-        index = pageOffset - PAGE_SIZE;
-        generalBuffer.generalBuffer2[index] = HIBYTE_WORD16(data);
-        generalBuffer.generalBuffer2[index + 1u] = LOBYTE_WORD16(data);
+        cachePage = oldestPage;
+        WriteBackCachePage(cachePage);
+        cachePage->subsectorNumber = subsectorNumber;
+        cachePage->pageNumber = pageNumber;
+        cachePage->isDirty = false;
+        cachePage->isEraseNeeded = false;
+        ReadBytes(subsectorNumber, (unsigned short)(pageNumber * DATAFLASH_PAGE_SIZE), \
+            cachePage->data, (unsigned short)DATAFLASH_PAGE_SIZE);
+        dataFlashCacheMisses++;
     }
-    else 
+    else
     {
-        // GB3
-        index = pageOffset - (2u * PAGE_SIZE);
-        generalBuffer.generalBuffer3[index] = HIBYTE_WORD16(data);
-        generalBuffer.generalBuffer3[index + 1u] = LOBYTE_WORD16(data);
-    } 
+        dataFlashCacheHits++;
+    }
+    dataFlashCacheClock++;
+    cachePage->lastUse = dataFlashCacheClock;
+    return cachePage;
 }
 
 //------------------------------------------------------------------------------
-//   ReadGeneralWord(unsigned short pageOffset, unsigned char *rxBuffer)
+//   WriteCacheByte(unsigned short subsectorNumber, unsigned short byteAddress, unsigned char data)
 //   
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/02
+//   Date:     2026/10/17
 //
-//!  This function is used to read the word data from general buffer
+//!  This function writes a byte to the cached page and widens the dirty range
+//!  of the page. A byte setting a bit which is cleared in the page needs the
+//!  subsector to be erased when the page is written back
 //
 //------------------------------------------------------------------------------
 
-static void ReadGeneralWord(
-                            unsigned short pageOffset,   //!< This variable contains the address in the page
-                            unsigned short *rxData       //!< This variable contains data after successful read operation
-                            )
+static void WriteCacheByte(
+                           unsigned short subsectorNumber,  //!< Subsector of the byte
+                           unsigned short byteAddress,      //!< Offset of the byte in the subsector
+                           unsigned char data               //!< Byte to be written
+                           )
 {
-    // This variable is used as a index
-    unsigned short index = (unsigned short)0;
-    
-    if(pageOffset < PAGE_SIZE)
-    {
-        // GB1
-        index = pageOffset;
-        *rxData = (unsigned short)((unsigned short)generalBuffer.generalBuffer1[index] << LEFT_SHIFT_BY_EIGHT ) |\
-            (unsigned short)generalBuffer.generalBuffer1[index+1u];
-
-    }
-    else if(pageOffset < (2u * PAGE_SIZE))
+    // For the page holding the byte
+    DATAFLASH_CACHE_STRUCT *cachePage = GetCachePage(subsectorNumber, (unsigned char)(byteAddress / DATAFLASH_PAGE_SIZE));
+    // For the offset of the byte in the page
+    unsigned short index = byteAddress % DATAFLASH_PAGE_SIZE;
+    if ( cachePage->data[index] != data )
     {
-        // GB2
-        index = pageOffset - PAGE_SIZE;
-        *rxData = (unsigned short)((unsigned short)generalBuffer.generalBuffer2[index] << LEFT_SHIFT_BY_EIGHT ) |\
-            (unsigned short)generalBuffer.generalBuffer2[index+1u];
+        if ( (cachePage->data[index] & data) != data )
+        {
+            cachePage->isEraseNeeded = true;
+        }
+        else
+        {
+            //Do nothing
+        }
+        if ( cachePage->isDirty == false )
+        {
+            cachePage->isDirty = true;
+            cachePage->firstDirtyByte = index;
+            cachePage->lastDirtyByte = index;
+        }
+        else if ( index < cachePage->firstDirtyByte )
+        {
+            cachePage->firstDirtyByte = index;
+        }
+        else if ( index > cachePage->lastDirtyByte )
+        {
+            cachePage->lastDirtyByte = index;
+        }
+        else
+        {
+            //Do nothing
+        }
+        cachePage->data[index] = data;
     }
     else
     {
-        // GB3
-        index = pageOffset - (2u * PAGE_SIZE);
-        *rxData = (unsigned short)((unsigned short)generalBuffer.generalBuffer3[index] << LEFT_SHIFT_BY_EIGHT ) |\
-            (unsigned short)generalBuffer.generalBuffer3[index+1u];
+        //Do nothing
     }
 }
 
+//------------------------------------------------------------------------------
+//   ReadCacheByte(unsigned short subsectorNumber, unsigned short byteAddress)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads a byte from the cached page
+//
+//------------------------------------------------------------------------------
+
+static unsigned char ReadCacheByte(
+                                   unsigned short subsectorNumber,  //!< Subsector of the byte
+                                   unsigned short byteAddress       //!< Offset of the byte in the subsector
+                                   )
+{
+    // For the page holding the byte
+    DATAFLASH_CACHE_STRUCT *cachePage = GetCachePage(subsectorNumber, (unsigned char)(byteAddress / DATAFLASH_PAGE_SIZE));
+    return cachePage->data[byteAddress % DATAFLASH_PAGE_SIZE];
+}
+
+//------------------------------------------------------------------------------
+//   WriteCacheWord(unsigned short subsectorNumber, unsigned short byteAddress, unsigned short data)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function writes a word to the page cache, high byte first
+//
+//------------------------------------------------------------------------------
+
+static void WriteCacheWord(
+                           unsigned short subsectorNumber,  //!< Subsector of the word
+                           unsigned short byteAddress,      //!< Offset of the word in the subsector
+                           unsigned short data              //!< Word to be written
+                           )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    WriteCacheByte(subsectorNumber, byteAddress, HIBYTE_WORD16(data));
+    WriteCacheByte(subsectorNumber, (unsigned short)(byteAddress + 1u), LOBYTE_WORD16(data));
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   ReadCacheWord(unsigned short subsectorNumber, unsigned short byteAddress)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads a word from the page cache, high byte first
+//
+//------------------------------------------------------------------------------
+
+static unsigned short ReadCacheWord(
+                                    unsigned short subsectorNumber,  //!< Subsector of the word
+                                    unsigned short byteAddress       //!< Offset of the word in the subsector
+                                    )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // For the word read
+    unsigned short data = 0u;
+    gateKey = EnterDataFlash();
+    data = (unsigned short)((unsigned short)ReadCacheByte(subsectorNumber, byteAddress) << LEFT_SHIFT_BY_EIGHT) | \
+        (unsigned short)ReadCacheByte(subsectorNumber, (unsigned short)(byteAddress + 1u));
+    LeaveDataFlash(gateKey);
+    return data;
+}
+
 //------------------------------------------------------------------------------
 //   SubsectorErase(unsigned short sectortNumber)
 //
@@ -661,6 +1185,66 @@ static void SubsectorErase(
     }*/
 }
 
+//------------------------------------------------------------------------------
+//   BlockErase(unsigned short firstSubsector)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases the 64 Kbyte block starting at the given subsector.
+//!  Every subsector of the block is read back as after a subsector erase and
+//!  the block erase is tried again if one of them is not blank
+//
+//------------------------------------------------------------------------------
+
+static void BlockErase(
+                       unsigned short firstSubsector   //!< First subsector of the block, a multiple of DATAFLASH_SUBSECTORS_PER_BLOCK
+                       )
+{
+    // This variable contains the length of dataFlash commands used in this function
+    unsigned char commandLength = 0u;
+    // Temporary variable contains the read value
+    unsigned char temp = 0u;
+    // Number of block erases tried
+    unsigned short attempts = 0u;
+    // Status of the block erase
+    bool isEraseComplete = false;
+    // For indexing the subsectors of the block
+    unsigned short subsectorIndex = 0u;
+    // Words read back from a subsector
+    unsigned short readbackValue1 = 0u;
+    unsigned short readbackValue2 = 0u;
+    do
+    {
+        (void) IfDataFlashReady();
+        // Latch the write enable bit
+        WriteEnableDataflash();
+        BuildDataFlashCommand(ERASE_BLOCK_COMMAND, (unsigned int)firstSubsector, DONT_CARE, spiBuffer, \
+          &commandLength, false);
+        // Start SPI command write process
+        WriteDataFlashCommandBytes(spiBuffer, (unsigned short)commandLength, IGNORED_NBYTES, &temp);
+        // Check the busy bit of dataflash
+        (void) IfDataFlashReady();
+        // Confirm that the erase worked correctly, with the same words as a subsector erase in every subsector
+        isEraseComplete = true;
+        for ( subsectorIndex = 0u; (subsectorIndex < DATAFLASH_SUBSECTORS_PER_BLOCK) && (isEraseComplete == true); subsectorIndex++ )
+        {
+            DataFlashReadWord((unsigned short)(firstSubsector + subsectorIndex), 0u, &readbackValue1);
+            DataFlashReadWord((unsigned short)(firstSubsector + subsectorIndex), 255u, &readbackValue2);
+            if ( (readbackValue1 != 0xFFFFu) || (readbackValue2 != 0xFFFFu) )
+            {
+                isEraseComplete = false;
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+        // Timeout after several attempts.
+        attempts++;
+    } while ( (isEraseComplete == false) && (attempts < 4u) );
+}
+
 //------------------------------------------------------------------------------
 //   WriteEnableDataflash(void)
 //   
@@ -679,6 +1263,8 @@ static void WriteEnableDataflash(void)
     unsigned char temp= 0u;
     // This variable is used to contain the error code
     ERRORCODE_ENUM error = ERRORCODE_ENUM_NO_ERROR;
+    // The write enable is ignored while the dataflash is busy with the last command
+    (void) IfDataFlashReady();
     // Instruction code to set the write enable latch bit 
     spiBuffer[commandLength++] = DATAFLASH_WRITE_EABLE;
     //TODO: Equvilent of K_RESOURCE_RELEASE in TI RTOS
@@ -686,64 +1272,264 @@ static void WriteEnableDataflash(void)
     error = SPITransferData(SPI_DATAFLASH, spiBuffer,(unsigned short)commandLength, IGNORED_NBYTES, &temp);
     if ( error !=  ERRORCODE_ENUM_NO_ERROR )
     {
-       
+       
+    }
+    //TODO: Equvilent of K_RESOURCE_RELEASE in TI RTOS
+}
+//------------------------------------------------------------------------------
+//   ReadIdentification(void)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2016/12/02
+//
+//!  This function is used to read the device identification data
+//
+//------------------------------------------------------------------------------
+
+static void ReadIdentification(void)
+{
+    // Length of dataFlash commands used in this function
+    unsigned char commandLength = 0u;
+//    // This buffer contains the read data
+//    unsigned char receiveBuffer[ARRAY_SIZE] = {0U, 0U, 0U};
+    // This variable is used to contain the error code
+    ERRORCODE_ENUM error = ERRORCODE_ENUM_NO_ERROR;   
+    spiBuffer[commandLength++] = DATAFLASH_READ_IDENTIFICATION;
+    // Write the data through SPI
+    error = SPITransferData(SPI_DATAFLASH, spiBuffer, NBYTES,(unsigned short)commandLength, receiveBuffer);
+     //! \todo - What we should do if there is an error in SPI communication?
+    if ( error != ERRORCODE_ENUM_NO_ERROR )
+    {
+       //Do something here 
+    }
+    //  Check the type of dataflash
+    else if ((receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_N25Q) && 
+            ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_N25Q ) &&
+            ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_N25Q ) )
+    {
+        deviceInstalled = N25Q;
+    }
+    else if( (receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_SST) &&
+        ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_SST ) &&\
+        ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_SST ) )
+    {
+        deviceInstalled = SST;
+        // The device programs one byte at a time
+        dataFlashGeometry.programSize = 1u;
+    }
+    else if((receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_M25) && 
+        ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_M25 ) && 
+        ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_M25 ) )
+    {
+        deviceInstalled = M25;
+    }
+    else if((receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_MX25) && 
+        ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_MX25 ) && 
+        ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_MX25 ) )
+    {
+        deviceInstalled = MX25;
+    }
+    else
+    {
+    }
+    // The identified devices erase 64 Kbyte blocks with the usual opcode
+    if ( deviceInstalled != 0u )
+    {
+        dataFlashGeometry.isBlockEraseSupported = true;
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+
+//------------------------------------------------------------------------------
+//   ReadSFDPBytes(unsigned int address, unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads n bytes of the SFDP table of the dataflash
+//
+//------------------------------------------------------------------------------
+
+static void ReadSFDPBytes(
+                          unsigned int address,    //!< Address in the SFDP table, data read starts from here
+                          unsigned char *data,     //!< All data read will be placed here
+                          unsigned short nBytes    //!< Number of bytes to be read
+                          )
+{
+    spiBuffer[0] = DATAFLASH_READ_SFDP;
+    spiBuffer[1] = LOBYTE_WORD16(HIWORD_WORD32(address));
+    spiBuffer[2] = HIBYTE_WORD16(LOWORD_WORD32(address));
+    spiBuffer[3] = LOBYTE_WORD16(LOWORD_WORD32(address));
+    spiBuffer[4] = DONT_CARE;
+    // SPI operation to write command bytes and then read the data
+    WriteDataFlashSegments(spiBuffer, SFDP_COMMAND_LENGTH, NULL, data, nBytes);
+}
+
+//------------------------------------------------------------------------------
+//   ReadSFDP(void)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads the JEDEC basic flash parameter table of the SFDP and
+//!  takes the page size, the program size, the erase opcodes and the read
+//!  modes from it. The geometry of the identification is kept if the device
+//!  has no SFDP table
+//
+//------------------------------------------------------------------------------
+
+static void ReadSFDP(void)
+{
+    // Bytes of the SFDP header and then of the basic flash parameter table
+    unsigned char sfdpBytes[SFDP_BASIC_TABLE_WORDS * 4U] = {0u};
+    // Address of the basic flash parameter table
+    unsigned int tableAddress = 0u;
+    // Number of words of the basic flash parameter table read
+    unsigned char tableWords = 0u;
+    // Density word of the basic flash parameter table
+    unsigned int density = 0u;
+    // For indexing the erase types
+    unsigned char eraseType = 0u;
+    // Size of an erase type as a power of two
+    unsigned char sizeExponent = 0u;
+    ReadSFDPBytes(0u, sfdpBytes, SFDP_HEADER_LENGTH);
+    if ( (memcmp(sfdpBytes, SFDP_SIGNATURE, SFDP_SIGNATURE_LENGTH) == 0) && \
+         (sfdpBytes[SFDP_PARAMETER_ID] == SFDP_BASIC_TABLE_ID) && \
+         (sfdpBytes[SFDP_PARAMETER_WORDS] >= SFDP_ERASE_TYPES_WORDS) )
+    {
+        tableWords = sfdpBytes[SFDP_PARAMETER_WORDS];
+        if ( tableWords > SFDP_BASIC_TABLE_WORDS )
+        {
+            tableWords = SFDP_BASIC_TABLE_WORDS;
+        }
+        else
+        {
+            //Do nothing
+        }
+        tableAddress = (unsigned int)sfdpBytes[SFDP_PARAMETER_POINTER] | \
+            ((unsigned int)sfdpBytes[SFDP_PARAMETER_POINTER + 1u] << 8) | \
+            ((unsigned int)sfdpBytes[SFDP_PARAMETER_POINTER + 2u] << 16);
+        ReadSFDPBytes(tableAddress, sfdpBytes, (unsigned short)(tableWords * 4U));
+        dataFlashGeometry.isSFDPFound = true;
+        // 4 Kbyte erase opcode
+        if ( (sfdpBytes[0] & SFDP_ERASE_4K_MASK) == SFDP_ERASE_4K_SUPPORTED )
+        {
+            dataFlashCommandTable[ERASE_SUBSECTOR_COMMAND].opCode = sfdpBytes[SFDP_ERASE_4K_OPCODE];
+        }
+        else
+        {
+            //Do nothing
+        }
+        // Read modes, the dataflash SPI has a single data line so they are only reported
+        dataFlashGeometry.isDualReadSupported = ((sfdpBytes[SFDP_FAST_READ_MODES] & SFDP_DUAL_READ_BITS) != 0u);
+        dataFlashGeometry.isQuadReadSupported = ((sfdpBytes[SFDP_FAST_READ_MODES] & SFDP_QUAD_READ_BITS) != 0u);
+        // Density in bits
+        density = (unsigned int)sfdpBytes[SFDP_DENSITY] | ((unsigned int)sfdpBytes[SFDP_DENSITY + 1u] << 8) | \
+            ((unsigned int)sfdpBytes[SFDP_DENSITY + 2u] << 16) | ((unsigned int)sfdpBytes[SFDP_DENSITY + 3u] << 24);
+        if ( (density & SFDP_DENSITY_EXPONENT_BIT) == 0u )
+        {
+            dataFlashGeometry.capacity = (density + 1u) / 8u;
+        }
+        else
+        {
+            // Too large to be addressed with three address bytes
+            dataFlashGeometry.capacity = 0u;
+        }
+        // Erase types, the block erase is used only if one of them erases 64 Kbyte
+        dataFlashGeometry.isBlockEraseSupported = false;
+        for ( eraseType = 0u; eraseType < SFDP_ERASE_TYPE_COUNT; eraseType++ )
+        {
+            sizeExponent = sfdpBytes[SFDP_ERASE_TYPES + (2u * eraseType)];
+            if ( sizeExponent == SUBSECTOR_SIZE_EXPONENT )
+            {
+                dataFlashCommandTable[ERASE_SUBSECTOR_COMMAND].opCode = sfdpBytes[SFDP_ERASE_TYPES + (2u * eraseType) + 1u];
+            }
+            else if ( sizeExponent == BLOCK_SIZE_EXPONENT )
+            {
+                dataFlashCommandTable[ERASE_BLOCK_COMMAND].opCode = sfdpBytes[SFDP_ERASE_TYPES + (2u * eraseType) + 1u];
+                dataFlashGeometry.isBlockEraseSupported = true;
+            }
+            else
+            {
+                //Do nothing
+            }
+        }
+        // Page size, given by the later versions of the table only
+        if ( tableWords >= SFDP_BASIC_TABLE_WORDS )
+        {
+            dataFlashGeometry.pageSize = (unsigned short)(1u << (sfdpBytes[SFDP_PAGE_SIZE] >> 4));
+        }
+        else
+        {
+            //Do nothing
+        }
+        // Program whole pages, at most one page of the cache, unless the device programs single bytes
+        if ( (sfdpBytes[0] & SFDP_WRITE_GRANULARITY_BIT) == 0u )
+        {
+            dataFlashGeometry.programSize = 1u;
+        }
+        else if ( dataFlashGeometry.pageSize < DATAFLASH_PAGE_SIZE )
+        {
+            dataFlashGeometry.programSize = dataFlashGeometry.pageSize;
+        }
+        else
+        {
+            dataFlashGeometry.programSize = DATAFLASH_PAGE_SIZE;
+        }
+    }
+    else
+    {
+        //Do nothing
     }
-    //TODO: Equvilent of K_RESOURCE_RELEASE in TI RTOS
 }
+
 //------------------------------------------------------------------------------
-//   ReadIdentification(void)
+//   OpenDataFlashSPI(void)
 //   
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/02
+//   Date:     2026/10/17
 //
-//!  This function is used to read the device identification data
+//!  This function creates the gate of the dataflash SPI and opens the SPI if
+//!  it is not open yet. The handle is kept open for all the next transfers
 //
 //------------------------------------------------------------------------------
 
-static void ReadIdentification(void)
+static void OpenDataFlashSPI(void)
 {
-    // Length of dataFlash commands used in this function
-    unsigned char commandLength = 0u;
-//    // This buffer contains the read data
-//    unsigned char receiveBuffer[ARRAY_SIZE] = {0U, 0U, 0U};
-    // This variable is used to contain the error code
-    ERRORCODE_ENUM error = ERRORCODE_ENUM_NO_ERROR;   
-    spiBuffer[commandLength++] = DATAFLASH_READ_IDENTIFICATION;
-    // Write the data through SPI
-    error = SPITransferData(SPI_DATAFLASH, spiBuffer, NBYTES,(unsigned short)commandLength, receiveBuffer);
-     //! \todo - What we should do if there is an error in SPI communication?
-    if ( error != ERRORCODE_ENUM_NO_ERROR )
-    {
-       //Do something here 
-    }
-    //  Check the type of dataflash
-    else if ((receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_N25Q) && 
-            ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_N25Q ) &&
-            ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_N25Q ) )
-    {
-        deviceInstalled = N25Q;
-    }
-    else if( (receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_SST) &&
-        ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_SST ) &&\
-        ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_SST ) )
+    //SPI Control Parameters
+    SPI_Params params;
+    //For entering the gate
+    IArg gateKey;
+    if ( dataFlashSPIGateHandle == NULL )
     {
-        deviceInstalled = SST;
+        dataFlashSPIGateHandle = GateMutex_create(NULL, NULL);
     }
-    else if((receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_M25) && 
-        ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_M25 ) && 
-        ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_M25 ) )
+    else
     {
-        deviceInstalled = M25;
+        //Do nothing
     }
-    else if((receiveBuffer[DEVICE_IDENTIFICATION] == MANUFACTURER_IDENTIFICATION_MX25) && 
-        ( receiveBuffer[DEVICE_TYPE] == MEMORY_TYPE_MX25 ) && 
-        ( receiveBuffer[DEVICE_CAPACITY] == MEMORY_CAPACITY_MX25 ) )
+    gateKey = GateMutex_enter(dataFlashSPIGateHandle);
+    if ( dataFlashSPIHandle == NULL )
     {
-        deviceInstalled = MX25;
+        //Initialize SPI Parameters (TODO: Check the default parameters settings)
+        SPI_Params_init(&params);
+        //Set the transfer mode
+        params.transferMode = SPI_MODE_BLOCKING;
+        params.frameFormat = SPI_POL1_PHA1;
+        //Set the baud rate
+        params.bitRate = 8000000;
+        //Open SPI for the communication
+        dataFlashSPIHandle = SPI_open(Board_SPI3, &params);
+        dataFlashSPIOpenCount++;
     }
     else
     {
+        //Do nothing
     }
+    GateMutex_leave(dataFlashSPIGateHandle, gateKey);
 }
 
 //==============================================================================
@@ -769,9 +1555,16 @@ void DataFlashInit(void)
     unsigned char temp = 0u;
     //To track the error code
     ERRORCODE_ENUM error = ERRORCODE_ENUM_NO_ERROR;
-    // This variable is used to contain the error code
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // The gate is created here, before the tasks use the dataflash
+    gateKey = EnterDataFlash();
+    // Open the SPI once, all the transfers use the same handle
+    OpenDataFlashSPI();
    // Read the identification of dataflash
     ReadIdentification();
+    // Read the geometry of dataflash from its SFDP table
+    ReadSFDP();
     // Check if FLASH is of type SST
     if ( deviceInstalled == SST )
     {
@@ -796,6 +1589,7 @@ void DataFlashInit(void)
         }
         while ( (status & WRITE_IN_PROGRESS_BIT) == true);*/
     }
+    LeaveDataFlash(gateKey);
 }
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
 //
@@ -823,10 +1617,8 @@ ERRORCODE_ENUM SPITransferData(
     ERRORCODE_ENUM errorCode = ERRORCODE_ENUM_NO_ERROR;
     //For checking the transfer success
     bool transferOK = false;
-    //SPI Configuration Handle
-    SPI_Handle      handle;
-    //SPI Control Parameters
-    SPI_Params      params;
+    //For entering the gate of the dataflash SPI
+    IArg gateKey;
     //SPI Transaction control
     SPI_Transaction spiTransaction;
     //Status of SPI
@@ -835,7 +1627,8 @@ ERRORCODE_ENUM SPITransferData(
     unsigned short loopIndex = 0u;
     //For limiting the loop
      short loopLimit = 0;
-    if ( nBytes > rxOffset )
+    // Received bytes are moved only if there are bytes to be ignored
+    if ( (rxOffset > 0u) && (nBytes > rxOffset) )
     {
       loopLimit  = nBytes - rxOffset;
     }
@@ -845,16 +1638,18 @@ ERRORCODE_ENUM SPITransferData(
     }
     if( spiDevice == SPI_DATAFLASH )
     {
-            //Initialize SPI Parameters (TODO: Check the default parameters settings)
-       SPI_Params_init(&params);
-       //Set the transfer mode
-       params.transferMode = SPI_MODE_BLOCKING;
-       params.frameFormat = SPI_POL1_PHA1;
-      //Set the baud rate
-      params.bitRate = 8000000;
-      //Open SPI for the communication
-      handle = SPI_open(Board_SPI3, &params);
-      if (!handle) 
+      //Open SPI if the dataflash is used before its initialization or the
+      //last open has failed
+      if ( dataFlashSPIHandle == NULL )
+      {
+         OpenDataFlashSPI();
+      }
+      else
+      {
+         //Do nothing
+      }
+      gateKey = GateMutex_enter(dataFlashSPIGateHandle);
+      if (!dataFlashSPIHandle) 
       {
          errorCode = ERRORCODE_ENUM_SPI_ERROR;
       }
@@ -864,7 +1659,8 @@ ERRORCODE_ENUM SPITransferData(
          spiTransaction.count = nBytes;
          spiTransaction.txBuf = txBuffer;
          spiTransaction.rxBuf = rxBuffer;        
-         transferOK = SPI_transfer(handle, &spiTransaction);
+         transferOK = SPI_transfer(dataFlashSPIHandle, &spiTransaction);
+         dataFlashSPITransferCount++;
          if (!transferOK) 
          {
             errorCode = ERRORCODE_ENUM_SPI_ERROR;
@@ -874,8 +1670,7 @@ ERRORCODE_ENUM SPITransferData(
             errorCode = ERRORCODE_ENUM_NO_ERROR;
          }
       }
-      //Open SPI for the communication
-      SPI_close(handle);
+      GateMutex_leave(dataFlashSPIGateHandle, gateKey);
     }
     else
     {
@@ -896,6 +1691,84 @@ ERRORCODE_ENUM SPITransferData(
     }
     return errorCode;
 }
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+//   SPITransferSegments(SPI_DEVICE_ENUM spiDevice, unsigned char *command, unsigned short commandLength, unsigned char *txData, unsigned char *rxData, unsigned short nBytes)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sends a command followed by n data bytes in one SPI
+//!  transfer. The bytes received during the command are dropped and the
+//!  following n bytes are received in rxData, both segments are moved by the
+//!  uDMA straight from and to the caller's buffers
+//
+//!  \return ERRORCODE_ENUM_NO_ERROR                                   - No error detected
+//!  \return ERRORCODE_ENUM_SPI_ERROR                                  - SPI error is detected
+//
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+ERRORCODE_ENUM SPITransferSegments(
+                                    SPI_DEVICE_ENUM spiDevice,     //!< SPI device id
+                                    unsigned char *command,        //!< Command bytes sent first
+                                    unsigned short commandLength,  //!< Number of command bytes
+                                    unsigned char *txData,         //!< Data bytes sent after the command, NULL sends don't care bytes
+                                    unsigned char *rxData,         //!< Data bytes received after the command, NULL drops them
+                                    unsigned short nBytes          //!< Number of data bytes
+                                  )
+{
+    //For recording the error code
+    ERRORCODE_ENUM errorCode = ERRORCODE_ENUM_SPI_ERROR;
+    //For checking the transfer success
+    bool transferOK = false;
+    //For entering the gate of the dataflash SPI
+    IArg gateKey;
+    //Scatter/gather transaction control
+    SPITivaDMA_SGTransaction sgTransaction;
+    if( spiDevice == SPI_DATAFLASH )
+    {
+      //Open SPI if the dataflash is used before its initialization or the
+      //last open has failed
+      if ( dataFlashSPIHandle == NULL )
+      {
+         OpenDataFlashSPI();
+      }
+      else
+      {
+         //Do nothing
+      }
+      gateKey = GateMutex_enter(dataFlashSPIGateHandle);
+      if (!dataFlashSPIHandle) 
+      {
+         errorCode = ERRORCODE_ENUM_SPI_ERROR;
+      }
+      else
+      {
+         // Setup the command segment and the data segment
+         sgTransaction.cmdBuf = command;
+         sgTransaction.cmdCount = commandLength;
+         sgTransaction.transaction.count = nBytes;
+         sgTransaction.transaction.txBuf = txData;
+         sgTransaction.transaction.rxBuf = rxData;
+         transferOK = SPITivaDMA_transferSG(dataFlashSPIHandle, &sgTransaction);
+         dataFlashSPITransferCount++;
+         if (!transferOK) 
+         {
+            errorCode = ERRORCODE_ENUM_SPI_ERROR;
+         }
+         else
+         {
+            errorCode = ERRORCODE_ENUM_NO_ERROR;
+         }
+      }
+      GateMutex_leave(dataFlashSPIGateHandle, gateKey);
+    }
+    else
+    {
+      //Do nothing TODO: Add for other files
+    }
+    return errorCode;
+}
 
 //------------------------------------------------------------------------------
 //   DataFlashGetCumulativeCRC(unsigned char  newByte, unsigned short *frameCRCValue)
@@ -912,20 +1785,7 @@ void DataFlashGetCumulativeCRC(
                                unsigned short *frameCRCValue //!< This variable contains the calculated CRC value
                                )
 {
-    // This variable contains higher byte of calculated CRC value    
-    unsigned char CRCHighByte = HIBYTE_WORD16(*frameCRCValue) ;
-    // This variable contains lower byte of calculated CRC value    
-    unsigned char CRCLowByte = LOBYTE_WORD16(*frameCRCValue) ;
-    // This variable is used as index into CRC lookup
-    unsigned char CRCIndex ;   
-
-    // Calculate the CRC from CRC tables
-    CRCIndex = CRCHighByte ^ newByte ;  
-    CRCHighByte = CRCLowByte ^ dataFlashCRCTableHigh[CRCIndex] ;
-    CRCLowByte = dataFlashCRCTableLow[CRCIndex] ;
-    (*frameCRCValue) = CRCHighByte  ;
-    (*frameCRCValue) = (*frameCRCValue) << LEFT_SHIFT_BY_EIGHT ;
-    (*frameCRCValue) |= CRCLowByte ;
+    (*frameCRCValue) = CRC16Calculate(&newByte, 1U, *frameCRCValue);
 }
 
 //------------------------------------------------------------------------------
@@ -934,7 +1794,8 @@ void DataFlashGetCumulativeCRC(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function reads a word(2 bytes) from a page of the dataflash
+//!  This function reads a word(2 bytes) from a page of the dataflash through
+//!  the page cache
 //
 //------------------------------------------------------------------------------
 
@@ -944,35 +1805,8 @@ void DataFlashReadGeneralWord(
                               unsigned short *data             //!< This variable contains data after successful read operation on dataflash
                               )
 { 
-    // This variable contains the length of  dataFlash commands
-    unsigned char commandLength = 0u;
-    // This variable contain the read data 
-    unsigned short readWord = (unsigned short)0;
-    // Buffer contains the data read from dataflash
-    unsigned char tempBuffer[2] = {0U,0U};
-    // This variable is used as a loop index
-    unsigned int byteCounter = (unsigned int)0;
-    //assert(subsectorNumber >= FIRST_HEADER_PAGE); 
-    //assert(generalBufferPageNumber >= FIRST_GENERAL_SUBSECTOR);
-    // Checking page to build read command from general buffer or from dataFlash page
-    if (generalBufferPageNumber == subsectorNumber)
-    {
-        // Read from the buffer instead of the flash page, its data may be newer
-        ReadGeneralWord((wordNumber << 1), &readWord);
-        *data = readWord;
-    }
-    else
-    {
-        // Read from dataflash page
-        BuildDataFlashCommand(READ_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber, (wordNumber << 1),\
-            spiBuffer, &commandLength, false);
-        // SPI operation to write command bytes and then read the data
-        WriteDataFlashCommandBytes(spiBuffer,((unsigned short)commandLength + NBYTES_TO_WRITE), RX_OFFSET, tempBuffer);
-        byteCounter = (unsigned int)0;
-        *data = (unsigned short)((unsigned short)tempBuffer[byteCounter]<< LEFT_SHIFT_BY_EIGHT) | \
-            (unsigned short)tempBuffer[byteCounter+(unsigned char)1];
-    }
-    (void) IfDataFlashReady();
+    // Read the word through the page cache, its data may be newer than the flash page
+    *data = ReadCacheWord(subsectorNumber, (unsigned short)(wordNumber << 1));
 }
 //------------------------------------------------------------------------------
 //   DataFlashReadSector(unsigned short subsectorNumber, unsigned char *data)
@@ -989,26 +1823,66 @@ void DataFlashReadSector(
                               unsigned char *data             //!< This variable contains data after successful read operation on dataflash
                         )
 { 
-    // This variable contains the length of  dataFlash commands
-    unsigned char commandLength = 0u;
-    // This variable contain the read data 
-    unsigned short readWord = (unsigned short)0;
-    // Buffer contains the data read from dataflash
-    unsigned char tempBuffer[2] = {0U,0U};
-    // This variable is used as a loop index
-    unsigned int byteCounter = (unsigned int)0;
-    //For the page number
-    unsigned char pageNumber = 0u;
-    for( pageNumber = 0; pageNumber < 16; pageNumber++ )
-    {
-       // Read from dataflash page
-       BuildDataFlashCommand(READ_DATAFLASH_FAST_COMMAND, (unsigned int)subsectorNumber, (unsigned short)(NEXT_PAGE_OFFSET*pageNumber),\
-               spiBuffer, &commandLength, false);
-       // SPI operation to write command bytes and then read the data
-       WriteDataFlashCommandBytes(spiBuffer,((unsigned short)commandLength + 256), (RX_OFFSET+1), &data[(pageNumber*NEXT_PAGE_OFFSET)]);
-       (void) IfDataFlashReady();
-    }
+    // Read the complete subsector
+    DataFlashReadBytes(subsectorNumber, 0u, data, (unsigned short)DATAFLASH_SUBSECTOR_SIZE);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashReadBytes(unsigned short subsectorNumber, unsigned short byteAddress, unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads n bytes from the given subsector of the dataflash. The
+//!  dirty cached pages of the subsector are written first, so the bytes
+//!  written through the page cache are read as well
+//
+//------------------------------------------------------------------------------
+
+void DataFlashReadBytes(
+                        unsigned short subsectorNumber,  //!< Data is to be read from this subsector
+                        unsigned short byteAddress,      //!< Offset in the subsector, data read starts from here
+                        unsigned char *data,             //!< All data read will be placed here
+                        unsigned short nBytes            //!< Number of bytes to be read
+                        )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    // The pages stay cached, they are the same as the dataflash after the write
+    FlushCachedSubsector(subsectorNumber, false);
+    ReadBytes(subsectorNumber, byteAddress, data, nBytes);
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashProgramBytes(unsigned short subsectorNumber, unsigned short byteAddress, const unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs n bytes in the given subsector of the dataflash
+//!  without erasing it, the bytes must be erased before. The program is split
+//!  at page boundaries
+//
+//------------------------------------------------------------------------------
+
+void DataFlashProgramBytes(
+                           unsigned short subsectorNumber,  //!< Data is to be written to this subsector
+                           unsigned short byteAddress,      //!< Offset in the subsector, data write starts from here
+                           const unsigned char *data,       //!< Data to be written
+                           unsigned short nBytes            //!< Number of bytes to be written
+                           )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // Write the cached bytes of the subsector first and drop the pages, they would not see these bytes
+    gateKey = EnterDataFlash();
+    FlushCachedSubsector(subsectorNumber, true);
+    ProgramBytes(subsectorNumber, byteAddress, data, nBytes);
+    LeaveDataFlash(gateKey);
 }
+
 //------------------------------------------------------------------------------
 //   DataFlashReadWord(unsigned short subsectorNumber, unsigned short wordNumber, unsigned short *data)
 //
@@ -1016,7 +1890,8 @@ void DataFlashReadSector(
 //   Date:     2016/12/02
 //
 //!  This function reads a word(2 bytes) directly from any page of the dataflash,
-//!  without using the RAM buffer.
+//!  without using the RAM buffer. The dirty cached pages of the subsector are
+//!  written first
 //
 //------------------------------------------------------------------------------
 
@@ -1033,20 +1908,25 @@ void DataFlashReadWord(
     unsigned char tempBuffer[2] = {0U,0U};
     // This variable is used as a loop index
     unsigned int byteCounter = (unsigned int)0;
+    // For entering the gate of the dataflash
+    IArg gateKey;
     
    //. //assert(subsectorNumber >= FIRST_HEADER_PAGE); 
     
-
+    gateKey = EnterDataFlash();
+    // Write the dirty cached pages of the subsector first, they stay cached
+    FlushCachedSubsector(subsectorNumber, false);
+    // A read is not answered while the dataflash is busy
+    (void) IfDataFlashReady();
     // Read from dataflash page
     BuildDataFlashCommand(READ_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber, (wordNumber << 1),\
         spiBuffer, &commandLength, false);
     // SPI operation to write command bytes and then read the data
-    WriteDataFlashCommandBytes(spiBuffer,((unsigned short)commandLength + NBYTES_TO_WRITE), RX_OFFSET, tempBuffer);
+    WriteDataFlashSegments(spiBuffer, commandLength, NULL, tempBuffer, NBYTES_TO_WRITE);
     byteCounter = (unsigned int)0;
     *data = (unsigned short)((unsigned short)tempBuffer[byteCounter]<< LEFT_SHIFT_BY_EIGHT) | \
         (unsigned short)tempBuffer[byteCounter+(unsigned char)1];
-
-    (void) IfDataFlashReady();    
+    LeaveDataFlash(gateKey);
 }
 
 //------------------------------------------------------------------------------
@@ -1055,7 +1935,10 @@ void DataFlashReadWord(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function writes a word(2 bytes) to the general page of the dataflash
+//!  This function writes a word(2 bytes) to the general page of the dataflash.
+//!  The word stays in the page cache until DataFlashCommitGeneralBuffer is
+//!  called or the page is replaced, consecutive words of a page are written
+//!  with one page program
 //
 //------------------------------------------------------------------------------
 
@@ -1065,69 +1948,8 @@ void DataFlashWriteGeneralWord(
                                unsigned short data              //!< This variable contains the data which is to be written on dataflash
                                )
 {
-    // This variable contains the length of  dataFlash commands
-    unsigned char commandLength = 0u;
-    // Temporary variable contains the read value
-    unsigned char temp= 0u;
-    unsigned short byteAddres = (unsigned short)0;
-    // If the subsector number is for event logging write the data to that subsector otherwise write the data to general buffer
-    if ( (subsectorNumber >= FIRST_DATAFLASH_SUBSECTOR )&& (subsectorNumber <= (LEGACY_ERRORS_SUBSECTOR + TOTAL_NUMBER_OF_ERRORS)))
-    {
-        if ( deviceInstalled == SST )
-        {
-            byteAddres = wordNumber << 1;
-            // Latch the write enable bit
-            WriteEnableDataflash();
-            // Build the command to write the data to the dataflash page
-            BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber, byteAddres, spiBuffer, \
-                &commandLength, false);
-            spiBuffer[commandLength] = HIBYTE_WORD16(data);
-            // SPI operation to write command bytes
-            WriteDataFlashCommandBytes(spiBuffer, ((unsigned short)commandLength + (unsigned char)1),\
-                IGNORED_NBYTES, &temp);
-            
-            IfDataFlashReady();
-
-            // Latch the write enable bit
-            WriteEnableDataflash();
-            // Build the command to write the data to the dataflash page
-            BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber,\
-                (unsigned short)(byteAddres+(unsigned char)1), spiBuffer, &commandLength, false);
-            spiBuffer[commandLength] = LOBYTE_WORD16(data);
-            // SPI operation to write command bytes
-            WriteDataFlashCommandBytes(spiBuffer, ((unsigned short)commandLength + (unsigned char)1), \
-                IGNORED_NBYTES, &temp);
-        }
-        else
-        {
-            // Latch the write enable bit
-            WriteEnableDataflash();
-            // Build the command to write the data to the dataflash page
-            BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber, \
-                (unsigned short)(wordNumber << 1), spiBuffer, &commandLength, false);
-            spiBuffer[commandLength] = HIBYTE_WORD16(data);
-            spiBuffer[commandLength+(unsigned char)1] = LOBYTE_WORD16(data);
-            // SPI operation to write command bytes
-            WriteDataFlashCommandBytes(spiBuffer, ((unsigned short)commandLength + NBYTES_TO_WRITE),\
-                IGNORED_NBYTES, &temp);
-        }
-
-        IfDataFlashReady();
-    }
-    else
-    {
-       /* // Checking if page is not same as the current page in general buffer
-        if (generalBufferPageNumber != subsectorNumber)
-        {
-            // Write the data of general buffer to the particular sub sector of dataflash
-            DataFlashCommitGeneralBuffer();
-            // Transfer the data from the pages of data flash to general buffer
-            TransferFlashToBuffer(GENERAL_BUFFER, subsectorNumber) ;
-            generalBufferPageNumber = subsectorNumber;
-        }
-        // Write the two bytes of data to general buffer
-        WriteGeneralWord((wordNumber << 1), data);*/
-    }
+    // Write the word to the page cache, the page is programmed when it is flushed or replaced
+    WriteCacheWord(subsectorNumber, (unsigned short)(wordNumber << 1), data);
 }
 //------------------------------------------------------------------------------
 //   DataFlashErasePage(unsigned short subsectorNumber)
@@ -1136,7 +1958,8 @@ void DataFlashWriteGeneralWord(
 //   Date:     2016/12/02
 //
 //!  This function erases the subsector of data flash 
-//!  Special datalog and eventlog schemes will use erase subsector
+//!  Special datalog and eventlog schemes will use erase subsector.
+//!  A protected subsector is not erased
 //
 //------------------------------------------------------------------------------
 
@@ -1144,8 +1967,22 @@ void DataFlashErasePage(
                         unsigned short subsectorNumber    //!< This variable contains the subsector number which is to erased from dataflash
                         )
 {
-    // Erase the particular sub sector
-    SubsectorErase(subsectorNumber);
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    // A protected subsector is erased by its owner only
+    if ( IsSubsectorProtected(subsectorNumber, 1u) == false )
+    {
+        // The cached pages of the subsector are erased as well
+        DropCachedSubsector(subsectorNumber);
+        // Erase the particular sub sector
+        SubsectorErase(subsectorNumber);
+    }
+    else
+    {
+        //Do nothing
+    }
+    LeaveDataFlash(gateKey);
 }
 
 //------------------------------------------------------------------------------
@@ -1154,7 +1991,8 @@ void DataFlashErasePage(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function reads the data in an dataArray i.e. n number of bytes from the given subsector of dataflash
+//!  This function reads the data in an dataArray i.e. n number of bytes from the given subsector of dataflash.
+//!  The dirty cached pages of the subsector are written first
 //
 //------------------------------------------------------------------------------
 
@@ -1170,11 +2008,18 @@ void DataFlashReadArray(
     unsigned char commandLength = 0u;
     // A loop index variable to read the n bytes of data
     unsigned int index = (unsigned int)0;
+    // For entering the gate of the dataflash
+    IArg gateKey;
     // Check that the data doesn't go over a page boundary
     //assert( (byteAddress + nBytes) <= DATAFLASH_SUBSECTOR_SIZE );
+    gateKey = EnterDataFlash();
+    // A read is not answered while the dataflash is busy
+    (void) IfDataFlashReady();
     // Checking subsector to build read command from dataFlash page  
     if( isForDatalog == true )
     {
+        // The datalog gives a page number, write the dirty cached pages of its subsector first
+        FlushCachedSubsector((unsigned short)(subsectorNumber / PAGES_PER_SUBSECTOR), false);
         if(( (byteAddress + nBytes) > DATAFLASH_PAGE_SIZE ))
         {
             nBytes = DATAFLASH_PAGE_SIZE - byteAddress;
@@ -1188,11 +2033,14 @@ void DataFlashReadArray(
     }
     else
     {
+        // Write the dirty cached pages of the subsector first, they stay cached
+        FlushCachedSubsector(subsectorNumber, false);
         BuildDataFlashCommand(READ_DATAFLASH_PAGE_COMMAND, (unsigned int)subsectorNumber, byteAddress,\
             spiBuffer, &commandLength, false);
     }
 
-    WriteDataFlashCommandBytes(spiBuffer, (commandLength+nBytes), RX_OFFSET, dataArray);
+    WriteDataFlashSegments(spiBuffer, commandLength, NULL, dataArray, nBytes);
+    LeaveDataFlash(gateKey);
 }
 
 /*
@@ -1274,20 +2122,23 @@ void DataFlashTrasferFromBackupRAM(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function erases general buffer
+//!  This function erases general buffer, the cached pages are dropped
+//!  without writing them
 //
 //------------------------------------------------------------------------------
 
 void DataFlashEraseGeneralBuffer(void)
 {
-    unsigned int index = 0u;
-
-    for (index = 0u; index < GENERAL_BUFFER_LENGTH; index++)
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // For indexing the cache
+    unsigned char cacheIndex = 0u;
+    gateKey = EnterDataFlash();
+    for (cacheIndex = 0u; cacheIndex < DATAFLASH_CACHE_PAGES; cacheIndex++)
     {
-        generalBuffer.generalBuffer1[index] = 0xFFu;
-        generalBuffer.generalBuffer2[index] = 0xFFu;
-        generalBuffer.generalBuffer3[index] = 0xFFu;
+        dataFlashCache[cacheIndex].subsectorNumber = NO_DATAFLASH_SUBSECTOR;
     }
+    LeaveDataFlash(gateKey);
 }
 
 //------------------------------------------------------------------------------
@@ -1296,22 +2147,19 @@ void DataFlashEraseGeneralBuffer(void)
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function writes the data from the general buffer to dataflash if the contents of both are not the same
+//!  This function writes the data from the general buffer to dataflash if the contents of both are not the same.
+//!  Every dirty page of the page cache is written, the pages stay cached
 //
 //------------------------------------------------------------------------------
 
 void DataFlashCommitGeneralBuffer(void)
 {
-    // Validate current generalBufferPageNumber it should be withing general pages of dataFlash
-    //assert(generalBufferPageNumber >= FIRST_GENERAL_SUBSECTOR);
-    // If no data available exit from function
-    if ( generalBufferPageNumber != NO_DATAFLASH_SUBSECTOR )
-    {
-        // Commit buffer
-        //.DataFlashCommitBuffer(GENERAL_BUFFER, generalBufferPageNumber);
-        // No data available in general buffer
-        generalBufferPageNumber = NO_DATAFLASH_SUBSECTOR;
-    }
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    // Write the dirty bytes of all the cached pages
+    FlushCachedSubsector(NO_DATAFLASH_SUBSECTOR, false);
+    LeaveDataFlash(gateKey);
 }
 
 //------------------------------------------------------------------------------
@@ -1329,26 +2177,146 @@ void DataFlashCommitBuffer(
                                unsigned short subsectorNumber                   //!< The data is to be written on this subsector of dataflash
                            )
 {
-    // This variable contains the length of dataFlash commands used in this function
-    unsigned char commandLength = 0u;
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    // The cached pages of the subsector are overwritten
+    DropCachedSubsector(subsectorNumber);
+    ProgramSubsector(data, subsectorNumber);
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   IsSubsectorProtected(unsigned short firstSubsector, unsigned short nSubsectors)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if one of the given subsectors is erased only
+//!  by DataFlashEraseProtectedSubsector
+//
+//------------------------------------------------------------------------------
+
+static bool IsSubsectorProtected(
+                                 unsigned short firstSubsector,  //!< First subsector to be checked
+                                 unsigned short nSubsectors      //!< Number of subsectors to be checked
+                                 )
+{
+    // For the status of the subsectors
+    bool isProtected = false;
+    if ( (protectedFirstSubsector != NO_DATAFLASH_SUBSECTOR) && (nSubsectors > 0u) && \
+         (firstSubsector <= protectedLastSubsector) && \
+         ((unsigned int)firstSubsector + nSubsectors - 1u >= protectedFirstSubsector) )
+    {
+        isProtected = true;
+    }
+    else
+    {
+        //Do nothing
+    }
+    return isProtected;
+}
+
+//------------------------------------------------------------------------------
+//   IsRewriteNeeded(unsigned short subsectorNumber)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if a dirty cached page of the subsector, or of
+//!  any subsector for NO_DATAFLASH_SUBSECTOR, sets bits which a page program
+//!  cannot set. Writing it back erases its subsector. The dataflash gate must
+//!  be entered before
+//
+//------------------------------------------------------------------------------
+
+static bool IsRewriteNeeded(
+                            unsigned short subsectorNumber  //!< Subsector to be checked
+                            )
+{
+    // For the result
+    bool isRewriteNeeded = false;
+    // For indexing the cache
+    unsigned char cacheIndex = 0u;
+    for ( cacheIndex = 0u; cacheIndex < DATAFLASH_CACHE_PAGES; cacheIndex++ )
+    {
+        if ( (dataFlashCache[cacheIndex].subsectorNumber != NO_DATAFLASH_SUBSECTOR) && \
+             ((subsectorNumber == NO_DATAFLASH_SUBSECTOR) || (dataFlashCache[cacheIndex].subsectorNumber == subsectorNumber)) && \
+             (dataFlashCache[cacheIndex].isDirty == true) && (dataFlashCache[cacheIndex].isEraseNeeded == true) )
+        {
+            isRewriteNeeded = true;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    return isRewriteNeeded;
+}
+
+//------------------------------------------------------------------------------
+//   IsEraseBlank(unsigned short firstSubsector, unsigned short nSubsectors)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads back erased subsectors with the same words as
+//!  SubsectorErase and returns true if all of them are blank
+//
+//------------------------------------------------------------------------------
+
+static bool IsEraseBlank(
+                         unsigned short firstSubsector,  //!< First erased subsector
+                         unsigned short nSubsectors      //!< Number of erased subsectors
+                         )
+{
+    // For the result
+    bool isBlank = true;
+    // For indexing the subsectors
+    unsigned short subsectorIndex = 0u;
+    // Words read back from a subsector
+    unsigned short readbackValue1 = 0u;
+    unsigned short readbackValue2 = 0u;
+    for ( subsectorIndex = 0u; (subsectorIndex < nSubsectors) && (isBlank == true); subsectorIndex++ )
+    {
+        DataFlashReadWord((unsigned short)(firstSubsector + subsectorIndex), 0u, &readbackValue1);
+        DataFlashReadWord((unsigned short)(firstSubsector + subsectorIndex), 255u, &readbackValue2);
+        if ( (readbackValue1 != 0xFFFFu) || (readbackValue2 != 0xFFFFu) )
+        {
+            isBlank = false;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    return isBlank;
+}
+
+//------------------------------------------------------------------------------
+//   ProgramSubsector(unsigned char *data, unsigned short subsectorNumber)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases a subsector and programs the given buffer to it one
+//!  page at a time. A protected subsector is left unchanged
+//
+//------------------------------------------------------------------------------
+
+static void ProgramSubsector(
+                             unsigned char *data,                             //!< start address of the data to be written
+                             unsigned short subsectorNumber                   //!< The data is to be written on this subsector of dataflash
+                             )
+{
     // Write retries counter    
     unsigned char numberOfTries = 0u;
     // This variable is used to store the dataflash write operation status is successful or not
     unsigned char isWriteSuccessful = false;
-    // Temporary variable contains the read value
-    unsigned char temp= 0u;
     // This variable is used as a loop index
     unsigned int tempIndex = (unsigned int)0;
-    // For indexing the loop
-    unsigned short loopIndex = 0u;
-    // For indexing the loop
-    unsigned short loopIndex2 = 0u;
-    //For indexing the page number
-    unsigned char pageNumber = 0u;
-    //For the data write
-    unsigned char dataWrite[260] = {0u};
-    // Check if page is valid
-    if ( subsectorNumber != NO_DATAFLASH_SUBSECTOR )
+    // Check if page is valid, a protected subsector is erased by its owner only
+    if ( (subsectorNumber != NO_DATAFLASH_SUBSECTOR) && (IsSubsectorProtected(subsectorNumber, 1u) == false) )
     {
         // Write dataflash operation repeats maximum DATAFLASH_COMMANDS_RETRIES times until it goes successful
         do
@@ -1362,27 +2330,8 @@ void DataFlashCommitBuffer(
             SubsectorErase(subsectorNumber);
             // Check the busy bit of dataflash
             IfDataFlashReady();
-            for( pageNumber = 0; pageNumber < 16; pageNumber++ )
-            {
-                // Latch the write enable bit 
-                WriteEnableDataflash();
-                // Build the command to write the data to dataflash
-                BuildDataFlashCommand(GENERAL_BUFFER_TO_DATAFLASH_COMMAND, (unsigned int)subsectorNumber, (unsigned short)(NEXT_PAGE_OFFSET*pageNumber), dataWrite, &commandLength, false);
-                //Get the command length
-                loopIndex = commandLength;
-                //Get the loopIndex2
-                loopIndex2 = 256 * pageNumber;
-                while ( loopIndex < (commandLength+256) )
-                {
-                    dataWrite[loopIndex] = data[loopIndex2];
-                    loopIndex++;
-                    loopIndex2++;
-                }
-               // SPI process to write the one byte of data to the dataflash
-               WriteDataFlashCommandBytes(dataWrite, ((unsigned short)commandLength+256u), IGNORED_NBYTES, &temp);
-               // Check the busy bit of dataflash
-               IfDataFlashReady();
-            }
+            // Program the whole subsector straight from the data, in pages or bytes as the device programs
+            ProgramBytes(subsectorNumber, 0u, data, (unsigned short)DATAFLASH_SUBSECTOR_SIZE);
             // Check if write operation was successful
             if(IfDataFlashReady() == (int) ERRORCODE_ENUM_NO_ERROR)
             {
@@ -1418,25 +2367,8 @@ void DataFlashDebugWrite(
                          unsigned short *dataWord     //!< data to be written 
                          )
 {
-    unsigned short data=*dataWord;  
-    if(currentSubSector!=sectorNumber)
-    {
-        //if buffer not update then  just read teh buffer do not write it 
-        if(isDebugBufferUpadted==true)
-        {
-            DataFlashCommitDebugBuffer();
-        }
-        currentSubSector=sectorNumber;
-        DataFlashReadArray(currentSubSector,0u,dataBuffer,DATAFLASH_SUBSECTOR_SIZE,false);
-        isDebugBufferUpadted=true;
-    }
-    else
-    {
-      
-    } 
-    dataBuffer[wordAddress]=HIBYTE_WORD16(data);
-    dataBuffer[wordAddress+1u]=LOBYTE_WORD16(data);
-
+    // Write the word to the page cache
+    WriteCacheWord(sectorNumber, wordAddress, *dataWord);
 }
 
 //------------------------------------------------------------------------------
@@ -1454,23 +2386,8 @@ void DataFlashDebugRead(
                         unsigned short *data         //!< data which is read 
                         )   
 {
-    if(currentSubSector!=sectorNumber)
-    {
-        if(isDebugBufferUpadted==true)
-        {
-            DataFlashCommitDebugBuffer();        
-        }
-        currentSubSector=sectorNumber;
-        DataFlashReadArray(currentSubSector,0u,dataBuffer,DATAFLASH_SUBSECTOR_SIZE,false);
-        isDebugBufferUpadted=true;
-        *data=(unsigned short)((unsigned short)dataBuffer[wordAddress]<< LEFT_SHIFT_BY_EIGHT) | \
-            (unsigned short)dataBuffer[wordAddress+(unsigned char)1];     
-    }
-    else
-    {
-        *data=(unsigned short)((unsigned short)dataBuffer[wordAddress]<< LEFT_SHIFT_BY_EIGHT) | \
-            (unsigned short)dataBuffer[wordAddress+(unsigned char)1];
-    }     
+    // Read the word through the page cache
+    *data = ReadCacheWord(sectorNumber, wordAddress);
 }
 
 //------------------------------------------------------------------------------
@@ -1479,72 +2396,16 @@ void DataFlashDebugRead(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function commit the buffer in dataflash debug mode
+//!  This function commit the buffer in dataflash debug mode. A cached page is
+//!  programmed in place if its bytes only clear bits, otherwise its subsector
+//!  is erased and written again
 //
 //------------------------------------------------------------------------------
 
 void DataFlashCommitDebugBuffer(void)
 {
-    // This variable contains the length of  dataFlash commands
-    unsigned char commandLength = 0u;
-    unsigned int index;
-    unsigned short byteAddres;
-    // Temporary variable contains the read value
-    unsigned char temp[6] = {0u};
-//    unsigned short address ;  
-//    int FlashStatus = 1;
-//    unsigned short waitCount = 0u;
-    DataFlashErasePage(currentSubSector);        
-
-    // Check if buffer not update then  just read teh buffer do not write it 
-    if(isDebugBufferUpadted==true)
-    {
-        address=0u;
-        for(index=0u; index<DATAFLASH_SUBSECTOR_SIZE; index+=2u)
-        {
-            if ( deviceInstalled == SST )
-            {
-                byteAddres = address << 1;
-                // Latch the write enable bit
-                WriteEnableDataflash();
-                // Build the command to write the data to the dataflash page
-                BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)currentSubSector, \
-                    byteAddres, spiBuffer, &commandLength, false);
-                // build spi Buffer
-                spiBuffer[commandLength] = dataBuffer[index];
-                // SPI operation to write command bytes
-                WriteDataFlashCommandBytes(spiBuffer, ((unsigned short)commandLength + (unsigned char)1), \
-                    IGNORED_NBYTES, temp);
-                // Check the busy bit of dataflash
-                IfDataFlashReady();
-                // Latch the write enable bit
-                WriteEnableDataflash();
-                // Build the command to write the data to the dataflash page
-                BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)currentSubSector, \
-                    (unsigned short)(byteAddres+(unsigned char)1), spiBuffer, &commandLength, false);
-                // build spi Buffer
-                spiBuffer[commandLength] = dataBuffer[index+1u];
-                // SPI operation to write command bytes
-                WriteDataFlashCommandBytes(spiBuffer, ((unsigned short)commandLength + (unsigned char)1), \
-                    IGNORED_NBYTES, temp);
-            }
-            else
-            {
-                // Latch the write enable bit
-                WriteEnableDataflash();
-                // Build the command to write the data to the dataflash page
-                BuildDataFlashCommand(WRITE_DATAFLASH_PAGE_COMMAND, (unsigned int)currentSubSector, \
-                    (unsigned short)(address << 1), spiBuffer, &commandLength, false);
-                spiBuffer[commandLength] = dataBuffer[index];
-                spiBuffer[commandLength+(unsigned char)1] = dataBuffer[index+1u];
-                // SPI operation to write command bytes
-                WriteDataFlashCommandBytes(spiBuffer, ((unsigned short)commandLength + NBYTES_TO_WRITE), \
-                    IGNORED_NBYTES, temp);
-            }
-            IfDataFlashReady();
-            address++;
-        }
-    }
+    // The debug words share the page cache with the general words
+    DataFlashCommitGeneralBuffer();
 }
 /*
 //------------------------------------------------------------------------------
@@ -1737,6 +2598,7 @@ void DataFlashBackupIparams( void )
 //   Date:     2016/12/02
 //
 //!  This function writes a word directly to the Dataflash IC, without using the RAM buffers.
+//!  The cached pages of the subsector are written first and dropped
 //
 //------------------------------------------------------------------------------
 
@@ -1750,7 +2612,12 @@ void DataFlashWriteWord(
     unsigned char commandLength = (unsigned char)0;
     // Temporary variable contains the read value
     unsigned char temp= (unsigned char)0;
+    // For entering the gate of the dataflash
+    IArg gateKey;
     
+    gateKey = EnterDataFlash();
+    // Write the cached bytes of the subsector first and drop the pages, they would not see this word
+    FlushCachedSubsector(subsectorNumber, true);
     // Latch the write enable bit
     WriteEnableDataflash();
     // Build the command to write the data to the dataflash page
@@ -1764,53 +2631,479 @@ void DataFlashWriteWord(
     
     // Check the busy bit of dataflash
     IfDataFlashReady();
+    LeaveDataFlash(gateKey);
+}
+//------------------------------------------------------------------------------
+//   unsigned char GetDataflashID(void)
+//
+//   Author:   Muhammad Shuaib
+//   Date:     2016/17/12
+//
+//!  This function is used by other modules to get the installed dataflash type
+//
+//------------------------------------------------------------------------------
+
+unsigned char GetDataflashID(void)
+{
+    return deviceInstalled;
 }
+
 //------------------------------------------------------------------------------
-//   void TM4CSPIInit(SPI_DEVICE_ENUM spiDevice)
+//   DataFlashGetSPIStatistics(unsigned int *openCount, unsigned int *transferCount)
 //
 //   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/05
+//   Date:     2026/10/17
+//
+//!  This function returns the number of times the dataflash SPI has been
+//!  opened and the number of transfers made on it
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetSPIStatistics(
+                               unsigned int *openCount,         //!< Number of times the SPI has been opened
+                               unsigned int *transferCount      //!< Number of SPI transfers
+                               )
+{
+    *openCount = dataFlashSPIOpenCount;
+    *transferCount = dataFlashSPITransferCount;
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashGetBusyWaitStatistics(unsigned int *statusPolls, unsigned int *sleepTicks)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of status polls made while waiting for
+//!  the dataflash and the clock ticks slept instead of polling
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetBusyWaitStatistics(
+                                    unsigned int *statusPolls,  //!< Number of status polls
+                                    unsigned int *sleepTicks    //!< Clock ticks slept
+                                    )
+{
+    *statusPolls = dataFlashStatusPollCount;
+    *sleepTicks = dataFlashSleepTicks;
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashGetCacheStatistics(unsigned int *hits, unsigned int *misses, unsigned int *pagePrograms, unsigned int *rewrites)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of page cache hits and misses, the
+//!  cached pages programmed and the subsectors written again for the cache
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetCacheStatistics(
+                                 unsigned int *hits,          //!< Accesses to a cached page
+                                 unsigned int *misses,        //!< Pages read into the cache
+                                 unsigned int *pagePrograms,  //!< Cached pages programmed
+                                 unsigned int *rewrites       //!< Subsectors erased and written again
+                                 )
+{
+    *hits = dataFlashCacheHits;
+    *misses = dataFlashCacheMisses;
+    *pagePrograms = dataFlashCachePagePrograms;
+    *rewrites = dataFlashCacheRewrites;
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashEraseSubsectors(unsigned short firstSubsector, unsigned short nSubsectors)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases consecutive subsectors. Whole 64 Kbyte blocks are
+//!  erased with one block erase if the dataflash supports it, the subsectors
+//!  before and after them one at a time. Protected subsectors are skipped
+//
+//------------------------------------------------------------------------------
+
+void DataFlashEraseSubsectors(
+                              unsigned short firstSubsector,  //!< First subsector to be erased
+                              unsigned short nSubsectors      //!< Number of subsectors to be erased
+                              )
+{
+    // For indexing the subsectors of a block
+    unsigned short subsectorIndex = 0u;
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    while ( nSubsectors > 0u )
+    {
+        if ( (dataFlashGeometry.isBlockEraseSupported == true) && \
+             ((firstSubsector % DATAFLASH_SUBSECTORS_PER_BLOCK) == 0u) && \
+             (nSubsectors >= DATAFLASH_SUBSECTORS_PER_BLOCK) && \
+             (IsSubsectorProtected(firstSubsector, (unsigned short)DATAFLASH_SUBSECTORS_PER_BLOCK) == false) )
+        {
+            // The cached pages of the block are erased as well
+            for ( subsectorIndex = 0u; subsectorIndex < DATAFLASH_SUBSECTORS_PER_BLOCK; subsectorIndex++ )
+            {
+                DropCachedSubsector((unsigned short)(firstSubsector + subsectorIndex));
+            }
+            BlockErase(firstSubsector);
+            firstSubsector = firstSubsector + DATAFLASH_SUBSECTORS_PER_BLOCK;
+            nSubsectors = nSubsectors - DATAFLASH_SUBSECTORS_PER_BLOCK;
+        }
+        else
+        {
+            DataFlashErasePage(firstSubsector);
+            firstSubsector++;
+            nSubsectors--;
+        }
+    }
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashGetGeometry(DATAFLASH_GEOMETRY_STRUCT *geometry)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the geometry of the installed dataflash found by
+//!  DataFlashInit
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetGeometry(
+                          DATAFLASH_GEOMETRY_STRUCT *geometry  //!< Geometry of the dataflash
+                          )
+{
+    *geometry = dataFlashGeometry;
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashProtectSubsectors(unsigned short firstSubsector, unsigned short lastSubsector)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function protects a range of subsectors, they are then erased only
+//!  by DataFlashEraseProtectedSubsector. The other erases leave them
+//!  unchanged, so a cached word which sets bits in them is not written
+//
+//------------------------------------------------------------------------------
+
+void DataFlashProtectSubsectors(
+                                unsigned short firstSubsector,  //!< First protected subsector
+                                unsigned short lastSubsector    //!< Last protected subsector
+                                )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    protectedFirstSubsector = firstSubsector;
+    protectedLastSubsector = lastSubsector;
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashEraseProtectedSubsector(unsigned short subsectorNumber)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases a subsector whether it is protected or not. It is
+//!  used by the owner of the protected subsectors
+//
+//------------------------------------------------------------------------------
+
+void DataFlashEraseProtectedSubsector(
+                                      unsigned short subsectorNumber  //!< Subsector to be erased
+                                      )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    // The cached pages of the subsector are erased as well
+    DropCachedSubsector(subsectorNumber);
+    SubsectorErase(subsectorNumber);
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashStartErase(unsigned short firstSubsector, unsigned short nSubsectors)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
 //
-//!  This function initialize the SPI for dataflash
+//!  This function starts the erase of one subsector, or of a whole 64 Kbyte
+//!  block if the dataflash supports it, and returns without waiting for it.
+//!  The erase is finished by DataFlashFinishErase. It returns false and
+//!  starts nothing if the subsectors cannot be erased with one command, are
+//!  protected or if another erase has not been finished
 //
 //------------------------------------------------------------------------------
 
-void TM4CSPIInit(
-                    SPI_DEVICE_ENUM spiDevice                                   //!< Connected SPI device
-                )
+bool DataFlashStartErase(
+                         unsigned short firstSubsector,  //!< First subsector to be erased
+                         unsigned short nSubsectors      //!< Number of subsectors to be erased, 1 or a block
+                         )
 {
-    if ( spiDevice == SPI_DATAFLASH )
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // This variable contains the length of dataFlash commands used in this function
+    unsigned char commandLength = 0u;
+    // Temporary variable contains the read value
+    unsigned char temp = 0u;
+    // For indexing the subsectors of a block
+    unsigned short subsectorIndex = 0u;
+    // For the erase command
+    DATAFLASH_COMMAND_ENUM command = ERASE_SUBSECTOR_COMMAND;
+    // For the result
+    bool isStarted = false;
+    gateKey = EnterDataFlash();
+    if ( (erasingSubsectors == 0u) && (IsSubsectorProtected(firstSubsector, nSubsectors) == false) )
+    {
+        if ( nSubsectors == 1u )
+        {
+            isStarted = true;
+        }
+        else if ( (dataFlashGeometry.isBlockEraseSupported == true) && \
+                  ((firstSubsector % DATAFLASH_SUBSECTORS_PER_BLOCK) == 0u) && \
+                  (nSubsectors == DATAFLASH_SUBSECTORS_PER_BLOCK) )
+        {
+            command = ERASE_BLOCK_COMMAND;
+            isStarted = true;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
     {
-       // Enable SSI3 module
-       SysCtlPeripheralEnable(SYSCTL_PERIPH_SSI3);
-      // Configure respective GPIO pins for FSS(PB4),CLK(PB5), MISO(PE4) and MOSI(PE5)
-      GPIOPinConfigure(GPIO_PQ1_SSI3FSS);
-      GPIOPinConfigure(GPIO_PQ0_SSI3CLK);
-      GPIOPinConfigure(GPIO_PQ2_SSI3XDAT0);
-      GPIOPinConfigure(GPIO_PQ3_SSI3XDAT1);
-      GPIOPinTypeSSI(GPIO_PORTQ_BASE, GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
+        //Do nothing
+    }
+    if ( isStarted == true )
+    {
+        // The cached pages of the subsectors are erased as well
+        for ( subsectorIndex = 0u; subsectorIndex < nSubsectors; subsectorIndex++ )
+        {
+            DropCachedSubsector((unsigned short)(firstSubsector + subsectorIndex));
+        }
+        // Latch the write enable bit
+        WriteEnableDataflash();
+        BuildDataFlashCommand(command, (unsigned int)firstSubsector, DONT_CARE, spiBuffer, &commandLength, false);
+        // Start SPI command write process, the next command waits for the erase
+        WriteDataFlashCommandBytes(spiBuffer, (unsigned short)commandLength, IGNORED_NBYTES, &temp);
+        erasingFirstSubsector = firstSubsector;
+        erasingSubsectors = nSubsectors;
+        erasingCommand = command;
+        dataFlashErasesStarted++;
     }
     else
     {
-      //TODO: add for other device as well
+        //Do nothing
     }
-      EK_TM4C1294XL_initDMA();
-      SPI_init();
+    LeaveDataFlash(gateKey);
+    return isStarted;
 }
 
 //------------------------------------------------------------------------------
-//   unsigned char GetDataflashID(void)
+//   DataFlashIsEraseBusy(void)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
 //
-//   Author:   Muhammad Shuaib
-//   Date:     2016/17/12
+//!  This function returns true while the erase started by DataFlashStartErase
+//!  is going on in the dataflash
 //
-//!  This function is used by other modules to get the installed dataflash type
+//------------------------------------------------------------------------------
+
+bool DataFlashIsEraseBusy(void)
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // This variable contains the status of the dataflash
+    unsigned char status = 0u;
+    // For the result
+    bool isBusy = false;
+    gateKey = EnterDataFlash();
+    if ( (erasingSubsectors > 0u) && (isEraseSuspended == false) )
+    {
+        GetDataFlashStatus(&status);
+        dataFlashStatusPollCount++;
+        if ( (status & WRITE_IN_PROGRESS_BIT) == DATAFLASH_BUSY )
+        {
+            isBusy = true;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    LeaveDataFlash(gateKey);
+    return isBusy;
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashFinishErase(void)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function waits for the erase started by DataFlashStartErase and
+//!  reads it back as SubsectorErase does. The erase is tried again the usual
+//!  way if a subsector is not blank
 //
 //------------------------------------------------------------------------------
 
-unsigned char GetDataflashID(void)
+void DataFlashFinishErase(void)
 {
-    return deviceInstalled;
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    gateKey = EnterDataFlash();
+    if ( erasingSubsectors > 0u )
+    {
+        // The busy wait is for the erase
+        lastDataFlashCommand = erasingCommand;
+        (void) IfDataFlashReady();
+        if ( IsEraseBlank(erasingFirstSubsector, erasingSubsectors) == false )
+        {
+            if ( erasingCommand == ERASE_BLOCK_COMMAND )
+            {
+                BlockErase(erasingFirstSubsector);
+            }
+            else
+            {
+                SubsectorErase(erasingFirstSubsector);
+            }
+        }
+        else
+        {
+            //Do nothing
+        }
+        erasingSubsectors = 0u;
+    }
+    else
+    {
+        //Do nothing
+    }
+    LeaveDataFlash(gateKey);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashSuspendErase(unsigned short subsectorNumber)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function makes the dataflash ready for a read or a program of a
+//!  subsector while the erase started by DataFlashStartErase is going on.
+//!  The N25Q suspends the erase, the other devices cannot. It returns false
+//!  if the subsector cannot be accessed before the end of the erase, it is
+//!  being erased or writing back its cached pages would erase it. The
+//!  dataflash gate is kept until DataFlashResumeErase in both cases
+//
+//------------------------------------------------------------------------------
+
+bool DataFlashSuspendErase(
+                           unsigned short subsectorNumber  //!< Subsector to be accessed, NO_DATAFLASH_SUBSECTOR for the whole page cache
+                           )
+{
+    // For entering the gate of the dataflash
+    IArg gateKey;
+    // This variable contains the status of the dataflash
+    unsigned char status = 0u;
+    // Temporary variable contains the read value
+    unsigned char temp = 0u;
+    // For the result
+    bool isAccessible = true;
+    gateKey = EnterDataFlash();
+    if ( (erasingSubsectors > 0u) && (isEraseSuspended == false) )
+    {
+        GetDataFlashStatus(&status);
+        dataFlashStatusPollCount++;
+        if ( (status & WRITE_IN_PROGRESS_BIT) != DATAFLASH_BUSY )
+        {
+            // The erase is over, it is read back by DataFlashFinishErase
+        }
+        else if ( ((subsectorNumber >= erasingFirstSubsector) && \
+                   ((unsigned int)subsectorNumber < ((unsigned int)erasingFirstSubsector + erasingSubsectors))) || \
+                  (deviceInstalled != N25Q) || (IsRewriteNeeded(subsectorNumber) == true) )
+        {
+            isAccessible = false;
+        }
+        else
+        {
+            spiBuffer[0] = PROGRAM_ERASE_SUSPEND_OPCODE;
+            (void) SPITransferData(SPI_DATAFLASH, spiBuffer, 1u, IGNORED_NBYTES, &temp);
+            // The suspend takes about as long as a page program
+            lastDataFlashCommand = WRITE_DATAFLASH_PAGE_COMMAND;
+            (void) IfDataFlashReady();
+            isEraseSuspended = true;
+            dataFlashEraseSuspends++;
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    suspendGateKey = gateKey;
+    return isAccessible;
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashResumeErase(void)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function resumes the erase suspended by DataFlashSuspendErase and
+//!  leaves the dataflash gate
+//
+//------------------------------------------------------------------------------
+
+void DataFlashResumeErase(void)
+{
+    // Temporary variable contains the read value
+    unsigned char temp = 0u;
+    if ( isEraseSuspended == true )
+    {
+        // The resume is ignored while a program is going on
+        (void) IfDataFlashReady();
+        spiBuffer[0] = PROGRAM_ERASE_RESUME_OPCODE;
+        (void) SPITransferData(SPI_DATAFLASH, spiBuffer, 1u, IGNORED_NBYTES, &temp);
+        // The next busy wait is for the erase again
+        lastDataFlashCommand = erasingCommand;
+        isEraseSuspended = false;
+    }
+    else
+    {
+        //Do nothing
+    }
+    LeaveDataFlash(suspendGateKey);
+}
+
+//------------------------------------------------------------------------------
+//   DataFlashGetEraseSuspendStatistics(unsigned int *erasesStarted, unsigned int *suspends)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of erases started by DataFlashStartErase
+//!  and the number of times one of them has been suspended
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetEraseSuspendStatistics(
+                                        unsigned int *erasesStarted,  //!< Erases started without waiting
+                                        unsigned int *suspends        //!< Erases suspended
+                                        )
+{
+    *erasesStarted = dataFlashErasesStarted;
+    *suspends = dataFlashEraseSuspends;
 }
 
 //==============================================================================
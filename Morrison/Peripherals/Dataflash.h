@@ -78,14 +78,15 @@
 //------------------------------------------------------------------------------
 
 #define FIRST_DATAFLASH_SUBSECTOR                    0x0000U                //!< Address of the first subsector in dataflash 
-#define LAST_DATAFLASH_SUBSECTOR                     0x03FFU                //!< 4096 subsectors in the dataflash, 4Kbyte each
+#define LAST_DATAFLASH_SUBSECTOR                     0x0FFFU                //!< 4096 subsectors in the dataflash, 4Kbyte each
 #define PAGES_PER_SUBSECTOR                          16u                    //!< Number of pages per subsector
 #define FIRST_DATAFLASH_PAGE                         0x0000U                //!< Address of first page in dataflash 
 #define LAST_DATAFLASH_PAGE                          (((LAST_DATAFLASH_SUBSECTOR + 1u)*PAGES_PER_SUBSECTOR) - 1u)  //!< Address of last page in dataflash 
 #define DATAFLASH_PAGE_SIZE                          256U                   //!< Bytes in one page of dataflash
-#define NO_DATAFLASH_SUBSECTOR                       (LAST_DATAFLASH_SUBSECTOR + 1u)   //!< Last subsector in dataflash
+#define NO_DATAFLASH_SUBSECTOR                       0xFFFFU                //!< Marker of no subsector, outside the dataflash
 #define DATAFLASH_SUBSECTOR                          (LAST_DATAFLASH_SUBSECTOR + 1u) //!< Total number of subsector in dataflash   
 #define DATAFLASH_SUBSECTOR_SIZE                     4096U                  //!< Number of bytes in a subsector (16 x 256bytes)
+#define DATAFLASH_SUBSECTORS_PER_BLOCK               16U                    //!< Number of subsectors in a 64 Kbyte block
 #define DATAFLASH_DATALOG_BLOCK_SIZE                 DATAFLASH_SUBSECTOR_SIZE   //!< Datalog memory block size in bytes 
 #define GENERAL_BUFFER_LENGTH                        256U                   //!< Define for array length
 #define INITIAL_CRC_VALUE                            0xFFFFU                //!< Default value before calculation
@@ -231,6 +232,7 @@ typedef enum
     ERASE_SUBSECTOR_COMMAND                         = 0x03,   //!< Command code to erase data from a subsector of dataflash
     WRITE_DATAFLASH_PAGE_COMMAND                    = 0x04,   //!< Command code to compare data of buffer with datalog data in dataflash before writing new data
     READ_DATAFLASH_FAST_COMMAND                     = 0x05,   //!< Fast read dataflash command
+    ERASE_BLOCK_COMMAND                             = 0x06,   //!< Command code to erase a 64 Kbyte block of dataflash
 } DATAFLASH_COMMAND_ENUM ;
 
 //! ENUM is used to classified dataflash into two buffer types
@@ -249,11 +251,24 @@ typedef enum
    SPI_NFC = 2,       //NFC Transciever
 }SPI_DEVICE_ENUM; //TODO: add other SPI connected devices as well
 
+//! This data structure defines the geometry of the installed dataflash, read
+//! from its SFDP table or taken from its identification
+typedef struct
+{
+    bool isSFDPFound;                   //!< Set if the geometry was read from the SFDP table
+    unsigned int capacity;              //!< Bytes in the dataflash, 0 if unknown
+    unsigned short pageSize;            //!< Bytes in a page of the dataflash
+    unsigned short programSize;         //!< Bytes written by one program command, 1 for devices programming one byte at a time
+    bool isBlockEraseSupported;         //!< Set if 64 Kbyte blocks can be erased with one command
+    bool isDualReadSupported;           //!< Set if the dataflash has a dual fast read
+    bool isQuadReadSupported;           //!< Set if the dataflash has a quad fast read
+
+}DATAFLASH_GEOMETRY_STRUCT;
+
 //==============================================================================
 //  GLOBAL DATA
 //==============================================================================
 
-extern unsigned short generalBufferPageNumber;     //!< This variable contains current subsector number in general buffer
 extern bool isParametersClearAcknowledged;      //!< This variable is used to tell if instrument parameters erased is finished
 
 //==============================================================================
@@ -309,7 +324,10 @@ void DataFlashReadGeneralWord(
 //   Author:   Ali Zulqarnain Anjum
 //   Date:     2016/12/02
 //
-//!  This function writes a word(2 bytes) to the general page of the dataflash
+//!  This function writes a word(2 bytes) to the general page of the dataflash.
+//!  The word stays in the page cache until DataFlashCommitGeneralBuffer is
+//!  called or the page is replaced, consecutive words of a page are written
+//!  with one page program
 //
 //------------------------------------------------------------------------------
 
@@ -544,18 +562,6 @@ void DataFlashWriteWord(
 
 void DataFlashSPIInit(void);
 
-//------------------------------------------------------------------------------
-//   void TM4CSPIInit(SPI_DEVICE_ENUM spiDevice)
-//
-//   Author:   Ali Zulqarnain Anjum
-//   Date:     2016/12/05
-//
-//!  This function initialize the SPI for dataflash
-//
-//------------------------------------------------------------------------------
-void TM4CSPIInit(
-                    SPI_DEVICE_ENUM spiDevice                                   //!< Connected SPI device
-                );
 //--------------------------------------------------------------------------------------------------------------------------------------------------------------
 //
 //   SPITransferData(SPI_DEVICE_ENUM spiDevice, unsigned char *txBuffer, unsigned short nBytes, unsigned char rxOffset, unsigned char *rxBuffer)
@@ -577,6 +583,31 @@ ERRORCODE_ENUM SPITransferData(
                                 unsigned short rxOffset,       //!< Number of received bytes to be ignored
                                 unsigned char *rxBuffer        //!< Pointer to the buffer containing the read value from SPI bus
                               );
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------
+//
+//   SPITransferSegments(SPI_DEVICE_ENUM spiDevice, unsigned char *command, unsigned short commandLength, unsigned char *txData, unsigned char *rxData, unsigned short nBytes)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function sends a command followed by n data bytes in one SPI
+//!  transfer. The bytes received during the command are dropped and the
+//!  following n bytes are received in rxData, both segments are moved by the
+//!  uDMA straight from and to the caller's buffers
+//
+//!  \return ERRORCODE_ENUM_NO_ERROR                                   - No error detected
+//!  \return ERRORCODE_ENUM_SPI_ERROR                                  - SPI error is detected
+//
+//--------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+ERRORCODE_ENUM SPITransferSegments(
+                                    SPI_DEVICE_ENUM spiDevice,     //!< SPI device id
+                                    unsigned char *command,        //!< Command bytes sent first
+                                    unsigned short commandLength,  //!< Number of command bytes
+                                    unsigned char *txData,         //!< Data bytes sent after the command, NULL sends don't care bytes
+                                    unsigned char *rxData,         //!< Data bytes received after the command, NULL drops them
+                                    unsigned short nBytes          //!< Number of data bytes
+                                  );
 //------------------------------------------------------------------------------
 //   DataFlashReadSector(unsigned short subsectorNumber, unsigned char *data)
 //   
@@ -592,6 +623,41 @@ void DataFlashReadSector(
                               unsigned char *data             //!< This variable contains data after successful read operation on dataflash
                         );
 
+//------------------------------------------------------------------------------
+//   DataFlashReadBytes(unsigned short subsectorNumber, unsigned short byteAddress, unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function reads n bytes from the given subsector of the dataflash
+//
+//------------------------------------------------------------------------------
+
+void DataFlashReadBytes(
+                        unsigned short subsectorNumber,  //!< Data is to be read from this subsector
+                        unsigned short byteAddress,      //!< Offset in the subsector, data read starts from here
+                        unsigned char *data,             //!< All data read will be placed here
+                        unsigned short nBytes            //!< Number of bytes to be read
+                        );
+
+//------------------------------------------------------------------------------
+//   DataFlashProgramBytes(unsigned short subsectorNumber, unsigned short byteAddress, const unsigned char *data, unsigned short nBytes)
+//   
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function programs n already erased bytes in the given subsector of
+//!  the dataflash
+//
+//------------------------------------------------------------------------------
+
+void DataFlashProgramBytes(
+                           unsigned short subsectorNumber,  //!< Data is to be written to this subsector
+                           unsigned short byteAddress,      //!< Offset in the subsector, data write starts from here
+                           const unsigned char *data,       //!< Data to be written
+                           unsigned short nBytes            //!< Number of bytes to be written
+                           );
+
 //------------------------------------------------------------------------------
 //   unsigned char GetDataflashID(void)
 //
@@ -604,6 +670,206 @@ void DataFlashReadSector(
 
 unsigned char GetDataflashID(void);
 
+//------------------------------------------------------------------------------
+//   DataFlashGetSPIStatistics(unsigned int *openCount, unsigned int *transferCount)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of times the dataflash SPI has been
+//!  opened and the number of transfers made on it
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetSPIStatistics(
+                               unsigned int *openCount,         //!< Number of times the SPI has been opened
+                               unsigned int *transferCount      //!< Number of SPI transfers
+                               );
+
+//------------------------------------------------------------------------------
+//   DataFlashGetBusyWaitStatistics(unsigned int *statusPolls, unsigned int *sleepTicks)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of status polls made while waiting for
+//!  the dataflash and the clock ticks slept instead of polling
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetBusyWaitStatistics(
+                                    unsigned int *statusPolls,  //!< Number of status polls
+                                    unsigned int *sleepTicks    //!< Clock ticks slept
+                                    );
+
+//------------------------------------------------------------------------------
+//   DataFlashGetCacheStatistics(unsigned int *hits, unsigned int *misses, unsigned int *pagePrograms, unsigned int *rewrites)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of page cache hits and misses, the
+//!  cached pages programmed and the subsectors written again for the cache
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetCacheStatistics(
+                                 unsigned int *hits,          //!< Accesses to a cached page
+                                 unsigned int *misses,        //!< Pages read into the cache
+                                 unsigned int *pagePrograms,  //!< Cached pages programmed
+                                 unsigned int *rewrites       //!< Subsectors erased and written again
+                                 );
+
+//------------------------------------------------------------------------------
+//   DataFlashEraseSubsectors(unsigned short firstSubsector, unsigned short nSubsectors)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases consecutive subsectors. Whole 64 Kbyte blocks are
+//!  erased with one block erase if the dataflash supports it
+//
+//------------------------------------------------------------------------------
+
+void DataFlashEraseSubsectors(
+                              unsigned short firstSubsector,  //!< First subsector to be erased
+                              unsigned short nSubsectors      //!< Number of subsectors to be erased
+                              );
+
+//------------------------------------------------------------------------------
+//   DataFlashStartErase(unsigned short firstSubsector, unsigned short nSubsectors)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function starts the erase of one subsector or of a whole 64 Kbyte
+//!  block and returns without waiting for it. It returns false if the erase
+//!  cannot be started
+//
+//------------------------------------------------------------------------------
+
+bool DataFlashStartErase(
+                         unsigned short firstSubsector,  //!< First subsector to be erased
+                         unsigned short nSubsectors      //!< Number of subsectors to be erased, 1 or a block
+                         );
+
+//------------------------------------------------------------------------------
+//   DataFlashIsEraseBusy(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true while the erase started by DataFlashStartErase
+//!  is going on in the dataflash
+//
+//------------------------------------------------------------------------------
+
+bool DataFlashIsEraseBusy(void);
+
+//------------------------------------------------------------------------------
+//   DataFlashFinishErase(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function waits for the erase started by DataFlashStartErase and
+//!  reads it back, the erase is tried again if it failed
+//
+//------------------------------------------------------------------------------
+
+void DataFlashFinishErase(void);
+
+//------------------------------------------------------------------------------
+//   DataFlashSuspendErase(unsigned short subsectorNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function suspends the started erase so that a subsector can be read
+//!  or programmed. It returns false if the subsector cannot be accessed
+//!  before the end of the erase. The dataflash gate is kept until
+//!  DataFlashResumeErase
+//
+//------------------------------------------------------------------------------
+
+bool DataFlashSuspendErase(
+                           unsigned short subsectorNumber  //!< Subsector to be accessed, NO_DATAFLASH_SUBSECTOR for the whole page cache
+                           );
+
+//------------------------------------------------------------------------------
+//   DataFlashResumeErase(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function resumes the erase suspended by DataFlashSuspendErase and
+//!  leaves the dataflash gate
+//
+//------------------------------------------------------------------------------
+
+void DataFlashResumeErase(void);
+
+//------------------------------------------------------------------------------
+//   DataFlashGetEraseSuspendStatistics(unsigned int *erasesStarted, unsigned int *suspends)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of erases started by DataFlashStartErase
+//!  and the number of times one of them has been suspended
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetEraseSuspendStatistics(
+                                        unsigned int *erasesStarted,  //!< Erases started without waiting
+                                        unsigned int *suspends        //!< Erases suspended
+                                        );
+
+//------------------------------------------------------------------------------
+//   DataFlashGetGeometry(DATAFLASH_GEOMETRY_STRUCT *geometry)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the geometry of the installed dataflash found by
+//!  DataFlashInit
+//
+//------------------------------------------------------------------------------
+
+void DataFlashGetGeometry(
+                          DATAFLASH_GEOMETRY_STRUCT *geometry  //!< Geometry of the dataflash
+                          );
+
+//------------------------------------------------------------------------------
+//   DataFlashProtectSubsectors(unsigned short firstSubsector, unsigned short lastSubsector)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function protects a range of subsectors, they are then erased only
+//!  by DataFlashEraseProtectedSubsector
+//
+//------------------------------------------------------------------------------
+
+void DataFlashProtectSubsectors(
+                                unsigned short firstSubsector,  //!< First protected subsector
+                                unsigned short lastSubsector    //!< Last protected subsector
+                                );
+
+//------------------------------------------------------------------------------
+//   DataFlashEraseProtectedSubsector(unsigned short subsectorNumber)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function erases a subsector whether it is protected or not
+//
+//------------------------------------------------------------------------------
+
+void DataFlashEraseProtectedSubsector(
+                                      unsigned short subsectorNumber  //!< Subsector to be erased
+                                      );
+
 #endif /* __DATAFLASH_H__ */
 //==============================================================================
 //  End Of File
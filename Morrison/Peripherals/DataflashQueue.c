@@ -0,0 +1,608 @@
+//==============================================================================
+//
+//  DataflashQueue.c
+//
+//  Copyright (C) 2026 by Industrial Scientific.
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashQueue.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module queues the dataflash requests of the other tasks so that they
+//! do not wait for an erase or a program to finish. The dataflash task takes
+//! the requests in order and carries them out with the Dataflash module
+//! functions, sleeping while the dataflash is busy.
+//!
+//! An erase is started without waiting for it. While it goes on, the reads,
+//! programs and flushes queued after it which do not touch the erased
+//! subsectors are carried out in erase suspends, so a page program waits
+//! for a suspend instead of a whole erase. Reads of the same subsector which
+//! follow each other in the dataflash and in RAM are carried out in one
+//! transfer. An erase followed by a commit of the same subsector is left
+//! out, the commit erases the subsector itself
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include <xdc/std.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/knl/Semaphore.h>
+#include <ti/sysbios/gates/GateMutex.h>
+#include "DataflashQueue.h"
+#include "Dataflash.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define DATAFLASH_QUEUE_POLL_TICKS  1u                                          //!< Sleep between the checks of a request or an erase
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+static DATAFLASH_REQUEST_STRUCT *requestQueue[DATAFLASH_QUEUE_LENGTH];          //!< Queued requests, oldest first from queueHead
+static DATAFLASH_REQUEST_STRUCT *requestBatch[DATAFLASH_QUEUE_LENGTH];          //!< Requests carried out by one operation
+static unsigned char queueHead = 0u;                                            //!< Position of the oldest request
+static unsigned char queueCount = 0u;                                           //!< Number of queued requests
+static Semaphore_Handle queueSemaphoreHandle = NULL;                            //!< Counts the queued requests, the dataflash task pends on it
+static GateMutex_Handle queueGateHandle = NULL;                                 //!< Serializes the accesses to the queue
+static volatile bool isQueueTaskRunning = false;                                //!< Set when the dataflash task takes its first request
+static unsigned int completedRequests = 0u;                                     //!< Number of completed requests
+static unsigned int mergedReads = 0u;                                           //!< Number of reads merged with the read before
+static unsigned int pipelinedRequests = 0u;                                     //!< Number of requests carried out during an erase
+static unsigned int maximumQueueDepth = 0u;                                     //!< Most requests queued at once
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+static DATAFLASH_REQUEST_STRUCT *TakeRequest(void);
+static bool IsReadMergeable(const DATAFLASH_REQUEST_STRUCT *firstRead, unsigned short readLength, const DATAFLASH_REQUEST_STRUCT *nextRequest);
+static DATAFLASH_REQUEST_STRUCT *TakePipelinedRequest(const DATAFLASH_REQUEST_STRUCT *eraseRequest);
+static void RunRequest(DATAFLASH_REQUEST_STRUCT *request, unsigned short readLength);
+static void PipelineErase(DATAFLASH_REQUEST_STRUCT *eraseRequest);
+static void CompleteRequest(DATAFLASH_REQUEST_STRUCT *request);
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   TakeRequest(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function removes the oldest request from the queue and returns it.
+//!  The queue gate must be entered and the queue must not be empty
+//
+//------------------------------------------------------------------------------
+static DATAFLASH_REQUEST_STRUCT *TakeRequest(void)
+{
+    //For the request taken
+    DATAFLASH_REQUEST_STRUCT *request = requestQueue[queueHead];
+    queueHead = (unsigned char)((queueHead + 1u) % DATAFLASH_QUEUE_LENGTH);
+    queueCount--;
+    return request;
+}
+//------------------------------------------------------------------------------
+//   IsReadMergeable(const DATAFLASH_REQUEST_STRUCT *firstRead, unsigned short readLength, const DATAFLASH_REQUEST_STRUCT *nextRequest)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if the next request is a read which goes on
+//!  where the merged reads end, both in the dataflash and in RAM
+//
+//------------------------------------------------------------------------------
+static bool IsReadMergeable(
+                              const DATAFLASH_REQUEST_STRUCT *firstRead,        //!< First read of the merged reads
+                              unsigned short readLength,                        //!< Bytes of the merged reads
+                              const DATAFLASH_REQUEST_STRUCT *nextRequest       //!< Request after the merged reads
+                           )
+{
+    //For the result
+    bool isMergeable = false;
+    if ( (nextRequest->operation == DATAFLASH_REQUEST_READ) &&
+         (nextRequest->subsectorNumber == firstRead->subsectorNumber) &&
+         (nextRequest->byteAddress == (unsigned short)(firstRead->byteAddress + readLength)) &&
+         (nextRequest->data == (firstRead->data + readLength)) &&
+         (((unsigned int)firstRead->byteAddress + readLength + nextRequest->nBytes) <= DATAFLASH_SUBSECTOR_SIZE) )
+    {
+        isMergeable = true;
+    }
+    else
+    {
+        //Do nothing
+    }
+    return isMergeable;
+}
+//------------------------------------------------------------------------------
+//   TakePipelinedRequest(const DATAFLASH_REQUEST_STRUCT *eraseRequest)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function removes the oldest request from the queue and returns it if
+//!  it can be carried out while the erase goes on. It is a read, a program or
+//!  a flush and it does not touch the erased subsectors. It returns NULL
+//!  otherwise, the requests stay in order
+//
+//------------------------------------------------------------------------------
+static DATAFLASH_REQUEST_STRUCT *TakePipelinedRequest(
+                                                        const DATAFLASH_REQUEST_STRUCT *eraseRequest  //!< Erase going on
+                                                     )
+{
+    //For entering the gate of the queue
+    IArg gateKey;
+    //For the oldest request
+    DATAFLASH_REQUEST_STRUCT *request = NULL;
+    gateKey = GateMutex_enter(queueGateHandle);
+    if ( queueCount > 0u )
+    {
+        request = requestQueue[queueHead];
+        if ( (request->operation == DATAFLASH_REQUEST_FLUSH) ||
+             (((request->operation == DATAFLASH_REQUEST_READ) || (request->operation == DATAFLASH_REQUEST_PROGRAM)) &&
+              ((request->subsectorNumber < eraseRequest->subsectorNumber) ||
+               ((unsigned int)request->subsectorNumber >= ((unsigned int)eraseRequest->subsectorNumber + eraseRequest->nSubsectors)))) )
+        {
+            (void) TakeRequest();
+            // The request has been counted by the semaphore
+            (void) Semaphore_pend(queueSemaphoreHandle, BIOS_NO_WAIT);
+        }
+        else
+        {
+            request = NULL;
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    GateMutex_leave(queueGateHandle, gateKey);
+    return request;
+}
+//------------------------------------------------------------------------------
+//   RunRequest(DATAFLASH_REQUEST_STRUCT *request, unsigned short readLength)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function carries out a request with the Dataflash module functions,
+//!  a read reads the bytes of the reads merged with it as well
+//
+//------------------------------------------------------------------------------
+static void RunRequest(
+                         DATAFLASH_REQUEST_STRUCT *request,                     //!< Request to be carried out
+                         unsigned short readLength                              //!< Bytes of the merged reads
+                      )
+{
+    switch ( request->operation )
+    {
+    case DATAFLASH_REQUEST_READ:
+        DataFlashReadBytes(request->subsectorNumber, request->byteAddress, request->data, readLength);
+        break;
+    case DATAFLASH_REQUEST_PROGRAM:
+        DataFlashProgramBytes(request->subsectorNumber, request->byteAddress, request->data, request->nBytes);
+        break;
+    case DATAFLASH_REQUEST_ERASE:
+        DataFlashEraseSubsectors(request->subsectorNumber, request->nSubsectors);
+        break;
+    case DATAFLASH_REQUEST_COMMIT:
+        DataFlashCommitBuffer(request->data, request->subsectorNumber);
+        break;
+    case DATAFLASH_REQUEST_FLUSH:
+        DataFlashCommitGeneralBuffer();
+        break;
+    default:
+        break;
+    }
+}
+//------------------------------------------------------------------------------
+//   PipelineErase(DATAFLASH_REQUEST_STRUCT *eraseRequest)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function starts an erase and carries out the requests queued after
+//!  it in erase suspends until the erase is over. A request which cannot be
+//!  carried out in a suspend waits for the end of the erase. An erase which
+//!  cannot be started at once is carried out the usual way
+//
+//------------------------------------------------------------------------------
+static void PipelineErase(
+                            DATAFLASH_REQUEST_STRUCT *eraseRequest              //!< Erase request
+                         )
+{
+    //For the request carried out during the erase
+    DATAFLASH_REQUEST_STRUCT *request = NULL;
+    //For the state of the erase
+    bool isErasing = DataFlashStartErase(eraseRequest->subsectorNumber, eraseRequest->nSubsectors);
+    if ( isErasing == false )
+    {
+        RunRequest(eraseRequest, 0u);
+    }
+    else
+    {
+        //Do nothing
+    }
+    while ( isErasing == true )
+    {
+        request = TakePipelinedRequest(eraseRequest);
+        if ( request != NULL )
+        {
+            if ( DataFlashSuspendErase((request->operation == DATAFLASH_REQUEST_FLUSH) ? NO_DATAFLASH_SUBSECTOR : request->subsectorNumber) == true )
+            {
+                RunRequest(request, request->nBytes);
+                DataFlashResumeErase();
+                pipelinedRequests++;
+            }
+            else
+            {
+                // The request waits for the end of the erase
+                DataFlashResumeErase();
+                DataFlashFinishErase();
+                isErasing = false;
+                RunRequest(request, request->nBytes);
+            }
+            CompleteRequest(request);
+        }
+        else if ( DataFlashIsEraseBusy() == true )
+        {
+            Task_sleep(DATAFLASH_QUEUE_POLL_TICKS);
+        }
+        else
+        {
+            isErasing = false;
+        }
+    }
+    DataFlashFinishErase();
+}
+//------------------------------------------------------------------------------
+//   CompleteRequest(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function calls the callback of a request, marks it as completed and
+//!  posts its semaphore. The request is not used after it is marked, its
+//!  owner can use it again at once
+//
+//------------------------------------------------------------------------------
+static void CompleteRequest(
+                              DATAFLASH_REQUEST_STRUCT *request                 //!< Completed request
+                           )
+{
+    //For entering the gate of the queue
+    IArg gateKey;
+    //For the semaphore of the request
+    Semaphore_Handle semaphore = request->semaphore;
+    if ( request->callback != NULL )
+    {
+        request->callback(request);
+    }
+    else
+    {
+        //Do nothing
+    }
+    if ( queueGateHandle != NULL )
+    {
+        gateKey = GateMutex_enter(queueGateHandle);
+        request->isCompleted = true;
+        completedRequests++;
+        GateMutex_leave(queueGateHandle, gateKey);
+    }
+    else
+    {
+        request->isCompleted = true;
+        completedRequests++;
+    }
+    if ( semaphore != NULL )
+    {
+        Semaphore_post(semaphore);
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   DataFlashQueueInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates the queue semaphore and gate, it is called before
+//!  the dataflash task is started
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueInit(void)
+{
+    //For the semaphore parameters
+    Semaphore_Params semaphoreParams;
+    if ( queueSemaphoreHandle == NULL )
+    {
+        Semaphore_Params_init(&semaphoreParams);
+        semaphoreParams.mode = Semaphore_Mode_COUNTING;
+        queueSemaphoreHandle = Semaphore_create(0, &semaphoreParams, NULL);
+        queueGateHandle = GateMutex_create(NULL, NULL);
+    }
+    else
+    {
+        //Do nothing
+    }
+}
+//------------------------------------------------------------------------------
+//   DataFlashQueueSubmit(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function queues a request and returns at once, it sleeps while the
+//!  queue is full. Before the dataflash task runs the request is carried out
+//!  and completed before the function returns
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueSubmit(
+                            DATAFLASH_REQUEST_STRUCT *request                   //!< Request to be queued
+                         )
+{
+    //For entering the gate of the queue
+    IArg gateKey;
+    //For the state of the request
+    bool isQueued = false;
+    request->isCompleted = false;
+    if ( (queueGateHandle == NULL) || (isQueueTaskRunning == false) )
+    {
+        // The start up uses the dataflash directly
+        RunRequest(request, request->nBytes);
+        CompleteRequest(request);
+    }
+    else
+    {
+        while ( isQueued == false )
+        {
+            gateKey = GateMutex_enter(queueGateHandle);
+            if ( queueCount < DATAFLASH_QUEUE_LENGTH )
+            {
+                requestQueue[(queueHead + queueCount) % DATAFLASH_QUEUE_LENGTH] = request;
+                queueCount++;
+                if ( queueCount > maximumQueueDepth )
+                {
+                    maximumQueueDepth = queueCount;
+                }
+                else
+                {
+                    //Do nothing
+                }
+                isQueued = true;
+            }
+            else
+            {
+                //Do nothing
+            }
+            GateMutex_leave(queueGateHandle, gateKey);
+            if ( isQueued == true )
+            {
+                Semaphore_post(queueSemaphoreHandle);
+            }
+            else
+            {
+                Task_sleep(DATAFLASH_QUEUE_POLL_TICKS);
+            }
+        }
+    }
+}
+//------------------------------------------------------------------------------
+//   DataFlashQueueWait(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function blocks until a queued request is completed, on its
+//!  semaphore if it has one
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueWait(
+                          DATAFLASH_REQUEST_STRUCT *request                     //!< Request to wait for
+                       )
+{
+    if ( request->semaphore != NULL )
+    {
+        (void) Semaphore_pend(request->semaphore, BIOS_WAIT_FOREVER);
+    }
+    else
+    {
+        while ( DataFlashQueueIsCompleted(request) == false )
+        {
+            Task_sleep(DATAFLASH_QUEUE_POLL_TICKS);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+//   DataFlashQueueIsCompleted(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if a queued request is completed, without
+//!  blocking
+//
+//------------------------------------------------------------------------------
+bool DataFlashQueueIsCompleted(
+                                 DATAFLASH_REQUEST_STRUCT *request              //!< Request to be checked
+                              )
+{
+    //For entering the gate of the queue
+    IArg gateKey;
+    //For the result
+    bool isCompleted = false;
+    if ( queueGateHandle != NULL )
+    {
+        gateKey = GateMutex_enter(queueGateHandle);
+        isCompleted = request->isCompleted;
+        GateMutex_leave(queueGateHandle, gateKey);
+    }
+    else
+    {
+        isCompleted = request->isCompleted;
+    }
+    return isCompleted;
+}
+//------------------------------------------------------------------------------
+//   DataFlashQueueProcess(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function waits for the next request and carries it out. It is
+//!  called in a loop by the dataflash task
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueProcess(void)
+{
+    //For entering the gate of the queue
+    IArg gateKey;
+    //For the first request of the operation
+    DATAFLASH_REQUEST_STRUCT *request = NULL;
+    //For the number of requests carried out by the operation
+    unsigned char batchLength = 0u;
+    //For indexing the batch
+    unsigned char batchIndex = 0u;
+    //For the bytes of the merged reads
+    unsigned short readLength = 0u;
+    //For stopping the merge
+    bool isMerging = true;
+    //For leaving out an erase
+    bool isEraseNeeded = true;
+    isQueueTaskRunning = true;
+    (void) Semaphore_pend(queueSemaphoreHandle, BIOS_WAIT_FOREVER);
+    gateKey = GateMutex_enter(queueGateHandle);
+    request = TakeRequest();
+    requestBatch[batchLength] = request;
+    batchLength++;
+    if ( request->operation == DATAFLASH_REQUEST_READ )
+    {
+        readLength = request->nBytes;
+        // Take the reads going on where this one ends
+        while ( (isMerging == true) && (queueCount > 0u) )
+        {
+            if ( IsReadMergeable(request, readLength, requestQueue[queueHead]) == true )
+            {
+                requestBatch[batchLength] = TakeRequest();
+                readLength = readLength + requestBatch[batchLength]->nBytes;
+                batchLength++;
+                mergedReads++;
+                // The request has been counted by the semaphore
+                (void) Semaphore_pend(queueSemaphoreHandle, BIOS_NO_WAIT);
+            }
+            else
+            {
+                isMerging = false;
+            }
+        }
+    }
+    else if ( (request->operation == DATAFLASH_REQUEST_ERASE) && (request->nSubsectors == 1u) && (queueCount > 0u) )
+    {
+        // A commit of the same subsector erases it anyway
+        if ( (requestQueue[queueHead]->operation == DATAFLASH_REQUEST_COMMIT) &&
+             (requestQueue[queueHead]->subsectorNumber == request->subsectorNumber) )
+        {
+            isEraseNeeded = false;
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
+    {
+        //Do nothing
+    }
+    GateMutex_leave(queueGateHandle, gateKey);
+    if ( request->operation == DATAFLASH_REQUEST_ERASE )
+    {
+        if ( isEraseNeeded == true )
+        {
+            PipelineErase(request);
+        }
+        else
+        {
+            //Do nothing
+        }
+    }
+    else
+    {
+        RunRequest(request, readLength);
+    }
+    for ( batchIndex = 0u; batchIndex < batchLength; batchIndex++ )
+    {
+        CompleteRequest(requestBatch[batchIndex]);
+    }
+}
+//------------------------------------------------------------------------------
+//   DataFlashQueueGetStatistics(unsigned int *requests, unsigned int *mergedReadCount, unsigned int *pipelinedCount, unsigned int *maximumDepth)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of completed requests, the reads merged
+//!  in the transfer of the read before them, the requests carried out while
+//!  an erase was going on and the deepest queue seen
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueGetStatistics(
+                                   unsigned int *requests,                      //!< Completed requests
+                                   unsigned int *mergedReadCount,               //!< Reads merged with the read before
+                                   unsigned int *pipelinedCount,                //!< Requests carried out during an erase
+                                   unsigned int *maximumDepth                   //!< Most requests queued at once
+                                )
+{
+    *requests = completedRequests;
+    *mergedReadCount = mergedReads;
+    *pipelinedCount = pipelinedRequests;
+    *maximumDepth = maximumQueueDepth;
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,187 @@
+//==============================================================================
+//
+//  DataflashQueue.h
+//
+//  Copyright (C) 2026 by Industrial Scientific.
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        DataflashQueue.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the global functions and constants of the dataflash
+//! request queue. A task queues read, program, erase, commit and flush
+//! requests and goes on, the dataflash task carries them out and completes
+//! every request with its callback and its semaphore
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __DATAFLASHQUEUE_H__
+#define __DATAFLASHQUEUE_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdbool.h>
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Semaphore.h>
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define DATAFLASH_QUEUE_LENGTH      16u                                         //!< Requests waiting in the queue at most
+
+//! Operations of a dataflash request
+typedef enum
+{
+    DATAFLASH_REQUEST_READ    = 0x00,   //!< Read nBytes from the subsector to data
+    DATAFLASH_REQUEST_PROGRAM = 0x01,   //!< Program nBytes of data to the erased subsector
+    DATAFLASH_REQUEST_ERASE   = 0x02,   //!< Erase nSubsectors from the subsector
+    DATAFLASH_REQUEST_COMMIT  = 0x03,   //!< Erase the subsector and write the whole subsector from data
+    DATAFLASH_REQUEST_FLUSH   = 0x04    //!< Write the dirty pages of the general and debug page cache
+
+}DATAFLASH_REQUEST_ENUM;
+
+typedef struct DATAFLASH_REQUEST_TAG DATAFLASH_REQUEST_STRUCT;
+
+//! Function called by the dataflash task when a request is completed. It
+//! must not submit a request or wait for one
+typedef void (*DATAFLASH_CALLBACK)(DATAFLASH_REQUEST_STRUCT *request);
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//! This data structure defines a dataflash request. It belongs to the caller
+//! and must not be changed until it is completed
+struct DATAFLASH_REQUEST_TAG
+{
+    DATAFLASH_REQUEST_ENUM operation;         //!< Operation to be carried out
+    unsigned short subsectorNumber;           //!< Subsector of the operation, not used by flush
+    unsigned short byteAddress;               //!< Offset in the subsector, used by read and program only
+    unsigned char *data;                      //!< Bytes read or written, used by read, program and commit
+    unsigned short nBytes;                    //!< Number of bytes read or programmed
+    unsigned short nSubsectors;               //!< Number of subsectors erased, used by erase only
+    DATAFLASH_CALLBACK callback;              //!< Called when the request is completed, can be NULL
+    Semaphore_Handle semaphore;               //!< Posted when the request is completed, can be NULL
+    volatile bool isCompleted;                //!< Set when the request is completed
+};
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   DataFlashQueueInit(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function creates the queue semaphore and gate, it is called before
+//!  the dataflash task is started
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueInit(void);
+//------------------------------------------------------------------------------
+//   DataFlashQueueSubmit(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function queues a request and returns at once, it sleeps while the
+//!  queue is full. Before the dataflash task runs the request is carried out
+//!  and completed before the function returns
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueSubmit(
+                            DATAFLASH_REQUEST_STRUCT *request                   //!< Request to be queued
+                         );
+//------------------------------------------------------------------------------
+//   DataFlashQueueWait(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function blocks until a queued request is completed, on its
+//!  semaphore if it has one
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueWait(
+                          DATAFLASH_REQUEST_STRUCT *request                     //!< Request to wait for
+                       );
+//------------------------------------------------------------------------------
+//   DataFlashQueueIsCompleted(DATAFLASH_REQUEST_STRUCT *request)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns true if a queued request is completed, without
+//!  blocking
+//
+//------------------------------------------------------------------------------
+bool DataFlashQueueIsCompleted(
+                                 DATAFLASH_REQUEST_STRUCT *request              //!< Request to be checked
+                              );
+//------------------------------------------------------------------------------
+//   DataFlashQueueProcess(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function waits for the next request and carries it out. It is
+//!  called in a loop by the dataflash task
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueProcess(void);
+//------------------------------------------------------------------------------
+//   DataFlashQueueGetStatistics(unsigned int *requests, unsigned int *mergedReadCount, unsigned int *pipelinedCount, unsigned int *maximumDepth)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the number of completed requests, the reads merged
+//!  in the transfer of the read before them, the requests carried out while
+//!  an erase was going on and the deepest queue seen
+//
+//------------------------------------------------------------------------------
+void DataFlashQueueGetStatistics(
+                                   unsigned int *requests,                      //!< Completed requests
+                                   unsigned int *mergedReadCount,               //!< Reads merged with the read before
+                                   unsigned int *pipelinedCount,                //!< Requests carried out during an erase
+                                   unsigned int *maximumDepth                   //!< Most requests queued at once
+                                );
+
+#endif /* __DATAFLASHQUEUE_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
@@ -0,0 +1,275 @@
+//==============================================================================
+//
+//  CRC16.c
+//
+//  Copyright (C) 2017 by Industrial Scientific.
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        CRC16.c
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This module calculates the Modbus CRC16 of a buffer four bytes at a time
+//! (slicing by 4). The first table is the usual byte table, each of the other
+//! tables gives the CRC of a byte followed by one, two or three zero bytes, so
+//! one aligned word is added to the CRC with four lookups and no shifts
+//! between them. The word loads assume a little endian processor
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+#include <stdint.h>
+#include "CRC16.h"
+
+//==============================================================================
+//  LOCAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CRC16_SLICES                4U                                          //!< Bytes added to the CRC by one word lookup
+#define CRC16_WORD_ALIGNMENT_MASK   0x03U                                       //!< Address bits of a byte inside a word
+#define CRC16_BYTE_MASK             0xFFU                                       //!< Mask of the lowest byte
+#define SWAP_CRC16_BYTES(crc)       ((unsigned short)(((crc) >> 8) | ((crc) << 8)))   //!< Swaps the record byte order and the calculation byte order
+
+//==============================================================================
+//  LOCAL DATA STRUCTURE DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA DECLARATIONS
+//==============================================================================
+
+//==============================================================================
+//  LOCAL DATA DECLARATIONS
+//==============================================================================
+
+//! CRC tables, crc16SliceTable[n][i] is the CRC of byte i followed by n zero bytes
+static const unsigned short crc16SliceTable[CRC16_SLICES][256] =
+{
+    {
+        0x0000U, 0xC0C1U, 0xC181U, 0x0140U, 0xC301U, 0x03C0U, 0x0280U, 0xC241U,
+        0xC601U, 0x06C0U, 0x0780U, 0xC741U, 0x0500U, 0xC5C1U, 0xC481U, 0x0440U,
+        0xCC01U, 0x0CC0U, 0x0D80U, 0xCD41U, 0x0F00U, 0xCFC1U, 0xCE81U, 0x0E40U,
+        0x0A00U, 0xCAC1U, 0xCB81U, 0x0B40U, 0xC901U, 0x09C0U, 0x0880U, 0xC841U,
+        0xD801U, 0x18C0U, 0x1980U, 0xD941U, 0x1B00U, 0xDBC1U, 0xDA81U, 0x1A40U,
+        0x1E00U, 0xDEC1U, 0xDF81U, 0x1F40U, 0xDD01U, 0x1DC0U, 0x1C80U, 0xDC41U,
+        0x1400U, 0xD4C1U, 0xD581U, 0x1540U, 0xD701U, 0x17C0U, 0x1680U, 0xD641U,
+        0xD201U, 0x12C0U, 0x1380U, 0xD341U, 0x1100U, 0xD1C1U, 0xD081U, 0x1040U,
+        0xF001U, 0x30C0U, 0x3180U, 0xF141U, 0x3300U, 0xF3C1U, 0xF281U, 0x3240U,
+        0x3600U, 0xF6C1U, 0xF781U, 0x3740U, 0xF501U, 0x35C0U, 0x3480U, 0xF441U,
+        0x3C00U, 0xFCC1U, 0xFD81U, 0x3D40U, 0xFF01U, 0x3FC0U, 0x3E80U, 0xFE41U,
+        0xFA01U, 0x3AC0U, 0x3B80U, 0xFB41U, 0x3900U, 0xF9C1U, 0xF881U, 0x3840U,
+        0x2800U, 0xE8C1U, 0xE981U, 0x2940U, 0xEB01U, 0x2BC0U, 0x2A80U, 0xEA41U,
+        0xEE01U, 0x2EC0U, 0x2F80U, 0xEF41U, 0x2D00U, 0xEDC1U, 0xEC81U, 0x2C40U,
+        0xE401U, 0x24C0U, 0x2580U, 0xE541U, 0x2700U, 0xE7C1U, 0xE681U, 0x2640U,
+        0x2200U, 0xE2C1U, 0xE381U, 0x2340U, 0xE101U, 0x21C0U, 0x2080U, 0xE041U,
+        0xA001U, 0x60C0U, 0x6180U, 0xA141U, 0x6300U, 0xA3C1U, 0xA281U, 0x6240U,
+        0x6600U, 0xA6C1U, 0xA781U, 0x6740U, 0xA501U, 0x65C0U, 0x6480U, 0xA441U,
+        0x6C00U, 0xACC1U, 0xAD81U, 0x6D40U, 0xAF01U, 0x6FC0U, 0x6E80U, 0xAE41U,
+        0xAA01U, 0x6AC0U, 0x6B80U, 0xAB41U, 0x6900U, 0xA9C1U, 0xA881U, 0x6840U,
+        0x7800U, 0xB8C1U, 0xB981U, 0x7940U, 0xBB01U, 0x7BC0U, 0x7A80U, 0xBA41U,
+        0xBE01U, 0x7EC0U, 0x7F80U, 0xBF41U, 0x7D00U, 0xBDC1U, 0xBC81U, 0x7C40U,
+        0xB401U, 0x74C0U, 0x7580U, 0xB541U, 0x7700U, 0xB7C1U, 0xB681U, 0x7640U,
+        0x7200U, 0xB2C1U, 0xB381U, 0x7340U, 0xB101U, 0x71C0U, 0x7080U, 0xB041U,
+        0x5000U, 0x90C1U, 0x9181U, 0x5140U, 0x9301U, 0x53C0U, 0x5280U, 0x9241U,
+        0x9601U, 0x56C0U, 0x5780U, 0x9741U, 0x5500U, 0x95C1U, 0x9481U, 0x5440U,
+        0x9C01U, 0x5CC0U, 0x5D80U, 0x9D41U, 0x5F00U, 0x9FC1U, 0x9E81U, 0x5E40U,
+        0x5A00U, 0x9AC1U, 0x9B81U, 0x5B40U, 0x9901U, 0x59C0U, 0x5880U, 0x9841U,
+        0x8801U, 0x48C0U, 0x4980U, 0x8941U, 0x4B00U, 0x8BC1U, 0x8A81U, 0x4A40U,
+        0x4E00U, 0x8EC1U, 0x8F81U, 0x4F40U, 0x8D01U, 0x4DC0U, 0x4C80U, 0x8C41U,
+        0x4400U, 0x84C1U, 0x8581U, 0x4540U, 0x8701U, 0x47C0U, 0x4680U, 0x8641U,
+        0x8201U, 0x42C0U, 0x4380U, 0x8341U, 0x4100U, 0x81C1U, 0x8081U, 0x4040U
+    },
+    {
+        0x0000U, 0x9001U, 0x6001U, 0xF000U, 0xC002U, 0x5003U, 0xA003U, 0x3002U,
+        0xC007U, 0x5006U, 0xA006U, 0x3007U, 0x0005U, 0x9004U, 0x6004U, 0xF005U,
+        0xC00DU, 0x500CU, 0xA00CU, 0x300DU, 0x000FU, 0x900EU, 0x600EU, 0xF00FU,
+        0x000AU, 0x900BU, 0x600BU, 0xF00AU, 0xC008U, 0x5009U, 0xA009U, 0x3008U,
+        0xC019U, 0x5018U, 0xA018U, 0x3019U, 0x001BU, 0x901AU, 0x601AU, 0xF01BU,
+        0x001EU, 0x901FU, 0x601FU, 0xF01EU, 0xC01CU, 0x501DU, 0xA01DU, 0x301CU,
+        0x0014U, 0x9015U, 0x6015U, 0xF014U, 0xC016U, 0x5017U, 0xA017U, 0x3016U,
+        0xC013U, 0x5012U, 0xA012U, 0x3013U, 0x0011U, 0x9010U, 0x6010U, 0xF011U,
+        0xC031U, 0x5030U, 0xA030U, 0x3031U, 0x0033U, 0x9032U, 0x6032U, 0xF033U,
+        0x0036U, 0x9037U, 0x6037U, 0xF036U, 0xC034U, 0x5035U, 0xA035U, 0x3034U,
+        0x003CU, 0x903DU, 0x603DU, 0xF03CU, 0xC03EU, 0x503FU, 0xA03FU, 0x303EU,
+        0xC03BU, 0x503AU, 0xA03AU, 0x303BU, 0x0039U, 0x9038U, 0x6038U, 0xF039U,
+        0x0028U, 0x9029U, 0x6029U, 0xF028U, 0xC02AU, 0x502BU, 0xA02BU, 0x302AU,
+        0xC02FU, 0x502EU, 0xA02EU, 0x302FU, 0x002DU, 0x902CU, 0x602CU, 0xF02DU,
+        0xC025U, 0x5024U, 0xA024U, 0x3025U, 0x0027U, 0x9026U, 0x6026U, 0xF027U,
+        0x0022U, 0x9023U, 0x6023U, 0xF022U, 0xC020U, 0x5021U, 0xA021U, 0x3020U,
+        0xC061U, 0x5060U, 0xA060U, 0x3061U, 0x0063U, 0x9062U, 0x6062U, 0xF063U,
+        0x0066U, 0x9067U, 0x6067U, 0xF066U, 0xC064U, 0x5065U, 0xA065U, 0x3064U,
+        0x006CU, 0x906DU, 0x606DU, 0xF06CU, 0xC06EU, 0x506FU, 0xA06FU, 0x306EU,
+        0xC06BU, 0x506AU, 0xA06AU, 0x306BU, 0x0069U, 0x9068U, 0x6068U, 0xF069U,
+        0x0078U, 0x9079U, 0x6079U, 0xF078U, 0xC07AU, 0x507BU, 0xA07BU, 0x307AU,
+        0xC07FU, 0x507EU, 0xA07EU, 0x307FU, 0x007DU, 0x907CU, 0x607CU, 0xF07DU,
+        0xC075U, 0x5074U, 0xA074U, 0x3075U, 0x0077U, 0x9076U, 0x6076U, 0xF077U,
+        0x0072U, 0x9073U, 0x6073U, 0xF072U, 0xC070U, 0x5071U, 0xA071U, 0x3070U,
+        0x0050U, 0x9051U, 0x6051U, 0xF050U, 0xC052U, 0x5053U, 0xA053U, 0x3052U,
+        0xC057U, 0x5056U, 0xA056U, 0x3057U, 0x0055U, 0x9054U, 0x6054U, 0xF055U,
+        0xC05DU, 0x505CU, 0xA05CU, 0x305DU, 0x005FU, 0x905EU, 0x605EU, 0xF05FU,
+        0x005AU, 0x905BU, 0x605BU, 0xF05AU, 0xC058U, 0x5059U, 0xA059U, 0x3058U,
+        0xC049U, 0x5048U, 0xA048U, 0x3049U, 0x004BU, 0x904AU, 0x604AU, 0xF04BU,
+        0x004EU, 0x904FU, 0x604FU, 0xF04EU, 0xC04CU, 0x504DU, 0xA04DU, 0x304CU,
+        0x0044U, 0x9045U, 0x6045U, 0xF044U, 0xC046U, 0x5047U, 0xA047U, 0x3046U,
+        0xC043U, 0x5042U, 0xA042U, 0x3043U, 0x0041U, 0x9040U, 0x6040U, 0xF041U
+    },
+    {
+        0x0000U, 0xC051U, 0xC0A1U, 0x00F0U, 0xC141U, 0x0110U, 0x01E0U, 0xC1B1U,
+        0xC281U, 0x02D0U, 0x0220U, 0xC271U, 0x03C0U, 0xC391U, 0xC361U, 0x0330U,
+        0xC501U, 0x0550U, 0x05A0U, 0xC5F1U, 0x0440U, 0xC411U, 0xC4E1U, 0x04B0U,
+        0x0780U, 0xC7D1U, 0xC721U, 0x0770U, 0xC6C1U, 0x0690U, 0x0660U, 0xC631U,
+        0xCA01U, 0x0A50U, 0x0AA0U, 0xCAF1U, 0x0B40U, 0xCB11U, 0xCBE1U, 0x0BB0U,
+        0x0880U, 0xC8D1U, 0xC821U, 0x0870U, 0xC9C1U, 0x0990U, 0x0960U, 0xC931U,
+        0x0F00U, 0xCF51U, 0xCFA1U, 0x0FF0U, 0xCE41U, 0x0E10U, 0x0EE0U, 0xCEB1U,
+        0xCD81U, 0x0DD0U, 0x0D20U, 0xCD71U, 0x0CC0U, 0xCC91U, 0xCC61U, 0x0C30U,
+        0xD401U, 0x1450U, 0x14A0U, 0xD4F1U, 0x1540U, 0xD511U, 0xD5E1U, 0x15B0U,
+        0x1680U, 0xD6D1U, 0xD621U, 0x1670U, 0xD7C1U, 0x1790U, 0x1760U, 0xD731U,
+        0x1100U, 0xD151U, 0xD1A1U, 0x11F0U, 0xD041U, 0x1010U, 0x10E0U, 0xD0B1U,
+        0xD381U, 0x13D0U, 0x1320U, 0xD371U, 0x12C0U, 0xD291U, 0xD261U, 0x1230U,
+        0x1E00U, 0xDE51U, 0xDEA1U, 0x1EF0U, 0xDF41U, 0x1F10U, 0x1FE0U, 0xDFB1U,
+        0xDC81U, 0x1CD0U, 0x1C20U, 0xDC71U, 0x1DC0U, 0xDD91U, 0xDD61U, 0x1D30U,
+        0xDB01U, 0x1B50U, 0x1BA0U, 0xDBF1U, 0x1A40U, 0xDA11U, 0xDAE1U, 0x1AB0U,
+        0x1980U, 0xD9D1U, 0xD921U, 0x1970U, 0xD8C1U, 0x1890U, 0x1860U, 0xD831U,
+        0xE801U, 0x2850U, 0x28A0U, 0xE8F1U, 0x2940U, 0xE911U, 0xE9E1U, 0x29B0U,
+        0x2A80U, 0xEAD1U, 0xEA21U, 0x2A70U, 0xEBC1U, 0x2B90U, 0x2B60U, 0xEB31U,
+        0x2D00U, 0xED51U, 0xEDA1U, 0x2DF0U, 0xEC41U, 0x2C10U, 0x2CE0U, 0xECB1U,
+        0xEF81U, 0x2FD0U, 0x2F20U, 0xEF71U, 0x2EC0U, 0xEE91U, 0xEE61U, 0x2E30U,
+        0x2200U, 0xE251U, 0xE2A1U, 0x22F0U, 0xE341U, 0x2310U, 0x23E0U, 0xE3B1U,
+        0xE081U, 0x20D0U, 0x2020U, 0xE071U, 0x21C0U, 0xE191U, 0xE161U, 0x2130U,
+        0xE701U, 0x2750U, 0x27A0U, 0xE7F1U, 0x2640U, 0xE611U, 0xE6E1U, 0x26B0U,
+        0x2580U, 0xE5D1U, 0xE521U, 0x2570U, 0xE4C1U, 0x2490U, 0x2460U, 0xE431U,
+        0x3C00U, 0xFC51U, 0xFCA1U, 0x3CF0U, 0xFD41U, 0x3D10U, 0x3DE0U, 0xFDB1U,
+        0xFE81U, 0x3ED0U, 0x3E20U, 0xFE71U, 0x3FC0U, 0xFF91U, 0xFF61U, 0x3F30U,
+        0xF901U, 0x3950U, 0x39A0U, 0xF9F1U, 0x3840U, 0xF811U, 0xF8E1U, 0x38B0U,
+        0x3B80U, 0xFBD1U, 0xFB21U, 0x3B70U, 0xFAC1U, 0x3A90U, 0x3A60U, 0xFA31U,
+        0xF601U, 0x3650U, 0x36A0U, 0xF6F1U, 0x3740U, 0xF711U, 0xF7E1U, 0x37B0U,
+        0x3480U, 0xF4D1U, 0xF421U, 0x3470U, 0xF5C1U, 0x3590U, 0x3560U, 0xF531U,
+        0x3300U, 0xF351U, 0xF3A1U, 0x33F0U, 0xF241U, 0x3210U, 0x32E0U, 0xF2B1U,
+        0xF181U, 0x31D0U, 0x3120U, 0xF171U, 0x30C0U, 0xF091U, 0xF061U, 0x3030U
+    },
+    {
+        0x0000U, 0xFC01U, 0xB801U, 0x4400U, 0x3001U, 0xCC00U, 0x8800U, 0x7401U,
+        0x6002U, 0x9C03U, 0xD803U, 0x2402U, 0x5003U, 0xAC02U, 0xE802U, 0x1403U,
+        0xC004U, 0x3C05U, 0x7805U, 0x8404U, 0xF005U, 0x0C04U, 0x4804U, 0xB405U,
+        0xA006U, 0x5C07U, 0x1807U, 0xE406U, 0x9007U, 0x6C06U, 0x2806U, 0xD407U,
+        0xC00BU, 0x3C0AU, 0x780AU, 0x840BU, 0xF00AU, 0x0C0BU, 0x480BU, 0xB40AU,
+        0xA009U, 0x5C08U, 0x1808U, 0xE409U, 0x9008U, 0x6C09U, 0x2809U, 0xD408U,
+        0x000FU, 0xFC0EU, 0xB80EU, 0x440FU, 0x300EU, 0xCC0FU, 0x880FU, 0x740EU,
+        0x600DU, 0x9C0CU, 0xD80CU, 0x240DU, 0x500CU, 0xAC0DU, 0xE80DU, 0x140CU,
+        0xC015U, 0x3C14U, 0x7814U, 0x8415U, 0xF014U, 0x0C15U, 0x4815U, 0xB414U,
+        0xA017U, 0x5C16U, 0x1816U, 0xE417U, 0x9016U, 0x6C17U, 0x2817U, 0xD416U,
+        0x0011U, 0xFC10U, 0xB810U, 0x4411U, 0x3010U, 0xCC11U, 0x8811U, 0x7410U,
+        0x6013U, 0x9C12U, 0xD812U, 0x2413U, 0x5012U, 0xAC13U, 0xE813U, 0x1412U,
+        0x001EU, 0xFC1FU, 0xB81FU, 0x441EU, 0x301FU, 0xCC1EU, 0x881EU, 0x741FU,
+        0x601CU, 0x9C1DU, 0xD81DU, 0x241CU, 0x501DU, 0xAC1CU, 0xE81CU, 0x141DU,
+        0xC01AU, 0x3C1BU, 0x781BU, 0x841AU, 0xF01BU, 0x0C1AU, 0x481AU, 0xB41BU,
+        0xA018U, 0x5C19U, 0x1819U, 0xE418U, 0x9019U, 0x6C18U, 0x2818U, 0xD419U,
+        0xC029U, 0x3C28U, 0x7828U, 0x8429U, 0xF028U, 0x0C29U, 0x4829U, 0xB428U,
+        0xA02BU, 0x5C2AU, 0x182AU, 0xE42BU, 0x902AU, 0x6C2BU, 0x282BU, 0xD42AU,
+        0x002DU, 0xFC2CU, 0xB82CU, 0x442DU, 0x302CU, 0xCC2DU, 0x882DU, 0x742CU,
+        0x602FU, 0x9C2EU, 0xD82EU, 0x242FU, 0x502EU, 0xAC2FU, 0xE82FU, 0x142EU,
+        0x0022U, 0xFC23U, 0xB823U, 0x4422U, 0x3023U, 0xCC22U, 0x8822U, 0x7423U,
+        0x6020U, 0x9C21U, 0xD821U, 0x2420U, 0x5021U, 0xAC20U, 0xE820U, 0x1421U,
+        0xC026U, 0x3C27U, 0x7827U, 0x8426U, 0xF027U, 0x0C26U, 0x4826U, 0xB427U,
+        0xA024U, 0x5C25U, 0x1825U, 0xE424U, 0x9025U, 0x6C24U, 0x2824U, 0xD425U,
+        0x003CU, 0xFC3DU, 0xB83DU, 0x443CU, 0x303DU, 0xCC3CU, 0x883CU, 0x743DU,
+        0x603EU, 0x9C3FU, 0xD83FU, 0x243EU, 0x503FU, 0xAC3EU, 0xE83EU, 0x143FU,
+        0xC038U, 0x3C39U, 0x7839U, 0x8438U, 0xF039U, 0x0C38U, 0x4838U, 0xB439U,
+        0xA03AU, 0x5C3BU, 0x183BU, 0xE43AU, 0x903BU, 0x6C3AU, 0x283AU, 0xD43BU,
+        0xC037U, 0x3C36U, 0x7836U, 0x8437U, 0xF036U, 0x0C37U, 0x4837U, 0xB436U,
+        0xA035U, 0x5C34U, 0x1834U, 0xE435U, 0x9034U, 0x6C35U, 0x2835U, 0xD434U,
+        0x0033U, 0xFC32U, 0xB832U, 0x4433U, 0x3032U, 0xCC33U, 0x8833U, 0x7432U,
+        0x6031U, 0x9C30U, 0xD830U, 0x2431U, 0x5030U, 0xAC31U, 0xE831U, 0x1430U
+    }
+};
+
+//==============================================================================
+//  LOCAL FUNCTION PROTOTYPES
+//==============================================================================
+
+//==============================================================================
+//  LOCAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL FUNCTIONS IMPLEMENTATION
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CRC16Calculate(const unsigned char *data, unsigned int length, unsigned short crcValue)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the CRC of the given bytes, continuing from the CRC
+//!  of the bytes before them. It gives the same CRC as DataFlashGetCumulativeCRC
+//!  called for every byte
+//
+//------------------------------------------------------------------------------
+unsigned short CRC16Calculate(
+                                const unsigned char *data,                      //!< Bytes to be added to the CRC
+                                unsigned int length,                            //!< Number of bytes
+                                unsigned short crcValue                         //!< CRC of the bytes before, CRC16_INITIAL_VALUE at the start
+                             )
+{
+    //For the CRC in the byte order of the calculation
+    unsigned int crc = SWAP_CRC16_BYTES(crcValue);
+    //For the word added to the CRC
+    unsigned int word = 0U;
+    // Add the bytes before the first aligned word
+    while ( (length > 0U) && ((((uintptr_t) data) & CRC16_WORD_ALIGNMENT_MASK) != 0U) )
+    {
+        crc = (crc >> 8) ^ crc16SliceTable[0][(crc ^ (*data)) & CRC16_BYTE_MASK];
+        data++;
+        length--;
+    }
+    // Add the aligned words
+    while ( length >= CRC16_SLICES )
+    {
+        word = (*((const uint32_t *) data)) ^ crc;
+        crc = crc16SliceTable[3][word & CRC16_BYTE_MASK] ^
+              crc16SliceTable[2][(word >> 8) & CRC16_BYTE_MASK] ^
+              crc16SliceTable[1][(word >> 16) & CRC16_BYTE_MASK] ^
+              crc16SliceTable[0][word >> 24];
+        data = data + CRC16_SLICES;
+        length = length - CRC16_SLICES;
+    }
+    // Add the bytes after the last word
+    while ( length > 0U )
+    {
+        crc = (crc >> 8) ^ crc16SliceTable[0][(crc ^ (*data)) & CRC16_BYTE_MASK];
+        data++;
+        length--;
+    }
+    return SWAP_CRC16_BYTES(crc);
+}
+//==============================================================================
+//  End Of File
+//==============================================================================
\ No newline at end of file
@@ -0,0 +1,88 @@
+//==============================================================================
+//
+//  CRC16.h
+//
+//  Copyright (C) 2017 by Industrial Scientific.
+//
+//  This document and all information contained within are confidential and
+//  proprietary property of Industrial Scientific Corporation. All rights
+//  reserved. It is not to be reproduced or reused without the prior approval
+//  of Industrial Scientific Corporation.
+//
+//==============================================================================
+//  FILE INFORMATION
+//==============================================================================
+//
+//  Source:        CRC16.h
+//
+//  Project:       Morrison
+//
+//  Author:        Ali Zulqarnain Anjum
+//
+//  Date:          2026/10/17
+//
+//  Revision:      1.0
+//
+//==============================================================================
+//  FILE DESCRIPTION
+//==============================================================================
+//
+//! \file
+//! This file declares the CRC16 function shared by the dataflash records and
+//! the self test of the application image. The CRC is the Modbus CRC16
+//! (polynomial 0xA001 reflected), with the high and low bytes in the order
+//! of the dataflash records
+//
+//==============================================================================
+//  REVISION HISTORY
+//==============================================================================
+//  Revision: 1.0  2026/10/17  Ali Zulqarnain Anjum
+//      Initial version
+//
+//==============================================================================
+
+#ifndef __CRC16_H__
+#define __CRC16_H__
+
+//==============================================================================
+//  INCLUDES
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL CONSTANTS, TYPEDEFS AND MACROS
+//==============================================================================
+
+#define CRC16_INITIAL_VALUE         0xFFFFU                                     //!< CRC before the first byte
+
+//==============================================================================
+//  GLOBAL DATA STRUCTURES DEFINITION
+//==============================================================================
+
+//==============================================================================
+//  GLOBAL DATA
+//==============================================================================
+
+//==============================================================================
+//  EXTERNAL OR GLOBAL FUNCTIONS
+//==============================================================================
+//------------------------------------------------------------------------------
+//   CRC16Calculate(const unsigned char *data, unsigned int length, unsigned short crcValue)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This function returns the CRC of the given bytes, continuing from the CRC
+//!  of the bytes before them. It gives the same CRC as DataFlashGetCumulativeCRC
+//!  called for every byte
+//
+//------------------------------------------------------------------------------
+unsigned short CRC16Calculate(
+                                const unsigned char *data,                      //!< Bytes to be added to the CRC
+                                unsigned int length,                            //!< Number of bytes
+                                unsigned short crcValue                         //!< CRC of the bytes before, CRC16_INITIAL_VALUE at the start
+                             );
+
+#endif /* __CRC16_H__ */
+//==============================================================================
+//  End Of File
+//==============================================================================
\ No newline at end of file
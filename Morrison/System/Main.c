@@ -72,6 +72,7 @@
 #include "Button.h"
 #include "ErrorLog.h"
 #include "DataFlash.h"
+#include "DataflashQueue.h"
 #include "EventLog.h"
 #include "TM4CEEPROM.h"
 #include "Main.h"
@@ -81,6 +82,10 @@
 #define DEFAULT_TASK_PRIORITY   5
 #define DEFAULT_TASKSTACKSIZE   512
 #define TEST_TASK_SIZE          16896
+#define EVENTLOG_TASKSTACKSIZE  1024
+#define ERRORLOG_TASK_PRIORITY  2
+#define ERRORLOG_TASKSTACKSIZE  1024
+#define DATAFLASH_TASKSTACKSIZE 1024
 //==============================================================================
 //  LOCAL DATA STRUCTURE DEFINITION
 //==============================================================================
@@ -97,6 +102,8 @@ Task_Handle taskParsing;
 Task_Handle taskInitialization;
 Task_Handle taskBattery;
 Task_Handle taskUSBDataRecieve;
+Task_Handle taskErrorLog;
+Task_Handle taskDataflash;
 
 Event_Struct evtStruct;
 Event_Handle evtHandle;
@@ -132,6 +139,8 @@ void TaskTCPClient(void);
 void TaskWhisper(void);
 void TaskParsing(void);
 void TaskBattery(void);
+void TaskErrorLog(void);
+void TaskDataflash(void);
 void TaskIdle(void);
 void SetIsDeviceInPeeking(bool);
 bool GetIsDeviceInPeeking(void);
@@ -497,6 +506,10 @@ void TaskEventLog(void)
     {
         //System_printf("In TaskEventLog \n");     
         //System_flush();
+        // Commit the full event log pages to dataflash
+        EventLogFlushFullPages();
+        // Erase the event log subsectors ahead while there is nothing to commit
+        EventLogEraseAhead();
         Task_sleep(5);
     }
 }
@@ -753,6 +766,39 @@ void TaskUSBDataRecieve(void)
     }
 }
 //------------------------------------------------------------------------------
+//   TaskErrorLog(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This task writes the errors queued by the interrupts to the error log
+//------------------------------------------------------------------------------
+
+void TaskErrorLog(void)
+{
+    while(1)
+    {
+        ErrorLogProcessDeferred();
+        Task_sleep(10);
+    }
+}
+//------------------------------------------------------------------------------
+//   TaskDataflash(void)
+//
+//   Author:   Ali Zulqarnain Anjum
+//   Date:     2026/10/17
+//
+//!  This task carries out the queued dataflash requests
+//------------------------------------------------------------------------------
+
+void TaskDataflash(void)
+{
+    while(1)
+    {
+        DataFlashQueueProcess();
+    }
+}
+//------------------------------------------------------------------------------
 //   TaskIdle(void)
 //
 //   Author:  Fehan Arif 
@@ -921,7 +967,7 @@ int main(void)
     }  
     // 6-Construct TaskEventLog Task threads
     
-    taskParams.stackSize = DEFAULT_TASKSTACKSIZE;
+    taskParams.stackSize = EVENTLOG_TASKSTACKSIZE;
     taskParams.priority = DEFAULT_TASK_PRIORITY;
     taskEventLog = Task_create((Task_FuncPtr)TaskEventLog, &taskParams, &eb);
     if (taskEventLog == NULL)
@@ -972,6 +1018,29 @@ int main(void)
         System_abort("Task create failed");
     }
     
+    // 13-Construct TaskErrorLog  Task threads, below the other tasks as it
+    // only writes the errors of the interrupts. The gate of the error log is
+    // created before any task writes an error
+    ErrorLogCreateGate();
+    taskParams.stackSize = ERRORLOG_TASKSTACKSIZE;
+    taskParams.priority = ERRORLOG_TASK_PRIORITY;
+    taskErrorLog = Task_create((Task_FuncPtr)TaskErrorLog, &taskParams, &eb);
+    if (taskErrorLog == NULL)
+    {
+        System_abort("Task create failed");
+    }
+    
+    // 14-Construct TaskDataflash  Task threads, the event log, the error log
+    // and the debug writes queue their dataflash requests to it
+    DataFlashQueueInit();
+    taskParams.stackSize = DATAFLASH_TASKSTACKSIZE;
+    taskParams.priority = DEFAULT_TASK_PRIORITY;
+    taskDataflash = Task_create((Task_FuncPtr)TaskDataflash, &taskParams, &eb);
+    if (taskDataflash == NULL)
+    {
+        System_abort("Task create failed");
+    }
+    
     // Set the device mode to peeking
     isDeviceInPeeking = true;
     
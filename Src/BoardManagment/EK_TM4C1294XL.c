@@ -60,6 +60,7 @@
 #include <driverlib/udma.h>
 
 #include "EK_TM4C1294XL.h"
+#include "ErrorLog.h"
 
 #ifndef TI_DRIVERS_UART_DMA
 #define TI_DRIVERS_UART_DMA 0
@@ -82,7 +83,7 @@ extern int USBSerialPPP_NIMUInit();
 #elif defined(__GNUC__)
 __attribute__ ((aligned (1024)))
 #endif
-static tDMAControlTable dmaControlTable[32];
+static tDMAControlTable dmaControlTable[64];         /* Primary and alternate structures */
 static bool dmaInitialized = false;
 
 /* Hwi_Struct used in the initDMA Hwi_construct call */
@@ -93,12 +94,15 @@ static Hwi_Struct usbBusFaultHwiStruct;
 
 /*
  *  ======== dmaErrorHwi ========
+ *  A uDMA bus error is queued for the error log, the dataflash cannot be
+ *  written from the interrupt.
  */
 static Void dmaErrorHwi(UArg arg)
 {
-    System_printf("DMA error code: %d\n", uDMAErrorStatusGet());
-    uDMAErrorStatusClear();
-    System_abort("DMA error!!");
+    if (uDMAErrorStatusGet() != 0) {
+        uDMAErrorStatusClear();
+        ErrorLogWriteFromISR(ERRORCODE_ENUM_UDMA_ERROR, ERRORTYPE_ENUM_CRITICAL);
+    }
 }
 
 /*